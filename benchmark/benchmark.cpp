@@ -12,9 +12,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <vector>
 #if defined(_MSC_VER)
 #include <Windows.h>
@@ -24,14 +27,23 @@
 #include <sys/time.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <dirent.h>
 #endif
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
 #include "core/Backend.hpp"
 #include <MNN/Interpreter.hpp>
 #include <MNN/MNNDefine.h>
 #include <MNN/Tensor.hpp>
 #include "revertMNNModel.hpp"
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
 /**
  TODOs:
  1. dynamically get CPU related info.
@@ -116,32 +128,235 @@ static inline uint64_t getTimeInUs() {
     return time;
 }
 
-std::vector<float> doBench(Model& model, int loop, int warmup = 10, int forward = MNN_FORWARD_CPU, bool only_inference = true,
-                           int numberThread = 4, int precision = 2) {
+static inline std::string forwardType(MNNForwardType type) {
+    switch (type) {
+        case MNN_FORWARD_CPU:
+            return "CPU";
+        case MNN_FORWARD_VULKAN:
+            return "Vulkan";
+        case MNN_FORWARD_OPENCL:
+            return "OpenCL";
+        case MNN_FORWARD_METAL:
+            return "Metal";
+        default:
+            break;
+    }
+    return "N/A";
+}
+
+/** options of the benchmark, from the command line or an options file */
+struct BenchOptions {
+    std::vector<Model> models;
+    int loop                 = 10;
+    int warmup               = 10;
+    MNNForwardType forward   = MNN_FORWARD_CPU;
+    std::vector<int> threads = {4};
+    int precision            = 2;
+    // model name -> input name -> dims, inputs not listed keep the shape of the model
+    std::map<std::string, std::map<std::string, std::vector<int>>> shapes;
+    // cpus the benchmark is bound to, empty for no binding
+    std::vector<int> cpus;
+    // time each op in extra loops by runSessionWithCallBackInfo
+    bool perOp = false;
+    // result file, json or csv by format
+    std::string output;
+    std::string format = "json";
+    // result file of a former run and the ratio of a slower metric to report as regression
+    std::string baseline;
+    std::string compareMetric = "p50";
+    float threshold           = 0.05f;
+};
+
+struct OpRecord {
+    std::string name;
+    std::string type;
+    float cost  = 0.0f;
+    float flops = 0.0f;
+    int count   = 0;
+};
+
+struct BenchResult {
+    std::string name;
+    int numberThread = 0;
+    // createFromBuffer, createSession with resize and the first inference, in ms
+    float loadTime   = 0.0f;
+    float createTime = 0.0f;
+    float coldTime   = 0.0f;
+    // warm inferences
+    std::vector<float> costs;
+    float sessionMemory = 0.0f;
+    float peakRSS       = 0.0f;
+    // average of a loop, sorted by cost
+    std::vector<OpRecord> ops;
+    std::vector<OpRecord> opTypes;
+};
+
+struct BenchStats {
+    float min    = 0.0f;
+    float max    = 0.0f;
+    float avg    = 0.0f;
+    float stddev = 0.0f;
+    float p50    = 0.0f;
+    float p90    = 0.0f;
+    float p99    = 0.0f;
+};
+
+// Linear interpolation between the closest ranks
+static float percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) {
+        return 0.0f;
+    }
+    float position = p * (sorted.size() - 1);
+    int lower      = (int)position;
+    int upper      = std::min(lower + 1, (int)sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+}
+
+static BenchStats computeStats(const std::vector<float>& costs) {
+    BenchStats stats;
+    if (costs.empty()) {
+        return stats;
+    }
+    std::vector<float> sorted = costs;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (auto v : sorted) {
+        sum += v;
+    }
+    stats.min = sorted.front();
+    stats.max = sorted.back();
+    stats.avg = sum / sorted.size();
+    double variance = 0.0;
+    for (auto v : sorted) {
+        variance += (v - stats.avg) * (v - stats.avg);
+    }
+    stats.stddev = sorted.size() > 1 ? sqrt(variance / (sorted.size() - 1)) : 0.0f;
+    stats.p50    = percentile(sorted, 0.5f);
+    stats.p90    = percentile(sorted, 0.9f);
+    stats.p99    = percentile(sorted, 0.99f);
+    return stats;
+}
+
+// Reset the peak resident memory so that it's measured per model, return false if the system doesn't support it
+static bool resetPeakRSS() {
+#if defined(__linux__) || defined(__ANDROID__)
+    FILE* fp = fopen("/proc/self/clear_refs", "w");
+    if (nullptr == fp) {
+        return false;
+    }
+    bool success = fputs("5", fp) >= 0;
+    fclose(fp);
+    return success;
+#else
+    return false;
+#endif
+}
+
+// Peak resident memory of the process in MB, 0 if unknown
+static float getPeakRSS() {
+#if defined(__linux__) || defined(__ANDROID__)
+    FILE* fp = fopen("/proc/self/status", "r");
+    if (nullptr != fp) {
+        char line[256];
+        long peak = -1;
+        while (fgets(line, sizeof(line), fp)) {
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                peak = atol(line + 6);
+                break;
+            }
+        }
+        fclose(fp);
+        if (peak >= 0) {
+            return peak / 1024.0f;
+        }
+    }
+#endif
+#if defined(_MSC_VER)
+    return 0.0f;
+#else
+    struct rusage usage;
+    if (0 != getrusage(RUSAGE_SELF, &usage)) {
+        return 0.0f;
+    }
+#if defined(__APPLE__)
+    // In bytes
+    return usage.ru_maxrss / 1024.0f / 1024.0f;
+#else
+    return usage.ru_maxrss / 1024.0f;
+#endif
+#endif
+}
+
+static bool setCpuAffinity(const std::vector<int>& cpus) {
+#if defined(__linux__) || defined(__ANDROID__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &mask);
+    }
+    // The worker threads created later inherit the affinity
+    return 0 == syscall(__NR_sched_setaffinity, 0, sizeof(mask), &mask);
+#else
+    return false;
+#endif
+}
+
+static void sortRecords(std::vector<OpRecord>& records, const std::map<std::string, OpRecord>& source, int loop) {
+    records.clear();
+    for (auto& iter : source) {
+        auto record = iter.second;
+        record.cost /= loop;
+        record.flops /= loop;
+        record.count /= loop;
+        records.emplace_back(record);
+    }
+    std::sort(records.begin(), records.end(), [](const OpRecord& a, const OpRecord& b) { return a.cost > b.cost; });
+}
+
+BenchResult doBench(Model& model, const BenchOptions& options, int numberThread) {
+    BenchResult result;
+    result.name         = model.name;
+    result.numberThread = numberThread;
+    resetPeakRSS();
     auto revertor = std::unique_ptr<Revert>(new Revert(model.model_file.c_str()));
     revertor->initialize();
     auto modelBuffer      = revertor->getBuffer();
     const auto bufferSize = revertor->getBufferSize();
+    auto timeBegin        = getTimeInUs();
     auto net = std::shared_ptr<MNN::Interpreter>(MNN::Interpreter::createFromBuffer(modelBuffer, bufferSize));
+    result.loadTime = (getTimeInUs() - timeBegin) / 1000.0f;
     revertor.reset();
-    net->setSessionMode(MNN::Interpreter::Session_Release);
+    // Callback with op info needs debug mode
+    net->setSessionMode(options.perOp ? MNN::Interpreter::Session_Debug : MNN::Interpreter::Session_Release);
     MNN::ScheduleConfig config;
     config.numThread = numberThread;
-    config.type      = static_cast<MNNForwardType>(forward);
+    config.type      = options.forward;
     MNN::BackendConfig backendConfig;
-    backendConfig.precision = (MNN::BackendConfig::PrecisionMode)precision;
+    backendConfig.precision = (MNN::BackendConfig::PrecisionMode)options.precision;
     backendConfig.power = MNN::BackendConfig::Power_High;
     config.backendConfig = &backendConfig;
 
-    std::vector<float> costs;
+    timeBegin             = getTimeInUs();
     MNN::Session* session = net->createSession(config);
-    net->releaseModel();
     MNN::Tensor* input    = net->getSessionInput(session, NULL);
 
-    // if the model has not the input dimension, umcomment the below code to set the input dims
-    // std::vector<int> dims{1, 3, 224, 224};
-    // net->resizeTensor(input, dims);
-    // net->resizeSession(session);
+    // Set the input dims from options, for the model has not the input dimension or other shapes are measured
+    auto shapeIter = options.shapes.find(model.name);
+    if (shapeIter != options.shapes.end()) {
+        for (auto& iter : shapeIter->second) {
+            auto tensor = net->getSessionInput(session, iter.first.empty() ? nullptr : iter.first.c_str());
+            if (nullptr == tensor) {
+                std::cout << "Can't find input " << iter.first << " of " << model.name << std::endl;
+                continue;
+            }
+            net->resizeTensor(tensor, iter.second);
+        }
+        net->resizeSession(session);
+    }
+    result.createTime = (getTimeInUs() - timeBegin) / 1000.0f;
+    if (!options.perOp) {
+        net->releaseModel();
+    }
 
     const MNN::Backend* inBackend = net->getBackend(session, input);
 
@@ -149,54 +364,353 @@ std::vector<float> doBench(Model& model, int loop, int warmup = 10, int forward
 
     auto outputTensor = net->getSessionOutput(session, NULL);
     std::shared_ptr<MNN::Tensor> expectTensor(MNN::Tensor::createHostTensorFromDevice(outputTensor, false));
-    // Warming up...
-    for (int i = 0; i < warmup; ++i) {
+    auto runOnce = [&]() {
         input->copyFromHostTensor(givenTensor.get());
         net->runSession(session);
         outputTensor->copyToHostTensor(expectTensor.get());
+    };
+    // The first inference may initialize lazily
+    timeBegin = getTimeInUs();
+    runOnce();
+    result.coldTime = (getTimeInUs() - timeBegin) / 1000.0f;
+    // Warming up...
+    for (int i = 0; i < options.warmup; ++i) {
+        runOnce();
     }
 
-    for (int round = 0; round < loop; round++) {
+    for (int round = 0; round < options.loop; round++) {
         auto timeBegin = getTimeInUs();
-
-        input->copyFromHostTensor(givenTensor.get());
-        net->runSession(session);
-        outputTensor->copyToHostTensor(expectTensor.get());
-
+        runOnce();
         auto timeEnd = getTimeInUs();
-        costs.push_back((timeEnd - timeBegin) / 1000.0);
+        result.costs.push_back((timeEnd - timeBegin) / 1000.0);
+    }
+    net->getSessionInfo(session, MNN::Interpreter::MEMORY, &result.sessionMemory);
+
+    if (options.perOp && options.loop > 0) {
+        std::map<std::string, OpRecord> byName, byType;
+        uint64_t opBegin = 0;
+        MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>&, const MNN::OperatorInfo* info) {
+            opBegin = getTimeInUs();
+            return true;
+        };
+        MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>&, const MNN::OperatorInfo* info) {
+            auto cost = (getTimeInUs() - opBegin) / 1000.0f;
+            for (auto record : {&byName[info->name()], &byType[info->type()]}) {
+                record->name = info->name();
+                record->type = info->type();
+                record->cost += cost;
+                record->flops += info->flops();
+                record->count++;
+            }
+            return true;
+        };
+        for (int round = 0; round < options.loop; round++) {
+            input->copyFromHostTensor(givenTensor.get());
+            // Sync for each op, so that the time of async backends is correct
+            net->runSessionWithCallBackInfo(session, before, after, true);
+            outputTensor->copyToHostTensor(expectTensor.get());
+        }
+        sortRecords(result.ops, byName, options.loop);
+        sortRecords(result.opTypes, byType, options.loop);
     }
-    return costs;
+    result.peakRSS = getPeakRSS();
+    return result;
 }
 
 void displayStats(const std::string& name, const std::vector<float>& costs) {
-    float max = 0, min = FLT_MAX, sum = 0, avg;
-    for (auto v : costs) {
-        max = fmax(max, v);
-        min = fmin(min, v);
-        sum += v;
-        //printf("[ - ] cost：%f ms\n", v);
+    auto stats = computeStats(costs);
+    printf("[ - ] %-24s    max = %8.3f ms  min = %8.3f ms  avg = %8.3f ms\n", name.c_str(), stats.max, stats.min,
+           stats.avg);
+}
+
+void displayResult(const BenchResult& result) {
+    auto stats = computeStats(result.costs);
+    displayStats(result.name, result.costs);
+    printf("      %-24s    p50 = %8.3f ms  p90 = %8.3f ms  p99 = %8.3f ms  stddev = %8.3f ms\n", "", stats.p50,
+           stats.p90, stats.p99, stats.stddev);
+    printf("      %-24s    create = %8.3f ms  cold = %8.3f ms  memory = %8.3f MB  peak rss = %8.3f MB\n", "",
+           result.createTime, result.coldTime, result.sessionMemory, result.peakRSS);
+    float opTotal = 0.0f;
+    for (auto& record : result.opTypes) {
+        opTotal += record.cost;
+    }
+    for (auto& record : result.opTypes) {
+        printf("      %-24s    %-20s %8.3f ms  %6.2f %%  %10.3f MFlops\n", "", record.type.c_str(), record.cost,
+               opTotal > 0.0f ? record.cost / opTotal * 100.0f : 0.0f, record.flops);
     }
-    avg = costs.size() > 0 ? sum / costs.size() : 0;
-    printf("[ - ] %-24s    max = %8.3f ms  min = %8.3f ms  avg = %8.3f ms\n", name.c_str(), max, avg == 0 ? 0 : min, avg);
 }
-static inline std::string forwardType(MNNForwardType type) {
-    switch (type) {
-        case MNN_FORWARD_CPU:
-            return "CPU";
-        case MNN_FORWARD_VULKAN:
-            return "Vulkan";
-        case MNN_FORWARD_OPENCL:
-            return "OpenCL";
-        case MNN_FORWARD_METAL:
-            return "Metal";
-        default:
-            break;
+
+static void writeRecords(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer, const char* key,
+                         const std::vector<OpRecord>& records, bool withName) {
+    float total = 0.0f;
+    for (auto& record : records) {
+        total += record.cost;
     }
-    return "N/A";
+    writer.Key(key);
+    writer.StartArray();
+    for (auto& record : records) {
+        writer.StartObject();
+        if (withName) {
+            writer.Key("name");
+            writer.String(record.name.c_str());
+        }
+        writer.Key("type");
+        writer.String(record.type.c_str());
+        writer.Key("count");
+        writer.Int(record.count);
+        writer.Key("time");
+        writer.Double(record.cost);
+        writer.Key("percent");
+        writer.Double(total > 0.0f ? record.cost / total * 100.0f : 0.0f);
+        writer.Key("mflops");
+        writer.Double(record.flops);
+        writer.EndObject();
+    }
+    writer.EndArray();
+}
+
+// Times are in ms and memory in MB
+static std::string resultToJson(const BenchOptions& options, const std::vector<BenchResult>& results) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("forward");
+    writer.String(forwardType(options.forward).c_str());
+    writer.Key("precision");
+    writer.Int(options.precision);
+    writer.Key("loop");
+    writer.Int(options.loop);
+    writer.Key("warmup");
+    writer.Int(options.warmup);
+    writer.Key("results");
+    writer.StartArray();
+    for (auto& result : results) {
+        auto stats = computeStats(result.costs);
+        writer.StartObject();
+        writer.Key("model");
+        writer.String(result.name.c_str());
+        writer.Key("threads");
+        writer.Int(result.numberThread);
+        std::vector<std::pair<const char*, float>> values = {
+            {"load", result.loadTime}, {"create", result.createTime}, {"cold", result.coldTime},
+            {"min", stats.min},        {"max", stats.max},            {"avg", stats.avg},
+            {"stddev", stats.stddev},  {"p50", stats.p50},            {"p90", stats.p90},
+            {"p99", stats.p99},        {"memory", result.sessionMemory}, {"peakRSS", result.peakRSS},
+        };
+        for (auto& v : values) {
+            writer.Key(v.first);
+            writer.Double(v.second);
+        }
+        if (!result.ops.empty()) {
+            writeRecords(writer, "opTypes", result.opTypes, false);
+            writeRecords(writer, "ops", result.ops, true);
+        }
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+// One row per model, the ops are listed after the models with the time of an inference
+static std::string resultToCsv(const std::vector<BenchResult>& results) {
+    std::ostringstream os;
+    os << "model,threads,load,create,cold,min,max,avg,stddev,p50,p90,p99,memory,peakRSS\n";
+    for (auto& result : results) {
+        auto stats = computeStats(result.costs);
+        os << result.name << "," << result.numberThread << "," << result.loadTime << "," << result.createTime << ","
+           << result.coldTime << "," << stats.min << "," << stats.max << "," << stats.avg << "," << stats.stddev
+           << "," << stats.p50 << "," << stats.p90 << "," << stats.p99 << "," << result.sessionMemory << ","
+           << result.peakRSS << "\n";
+    }
+    bool hasOps = false;
+    for (auto& result : results) {
+        hasOps = hasOps || !result.ops.empty();
+    }
+    if (hasOps) {
+        os << "\nmodel,threads,op,type,count,time,mflops\n";
+        for (auto& result : results) {
+            for (auto& record : result.ops) {
+                os << result.name << "," << result.numberThread << "," << record.name << "," << record.type << ","
+                   << record.count << "," << record.cost << "," << record.flops << "\n";
+            }
+        }
+    }
+    return os.str();
+}
+
+static bool readFile(const std::string& fileName, std::string& content) {
+    std::ifstream file(fileName.c_str());
+    if (file.fail()) {
+        return false;
+    }
+    std::ostringstream os;
+    os << file.rdbuf();
+    content = os.str();
+    return true;
+}
+
+static std::vector<int> readInts(const rapidjson::Value& value) {
+    std::vector<int> result;
+    if (value.IsInt()) {
+        result.emplace_back(value.GetInt());
+    } else if (value.IsArray()) {
+        for (auto iter = value.Begin(); iter != value.End(); iter++) {
+            if (iter->IsInt()) {
+                result.emplace_back(iter->GetInt());
+            }
+        }
+    }
+    return result;
 }
 
+/**
+ Options file, all keys are optional except models:
+ {
+     "models": "models_folder" or ["a.mnn", "b.mnn"],
+     "loop": 10, "warmup": 10, "forward": 0, "threads": 4 or [1, 4], "precision": 2,
+     "shapes": {"a.mnn": {"input_name": [1, 3, 224, 224]}},
+     "cpus": [4, 5, 6, 7], "perOp": false,
+     "output": "result.json", "format": "json" or "csv",
+     "baseline": "baseline.json", "compareMetric": "p50", "threshold": 0.05
+ }
+ */
+static bool loadOptions(const char* fileName, BenchOptions& options) {
+    std::string content;
+    if (!readFile(fileName, content)) {
+        std::cout << "open " << fileName << " failed" << std::endl;
+        return false;
+    }
+    rapidjson::Document document;
+    document.Parse(content.c_str());
+    if (document.HasParseError() || !document.IsObject()) {
+        std::cout << "Invalid json: " << fileName << std::endl;
+        return false;
+    }
+    if (document.HasMember("models")) {
+        auto& models = document["models"];
+        if (models.IsString()) {
+            options.models = findModelFiles(models.GetString());
+        } else if (models.IsArray()) {
+            for (auto iter = models.Begin(); iter != models.End(); iter++) {
+                if (!iter->IsString()) {
+                    continue;
+                }
+                Model m;
+                m.model_file = iter->GetString();
+                auto pos     = m.model_file.find_last_of("/\\");
+                m.name       = pos == std::string::npos ? m.model_file : m.model_file.substr(pos + 1);
+                options.models.emplace_back(std::move(m));
+            }
+        }
+    }
+    if (options.models.empty()) {
+        std::cout << "No model in " << fileName << std::endl;
+        return false;
+    }
+    if (document.HasMember("loop") && document["loop"].IsInt()) {
+        options.loop = document["loop"].GetInt();
+    }
+    if (document.HasMember("warmup") && document["warmup"].IsInt()) {
+        options.warmup = document["warmup"].GetInt();
+    }
+    if (document.HasMember("forward") && document["forward"].IsInt()) {
+        options.forward = static_cast<MNNForwardType>(document["forward"].GetInt());
+    }
+    if (document.HasMember("threads")) {
+        auto threads = readInts(document["threads"]);
+        if (!threads.empty()) {
+            options.threads = threads;
+        }
+    }
+    if (document.HasMember("precision") && document["precision"].IsInt()) {
+        options.precision = document["precision"].GetInt();
+    }
+    if (document.HasMember("shapes") && document["shapes"].IsObject()) {
+        for (auto& model : document["shapes"].GetObject()) {
+            if (!model.value.IsObject()) {
+                continue;
+            }
+            auto& shapes = options.shapes[model.name.GetString()];
+            for (auto& input : model.value.GetObject()) {
+                shapes[input.name.GetString()] = readInts(input.value);
+            }
+        }
+    }
+    if (document.HasMember("cpus")) {
+        options.cpus = readInts(document["cpus"]);
+    }
+    if (document.HasMember("perOp") && document["perOp"].IsBool()) {
+        options.perOp = document["perOp"].GetBool();
+    }
+    if (document.HasMember("output") && document["output"].IsString()) {
+        options.output = document["output"].GetString();
+        auto size      = options.output.size();
+        if (size > 4 && options.output.substr(size - 4) == ".csv") {
+            options.format = "csv";
+        }
+    }
+    if (document.HasMember("format") && document["format"].IsString()) {
+        options.format = document["format"].GetString();
+    }
+    if (document.HasMember("baseline") && document["baseline"].IsString()) {
+        options.baseline = document["baseline"].GetString();
+    }
+    if (document.HasMember("compareMetric") && document["compareMetric"].IsString()) {
+        options.compareMetric = document["compareMetric"].GetString();
+    }
+    if (document.HasMember("threshold") && document["threshold"].IsNumber()) {
+        options.threshold = document["threshold"].GetFloat();
+    }
+    return true;
+}
 
+// Compare with the json result of a former run, return the number of regressions or -1 for invalid baseline
+static int compareBaseline(const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::string content;
+    if (!readFile(options.baseline, content)) {
+        std::cout << "open baseline " << options.baseline << " failed" << std::endl;
+        return -1;
+    }
+    rapidjson::Document document;
+    document.Parse(content.c_str());
+    if (document.HasParseError() || !document.IsObject() || !document.HasMember("results") ||
+        !document["results"].IsArray()) {
+        std::cout << "Invalid baseline: " << options.baseline << std::endl;
+        return -1;
+    }
+    const char* metric = options.compareMetric.c_str();
+    std::map<std::pair<std::string, int>, float> baseValues;
+    for (auto& item : document["results"].GetArray()) {
+        if (item.HasMember("model") && item.HasMember("threads") && item.HasMember(metric) && item[metric].IsNumber()) {
+            baseValues[std::make_pair(std::string(item["model"].GetString()), item["threads"].GetInt())] =
+                item[metric].GetFloat();
+        }
+    }
+    // The current values from the same json as the output
+    rapidjson::Document current;
+    current.Parse(resultToJson(options, results).c_str());
+    int regressions = 0;
+    std::cout << "--------> Compare " << metric << " with " << options.baseline << ", threshold = "
+              << options.threshold * 100.0f << "%" << std::endl;
+    for (auto& item : current["results"].GetArray()) {
+        std::string name = item["model"].GetString();
+        int threads      = item["threads"].GetInt();
+        auto iter        = baseValues.find(std::make_pair(name, threads));
+        if (iter == baseValues.end() || !item.HasMember(metric)) {
+            printf("[ ? ] %-24s    threads = %d  not in baseline\n", name.c_str(), threads);
+            continue;
+        }
+        float value  = item[metric].GetFloat();
+        float base   = iter->second;
+        float change = base > 0.0f ? (value - base) / base : 0.0f;
+        bool regress = change > options.threshold;
+        regressions += regress ? 1 : 0;
+        printf("[%s] %-24s    threads = %d  %s = %8.3f  baseline = %8.3f  change = %+6.2f %%\n",
+               regress ? " X " : " - ", name.c_str(), threads, metric, value, base, change * 100.0f);
+    }
+    return regressions;
+}
 
 #ifdef __ANDROID__
 #include <errno.h>
@@ -351,40 +865,67 @@ void set_cpu_affinity()
 
 int main(int argc, const char* argv[]) {
     std::cout << "MNN benchmark" << std::endl;
-    int loop               = 10;
-    int warmup             = 10;
-    MNNForwardType forward = MNN_FORWARD_CPU;
-    int numberThread       = 4;
-    if (argc <= 2) {
-        std::cout << "Usage: " << argv[0] << " models_folder [loop_count] [warmup] [forwardtype] [numberThread] [precision]" << std::endl;
-        return 1;
-    }
-    if (argc >= 3) {
-        loop = atoi(argv[2]);
-    }
-    if (argc >= 4) {
-        warmup = atoi(argv[3]);
-    }
-    if (argc >= 5) {
-        forward = static_cast<MNNForwardType>(atoi(argv[4]));
-    }
-    if (argc >= 6) {
-        numberThread = atoi(argv[5]);
+    BenchOptions options;
+    if (argc >= 3 && (strcmp(argv[1], "-c") == 0 || strcmp(argv[1], "--config") == 0)) {
+        if (!loadOptions(argv[2], options)) {
+            return 1;
+        }
+    } else {
+        if (argc <= 2) {
+            std::cout << "Usage: " << argv[0] << " models_folder [loop_count] [warmup] [forwardtype] [numberThread] [precision]" << std::endl;
+            std::cout << "       " << argv[0] << " -c options.json" << std::endl;
+            return 1;
+        }
+        if (argc >= 3) {
+            options.loop = atoi(argv[2]);
+        }
+        if (argc >= 4) {
+            options.warmup = atoi(argv[3]);
+        }
+        if (argc >= 5) {
+            options.forward = static_cast<MNNForwardType>(atoi(argv[4]));
+        }
+        if (argc >= 6) {
+            options.threads = {atoi(argv[5])};
+        }
+        if (argc >= 7) {
+            options.precision = atoi(argv[6]);
+        }
+        options.models = findModelFiles(argv[1]);
     }
-    int precision = 2;
-    if (argc >= 7) {
-        precision = atoi(argv[6]);
+    std::cout << "Forward type: **" << forwardType(options.forward) << "** thread=";
+    for (auto t : options.threads) {
+        std::cout << t << " ";
     }
-    std::cout << "Forward type: **" << forwardType(forward) << "** thread=" << numberThread << "** precision=" <<precision << std::endl;
-    std::vector<Model> models = findModelFiles(argv[1]);
+    std::cout << "** precision=" << options.precision << std::endl;
 
-    std::cout << "--------> Benchmarking... loop = " << argv[2] << ", warmup = " << warmup << std::endl;
+    std::cout << "--------> Benchmarking... loop = " << options.loop << ", warmup = " << options.warmup << std::endl;
 
-    /* not called yet */
-    // set_cpu_affinity();
+    if (!options.cpus.empty() && !setCpuAffinity(options.cpus)) {
+        std::cout << "Set cpu affinity failed" << std::endl;
+    }
 
-    for (auto& m : models) {
-        std::vector<float> costs = doBench(m, loop, warmup, forward, false, numberThread, precision);
-        displayStats(m.name, costs);
+    std::vector<BenchResult> results;
+    for (auto numberThread : options.threads) {
+        for (auto& m : options.models) {
+            results.emplace_back(doBench(m, options, numberThread));
+            displayResult(results.back());
+        }
     }
+    if (!options.output.empty()) {
+        std::ofstream output(options.output.c_str());
+        if (output.fail()) {
+            std::cout << "open " << options.output << " failed" << std::endl;
+            return 1;
+        }
+        output << (options.format == "csv" ? resultToCsv(results) : resultToJson(options, results));
+    }
+    if (!options.baseline.empty()) {
+        auto regressions = compareBaseline(options, results);
+        if (regressions != 0) {
+            std::cout << "Regression found: " << regressions << std::endl;
+            return 2;
+        }
+    }
+    return 0;
 }
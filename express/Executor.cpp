@@ -276,7 +276,7 @@ void Executor::ComputeCache::setContentDirty() {
     mContentDirty = true;
 }
 
-Executor::ComputeCache::ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend) : mContext(backupBackend) {
+Executor::ComputeCache::ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend) : mContext(backupBackend, true, backend->type()) {
     mBackend = backend;
     mBackupBackend = backupBackend;
 }
@@ -131,7 +131,7 @@ static VARP _EltwiseInt8(VARP x, VARP y, EltwiseType type,
     param_x->weight = x_weight;
     param_x->bias = x_bias;
     param_x->scale = x_scale;
-    param_x->tensorScale = y_tensorScale;
+    param_x->tensorScale = x_tensorScale;
     param_y->weight = y_weight;
     param_y->bias = y_bias;
     param_y->scale = y_scale;
@@ -1784,6 +1784,28 @@ std::vector<VARP> _TopKV2(VARP input0, VARP input1) {
     return res;
 }
 
+/*Fused attention: softmax(query * key^T * scale) * value, the scores are not materialized.
+Args:
+query: A variable of [..., seqQ, dim], must be Halide_Type_Float.
+key: A variable of [..., seqK, dim], the leading dimensions are the same as query.
+value: A variable of [..., seqK, dimV], the leading dimensions are the same as query.
+scale: The factor of the scores, usually 1 / sqrt(dim).
+kvcache: Keep key and value in the execution and append the new ones on each forward, so a decoder only feeds the
+ key and value of new tokens. The mask is causal: query i is the token after the former ones plus i and only attends to
+ the keys up to it, so a prompt can be fed at once. The state lives in the Module which runs the op,
+ Module::clearCache drops it.
+Returns:
+A variable of [..., seqQ, dimV].
+*/
+VARP _Attention(VARP query, VARP key, VARP value, float scale, bool kvcache) {
+    std::unique_ptr<OpT> op(new OpT);
+    op->type       = OpType_Attention;
+    op->main.type  = OpParameter_AttentionParam;
+    op->main.value = new AttentionParamT;
+    op->main.AsAttentionParam()->scale   = scale;
+    op->main.AsAttentionParam()->kvcache = kvcache;
+    return (Variable::create(Expr::create(std::move(op), {query, key, value})));
+}
 
 } // namespace Express
 } // namespace MNN
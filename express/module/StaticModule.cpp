@@ -13,12 +13,17 @@
 #include <MNN/expr/ExprCreator.hpp>
 #include "Utils.hpp"
 #include "core/MNNMemoryUtils.h"
+#include "core/ModelRegistry.hpp"
 #include "core/Session.hpp"
 #include "core/TensorUtils.hpp"
 
 namespace MNN {
 namespace Express {
 
+StaticModule::Resource::~Resource() {
+    ModelRegistry::remove(mNetId);
+}
+
 static std::shared_ptr<BufferStorage> preRearrangeWeights( // NOLINT
     const MNN::Net* net, std::map<const Op*, std::shared_ptr<Execution>>& cache, Backend* backend) {
     std::unique_ptr<MNN::NetT> net_table(net->UnPack());
@@ -146,6 +151,7 @@ StaticModule::StaticModule(const void* buffer, size_t length, const std::vector<
         buffer = net_storage->storage.get();
     }
     mResource->mNetStorage    = std::move(net_storage);
+    mResource->mNetId         = ModelRegistry::add(buffer, length);
     mResource->mShapeFix      = !moduleconfig.shapeMutable;
     mResource->mOutputNumbers = (int)outputs.size();
     /** Compute:
@@ -340,6 +346,16 @@ std::vector<Express::VARP> StaticModule::onForward(const std::vector<Express::VA
     return outputs;
 }
 
+void StaticModule::onClearCache() {
+    if (nullptr == mSession) {
+        return;
+    }
+    // Such as the key / value cache of attention, the next forward starts a new sequence
+    for (auto& iter : mSession->getExecution(0)) {
+        iter.second->onReset();
+    }
+}
+
 void StaticModule::setReusedTensors(std::set<int> reused) {
     mResource->mReusedTensors = std::move(reused);
 }
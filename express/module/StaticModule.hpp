@@ -29,6 +29,7 @@ private:
     StaticModule() = default;
 
     Module* clone(CloneContext* ctx) const override;
+    virtual void onClearCache() override;
     void resizeTensor(Tensor* tensor, const std::vector<int>& dims);
 
     struct Resource {
@@ -44,8 +45,11 @@ private:
         std::set<int> mReusedTensors;
         std::set<int> mUseContentInputs;
         std::shared_ptr<BufferStorage> mNetStorage;
+        // Id of mNetStorage in ModelRegistry
+        int64_t mNetId = -1;
         bool mCopyOutput = false;
         ScheduleConfig mConfig;
+        ~Resource();
     };
     std::shared_ptr<Session> mSession;
     std::vector<Tensor*> mInputTensors;
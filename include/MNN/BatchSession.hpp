@@ -0,0 +1,93 @@
+//
+//  BatchSession.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/26.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef BatchSession_hpp
+#define BatchSession_hpp
+
+#include <map>
+#include <memory>
+#include <string>
+#include <MNN/Interpreter.hpp>
+
+namespace MNN {
+
+/** config of dynamic batching */
+struct BatchConfig {
+    /** max batch of one run, requests are split if their total batch exceed it */
+    int maxBatch = 8;
+    /** time in microseconds a request may wait for others to fill the batch, 0 runs what is queued at once */
+    int timeout = 2000;
+    /** memory in MB to keep the prepared states of former batch sizes, see Interpreter::setSessionShapeCache */
+    float shapeCacheMemory = 64.0f;
+    /** dimension type of the output tensors returned to the requests */
+    Tensor::DimensionType outputDimensionType = Tensor::CAFFE;
+};
+
+/** counters of a BatchSession, time in microseconds */
+struct BatchStatistics {
+    /** requests finished, including failed ones */
+    size_t requests = 0;
+    /** runSession called */
+    size_t runs = 0;
+    /** total batch of all runs */
+    size_t batches = 0;
+    /** runs that need resize for a new batch size */
+    size_t resizes = 0;
+    /** sum of the time from submit to the start of the run of each request */
+    uint64_t waitTime = 0;
+    /** sum of the time of runs, including copy in and out */
+    uint64_t runTime = 0;
+    /** max time from submit to return of one request */
+    uint64_t maxLatency = 0;
+};
+
+/**
+ * queue single requests of a net from many threads, run them in one session with the inputs resized along the
+ * batch (first) dimension and scatter the outputs back. All inputs and outputs of the net must have the batch as
+ * the first dimension, requests with different shapes besides the batch are run in different batches.
+ */
+class MNN_PUBLIC BatchSession {
+public:
+    /**
+     * @brief create a batch session with a new session of the net, a thread is started to run the requests.
+     * @param net       given net, it must be alive while the batch session is used.
+     * @param config    session schedule config.
+     * @param batch     batching config.
+     * @return created batch session if success, NULL otherwise.
+     */
+    static BatchSession* create(Interpreter* net, const ScheduleConfig& config, const BatchConfig& batch);
+    /**
+     * @brief wait for the queued requests and stop the thread.
+     */
+    ~BatchSession();
+
+    /**
+     * @brief run one request, thread safe. It blocks until the batch containing the request finished.
+     * @param inputs    host tensors for each input of the net by name, all inputs must be set. Their batch may be
+     * larger than one but not larger than maxBatch.
+     * @param outputs   host tensors of all outputs of the net by name, with the batch of the inputs.
+     * @return result code.
+     */
+    ErrorCode run(const std::map<std::string, const Tensor*>& inputs,
+                  std::map<std::string, std::shared_ptr<Tensor>>& outputs);
+
+    /**
+     * @brief get the counters since creation.
+     */
+    BatchStatistics getStatistics() const;
+
+    struct Content;
+
+private:
+    BatchSession(Content* content);
+    Content* mContent;
+};
+
+} // namespace MNN
+
+#endif /* BatchSession_hpp */
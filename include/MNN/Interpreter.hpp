@@ -65,6 +65,9 @@ struct ScheduleConfig {
 
     /** extra backend config */
     BackendConfig* backendConfig = nullptr;
+
+    /** CPU only: cpus to bind the threads of the runtime, implies MNN_CPU_OWN_THREAD_POOL if not empty */
+    std::vector<int> cpuIds;
 };
 
 class Session;
@@ -105,6 +108,15 @@ public:
      * @return created net if success, NULL otherwise.
      */
     static Interpreter* createFromFile(const char* file);
+    /**
+     * @brief create net from file by memory mapping it read-only, so processes loading the same model share its
+     * pages and constant tensors are used from the mapping directly. The file must not be modified or replaced in
+     * place while the net is alive, or the process may crash by SIGBUS. Falls back to createFromFile if mapping is
+     * not supported.
+     * @param file  given file.
+     * @return created net if success, NULL otherwise.
+     */
+    static Interpreter* createFromMappedFile(const char* file);
     /**
      * @brief create net from buffer.
      * @param buffer    given data buffer.
@@ -126,6 +138,12 @@ public:
         Session_Input_Inside = 2,
         /** The input tensor is alloced by user, set input data before session resize*/
         Session_Input_User = 3,
+
+        /** About trace, Default Session_Trace_Off*/
+        /** No timeline is recorded for the session*/
+        Session_Trace_Off = 4,
+        /** Ops, thread pool tasks and resize phases are recorded while the session resizes or runs, see dumpTrace*/
+        Session_Trace_On = 5,
     };
     /**
      * @brief The API shoud be called before create session.
@@ -142,6 +160,16 @@ public:
      */
     void setCacheFile(const char* cacheFile, size_t keySize = 128);
 
+    /**
+     * @brief write the recorded timeline as Chrome Trace Event JSON, open it by chrome://tracing or Perfetto.
+     * The timeline is recorded for sessions created with Session_Trace_On, or for all sessions if the env
+     * MNN_TRACE_FILE is set, in which case it is also written to the file at exit. Call it when no traced session is
+     * running.
+     * @param file      trace file name
+     * @return true if the file is written.
+     */
+    static bool dumpTrace(const char* file);
+
 public:
     /**
      * @brief create runtimeInfo seperately with schedule config.
@@ -178,6 +206,17 @@ public:
      */
     Session* createMultiPathSession(const std::vector<ScheduleConfig>& configs, const RuntimeInfo& runtime);
 
+    /**
+     * @brief create a session to run concurrently with the given one in another thread. The created session shares
+     *        the executions' weights of the given session (see Execution::onClone) and owns only its tensors and
+     *        activation memory. It uses new runtimes of the same configs, so the thread pool task and the allocators
+     *        are not shared. The input shapes of the given session are kept, resize it as usual to change them.
+     * @param session   given session, resize it before cloning to share its executions. It may be released before the
+     *                  created session.
+     * @return created session if success, NULL otherwise. It is managed in net like other sessions.
+     */
+    Session* cloneSession(const Session* session);
+
     /**
      * @brief release session.
      * @param session   given session.
@@ -192,9 +231,18 @@ public:
      */
     void resizeSession(Session* session);
 
+    /**
+     * @brief keep the prepared states of the session for former input shapes. resizeSession back to the shapes of
+     * a kept state only swaps it in, without shape compute, geometry transform and memory alloc. The least recently
+     * used states are released when their memory exceeds the limit. Only the states prepared after the call are kept.
+     * @param session       given session.
+     * @param memoryLimit   memory in MB the kept states may use besides the current one, 0 (default) disables it.
+     */
+    void setSessionShapeCache(Session* session, float memoryLimit);
+
     /**
      * @brief call this function if don't need resize or create session any more, it will save a few memory that equal
-     * to the size of model buffer
+     * to the size of model buffer. A memory mapped model is kept, its clean pages can be reclaimed by the system.
      */
     void releaseModel();
 
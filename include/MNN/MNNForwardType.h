@@ -65,6 +65,31 @@ typedef enum {
     MNN_GPU_MEMORY_IMAGE  = 1 << 7,/* User assign mode */
 } MNNGpuMode;
 
+typedef enum {
+    /* Check nan of every op's outputs, for debug */
+    MNN_CPU_CHECK_NAN          = 1 << 0,
+    /* Schedule multi-thread tasks by work-stealing, idle workers sleep instead of spinning */
+    MNN_CPU_WORK_STEALING      = 1 << 1,
+    /* Bind workers to distinct physical cores of the local NUMA node and allocate memory on that node */
+    MNN_CPU_BIND_CORE          = 1 << 2,
+    /* The runtime owns a thread pool of numThread threads instead of sharing the process-wide one.
+       Sessions created with the same RuntimeInfo share the runtime and so its pool */
+    MNN_CPU_OWN_THREAD_POOL    = 1 << 3,
+    /* Measure candidate algorithms of convolution for each shape instead of using heuristics,
+       results are persisted through Interpreter::setCacheFile */
+    MNN_CPU_TUNING             = 1 << 4,
+    /* Plan the memory of resize with size classes in O(1) per tensor instead of best-fit free lists,
+       faster for services resizing per request but may use more memory */
+    MNN_CPU_SIZE_CLASS_MEMORY  = 1 << 5,
+    /* Plan the memory of resize offline: record the lifetime of every tensor and scratch buffer, place them in one
+       arena by best fit and resize again with the plan. Lower peak memory for twice the resize time,
+       ignored with MNN_CPU_SIZE_CLASS_MEMORY */
+    MNN_CPU_STATIC_MEMORY_PLAN = 1 << 6,
+    /* Pack NC4HW4 tensors by the vector width of the cpu: 8 channels on AVX2, 16 on AVX-512. Read and write such
+       tensors of the session by Tensor::copyToHostTensor / copyFromHostTensor, ignored if not supported */
+    MNN_CPU_WIDE_PACK          = 1 << 7,
+} MNNCPUFlags;
+
 #ifdef __cplusplus
 namespace MNN {
 struct BackendConfig {
@@ -83,7 +108,7 @@ struct BackendConfig {
     /** user defined context */
     union {
         void* sharedContext = nullptr;
-        size_t flags; // Valid for CPU Backend
+        size_t flags; // Valid for CPU Backend, see MNNCPUFlags
     };
 };
 }; // namespace MNN
@@ -28,6 +28,7 @@ public:
     bool loadParameters(const std::vector<Express::VARP>& parameters);
     void setIsTraining(const bool isTraining);
     bool getIsTraining();
+    // Drop the state kept across forwards, such as the key / value cache of _Attention with kvcache
     void clearCache();
 
     const std::string& name() const {
@@ -152,6 +152,7 @@ MNN_PUBLIC VARP _Int8ToFloat(VARP x, VARP scale, int8_t zeroPoint);
 
 MNN_PUBLIC VARP _Select(VARP select, VARP input0, VARP input1);
 MNN_PUBLIC std::vector<VARP> _TopKV2(VARP input0, VARP input1);
+MNN_PUBLIC VARP _Attention(VARP query, VARP key, VARP value, float scale, bool kvcache = false);
 
 } // namespace Express
 } // namespace MNN
@@ -22,6 +22,9 @@ struct IDSTQuanT;
 struct QuantizedFloatParam;
 struct QuantizedFloatParamT;
 
+struct PackedWeight;
+struct PackedWeightT;
+
 struct Convolution2D;
 struct Convolution2DT;
 
@@ -117,6 +120,8 @@ inline const flatbuffers::TypeTable *IDSTQuanTypeTable();
 
 inline const flatbuffers::TypeTable *QuantizedFloatParamTypeTable();
 
+inline const flatbuffers::TypeTable *PackedWeightTypeTable();
+
 inline const flatbuffers::TypeTable *Convolution2DTypeTable();
 
 inline const flatbuffers::TypeTable *Convolution3DTypeTable();
@@ -1292,6 +1297,115 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParamDirect(
 
 flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(flatbuffers::FlatBufferBuilder &_fbb, const QuantizedFloatParamT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
+struct PackedWeightT : public flatbuffers::NativeTable {
+  typedef PackedWeight TableType;
+  std::string target;
+  int32_t lP;
+  int32_t hP;
+  std::vector<float> weight;
+  PackedWeightT()
+      : lP(0),
+        hP(0) {
+  }
+};
+
+struct PackedWeight FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PackedWeightT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return PackedWeightTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TARGET = 4,
+    VT_LP = 6,
+    VT_HP = 8,
+    VT_WEIGHT = 10
+  };
+  const flatbuffers::String *target() const {
+    return GetPointer<const flatbuffers::String *>(VT_TARGET);
+  }
+  int32_t lP() const {
+    return GetField<int32_t>(VT_LP, 0);
+  }
+  int32_t hP() const {
+    return GetField<int32_t>(VT_HP, 0);
+  }
+  const flatbuffers::Vector<float> *weight() const {
+    return GetPointer<const flatbuffers::Vector<float> *>(VT_WEIGHT);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_TARGET) &&
+           verifier.VerifyString(target()) &&
+           VerifyField<int32_t>(verifier, VT_LP) &&
+           VerifyField<int32_t>(verifier, VT_HP) &&
+           VerifyOffset(verifier, VT_WEIGHT) &&
+           verifier.VerifyVector(weight()) &&
+           verifier.EndTable();
+  }
+  PackedWeightT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(PackedWeightT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<PackedWeight> Pack(flatbuffers::FlatBufferBuilder &_fbb, const PackedWeightT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct PackedWeightBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_target(flatbuffers::Offset<flatbuffers::String> target) {
+    fbb_.AddOffset(PackedWeight::VT_TARGET, target);
+  }
+  void add_lP(int32_t lP) {
+    fbb_.AddElement<int32_t>(PackedWeight::VT_LP, lP, 0);
+  }
+  void add_hP(int32_t hP) {
+    fbb_.AddElement<int32_t>(PackedWeight::VT_HP, hP, 0);
+  }
+  void add_weight(flatbuffers::Offset<flatbuffers::Vector<float>> weight) {
+    fbb_.AddOffset(PackedWeight::VT_WEIGHT, weight);
+  }
+  explicit PackedWeightBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PackedWeightBuilder &operator=(const PackedWeightBuilder &);
+  flatbuffers::Offset<PackedWeight> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PackedWeight>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PackedWeight> CreatePackedWeight(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> target = 0,
+    int32_t lP = 0,
+    int32_t hP = 0,
+    flatbuffers::Offset<flatbuffers::Vector<float>> weight = 0) {
+  PackedWeightBuilder builder_(_fbb);
+  builder_.add_weight(weight);
+  builder_.add_hP(hP);
+  builder_.add_lP(lP);
+  builder_.add_target(target);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PackedWeight> CreatePackedWeightDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *target = nullptr,
+    int32_t lP = 0,
+    int32_t hP = 0,
+    const std::vector<float> *weight = nullptr) {
+  auto target__ = target ? _fbb.CreateString(target) : 0;
+  auto weight__ = weight ? _fbb.CreateVector<float>(*weight) : 0;
+  return MNN::CreatePackedWeight(
+      _fbb,
+      target__,
+      lP,
+      hP,
+      weight__);
+}
+
+flatbuffers::Offset<PackedWeight> CreatePackedWeight(flatbuffers::FlatBufferBuilder &_fbb, const PackedWeightT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
 struct Convolution2DT : public flatbuffers::NativeTable {
   typedef Convolution2D TableType;
   std::unique_ptr<Convolution2DCommonT> common;
@@ -1299,6 +1413,7 @@ struct Convolution2DT : public flatbuffers::NativeTable {
   std::vector<float> bias;
   std::unique_ptr<IDSTQuanT> quanParameter;
   std::unique_ptr<QuantizedFloatParamT> symmetricQuan;
+  std::unique_ptr<PackedWeightT> packedWeight;
   Convolution2DT() {
   }
 };
@@ -1313,7 +1428,8 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_WEIGHT = 6,
     VT_BIAS = 8,
     VT_QUANPARAMETER = 10,
-    VT_SYMMETRICQUAN = 12
+    VT_SYMMETRICQUAN = 12,
+    VT_PACKEDWEIGHT = 14
   };
   const Convolution2DCommon *common() const {
     return GetPointer<const Convolution2DCommon *>(VT_COMMON);
@@ -1330,6 +1446,9 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const QuantizedFloatParam *symmetricQuan() const {
     return GetPointer<const QuantizedFloatParam *>(VT_SYMMETRICQUAN);
   }
+  const PackedWeight *packedWeight() const {
+    return GetPointer<const PackedWeight *>(VT_PACKEDWEIGHT);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_COMMON) &&
@@ -1342,6 +1461,8 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(quanParameter()) &&
            VerifyOffset(verifier, VT_SYMMETRICQUAN) &&
            verifier.VerifyTable(symmetricQuan()) &&
+           VerifyOffset(verifier, VT_PACKEDWEIGHT) &&
+           verifier.VerifyTable(packedWeight()) &&
            verifier.EndTable();
   }
   Convolution2DT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1367,6 +1488,9 @@ struct Convolution2DBuilder {
   void add_symmetricQuan(flatbuffers::Offset<QuantizedFloatParam> symmetricQuan) {
     fbb_.AddOffset(Convolution2D::VT_SYMMETRICQUAN, symmetricQuan);
   }
+  void add_packedWeight(flatbuffers::Offset<PackedWeight> packedWeight) {
+    fbb_.AddOffset(Convolution2D::VT_PACKEDWEIGHT, packedWeight);
+  }
   explicit Convolution2DBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1385,8 +1509,10 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2D(
     flatbuffers::Offset<flatbuffers::Vector<float>> weight = 0,
     flatbuffers::Offset<flatbuffers::Vector<float>> bias = 0,
     flatbuffers::Offset<IDSTQuan> quanParameter = 0,
-    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0) {
+    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0,
+    flatbuffers::Offset<PackedWeight> packedWeight = 0) {
   Convolution2DBuilder builder_(_fbb);
+  builder_.add_packedWeight(packedWeight);
   builder_.add_symmetricQuan(symmetricQuan);
   builder_.add_quanParameter(quanParameter);
   builder_.add_bias(bias);
@@ -1401,7 +1527,8 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2DDirect(
     const std::vector<float> *weight = nullptr,
     const std::vector<float> *bias = nullptr,
     flatbuffers::Offset<IDSTQuan> quanParameter = 0,
-    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0) {
+    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0,
+    flatbuffers::Offset<PackedWeight> packedWeight = 0) {
   auto weight__ = weight ? _fbb.CreateVector<float>(*weight) : 0;
   auto bias__ = bias ? _fbb.CreateVector<float>(*bias) : 0;
   return MNN::CreateConvolution2D(
@@ -1410,7 +1537,8 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2DDirect(
       weight__,
       bias__,
       quanParameter,
-      symmetricQuan);
+      symmetricQuan,
+      packedWeight);
 }
 
 flatbuffers::Offset<Convolution2D> CreateConvolution2D(flatbuffers::FlatBufferBuilder &_fbb, const Convolution2DT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -4741,6 +4869,41 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(flatbu
       _clampMax);
 }
 
+inline PackedWeightT *PackedWeight::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new PackedWeightT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void PackedWeight::UnPackTo(PackedWeightT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = target(); if (_e) _o->target = _e->str(); };
+  { auto _e = lP(); _o->lP = _e; };
+  { auto _e = hP(); _o->hP = _e; };
+  { auto _e = weight(); if (_e) { _o->weight.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->weight[_i] = _e->Get(_i); } } };
+}
+
+inline flatbuffers::Offset<PackedWeight> PackedWeight::Pack(flatbuffers::FlatBufferBuilder &_fbb, const PackedWeightT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreatePackedWeight(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<PackedWeight> CreatePackedWeight(flatbuffers::FlatBufferBuilder &_fbb, const PackedWeightT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const PackedWeightT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _target = _o->target.empty() ? 0 : _fbb.CreateString(_o->target);
+  auto _lP = _o->lP;
+  auto _hP = _o->hP;
+  auto _weight = _o->weight.size() ? _fbb.CreateVector(_o->weight) : 0;
+  return MNN::CreatePackedWeight(
+      _fbb,
+      _target,
+      _lP,
+      _hP,
+      _weight);
+}
+
 inline Convolution2DT *Convolution2D::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new Convolution2DT();
   UnPackTo(_o, _resolver);
@@ -4755,6 +4918,7 @@ inline void Convolution2D::UnPackTo(Convolution2DT *_o, const flatbuffers::resol
   { auto _e = bias(); if (_e) { _o->bias.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->bias[_i] = _e->Get(_i); } } };
   { auto _e = quanParameter(); if (_e) _o->quanParameter = std::unique_ptr<IDSTQuanT>(_e->UnPack(_resolver)); };
   { auto _e = symmetricQuan(); if (_e) _o->symmetricQuan = std::unique_ptr<QuantizedFloatParamT>(_e->UnPack(_resolver)); };
+  { auto _e = packedWeight(); if (_e) _o->packedWeight = std::unique_ptr<PackedWeightT>(_e->UnPack(_resolver)); };
 }
 
 inline flatbuffers::Offset<Convolution2D> Convolution2D::Pack(flatbuffers::FlatBufferBuilder &_fbb, const Convolution2DT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -4770,13 +4934,15 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2D(flatbuffers::FlatB
   auto _bias = _o->bias.size() ? _fbb.CreateVector(_o->bias) : 0;
   auto _quanParameter = _o->quanParameter ? CreateIDSTQuan(_fbb, _o->quanParameter.get(), _rehasher) : 0;
   auto _symmetricQuan = _o->symmetricQuan ? CreateQuantizedFloatParam(_fbb, _o->symmetricQuan.get(), _rehasher) : 0;
+  auto _packedWeight = _o->packedWeight ? CreatePackedWeight(_fbb, _o->packedWeight.get(), _rehasher) : 0;
   return MNN::CreateConvolution2D(
       _fbb,
       _common,
       _weight,
       _bias,
       _quanParameter,
-      _symmetricQuan);
+      _symmetricQuan,
+      _packedWeight);
 }
 
 inline Convolution3DT *Convolution3D::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -6114,28 +6280,50 @@ inline const flatbuffers::TypeTable *QuantizedFloatParamTypeTable() {
   return &tt;
 }
 
+inline const flatbuffers::TypeTable *PackedWeightTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_INT, 0, -1 },
+    { flatbuffers::ET_INT, 0, -1 },
+    { flatbuffers::ET_FLOAT, 1, -1 }
+  };
+  static const char * const names[] = {
+    "target",
+    "lP",
+    "hP",
+    "weight"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 4, type_codes, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
 inline const flatbuffers::TypeTable *Convolution2DTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
     { flatbuffers::ET_SEQUENCE, 0, 0 },
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_SEQUENCE, 0, 1 },
-    { flatbuffers::ET_SEQUENCE, 0, 2 }
+    { flatbuffers::ET_SEQUENCE, 0, 2 },
+    { flatbuffers::ET_SEQUENCE, 0, 3 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     Convolution2DCommonTypeTable,
     IDSTQuanTypeTable,
-    QuantizedFloatParamTypeTable
+    QuantizedFloatParamTypeTable,
+    PackedWeightTypeTable
   };
   static const char * const names[] = {
     "common",
     "weight",
     "bias",
     "quanParameter",
-    "symmetricQuan"
+    "symmetricQuan",
+    "packedWeight"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 5, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 6, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }
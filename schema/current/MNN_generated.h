@@ -226,6 +226,7 @@ enum OpType {
   OpType_TrainableParam = 266,
   OpType_BatchNorm = 267,
   OpType_ZeroGrad = 268,
+  OpType_Attention = 299,
   OpType_Extra = 512,
   OpType_ConvInt8 = 513,
   OpType_Int8ToFloat = 514,
@@ -241,7 +242,7 @@ enum OpType {
   OpType_MAX = OpType_GridSample
 };
 
-inline const OpType (&EnumValuesOpType())[161] {
+inline const OpType (&EnumValuesOpType())[162] {
   static const OpType values[] = {
     OpType_AbsVal,
     OpType_QuantizedAdd,
@@ -393,6 +394,7 @@ inline const OpType (&EnumValuesOpType())[161] {
     OpType_TrainableParam,
     OpType_BatchNorm,
     OpType_ZeroGrad,
+    OpType_Attention,
     OpType_Extra,
     OpType_ConvInt8,
     OpType_Int8ToFloat,
@@ -709,7 +711,7 @@ inline const char * const *EnumNamesOpType() {
     "",
     "",
     "",
-    "",
+    "Attention",
     "",
     "",
     "",
@@ -1119,11 +1121,12 @@ enum OpParameter {
   OpParameter_TensorArray = 89,
   OpParameter_LSTMBlockCell = 90,
   OpParameter_GridSample = 91,
+  OpParameter_AttentionParam = 92,
   OpParameter_MIN = OpParameter_NONE,
-  OpParameter_MAX = OpParameter_GridSample
+  OpParameter_MAX = OpParameter_AttentionParam
 };
 
-inline const OpParameter (&EnumValuesOpParameter())[92] {
+inline const OpParameter (&EnumValuesOpParameter())[93] {
   static const OpParameter values[] = {
     OpParameter_NONE,
     OpParameter_QuantizedAdd,
@@ -1216,7 +1219,8 @@ inline const OpParameter (&EnumValuesOpParameter())[92] {
     OpParameter_LayerNorm,
     OpParameter_TensorArray,
     OpParameter_LSTMBlockCell,
-    OpParameter_GridSample
+    OpParameter_GridSample,
+    OpParameter_AttentionParam
   };
   return values;
 }
@@ -1315,13 +1319,14 @@ inline const char * const *EnumNamesOpParameter() {
     "TensorArray",
     "LSTMBlockCell",
     "GridSample",
+    "AttentionParam",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameOpParameter(OpParameter e) {
-  if (e < OpParameter_NONE || e > OpParameter_GridSample) return "";
+  if (e < OpParameter_NONE || e > OpParameter_AttentionParam) return "";
   const size_t index = static_cast<int>(e);
   return EnumNamesOpParameter()[index];
 }
@@ -1694,6 +1699,10 @@ template<> struct OpParameterTraits<GridSample> {
   static const OpParameter enum_value = OpParameter_GridSample;
 };
 
+template<> struct OpParameterTraits<AttentionParam> {
+  static const OpParameter enum_value = OpParameter_AttentionParam;
+};
+
 struct OpParameterUnion {
   OpParameter type;
   void *value;
@@ -2453,6 +2462,14 @@ struct OpParameterUnion {
     return type == OpParameter_GridSample ?
       reinterpret_cast<const GridSampleT *>(value) : nullptr;
   }
+  AttentionParamT *AsAttentionParam() {
+    return type == OpParameter_AttentionParam ?
+      reinterpret_cast<AttentionParamT *>(value) : nullptr;
+  }
+  const AttentionParamT *AsAttentionParam() const {
+    return type == OpParameter_AttentionParam ?
+      reinterpret_cast<const AttentionParamT *>(value) : nullptr;
+  }
 };
 
 bool VerifyOpParameter(flatbuffers::Verifier &verifier, const void *obj, OpParameter type);
@@ -3344,6 +3361,9 @@ struct Op FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const GridSample *main_as_GridSample() const {
     return main_type() == OpParameter_GridSample ? static_cast<const GridSample *>(main()) : nullptr;
   }
+  const AttentionParam *main_as_AttentionParam() const {
+    return main_type() == OpParameter_AttentionParam ? static_cast<const AttentionParam *>(main()) : nullptr;
+  }
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
   }
@@ -3740,6 +3760,10 @@ template<> inline const GridSample *Op::main_as<GridSample>() const {
   return main_as_GridSample();
 }
 
+template<> inline const AttentionParam *Op::main_as<AttentionParam>() const {
+  return main_as_AttentionParam();
+}
+
 struct OpBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
@@ -5411,6 +5435,10 @@ inline bool VerifyOpParameter(flatbuffers::Verifier &verifier, const void *obj,
       auto ptr = reinterpret_cast<const GridSample *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case OpParameter_AttentionParam: {
+      auto ptr = reinterpret_cast<const AttentionParam *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
@@ -5793,6 +5821,10 @@ inline void *OpParameterUnion::UnPack(const void *obj, OpParameter type, const f
       auto ptr = reinterpret_cast<const GridSample *>(obj);
       return ptr->UnPack(resolver);
     }
+    case OpParameter_AttentionParam: {
+      auto ptr = reinterpret_cast<const AttentionParam *>(obj);
+      return ptr->UnPack(resolver);
+    }
     default: return nullptr;
   }
 }
@@ -6163,6 +6195,10 @@ inline flatbuffers::Offset<void> OpParameterUnion::Pack(flatbuffers::FlatBufferB
       auto ptr = reinterpret_cast<const GridSampleT *>(value);
       return CreateGridSample(_fbb, ptr, _rehasher).Union();
     }
+    case OpParameter_AttentionParam: {
+      auto ptr = reinterpret_cast<const AttentionParamT *>(value);
+      return CreateAttentionParam(_fbb, ptr, _rehasher).Union();
+    }
     default: return 0;
   }
 }
@@ -6533,6 +6569,10 @@ inline OpParameterUnion::OpParameterUnion(const OpParameterUnion &u) FLATBUFFERS
       value = new GridSampleT(*reinterpret_cast<GridSampleT *>(u.value));
       break;
     }
+    case OpParameter_AttentionParam: {
+      value = new AttentionParamT(*reinterpret_cast<AttentionParamT *>(u.value));
+      break;
+    }
     default:
       break;
   }
@@ -6995,6 +7035,11 @@ inline void OpParameterUnion::Reset() {
       delete ptr;
       break;
     }
+    case OpParameter_AttentionParam: {
+      auto ptr = reinterpret_cast<AttentionParamT *>(value);
+      delete ptr;
+      break;
+    }
     default: break;
   }
   value = nullptr;
@@ -7163,12 +7208,13 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 },
+    { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     OpTypeTypeTable
   };
-  static const int64_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 512, 513, 514, 515, 516, 517, 518, 600, 601, 603, 604 };
+  static const int64_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 299, 512, 513, 514, 515, 516, 517, 518, 600, 601, 603, 604 };
   static const char * const names[] = {
     "AbsVal",
     "QuantizedAdd",
@@ -7320,6 +7366,7 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     "TrainableParam",
     "BatchNorm",
     "ZeroGrad",
+    "Attention",
     "Extra",
     "ConvInt8",
     "Int8ToFloat",
@@ -7333,7 +7380,7 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     "GridSample"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_ENUM, 161, type_codes, type_refs, values, names
+    flatbuffers::ST_ENUM, 162, type_codes, type_refs, values, names
   };
   return &tt;
 }
@@ -7431,7 +7478,8 @@ inline const flatbuffers::TypeTable *OpParameterTypeTable() {
     { flatbuffers::ET_SEQUENCE, 0, 87 },
     { flatbuffers::ET_SEQUENCE, 0, 88 },
     { flatbuffers::ET_SEQUENCE, 0, 89 },
-    { flatbuffers::ET_SEQUENCE, 0, 90 }
+    { flatbuffers::ET_SEQUENCE, 0, 90 },
+    { flatbuffers::ET_SEQUENCE, 0, 91 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     QuantizedAddTypeTable,
@@ -7524,7 +7572,8 @@ inline const flatbuffers::TypeTable *OpParameterTypeTable() {
     LayerNormTypeTable,
     TensorArrayTypeTable,
     LSTMBlockCellTypeTable,
-    GridSampleTypeTable
+    GridSampleTypeTable,
+    AttentionParamTypeTable
   };
   static const char * const names[] = {
     "NONE",
@@ -7618,10 +7667,11 @@ inline const flatbuffers::TypeTable *OpParameterTypeTable() {
     "LayerNorm",
     "TensorArray",
     "LSTMBlockCell",
-    "GridSample"
+    "GridSample",
+    "AttentionParam"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_UNION, 92, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_UNION, 93, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }
@@ -16,10 +16,15 @@ struct TensorConvertInfoT;
 struct GridSample;
 struct GridSampleT;
 
+struct AttentionParam;
+struct AttentionParamT;
+
 inline const flatbuffers::TypeTable *TensorConvertInfoTypeTable();
 
 inline const flatbuffers::TypeTable *GridSampleTypeTable();
 
+inline const flatbuffers::TypeTable *AttentionParamTypeTable();
+
 enum SampleMode {
   SampleMode_BILINEAR = 0,
   SampleMode_NEAREST = 1,
@@ -233,6 +238,75 @@ inline flatbuffers::Offset<GridSample> CreateGridSample(
 
 flatbuffers::Offset<GridSample> CreateGridSample(flatbuffers::FlatBufferBuilder &_fbb, const GridSampleT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
+struct AttentionParamT : public flatbuffers::NativeTable {
+  typedef AttentionParam TableType;
+  float scale;
+  bool kvcache;
+  AttentionParamT()
+      : scale(1.0f),
+        kvcache(false) {
+  }
+};
+
+struct AttentionParam FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef AttentionParamT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return AttentionParamTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_SCALE = 4,
+    VT_KVCACHE = 6
+  };
+  float scale() const {
+    return GetField<float>(VT_SCALE, 1.0f);
+  }
+  bool kvcache() const {
+    return GetField<uint8_t>(VT_KVCACHE, 0) != 0;
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<float>(verifier, VT_SCALE) &&
+           VerifyField<uint8_t>(verifier, VT_KVCACHE) &&
+           verifier.EndTable();
+  }
+  AttentionParamT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(AttentionParamT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<AttentionParam> Pack(flatbuffers::FlatBufferBuilder &_fbb, const AttentionParamT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct AttentionParamBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_scale(float scale) {
+    fbb_.AddElement<float>(AttentionParam::VT_SCALE, scale, 1.0f);
+  }
+  void add_kvcache(bool kvcache) {
+    fbb_.AddElement<uint8_t>(AttentionParam::VT_KVCACHE, static_cast<uint8_t>(kvcache), 0);
+  }
+  explicit AttentionParamBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  AttentionParamBuilder &operator=(const AttentionParamBuilder &);
+  flatbuffers::Offset<AttentionParam> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<AttentionParam>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<AttentionParam> CreateAttentionParam(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    float scale = 1.0f,
+    bool kvcache = false) {
+  AttentionParamBuilder builder_(_fbb);
+  builder_.add_scale(scale);
+  builder_.add_kvcache(kvcache);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<AttentionParam> CreateAttentionParam(flatbuffers::FlatBufferBuilder &_fbb, const AttentionParamT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
 inline TensorConvertInfoT *TensorConvertInfo::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new TensorConvertInfoT();
   UnPackTo(_o, _resolver);
@@ -294,6 +368,35 @@ inline flatbuffers::Offset<GridSample> CreateGridSample(flatbuffers::FlatBufferB
       _alignCorners);
 }
 
+inline AttentionParamT *AttentionParam::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new AttentionParamT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void AttentionParam::UnPackTo(AttentionParamT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = scale(); _o->scale = _e; };
+  { auto _e = kvcache(); _o->kvcache = _e; };
+}
+
+inline flatbuffers::Offset<AttentionParam> AttentionParam::Pack(flatbuffers::FlatBufferBuilder &_fbb, const AttentionParamT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateAttentionParam(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<AttentionParam> CreateAttentionParam(flatbuffers::FlatBufferBuilder &_fbb, const AttentionParamT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const AttentionParamT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _scale = _o->scale;
+  auto _kvcache = _o->kvcache;
+  return MNN::CreateAttentionParam(
+      _fbb,
+      _scale,
+      _kvcache);
+}
+
 inline const flatbuffers::TypeTable *SampleModeTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
     { flatbuffers::ET_CHAR, 0, 0 },
@@ -371,6 +474,21 @@ inline const flatbuffers::TypeTable *GridSampleTypeTable() {
   return &tt;
 }
 
+inline const flatbuffers::TypeTable *AttentionParamTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_FLOAT, 0, -1 },
+    { flatbuffers::ET_BOOL, 0, -1 }
+  };
+  static const char * const names[] = {
+    "scale",
+    "kvcache"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
 }  // namespace MNN
 
 #endif  // FLATBUFFERS_GENERATED_USERDEFINE_MNN_H_
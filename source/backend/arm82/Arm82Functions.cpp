@@ -469,6 +469,8 @@ bool Arm82Functions::init() {
 
     gInstance->MNNDeconvRunForLineDepthwise = (decltype(gInstance->MNNDeconvRunForLineDepthwise))_MNNDeconvRunForLineDepthwise;
     gInstance->MNNDeconvRunForUnitDepthWise = (decltype(gInstance->MNNDeconvRunForUnitDepthWise))_MNNDeconvRunForUnitDepthWise;
+    gInstance->MNNSelectUnaryFunctionForFloat = nullptr;
+    gInstance->MNNSoftmax = nullptr;
     return true;
 }
 
@@ -0,0 +1,371 @@
+//
+//  CPUAttention.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPUAttention.hpp"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#include "math/Vec.hpp"
+using Vec4 = MNN::Math::Vec<float, 4>;
+
+// Keys of one tile, aligned to hP. The scores of a tile are [eP, KEY_TILE]
+#define KEY_TILE 256
+// Keys preallocated by the kvcache, the capacity doubles when it's used up
+#define KV_CACHE_STEP 256
+
+namespace MNN {
+CPUAttention::CPUAttention(Backend *b, float scale, bool kvcache) : Execution(b), mScale(scale), mKVCache(kvcache) {
+    // Do nothing
+}
+
+CPUAttention::~CPUAttention() {
+    if (mKVCache) {
+        _releaseKVCache();
+    }
+}
+
+void CPUAttention::onReset() {
+    // Keep the buffers for the next sequence
+    mPastLength = 0;
+}
+
+void CPUAttention::_releaseKVCache() {
+    if (nullptr != mPackedKey) {
+        backend()->onReleaseBuffer(mPackedKey.get(), Backend::STATIC);
+        backend()->onReleaseBuffer(mPackedValue.get(), Backend::STATIC);
+    }
+    mPackedKey   = nullptr;
+    mPackedValue = nullptr;
+    mMaxLength   = 0;
+}
+
+bool CPUAttention::_reserveKVCache(int maxLength) {
+    int eP, lP, hP;
+    MNNGetCoreFunctions()->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    std::shared_ptr<Tensor> key(Tensor::createDevice<float>({mBatch, UP_DIV(maxLength, hP) * hP * mDim}));
+    std::shared_ptr<Tensor> value(Tensor::createDevice<float>({mBatch, UP_DIV(mDimV, hP) * hP * maxLength}));
+    if (!backend()->onAcquireBuffer(key.get(), Backend::STATIC)) {
+        return false;
+    }
+    if (!backend()->onAcquireBuffer(value.get(), Backend::STATIC)) {
+        backend()->onReleaseBuffer(key.get(), Backend::STATIC);
+        return false;
+    }
+    ::memset(key->host<float>(), 0, key->size());
+    ::memset(value->host<float>(), 0, value->size());
+    if (mPastLength > 0) {
+        // The blocks of key keep their layout, the rows of value move to the longer stride
+        for (int b = 0; b < mBatch; ++b) {
+            ::memcpy(key->host<float>() + b * key->length(1), mPackedKey->host<float>() + b * mPackedKey->length(1),
+                     UP_DIV(mPastLength, hP) * hP * mDim * sizeof(float));
+            for (int z = 0; z < UP_DIV(mDimV, hP); ++z) {
+                ::memcpy(value->host<float>() + b * value->length(1) + z * maxLength * hP,
+                         mPackedValue->host<float>() + b * mPackedValue->length(1) + z * mMaxLength * hP,
+                         mPastLength * hP * sizeof(float));
+            }
+        }
+    }
+    _releaseKVCache();
+    mPackedKey   = key;
+    mPackedValue = value;
+    mMaxLength   = maxLength;
+    return true;
+}
+
+// Write key: [seqK, dim] and value: [seqK, dimV] after the past keys of the packed B, which hold maxLength keys
+static void _appendKV(float *packedKey, float *packedValue, const float *key, const float *value, int past, int seqK,
+                      int dim, int dimV, int maxLength, int hP) {
+    for (int k = 0; k < seqK; ++k) {
+        int pos   = past + k;
+        auto dstK = packedKey + (pos / hP) * dim * hP + pos % hP;
+        auto srcK = key + k * dim;
+        for (int d = 0; d < dim; ++d) {
+            dstK[d * hP] = srcK[d];
+        }
+        auto dstV = packedValue + pos * hP;
+        auto srcV = value + k * dimV;
+        for (int j = 0; j < dimV; ++j) {
+            dstV[(j / hP) * maxLength * hP + j % hP] = srcV[j];
+        }
+    }
+}
+
+// C: [UP_DIV(h, 4), e, 4], A: packed by _packA, B: packed by MNNPackForMatMul_B with bExtraStride floats skipped
+static void _packedMatMul(const CoreFunctions *core, float *C, const float *A, const float *B, int e, int l, int h,
+                          int eP, size_t bExtraStride) {
+    size_t parameters[6];
+    parameters[0] = e * sizeof(float);
+    parameters[1] = l;
+    parameters[2] = h;
+    parameters[3] = e * 4 * sizeof(float);
+    parameters[4] = 0;
+    parameters[5] = bExtraStride * sizeof(float);
+    if (e == eP) {
+        core->MNNPackedMatMul(C, A, B, parameters, nullptr, nullptr);
+    } else {
+        core->MNNPackedMatMulRemain(C, A, B, e, parameters, nullptr, nullptr);
+    }
+}
+
+// [UP_DIV(l, 4), e, 4] -> A of MNNPackedMatMul
+static void _packA(const CoreFunctions *core, float *dst, const float *src, int e, int l) {
+    int32_t info[4]   = {1, e, e, 1};
+    int32_t stride[4] = {e, l, 0, 0};
+    core->MNNPackC4ForMatMul_A(dst, &src, info, stride);
+}
+
+// Flash attention for e rows of query: the scores of each key tile update the running max and sum of the rows,
+// the accumulated output is rescaled by exp(mOld - mNew) before adding probabilities * value.
+// The packed value holds valueStride keys, seqK of them are used. If causal >= 0, row r only sees the keys before
+// causal + r + 1, the others are masked as the padding
+static void _attentionTile(float *dst, const float *query, const float *packedKey, const float *packedValue, int e,
+                           int seqK, int valueStride, int dim, int dimV, int keyTile, float scale, int causal,
+                           float *cache) {
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    auto dimVC4   = UP_DIV(dimV, 4);
+    auto packQ    = cache;
+    auto packP    = packQ + eP * dim;
+    auto scores   = packP + eP * keyTile;
+    auto newOut   = scores + eP * ALIGN_UP4(std::max(dim, keyTile));
+    auto acc      = newOut + eP * dimVC4 * 4;
+    auto maxValue = acc + eP * dimVC4 * 4;
+    auto sumValue = maxValue + eP;
+
+    core->MNNPackCUnitTranspose(scores, query, e, dim);
+    _packA(core, packQ, scores, e, dim);
+    ::memset(acc, 0, e * dimVC4 * 4 * sizeof(float));
+    for (int r = 0; r < e; ++r) {
+        maxValue[r] = -FLT_MAX;
+        sumValue[r] = 0.0f;
+    }
+    if (causal >= 0) {
+        // No row sees the keys after the last row
+        seqK = std::min(seqK, causal + e);
+    }
+    // Number of keys of the tile seen by row r, the rest of colsC4 * 4 are masked
+    auto validCols = [causal](int r, int k0, int cols) {
+        if (causal < 0) {
+            return cols;
+        }
+        return std::max(0, std::min(cols, causal + r + 1 - k0));
+    };
+    for (int k0 = 0; k0 < seqK; k0 += keyTile) {
+        int cols   = std::min(keyTile, seqK - k0);
+        int colsC4 = UP_DIV(cols, 4);
+        _packedMatMul(core, scores, packQ, packedKey + k0 * dim, e, dim, cols, eP, 0);
+        // The scores are [colsC4, e, 4], each Vec4 belongs to one row. They are scaled before the max and the
+        // padding, the scale may be negative
+        Vec4 scaleV(scale);
+        for (int i = 0; i < colsC4 * e * 4; i += 4) {
+            Vec4::save(scores + i, Vec4::load(scores + i) * scaleV);
+        }
+        for (int r = 0; r < e; ++r) {
+            for (int k = validCols(r, k0, cols); k < colsC4 * 4; ++k) {
+                scores[((k / 4) * e + r) * 4 + k % 4] = -FLT_MAX;
+            }
+        }
+        for (int r = 0; r < e; ++r) {
+            Vec4 maxV(-FLT_MAX);
+            for (int z = 0; z < colsC4; ++z) {
+                maxV = Vec4::max(maxV, Vec4::load(scores + (z * e + r) * 4));
+            }
+            float m     = std::max(std::max(maxV[0], maxV[1]), std::max(maxV[2], maxV[3]));
+            m           = std::max(m, maxValue[r]);
+            float alpha = expf(maxValue[r] - m);
+            maxValue[r] = m;
+            sumValue[r] *= alpha;
+            // MNNExp computes exp(-x)
+            Vec4 mV(m);
+            for (int z = 0; z < colsC4; ++z) {
+                auto s = scores + (z * e + r) * 4;
+                Vec4::save(s, mV - Vec4::load(s));
+            }
+            Vec4 alphaV(alpha);
+            for (int z = 0; z < dimVC4; ++z) {
+                auto a = acc + (z * e + r) * 4;
+                Vec4::save(a, Vec4::load(a) * alphaV);
+            }
+        }
+        MNNExp(scores, scores, colsC4 * e * 4);
+        for (int r = 0; r < e; ++r) {
+            for (int k = validCols(r, k0, cols); k < colsC4 * 4; ++k) {
+                scores[((k / 4) * e + r) * 4 + k % 4] = 0.0f;
+            }
+        }
+        for (int r = 0; r < e; ++r) {
+            Vec4 sumV(0.0f);
+            for (int z = 0; z < colsC4; ++z) {
+                sumV = sumV + Vec4::load(scores + (z * e + r) * 4);
+            }
+            sumValue[r] += (sumV[0] + sumV[1]) + (sumV[2] + sumV[3]);
+        }
+        _packA(core, packP, scores, e, cols);
+        _packedMatMul(core, newOut, packP, packedValue + k0 * hP, e, cols, dimV, eP,
+                      (valueStride - cols) * hP);
+        for (int i = 0; i < e * dimVC4 * 4; i += 4) {
+            Vec4::save(acc + i, Vec4::load(acc + i) + Vec4::load(newOut + i));
+        }
+    }
+    for (int r = 0; r < e; ++r) {
+        Vec4 scaleV(1.0f / sumValue[r]);
+        for (int z = 0; z < dimVC4; ++z) {
+            auto a = acc + (z * e + r) * 4;
+            Vec4::save(a, Vec4::load(a) * scaleV);
+        }
+    }
+    core->MNNUnpackCUnitTranspose(dst, acc, e, dimV);
+}
+
+ErrorCode CPUAttention::onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+    auto query = inputs[0];
+    auto dims  = query->dimensions();
+    mBatch     = 1;
+    for (int i = 0; i < dims - 2; ++i) {
+        mBatch *= query->length(i);
+    }
+    mSeqQ = query->length(dims - 2);
+    mDim  = query->length(dims - 1);
+    mSeqK = inputs[1]->length(dims - 2);
+    mDimV = inputs[2]->length(dims - 1);
+
+    // The data is always float, use the float functions even for lowp backends
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    MNN_ASSERT(1 == lP);
+    mKeyTile = UP_DIV(KEY_TILE, hP) * hP;
+    int numberThread = static_cast<CPUBackend *>(backend())->threadNumber();
+    int cacheSize    = eP * (mDim + mKeyTile + ALIGN_UP4(std::max(mDim, mKeyTile)) + 2 * ALIGN_UP4(mDimV) + 2);
+    mCache.reset(Tensor::createDevice<float>({numberThread, cacheSize}));
+    if (mKVCache) {
+        // A new batch or dim can't use the cached key / value, start a new sequence
+        if (nullptr != mPackedKey &&
+            (mPackedKey->length(0) != mBatch || mPackedKey->length(1) != UP_DIV(mMaxLength, hP) * hP * mDim ||
+             mPackedValue->length(1) != UP_DIV(mDimV, hP) * hP * mMaxLength)) {
+            _releaseKVCache();
+            mPastLength = 0;
+        }
+        if (nullptr == mPackedKey && !_reserveKVCache(UP_DIV(std::max(mSeqK, KV_CACHE_STEP), hP) * hP)) {
+            return OUT_OF_MEMORY;
+        }
+        auto res = backend()->onAcquireBuffer(mCache.get(), Backend::DYNAMIC);
+        if (!res) {
+            return OUT_OF_MEMORY;
+        }
+        backend()->onReleaseBuffer(mCache.get(), Backend::DYNAMIC);
+        return NO_ERROR;
+    }
+    mPackedKey.reset(Tensor::createDevice<float>({mBatch, UP_DIV(mSeqK, hP) * hP * mDim}));
+    mPackedValue.reset(Tensor::createDevice<float>({mBatch, UP_DIV(mDimV, hP) * hP * mSeqK}));
+    for (auto t : {mPackedKey.get(), mPackedValue.get(), mCache.get()}) {
+        auto res = backend()->onAcquireBuffer(t, Backend::DYNAMIC);
+        if (!res) {
+            return OUT_OF_MEMORY;
+        }
+    }
+    for (auto t : {mPackedKey.get(), mPackedValue.get(), mCache.get()}) {
+        backend()->onReleaseBuffer(t, Backend::DYNAMIC);
+    }
+    return NO_ERROR;
+}
+
+ErrorCode CPUAttention::onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+    auto queryPtr    = inputs[0]->host<float>();
+    auto keyPtr      = inputs[1]->host<float>();
+    auto valuePtr    = inputs[2]->host<float>();
+    auto outputPtr   = outputs[0]->host<float>();
+    auto core        = MNNGetCoreFunctions();
+    int numberThread = static_cast<CPUBackend *>(backend())->threadNumber();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+
+    int seqK        = mSeqK;
+    int valueStride = mSeqK;
+    // For kvcache, query i is the token past + i and sees the keys up to it
+    int past        = mPastLength;
+    if (mKVCache && mPastLength + mSeqK > mMaxLength) {
+        auto maxLength = UP_DIV(std::max(mMaxLength * 2, mPastLength + mSeqK), hP) * hP;
+        if (!_reserveKVCache(maxLength)) {
+            return OUT_OF_MEMORY;
+        }
+    }
+    auto packedKey   = mPackedKey->host<float>();
+    auto packedValue = mPackedValue->host<float>();
+    if (mKVCache) {
+        MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+            for (int b = (int)tId; b < mBatch; b += numberThread) {
+                _appendKV(packedKey + b * mPackedKey->length(1), packedValue + b * mPackedValue->length(1),
+                          keyPtr + b * mSeqK * mDim, valuePtr + b * mSeqK * mDimV, mPastLength, mSeqK, mDim, mDimV,
+                          mMaxLength, hP);
+            }
+        }
+        MNN_CONCURRENCY_END();
+        mPastLength += mSeqK;
+        seqK        = mPastLength;
+        valueStride = mMaxLength;
+    } else {
+        // key: [seqK, dim] as transposed B, value: [seqK, dimV] as B
+        MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+            for (int b = (int)tId; b < mBatch; b += numberThread) {
+                core->MNNPackForMatMul_B(packedKey + b * mPackedKey->length(1), keyPtr + b * mSeqK * mDim, mSeqK,
+                                         mDim, true);
+                core->MNNPackForMatMul_B(packedValue + b * mPackedValue->length(1), valuePtr + b * mSeqK * mDimV,
+                                         mDimV, mSeqK, false);
+            }
+        }
+        MNN_CONCURRENCY_END();
+    }
+
+    int tileCount  = UP_DIV(mSeqQ, eP);
+    int totalCount = mBatch * tileCount;
+    MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+        auto cache = mCache->host<float>() + tId * mCache->length(1);
+        for (int index = (int)tId; index < totalCount; index += numberThread) {
+            int b    = index / tileCount;
+            int q0   = (index % tileCount) * eP;
+            int e    = std::min(eP, mSeqQ - q0);
+            auto dst = outputPtr + (b * mSeqQ + q0) * mDimV;
+            auto q   = queryPtr + (b * mSeqQ + q0) * mDim;
+            _attentionTile(dst, q, packedKey + b * mPackedKey->length(1), packedValue + b * mPackedValue->length(1),
+                           e, seqK, valueStride, mDim, mDimV, mKeyTile, mScale, mKVCache ? past + q0 : -1, cache);
+        }
+    }
+    MNN_CONCURRENCY_END();
+    return NO_ERROR;
+}
+
+class CPUAttentionCreator : public CPUBackend::Creator {
+public:
+    virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                                const MNN::Op *op, Backend *backend) const override {
+        for (auto t : inputs) {
+            if (TensorUtils::getDescribe(t)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4) {
+                return nullptr;
+            }
+        }
+        float scale  = 1.0f;
+        bool kvcache = false;
+        if (nullptr != op->main_as_AttentionParam()) {
+            scale   = op->main_as_AttentionParam()->scale();
+            kvcache = op->main_as_AttentionParam()->kvcache();
+        }
+        return new CPUAttention(backend, scale, kvcache);
+    }
+};
+
+REGISTER_CPU_OP_CREATOR(CPUAttentionCreator, OpType_Attention);
+
+} // namespace MNN
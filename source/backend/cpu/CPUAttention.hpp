@@ -0,0 +1,49 @@
+//
+//  CPUAttention.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPUAttention_hpp
+#define CPUAttention_hpp
+
+#include "core/Execution.hpp"
+#include "MNN_generated.h"
+
+namespace MNN {
+// softmax(query * key^T * scale) * value computed by tiles, the [seqQ, seqK] scores are never materialized
+class CPUAttention : public Execution {
+public:
+    CPUAttention(Backend *b, float scale, bool kvcache);
+    virtual ~CPUAttention();
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual void onReset() override;
+
+private:
+    bool _reserveKVCache(int maxLength);
+    void _releaseKVCache();
+
+    float mScale;
+    bool mKVCache;
+    int mBatch   = 1;
+    int mSeqQ    = 1;
+    int mSeqK    = 1;
+    int mDim     = 1;
+    int mDimV    = 1;
+    int mKeyTile = 1;
+    // For kvcache: keys appended by former executions and the keys the buffers can hold
+    int mPastLength = 0;
+    int mMaxLength  = 0;
+    // Key and value of each batch packed as B of MNNPackedMatMul, kept in static memory for kvcache
+    std::shared_ptr<Tensor> mPackedKey;
+    std::shared_ptr<Tensor> mPackedValue;
+    // Per thread: packed query / probabilities, scores, new and accumulated output, running max and sum
+    std::shared_ptr<Tensor> mCache;
+};
+
+} // namespace MNN
+
+#endif /* CPUAttention_hpp */
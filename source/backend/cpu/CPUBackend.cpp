@@ -9,7 +9,10 @@
 #include "backend/cpu/CPUBackend.hpp"
 #include <cmath>
 #include <mutex>
+#include <sstream>
+#include <string.h>
 #include "core/BufferAllocator.hpp"
+#include "core/ModelRegistry.hpp"
 #include "CPUTensorConvert.hpp"
 #include "compute/CommonOptFunction.h"
 #include "core/TensorUtils.hpp"
@@ -18,6 +21,7 @@
 #include "compute/Int8FunctionsOpt.h"
 #include "CPUCast.hpp"
 #include "core/OpCommonUtils.hpp"
+#include "CPUCache_generated.h"
 #ifdef _OPENMP
 #include <omp.h>
 #endif // _OPENMP
@@ -31,7 +35,6 @@
 #include "bf16/BF16Backend.hpp"
 #endif
 
-#define MNN_CPU_CHECK_NAN 1
 namespace MNN {
 void registerCPUOps();
 #if defined(ENABLE_ARMV82) && (defined(__ANDROID__) || defined(__aarch64__))
@@ -39,7 +42,6 @@ struct cpuinfo_arm_isa gCPUInfo;
 #endif
 
 CPURuntime::CPURuntime(const Backend::Info& info) {
-    mStaticAllocator.reset(new BufferAllocator(BufferAllocator::Allocator::createDefault()));
     mThreadNumber = info.numThread;
     mThreadNumber = std::max(1, mThreadNumber);
     mThreadNumber = std::min(mThreadNumber, MAX_THREAD_NUMBER);
@@ -58,6 +60,25 @@ CPURuntime::CPURuntime(const Backend::Info& info) {
         mMemory = info.user->memory;
         mFlags = info.user->flags;
     }
+    std::vector<int> cpuIDs;
+    if (!info.cpuIds.empty()) {
+        cpuIDs = info.cpuIds;
+        auto& cpuNode = MNNGetCPUTopology().cpuNode;
+        if (cpuIDs[0] >= 0 && cpuIDs[0] < cpuNode.size()) {
+            mNUMANode = cpuNode[cpuIDs[0]];
+        }
+    } else if (mFlags & MNN_CPU_BIND_CORE) {
+        mNUMANode = MNNGetCurrentNUMANode();
+        cpuIDs    = MNNGetBindCPUIDs(mThreadNumber, mNUMANode);
+    }
+    if (mNUMANode >= 0 && MNNGetCPUTopology().nodeCPUs.size() > 1) {
+        mStaticAllocator.reset(new BufferAllocator(BufferAllocator::Allocator::createNuma(mNUMANode)));
+    } else {
+        mStaticAllocator.reset(new BufferAllocator(BufferAllocator::Allocator::createDefault()));
+    }
+#ifdef MNN_USE_THREAD_POOL
+    mScheduleMode = (mFlags & MNN_CPU_WORK_STEALING) ? ThreadPool::WORK_STEALING : ThreadPool::STATIC;
+#endif
 #ifdef _OPENMP
     switch (mPower) {
         case BackendConfig::Power_Low:
@@ -71,29 +92,41 @@ CPURuntime::CPURuntime(const Backend::Info& info) {
     }
 #endif
 #ifdef MNN_USE_THREAD_POOL
-    mThreadNumber = ThreadPool::init(mThreadNumber);
+    // A core set can't be applied to the shared pool once it's created, and would bind the runtimes created later
+    // if it created the pool, so it implies an own pool
+    if ((mFlags & MNN_CPU_OWN_THREAD_POOL) || !cpuIDs.empty()) {
+        mThreadPool = ThreadPool::create(mThreadNumber, cpuIDs);
+        mThreadNumber = nullptr != mThreadPool ? mThreadPool->number() : 1;
+        if (nullptr != mThreadPool) {
+            mCpuIDs = cpuIDs;
+        }
+    } else {
+        mThreadNumber = ThreadPool::init(mThreadNumber, cpuIDs);
+    }
     if (mThreadNumber > 1) {
-        mTaskIndex = ThreadPool::acquireWorkIndex();
+        mTaskIndex = ThreadPool::acquireWorkIndex(mThreadPool.get());
     } else {
         mTaskIndex = -1;
     }
-    if (mTaskIndex >= 0 && mPower == BackendConfig::Power_High) {
-        ThreadPool::active();
+    // Work-stealing workers are woken per task, needn't keep them active
+    if (mTaskIndex >= 0 && mPower == BackendConfig::Power_High && mScheduleMode == ThreadPool::STATIC) {
+        ThreadPool::active(mThreadPool.get());
     }
 #endif
 }
 CPURuntime:: ~ CPURuntime() {
 #ifdef MNN_USE_THREAD_POOL
-    if (mTaskIndex >= 0 && mPower == BackendConfig::Power_High) {
-        ThreadPool::deactive();
+    if (mTaskIndex >= 0 && mPower == BackendConfig::Power_High && mScheduleMode == ThreadPool::STATIC) {
+        ThreadPool::deactive(mThreadPool.get());
     }
-    ThreadPool::releaseWorkIndex(mTaskIndex);
+    ThreadPool::releaseWorkIndex(mTaskIndex, mThreadPool.get());
 #endif
 }
 float CPURuntime::onGetMemoryInMB() {
     auto staticMemoryInMB = mStaticAllocator->totalSize() / 1024.0f / 1024.0f;
     return staticMemoryInMB;
 }
+Backend*(*CPURuntime::gExtraCreate)(const CPURuntime* runtime, BackendConfig::PrecisionMode precision) = nullptr;
 Backend* CPURuntime::onCreate(const BackendConfig* config) const {
     auto precision = mPrecision;
     if (nullptr != config) {
@@ -109,11 +142,66 @@ Backend* CPURuntime::onCreate(const BackendConfig* config) const {
         return new BF16Backend(this);
     }
 #endif
+    if ((mFlags & MNN_CPU_WIDE_PACK) && nullptr != gExtraCreate) {
+        return gExtraCreate(this, precision);
+    }
     return new CPUBackend(this, precision);
 }
 void CPURuntime::onGabageCollect(int level) {
     mStaticAllocator->release(false);
 }
+bool CPURuntime::onSetCache(const void* buffer, size_t size) {
+    if (nullptr == buffer) {
+        // Only reset the outside buffer, tuned choices are kept
+        return false;
+    }
+    flatbuffers::Verifier verify((const uint8_t*)buffer, size);
+    if (!CPUCache::CacheBufferHasIdentifier(buffer) || !CPUCache::VerifyCacheBuffer(verify)) {
+        return false;
+    }
+    auto cache = CPUCache::GetCache(buffer);
+    if (nullptr == cache->tunings()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> _l(mTuneLock);
+    for (int i = 0; i < cache->tunings()->size(); ++i) {
+        auto tun = cache->tunings()->GetAs<CPUCache::Tuning>(i);
+        if (nullptr == tun->key() || nullptr == tun->choice()) {
+            MNN_ERROR("Error tunning info\n");
+            continue;
+        }
+        TuneInfo info;
+        info.choice.resize(tun->choice()->size());
+        for (int v = 0; v < info.choice.size(); ++v) {
+            info.choice[v] = tun->choice()->data()[v];
+        }
+        info.timeCost = tun->timeCost();
+        mTuneInfos[tun->key()->str()] = std::move(info);
+    }
+    return true;
+}
+std::pair<const void*, size_t> CPURuntime::onGetCache() {
+    std::unique_ptr<CPUCache::CacheT> cache(new CPUCache::CacheT);
+    {
+        std::lock_guard<std::mutex> _l(mTuneLock);
+        if (mTuneInfos.empty()) {
+            return std::make_pair(nullptr, 0);
+        }
+        for (auto& iter : mTuneInfos) {
+            std::unique_ptr<CPUCache::TuningT> tuning(new CPUCache::TuningT);
+            tuning->key      = iter.first;
+            tuning->choice   = iter.second.choice;
+            tuning->timeCost = iter.second.timeCost;
+            cache->tunings.emplace_back(std::move(tuning));
+        }
+    }
+    flatbuffers::FlatBufferBuilder builder;
+    auto lastOffset = CPUCache::Cache::Pack(builder, cache.get());
+    CPUCache::FinishCacheBuffer(builder, lastOffset);
+    mCacheBuffer.resize(builder.GetSize());
+    ::memcpy(mCacheBuffer.data(), builder.GetBufferPointer(), builder.GetSize());
+    return std::make_pair(mCacheBuffer.data(), mCacheBuffer.size());
+}
 std::map<OpType, CPUBackend::Creator*>* CPUBackend::gCreator = nullptr;
 void CPUBackend::initCreatorMap() {
     gCreator = new std::map<OpType, CPUBackend::Creator*>;
@@ -131,8 +219,11 @@ bool CPUBackend::addCreator(OpType t, Creator* c) {
 
 CPUBackend::CPUBackend(const CPURuntime* runtime, BackendConfig::PrecisionMode precision, MNNForwardType type) : Backend(type) {
     mRuntime = runtime;
-    mCheckNAN = runtime->mFlags == MNN_CPU_CHECK_NAN;
+    mCheckNAN = (runtime->mFlags & MNN_CPU_CHECK_NAN) != 0;
     std::shared_ptr<BufferAllocator::Allocator> defaultAlloc(BufferAllocator::Allocator::createRecurse(runtime->mStaticAllocator.get()));
+    if (runtime->mFlags & MNN_CPU_SIZE_CLASS_MEMORY) {
+        defaultAlloc = BufferAllocator::Allocator::createSizeClass(defaultAlloc);
+    }
     mDynamicAllocator.reset(new BufferAllocator(defaultAlloc));
     mStaticAllocator = runtime->mStaticAllocator;
     mPrecisionMode = precision;
@@ -141,6 +232,77 @@ CPUBackend::CPUBackend(const CPURuntime* runtime, BackendConfig::PrecisionMode p
 bool CPUBackend::supportDot() const {
     return mRuntime->mIsSupportDot;
 }
+bool CPUBackend::getTuneChoice(const std::string& key, std::vector<int>& choice) const {
+    std::lock_guard<std::mutex> _l(mRuntime->mTuneLock);
+    auto iter = mRuntime->mTuneInfos.find(key);
+    if (iter == mRuntime->mTuneInfos.end()) {
+        return false;
+    }
+    choice = iter->second.choice;
+    return true;
+}
+void CPUBackend::setTuneChoice(const std::string& key, const std::vector<int>& choice, float timeCost) const {
+    std::lock_guard<std::mutex> _l(mRuntime->mTuneLock);
+    auto& info    = mRuntime->mTuneInfos[key];
+    info.choice   = choice;
+    info.timeCost = timeCost;
+}
+
+std::shared_ptr<void> CPUBackend::getSharedResource(const std::string& key) const {
+    if (key.empty()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> _l(mRuntime->mSharedLock);
+    auto iter = mRuntime->mSharedResources.find(key);
+    if (iter == mRuntime->mSharedResources.end()) {
+        return nullptr;
+    }
+    return iter->second.lock();
+}
+void CPUBackend::setSharedResource(const std::string& key, std::shared_ptr<void> resource) const {
+    if (key.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> _l(mRuntime->mSharedLock);
+    auto& resources = mRuntime->mSharedResources;
+    for (auto iter = resources.begin(); iter != resources.end();) {
+        if (iter->second.expired()) {
+            iter = resources.erase(iter);
+            continue;
+        }
+        iter++;
+    }
+    resources[key] = resource;
+}
+std::string CPUBackend::makeResourceKey(const std::string& type,
+                                        const std::vector<std::pair<const void*, size_t>>& data) const {
+    int eP, lP, hP;
+    mCoreFunctions->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    std::ostringstream key;
+    key << type << "|" << mCoreFunctions->bytes << "," << mCoreFunctions->pack << "," << eP << "," << lP << ","
+        << hP;
+    for (auto& d : data) {
+        int64_t id;
+        size_t offset;
+        if (0 == d.second) {
+            key << "|-";
+            continue;
+        }
+        if (!ModelRegistry::find(d.first, d.second, id, offset)) {
+            // Temporary data, its address may hold other data later
+            return "";
+        }
+        key << "|" << id << ":" << offset << ":" << d.second;
+    }
+    return key.str();
+}
+Backend* CPUBackend::getSharedBackend() const {
+    std::lock_guard<std::mutex> _l(mRuntime->mSharedLock);
+    if (nullptr == mRuntime->mSharedBackend) {
+        mRuntime->mSharedBackend.reset(new CPUBackend(mRuntime, BackendConfig::Precision_Normal));
+    }
+    return mRuntime->mSharedBackend.get();
+}
 
 CPUBackend::~CPUBackend() {
     // Do nothing
@@ -148,8 +310,15 @@ CPUBackend::~CPUBackend() {
 
 void CPUBackend::onExecuteBegin() const {
 #ifdef MNN_USE_THREAD_POOL
-    if (mRuntime->mTaskIndex >= 0 && mRuntime->mPower != BackendConfig::Power_High) {
-        ThreadPool::active();
+    if (!mRuntime->mCpuIDs.empty() && mCallerAffinity.empty()) {
+        // The executing thread runs slot 0 of the pool's tasks, bind it only if its affinity can be restored
+        mCallerAffinity = MNNGetThreadAffinity();
+        if (!mCallerAffinity.empty()) {
+            MNNSetThreadAffinity({mRuntime->mCpuIDs[0]});
+        }
+    }
+    if (mRuntime->mTaskIndex >= 0 && mRuntime->mPower != BackendConfig::Power_High && mRuntime->mScheduleMode == ThreadPool::STATIC) {
+        ThreadPool::active(mRuntime->mThreadPool.get());
     }
 #else
 #ifdef _OPENMP
@@ -160,8 +329,12 @@ void CPUBackend::onExecuteBegin() const {
 }
 void CPUBackend::onExecuteEnd() const {
 #ifdef MNN_USE_THREAD_POOL
-    if (mRuntime->mTaskIndex >= 0 && mRuntime->mPower != BackendConfig::Power_High) {
-        ThreadPool::deactive();
+    if (mRuntime->mTaskIndex >= 0 && mRuntime->mPower != BackendConfig::Power_High && mRuntime->mScheduleMode == ThreadPool::STATIC) {
+        ThreadPool::deactive(mRuntime->mThreadPool.get());
+    }
+    if (!mCallerAffinity.empty()) {
+        MNNSetThreadAffinity(mCallerAffinity);
+        mCallerAffinity.clear();
     }
 #endif
 }
@@ -216,10 +389,23 @@ bool CPUBackend::onAcquireBuffer(const MNN::Tensor* nativeTensorConst, StorageTy
     }
     //FUNC_PRINT_ALL(nativeTensorConst, p);
     auto nativeTensor = (Tensor*)nativeTensorConst;
-    auto size = nativeTensor->size();
+    auto size = getTensorSize(nativeTensor) * nativeTensor->getType().bytes();
     return allocBuffer(size, nativeTensor, storageType);
 }
 
+int CPUBackend::getTensorSize(const Tensor* tensor) const {
+    auto format = TensorUtils::getDescribe(tensor)->dimensionFormat;
+    int dataSize = 1;
+    for (int i = 0; i < tensor->dimensions(); i++) {
+        int currentDimSize = tensor->length(i);
+        if (format == MNN_DATA_FORMAT_NC4HW4 && 1 == i) {
+            currentDimSize = UP_DIV(currentDimSize, mCoreFunctions->pack) * mCoreFunctions->pack;
+        }
+        dataSize *= currentDimSize;
+    }
+    return dataSize;
+}
+
 bool CPUBackend::onReleaseBuffer(const MNN::Tensor* nativeTensor, StorageType storageType) {
     if (DYNAMIC_SEPERATE == storageType) {
         return true;
@@ -614,6 +800,44 @@ Execution* CPUBackend::onCreate(const std::vector<Tensor*>& inputs, const std::v
     return exe;
 }
 
+void CPUBackend::onResizeBegin() {
+    if (0 == (mRuntime->mFlags & MNN_CPU_STATIC_MEMORY_PLAN) || (mRuntime->mFlags & MNN_CPU_SIZE_CLASS_MEMORY)) {
+        return;
+    }
+    if (MEMORY_PLAN_AGAIN == mMemoryPlanState && mDynamicAllocator->beginReplay()) {
+        mMemoryPlanState = MEMORY_PLAN_REPLAY;
+        return;
+    }
+    mDynamicAllocator->beginRecord();
+    mMemoryPlanState = MEMORY_PLAN_RECORD;
+}
+
+void CPUBackend::onResizeEnd() {
+    if (MEMORY_PLAN_RECORD == mMemoryPlanState) {
+        auto current = mDynamicAllocator->totalSize();
+        auto planned = mDynamicAllocator->endRecord();
+        mMemoryPlanState = (planned > 0 && planned < current) ? MEMORY_PLAN_READY : MEMORY_PLAN_NONE;
+        return;
+    }
+    if (MEMORY_PLAN_REPLAY == mMemoryPlanState) {
+        // If the pass differed from the record, the rest has been allocated by the free list, which is still valid
+        mDynamicAllocator->endReplay();
+    }
+    mMemoryPlanState = MEMORY_PLAN_NONE;
+}
+
+bool CPUBackend::onResizeAgain() {
+    if (MEMORY_PLAN_READY == mMemoryPlanState) {
+        mMemoryPlanState = MEMORY_PLAN_AGAIN;
+        return true;
+    }
+    return false;
+}
+
+float CPUBackend::onGetMemoryInMB() {
+    return mDynamicAllocator->totalSize() / 1024.0f / 1024.0f;
+}
+
 bool CPUBackend::onClearBuffer() {
     mDynamicAllocator->release(true);
     mCachedCastTensor.clear();
@@ -11,9 +11,14 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include "core/Backend.hpp"
 #include "core/Execution.hpp"
 #include "MNN_generated.h"
+#ifdef MNN_USE_THREAD_POOL
+#include "backend/cpu/ThreadPool.hpp"
+#endif
 
 namespace MNN {
 class BufferAllocator;
@@ -31,11 +36,22 @@ public:
     virtual Backend* onCreate(const BackendConfig* config) const override;
     virtual void onGabageCollect(int level) override;
     virtual float onGetMemoryInMB() override;
+    virtual bool onSetCache(const void* buffer, size_t size) override;
+    virtual std::pair<const void*, size_t> onGetCache() override;
 private:
     std::shared_ptr<BufferAllocator> mStaticAllocator;
     int mThreadNumber;
     int mTaskIndex;
+#ifdef MNN_USE_THREAD_POOL
+    ThreadPool::ScheduleMode mScheduleMode = ThreadPool::STATIC;
+    // Own pool of the runtime, nullptr means using the process-wide pool
+    std::shared_ptr<ThreadPool> mThreadPool;
+    // Cpus of the own pool's threads, the thread running a session takes cpuIDs[0] while it executes
+    std::vector<int> mCpuIDs;
+#endif
     size_t mFlags;
+    // NUMA node the runtime is bound to, -1 if not bound
+    int mNUMANode = -1;
     BackendConfig::MemoryMode mMemory;
     BackendConfig::PowerMode mPower;
     BackendConfig::PrecisionMode mPrecision;
@@ -45,7 +61,24 @@ private:
     bool mIsSupportDot = false;
     bool mIsSupportFp16arith = false;
     float mFlops = 0.0f;
-    static Backend*(*gExtraCreate)(const Runtime* runtime);
+
+    // Measured best choice of algorithm for each op / shape key, persisted by onGetCache / onSetCache
+    struct TuneInfo {
+        std::vector<int> choice;
+        float timeCost;
+    };
+    mutable std::map<std::string, TuneInfo> mTuneInfos;
+    mutable std::mutex mTuneLock;
+    std::vector<uint8_t> mCacheBuffer;
+
+    // Weak references of the resources shared by the executions, see CPUBackend::getSharedResource
+    mutable std::map<std::string, std::weak_ptr<void>> mSharedResources;
+    mutable std::mutex mSharedLock;
+    // Releases the static memory of the shared resources, destroyed before the allocator
+    mutable std::shared_ptr<Backend> mSharedBackend;
+public:
+    // Creator of the backend with the wider NC4HW4 pack for MNN_CPU_WIDE_PACK, nullptr if the cpu doesn't support it
+    static Backend*(*gExtraCreate)(const CPURuntime* runtime, BackendConfig::PrecisionMode precision);
 };
 struct CoreFunctions;
 
@@ -61,6 +94,7 @@ public:
     virtual bool onReleaseBuffer(const Tensor* nativeTensor, StorageType storageType) override;
     virtual bool onClearBuffer() override;
     virtual void onCopyBuffer(const Tensor* srcTensor, const Tensor* dstTensor) const override;
+    virtual float onGetMemoryInMB() override;
     virtual std::pair<float, bool> onMeasure(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                                             const MNN::Op* op) override;
 
@@ -68,10 +102,15 @@ public:
                                 const MNN::Op* op) override;
     virtual void onExecuteBegin() const override;
     virtual void onExecuteEnd() const override;
+    virtual void onResizeBegin() override;
+    virtual void onResizeEnd() override;
+    virtual bool onResizeAgain() override;
 
     const CoreFunctions* functions() const {
         return mCoreFunctions;
     }
+    // Element count of the tensor, the channel of NC4HW4 is aligned to the pack of functions()
+    int getTensorSize(const Tensor* tensor) const;
 public:
     class Creator {
     public:
@@ -97,8 +136,27 @@ public:
     }
 #ifdef MNN_USE_THREAD_POOL
     inline int taskIndex() const {return mRuntime->mTaskIndex;}
+    inline ThreadPool::ScheduleMode scheduleMode() const {return mRuntime->mScheduleMode;}
+    inline ThreadPool* threadPool() const {return mRuntime->mThreadPool.get();}
 #endif
     bool supportDot() const;
+    bool needTuning() const {
+        return (mRuntime->mFlags & MNN_CPU_TUNING) != 0;
+    }
+    // Return false if no choice was recorded for key
+    bool getTuneChoice(const std::string& key, std::vector<int>& choice) const;
+    void setTuneChoice(const std::string& key, const std::vector<int>& choice, float timeCost) const;
+
+    // Resources shared by the executions of the runtime, such as the packed weights of a model used by its sessions
+    // and clones. The runtime keeps weak references only, a resource is released with its last execution. Return
+    // nullptr if no alive resource was kept for key
+    std::shared_ptr<void> getSharedResource(const std::string& key) const;
+    void setSharedResource(const std::string& key, std::shared_ptr<void> resource) const;
+    // Key of the resource made by type (the execution and its options) from data with the functions of the backend.
+    // The data are identified by their place in a model of ModelRegistry, return "" (not shared) if one is not in any
+    std::string makeResourceKey(const std::string& type, const std::vector<std::pair<const void*, size_t>>& data) const;
+    // Backend living with the runtime, shared resources release their static memory by it
+    Backend* getSharedBackend() const;
     static void initCreatorMap();
     halide_type_t getRunType(const Op* op, halide_type_t qtype, halide_type_t rtype) override;
 private:
@@ -114,6 +172,17 @@ private:
     BackendConfig::PrecisionMode mPrecisionMode;
     static std::map<OpType, CPUBackend::Creator*>* gCreator;
     std::map<const Tensor*, const Tensor*> mCachedCastTensor;
+    // Affinity of the executing thread before it's bound to the runtime's cpuIDs[0], restored at execute end
+    mutable std::vector<int> mCallerAffinity;
+    // MNN_CPU_STATIC_MEMORY_PLAN: record a resize, then resize again with the planned memory
+    enum MemoryPlanState {
+        MEMORY_PLAN_NONE,
+        MEMORY_PLAN_RECORD,
+        MEMORY_PLAN_READY,
+        MEMORY_PLAN_AGAIN,
+        MEMORY_PLAN_REPLAY
+    };
+    MemoryPlanState mMemoryPlanState = MEMORY_PLAN_NONE;
 };
 
 #define REGISTER_CPU_OP_CREATOR(name, opType)     \
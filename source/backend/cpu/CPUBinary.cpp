@@ -25,9 +25,10 @@ CPUBinaryFloat::CPUBinaryFloat(Backend* b, int32_t type) : MNN::Execution(b), mT
 
 ErrorCode CPUBinaryFloat::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
     MNN_ASSERT(1 == outputs.size());
-    const int input0DataCount = inputs[0]->elementSize();
-    const int input1DataCount = inputs[1]->elementSize();
-    const int outputDataCount = outputs[0]->elementSize();
+    auto cpuBn = static_cast<CPUBackend*>(backend());
+    const int input0DataCount = cpuBn->getTensorSize(inputs[0]);
+    const int input1DataCount = cpuBn->getTensorSize(inputs[1]);
+    const int outputDataCount = cpuBn->getTensorSize(outputs[0]);
     int maxCount = input0DataCount > input1DataCount ?  input0DataCount : input1DataCount;
     mElementProc = nullptr;
     mSupportScale = false;
@@ -216,8 +217,8 @@ ErrorCode CPUBinaryFloat::onExecute(const std::vector<Tensor*>& inputs, const st
     
     if (nullptr != mElementProc || mSupportScale) {
         auto numberThread = ((CPUBackend*)backend())->threadNumber();
-        auto i1Size = input->elementSize();
-        auto i2Size = input1->elementSize();
+        auto i1Size = ((CPUBackend*)backend())->getTensorSize(input);
+        auto i2Size = ((CPUBackend*)backend())->getTensorSize(input1);
         bool swap = false;
         if (i1Size < i2Size) {
             auto temp = i2Size;
@@ -199,8 +199,52 @@ CPUConvInt8::CPUConvInt8(Backend* backend, const Convolution2DCommon* common, st
     : CPUConvolution(common, backend) {
     mResource = res;
 }
+static std::string _resourceKey(Backend* backend, const MNN::Convolution2D* convParam, float inputScale,
+                                float outputScale) {
+    auto common = convParam->common();
+    auto quan   = convParam->symmetricQuan();
+    std::vector<int> values = {common->kernelX(), common->kernelY(), common->inputCount(), common->outputCount(),
+                               common->relu() || common->relu6(), quan->nbits(), quan->method(), quan->zeroPoint(),
+                               quan->outputZeroPoint(), quan->clampMin(), quan->clampMax()};
+    // The scales are compared exactly by their bits
+    uint32_t scales[2];
+    ::memcpy(scales, &inputScale, sizeof(float));
+    ::memcpy(scales + 1, &outputScale, sizeof(float));
+    values.emplace_back((int)scales[0]);
+    values.emplace_back((int)scales[1]);
+    std::string type = "ConvInt8";
+    for (auto v : values) {
+        type += "_" + std::to_string(v);
+    }
+    std::vector<std::pair<const void*, size_t>> data;
+    if (nullptr != quan->weight()) {
+        data.emplace_back(quan->weight()->data(), quan->weight()->size());
+    }
+    if (nullptr != quan->bias()) {
+        data.emplace_back(quan->bias()->data(), quan->bias()->size() * sizeof(int32_t));
+    }
+    if (nullptr != quan->scale()) {
+        data.emplace_back(quan->scale()->data(), quan->scale()->size() * sizeof(float));
+    }
+    if (nullptr != convParam->quanParameter() && nullptr != convParam->quanParameter()->buffer()) {
+        data.emplace_back(convParam->quanParameter()->buffer()->data(), convParam->quanParameter()->buffer()->size());
+    }
+    if (nullptr != convParam->quanParameter() && nullptr != convParam->quanParameter()->alpha()) {
+        data.emplace_back(convParam->quanParameter()->alpha()->data(),
+                          convParam->quanParameter()->alpha()->size() * sizeof(float));
+    }
+    return static_cast<CPUBackend*>(backend)->makeResourceKey(type, data);
+}
+
 std::shared_ptr<CPUConvInt8::ResourceInt8> CPUConvInt8::makeResource(Backend* backend, const MNN::Convolution2D *convParam,
                                                                      float inputScale, float outputScale) {
+    // Sessions of the model on the runtime share the reordered weight
+    auto key = _resourceKey(backend, convParam, inputScale, outputScale);
+    auto cpuBn = static_cast<CPUBackend*>(backend);
+    auto shared = std::static_pointer_cast<ResourceInt8>(cpuBn->getSharedResource(key));
+    if (nullptr != shared) {
+        return shared;
+    }
     std::shared_ptr<CPUConvInt8::ResourceInt8> resource(new ResourceInt8);
     resource->backend = backend;
     resource->mInputScale = inputScale;
@@ -298,6 +342,10 @@ std::shared_ptr<CPUConvInt8::ResourceInt8> CPUConvInt8::makeResource(Backend* ba
     resource->mClampMin = convParam->symmetricQuan()->clampMin();
     resource->mClampMax = convParam->symmetricQuan()->clampMax();
     resource->mRelu = convCommon->relu() || convCommon->relu6();
+    if (!key.empty()) {
+        resource->backend = cpuBn->getSharedBackend();
+        cpuBn->setSharedResource(key, resource);
+    }
     return resource;
 }
 
@@ -61,6 +61,22 @@ std::vector<float> CPUConvolution::getPostParameters() const {
     return postParameters;
 }
 
+std::string CPUConvolution::makeResourceKey(Backend* b, const std::string& type, const void* weight,
+                                            size_t weightBytes, const void* bias, size_t biasBytes) {
+    return static_cast<CPUBackend*>(b)->makeResourceKey(type, {{weight, weightBytes}, {bias, biasBytes}});
+}
+std::shared_ptr<CPUConvolution::Resource> CPUConvolution::getSharedResource(Backend* b, const std::string& key) {
+    return std::static_pointer_cast<Resource>(static_cast<CPUBackend*>(b)->getSharedResource(key));
+}
+void CPUConvolution::setSharedResource(Backend* b, const std::string& key, std::shared_ptr<Resource> resource) {
+    if (key.empty()) {
+        return;
+    }
+    auto cpuBn        = static_cast<CPUBackend*>(b);
+    resource->backend = cpuBn->getSharedBackend();
+    cpuBn->setSharedResource(key, resource);
+}
+
 int CPUConvolution::reorderWeightSize(int depth, int outputCount, int kernelSize, int unitDepth, int unitOC) {
     return UP_DIV(outputCount, unitOC) * UP_DIV(depth, unitDepth) * kernelSize * unitDepth * unitOC;
 }
@@ -46,6 +46,14 @@ public:
     template<typename T, typename U> static bool acquireMemoryAndCopy(std::shared_ptr<Tensor> dest, const T* source, size_t count, Backend*);
 
     std::vector<float> getPostParameters() const;
+
+    // Key of the resource packed by type (the execution and its options) from weight and bias
+    static std::string makeResourceKey(Backend* b, const std::string& type, const void* weight, size_t weightBytes,
+                                       const void* bias, size_t biasBytes);
+    // Resource packed from the same weight by another execution of the runtime, nullptr if not exist
+    static std::shared_ptr<Resource> getSharedResource(Backend* b, const std::string& key);
+    // Share the packed resource by key, it's released by the shared backend of the runtime since then
+    static void setSharedResource(Backend* b, const std::string& key, std::shared_ptr<Resource> resource);
 protected:
     const Convolution2DCommon *mCommon;
 
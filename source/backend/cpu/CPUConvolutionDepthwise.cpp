@@ -23,8 +23,6 @@ CPUConvolutionDepthwise::FloatExecution::FloatExecution(const Convolution2DCommo
     : MNN::CPUConvolution(common, b) {
     auto layer = common;
     mOrigin.reset(new BasicFloatExecution(common, b));
-    mResource.reset(new Resource);
-    mResource->backend = backend();
     auto core = static_cast<CPUBackend*>(b)->functions();
     int bytes = core->bytes;
     int unit = core->pack;
@@ -33,6 +31,14 @@ CPUConvolutionDepthwise::FloatExecution::FloatExecution(const Convolution2DCommo
     int outputCount = (int)biasSize;
     int depthQuad   = UP_DIV(outputCount, unit);
     int kernelSize  = depthQuad * unit * kw * kh;
+    auto key = makeResourceKey(b, "Depthwise_" + std::to_string(outputCount) + "_" + std::to_string(kw * kh),
+                               originWeight, originWeightSize * sizeof(float), bias, biasSize * sizeof(float));
+    mResource = getSharedResource(b, key);
+    if (nullptr != mResource) {
+        return;
+    }
+    mResource.reset(new Resource);
+    mResource->backend = backend();
     mResource->mWeight.reset(Tensor::createDevice<uint8_t>(std::vector<int>{kernelSize * bytes}));
     bool success = b->onAcquireBuffer(mResource->mWeight.get(), Backend::STATIC);
     if (!success) {
@@ -59,6 +65,7 @@ CPUConvolutionDepthwise::FloatExecution::FloatExecution(const Convolution2DCommo
     } else {
         core->MNNPackCUnit(weight, tempWeight, kh * kw, outputCount);
     }
+    setSharedResource(b, key, mResource);
 }
 CPUConvolutionDepthwise::FloatExecution::~FloatExecution() {
     // Do nothing
@@ -8,15 +8,11 @@
 
 #include "backend/cpu/CPUEltwiseInt8.hpp"
 #include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/compute/Int8FunctionsOpt.h"
 #include "core/Concurrency.h"
 #include "core/Macro.h"
 #include "core/TensorUtils.hpp"
 
-extern "C" {
-void MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
-                     const float* outputScale, const size_t size);
-}
-
 namespace MNN {
 
 CPUEltwiseInt8::CPUEltwiseInt8(Backend* backend, const Op* op) : Execution(backend) {
@@ -62,7 +58,9 @@ ErrorCode CPUEltwiseInt8::onExecute(const std::vector<Tensor*>& inputs, const st
     const int oc4Stride   = width * height;
 
     const float *scale0Ptr, *scale1Ptr, *outputScalePtr;
-    std::vector<float> scale0(input0->channel()), scale1(input1->channel()), outputScale(output->channel());
+    // The kernel reads 4 scales per channel quad
+    std::vector<float> scale0(ALIGN_UP4(input0->channel())), scale1(ALIGN_UP4(input1->channel())),
+        outputScale(ALIGN_UP4(output->channel()));
     if (isEltwiseInt8) {
         scale0Ptr      = mInput0Scales->host<float>();
         scale1Ptr      = mInput1Scales->host<float>();
@@ -88,19 +86,8 @@ ErrorCode CPUEltwiseInt8::onExecute(const std::vector<Tensor*>& inputs, const st
             const auto scale1ChannelPtr      = scale1Ptr + tId * 4;
             const auto outputScaleChannelPtr = outputScalePtr + tId * 4;
             auto dstChannelPtr               = dstBatch + tId * oc4Stride * 4;
-#ifdef MNN_USE_NEON
             MNNScaleAddInt8(dstChannelPtr, src0ChannelPtr, src1ChannelPtr, scale0ChannelPtr, scale1ChannelPtr,
                             outputScaleChannelPtr, oc4Stride);
-#else
-            for (int i = 0; i < oc4Stride; ++i) {
-                for (int k = 0; k < 4; ++k) {
-                    float sum = static_cast<float>(src0ChannelPtr[i * 4 + k]) * scale0ChannelPtr[k] +
-                                static_cast<float>(src1ChannelPtr[i * 4 + k]) * scale1ChannelPtr[k];
-                    float value              = sum * outputScaleChannelPtr[k];
-                    dstChannelPtr[i * 4 + k] = static_cast<int8_t>(std::max(std::min(value, 127.0f), -127.0f));
-                }
-            }
-#endif
         }
         MNN_CONCURRENCY_END();
     }
@@ -0,0 +1,317 @@
+//
+//  CPULSTM.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPULSTM.hpp"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#include "math/VecMath.hpp"
+using Vec4     = MNN::Math::Vec<float, 4>;
+using VecMath4 = MNN::Math::VecMath<Vec4, false>;
+
+namespace MNN {
+// C: [UP_DIV(h, 4), cStride, 4], A: packed by _packA, B: packed by MNNPackForMatMul_B
+static void _packedMatMul(const CoreFunctions* core, float* C, const float* A, const float* B, int e, int l, int h,
+                          int eP, int cStride) {
+    size_t parameters[6];
+    parameters[0] = e * sizeof(float);
+    parameters[1] = l;
+    parameters[2] = h;
+    parameters[3] = cStride * 4 * sizeof(float);
+    parameters[4] = 0;
+    parameters[5] = 0;
+    if (e == eP) {
+        core->MNNPackedMatMul(C, A, B, parameters, nullptr, nullptr);
+    } else {
+        core->MNNPackedMatMulRemain(C, A, B, e, parameters, nullptr, nullptr);
+    }
+}
+
+// e rows of [UP_DIV(l, 4), eStride, 4] -> A of MNNPackedMatMul
+static void _packA(const CoreFunctions* core, float* dst, const float* src, int eStride, int e, int l) {
+    int32_t info[4]   = {1, eStride, e, 1};
+    int32_t stride[4] = {e, l, 0, 0};
+    core->MNNPackC4ForMatMul_A(dst, &src, info, stride);
+}
+
+// Onnx's gate g (iofc) of unit j -> row of the reordered gates
+static inline int _gateRow(int g, int j) {
+    return ((j / 4) * 4 + g) * 4 + j % 4;
+}
+
+// Split the unit blocks of a step to threads, each part computes gates aligned to hP
+static void _unitRange(int tId, int threadNumber, int unitBlocks, int gatesPerBlock, int hP, int& u0, int& u1) {
+    int granule = 1;
+    while ((granule * gatesPerBlock) % hP != 0) {
+        granule++;
+    }
+    int granules = UP_DIV(unitBlocks, granule);
+    u0           = std::min(tId * granules / threadNumber * granule, unitBlocks);
+    u1           = std::min((tId + 1) * granules / threadNumber * granule, unitBlocks);
+}
+
+CPULSTM::Resource::~Resource() {
+    for (auto t : {mWeight.get(), mRecurrent.get(), mBias.get()}) {
+        if (nullptr != t && nullptr != t->host<void>()) {
+            backend->onReleaseBuffer(t, Backend::STATIC);
+        }
+    }
+}
+
+static std::shared_ptr<CPULSTM::Resource> _createResource(Backend* backend, int directions, int weightSize,
+                                                          int recurrentSize, int gateSize) {
+    std::shared_ptr<CPULSTM::Resource> resource(new CPULSTM::Resource);
+    resource->backend = backend;
+    resource->mWeight.reset(Tensor::createDevice<float>({directions, weightSize}));
+    resource->mRecurrent.reset(Tensor::createDevice<float>({directions, recurrentSize}));
+    resource->mBias.reset(Tensor::createDevice<float>({directions, gateSize}));
+    for (auto t : {resource->mWeight.get(), resource->mRecurrent.get(), resource->mBias.get()}) {
+        if (!backend->onAcquireBuffer(t, Backend::STATIC)) {
+            return nullptr;
+        }
+    }
+    return resource;
+}
+
+CPULSTM::CPULSTM(Backend* backend) : Execution(backend) {
+    // Do nothing
+}
+
+CPULSTM::~CPULSTM() {
+    // Do nothing
+}
+
+void CPULSTM::_packWeights(const Tensor* W, const Tensor* R, const Tensor* B) {
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    int hidden = mHiddenSize;
+    int hU     = ALIGN_UP4(hidden);
+    std::vector<float> temp(4 * hU * std::max(mInputSize, hidden));
+    for (int d = 0; d < mDirections; ++d) {
+        auto pack = [&](const Tensor* src, int l, Tensor* dst) {
+            ::memset(temp.data(), 0, temp.size() * sizeof(float));
+            auto srcD = src->host<float>() + d * 4 * hidden * l;
+            for (int g = 0; g < 4; ++g) {
+                for (int j = 0; j < hidden; ++j) {
+                    ::memcpy(temp.data() + _gateRow(g, j) * l, srcD + (g * hidden + j) * l, l * sizeof(float));
+                }
+            }
+            core->MNNPackForMatMul_B(dst->host<float>() + d * dst->length(1), temp.data(), 4 * hU, l, true);
+        };
+        pack(W, mInputSize, mResource->mWeight.get());
+        pack(R, hidden, mResource->mRecurrent.get());
+        auto dstB = mResource->mBias->host<float>() + d * 4 * hU;
+        auto srcB = B->host<float>() + d * 4 * hidden;
+        ::memset(dstB, 0, 4 * hU * sizeof(float));
+        for (int g = 0; g < 4; ++g) {
+            for (int j = 0; j < hidden; ++j) {
+                dstB[_gateRow(g, j)] = srcB[g * hidden + j];
+            }
+        }
+    }
+}
+
+ErrorCode CPULSTM::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    // X: [seqLength, batch, inputSize], W: [directions, 4 * hidden, inputSize], R: [directions, 4 * hidden, hidden],
+    // B: [directions, 4 * hidden], initial hidden / cell: [directions, batch, hidden]
+    auto X      = inputs[0];
+    mSeqLength  = X->length(0);
+    mBatch      = X->length(1);
+    mInputSize  = X->length(2);
+    mDirections = inputs[1]->length(0);
+    mHiddenSize = inputs[2]->length(2);
+    int hU      = ALIGN_UP4(mHiddenSize);
+
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    MNN_ASSERT(1 == lP);
+    int weightSize    = UP_DIV(4 * hU, hP) * hP * mInputSize;
+    int recurrentSize = UP_DIV(4 * hU, hP) * hP * mHiddenSize;
+    if (nullptr != mResource && (mResource->mWeight->length(0) != mDirections ||
+                                 mResource->mWeight->length(1) != weightSize ||
+                                 mResource->mRecurrent->length(1) != recurrentSize)) {
+        mResource    = nullptr;
+        mWeightReady = false;
+    }
+    mWeightConst = true;
+    for (int i = 1; i < 4; ++i) {
+        if (TensorUtils::getDescribe(inputs[i])->usage != Tensor::InsideDescribe::CONSTANT) {
+            mWeightConst = false;
+        }
+    }
+    if (mWeightConst && !mWeightReady) {
+        // Other sessions of the model on the runtime may have packed the same weights, if the constants are used
+        // in the model directly (Session_Input_User or a mapped model)
+        auto cpuBn = static_cast<CPUBackend*>(backend());
+        std::string type = "LSTM_" + std::to_string(mDirections) + "_" + std::to_string(mInputSize) + "_" +
+                           std::to_string(mHiddenSize);
+        auto key  = cpuBn->makeResourceKey(type, {{inputs[1]->host<void>(), inputs[1]->size()},
+                                                  {inputs[2]->host<void>(), inputs[2]->size()},
+                                                  {inputs[3]->host<void>(), inputs[3]->size()}});
+        mResource = std::static_pointer_cast<Resource>(cpuBn->getSharedResource(key));
+        if (nullptr == mResource) {
+            mResource = _createResource(backend(), mDirections, weightSize, recurrentSize, 4 * hU);
+            if (nullptr == mResource) {
+                return OUT_OF_MEMORY;
+            }
+            _packWeights(inputs[1], inputs[2], inputs[3]);
+            if (!key.empty()) {
+                mResource->backend = cpuBn->getSharedBackend();
+                cpuBn->setSharedResource(key, mResource);
+            }
+        }
+        mWeightReady = true;
+    } else if (nullptr == mResource) {
+        // Packed before each execution
+        mResource = _createResource(backend(), mDirections, weightSize, recurrentSize, 4 * hU);
+        if (nullptr == mResource) {
+            return OUT_OF_MEMORY;
+        }
+    }
+
+    int numberThread = static_cast<CPUBackend*>(backend())->threadNumber();
+    mGates.reset(Tensor::createDevice<float>({4 * hU * mSeqLength * mBatch}));
+    mState.reset(Tensor::createDevice<float>({3, hU * mBatch}));
+    mRecurrentGates.reset(Tensor::createDevice<float>({4 * hU * mBatch}));
+    mCache.reset(Tensor::createDevice<float>({numberThread, eP * (ALIGN_UP4(mInputSize) + mInputSize + mHiddenSize)}));
+    for (auto t : {mGates.get(), mState.get(), mRecurrentGates.get(), mCache.get()}) {
+        if (!backend()->onAcquireBuffer(t, Backend::DYNAMIC)) {
+            return OUT_OF_MEMORY;
+        }
+    }
+    for (auto t : {mGates.get(), mState.get(), mRecurrentGates.get(), mCache.get()}) {
+        backend()->onReleaseBuffer(t, Backend::DYNAMIC);
+    }
+    return NO_ERROR;
+}
+
+ErrorCode CPULSTM::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    if (!mWeightReady) {
+        _packWeights(inputs[1], inputs[2], inputs[3]);
+        mWeightReady = mWeightConst;
+    }
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    int numberThread   = static_cast<CPUBackend*>(backend())->threadNumber();
+    const int hidden   = mHiddenSize;
+    const int hU       = ALIGN_UP4(hidden);
+    const int batch    = mBatch;
+    const int total    = mSeqLength * batch;
+    const int blocks   = hU / 4;
+    auto xPtr          = inputs[0]->host<float>();
+    auto yPtr          = outputs[0]->host<float>();
+    float* initHidden  = inputs.size() > 4 ? inputs[4]->host<float>() : nullptr;
+    float* initCell    = inputs.size() > 5 ? inputs[5]->host<float>() : nullptr;
+    auto gates         = mGates->host<float>();
+    auto recGates      = mRecurrentGates->host<float>();
+    auto cacheSize     = mCache->length(1);
+    auto packedASize   = eP * (ALIGN_UP4(mInputSize) + mInputSize);
+
+    for (int d = 0; d < mDirections; ++d) {
+        auto weight    = mResource->mWeight->host<float>() + d * mResource->mWeight->length(1);
+        auto recurrent = mResource->mRecurrent->host<float>() + d * mResource->mRecurrent->length(1);
+        auto bias      = mResource->mBias->host<float>() + d * 4 * hU;
+        // Input projection of all timesteps
+        MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+            auto transposed = mCache->host<float>() + tId * cacheSize;
+            auto packA      = transposed + eP * ALIGN_UP4(mInputSize);
+            for (int e0 = (int)tId * eP; e0 < total; e0 += numberThread * eP) {
+                int e = std::min(eP, total - e0);
+                core->MNNPackCUnitTranspose(transposed, xPtr + e0 * mInputSize, e, mInputSize);
+                _packA(core, packA, transposed, e, e, mInputSize);
+                _packedMatMul(core, gates + e0 * 4, packA, weight, e, mInputSize, 4 * hU, eP, total);
+            }
+        }
+        MNN_CONCURRENCY_END();
+
+        auto lastHidden = mState->host<float>();
+        auto curHidden  = lastHidden + hU * batch;
+        auto cell       = curHidden + hU * batch;
+        ::memset(lastHidden, 0, hU * batch * sizeof(float));
+        ::memset(cell, 0, hU * batch * sizeof(float));
+        if (nullptr != initHidden) {
+            core->MNNPackCUnitTranspose(lastHidden, initHidden + d * batch * hidden, batch, hidden);
+        }
+        if (nullptr != initCell) {
+            core->MNNPackCUnitTranspose(cell, initCell + d * batch * hidden, batch, hidden);
+        }
+        for (int step = 0; step < mSeqLength; ++step) {
+            int t = 0 == d ? step : mSeqLength - 1 - step;
+            MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+                int u0, u1;
+                _unitRange((int)tId, numberThread, blocks, 16, hP, u0, u1);
+                if (u0 < u1) {
+                    auto packA = mCache->host<float>() + tId * cacheSize + packedASize;
+                    for (int b0 = 0; b0 < batch; b0 += eP) {
+                        int e = std::min(eP, batch - b0);
+                        _packA(core, packA, lastHidden + b0 * 4, batch, e, hidden);
+                        _packedMatMul(core, recGates + u0 * 4 * batch * 4 + b0 * 4, packA,
+                                      recurrent + (u0 * 16 / hP) * hidden * hP, e, hidden, (u1 - u0) * 16, eP, batch);
+                    }
+                    // Cell = I * C + F * Cell, Hidden = O * tanh(Cell)
+                    for (int u = u0; u < u1; ++u) {
+                        for (int b = 0; b < batch; ++b) {
+                            auto pre = gates + (u * 4 * total + t * batch + b) * 4;
+                            auto rec = recGates + (u * 4 * batch + b) * 4;
+                            auto bu  = bias + u * 16;
+                            auto gI  = VecMath4::sigmoid(Vec4::load(pre) + Vec4::load(rec) + Vec4::load(bu));
+                            auto gO  = VecMath4::sigmoid(Vec4::load(pre + total * 4) + Vec4::load(rec + batch * 4) +
+                                                        Vec4::load(bu + 4));
+                            auto gF  = VecMath4::sigmoid(Vec4::load(pre + 2 * total * 4) +
+                                                        Vec4::load(rec + 2 * batch * 4) + Vec4::load(bu + 8));
+                            auto gC  = VecMath4::tanh(Vec4::load(pre + 3 * total * 4) +
+                                                     Vec4::load(rec + 3 * batch * 4) + Vec4::load(bu + 12));
+                            auto c   = cell + (u * batch + b) * 4;
+                            auto newCell = gI * gC + gF * Vec4::load(c);
+                            Vec4::save(c, newCell);
+                            auto h = gO * VecMath4::tanh(newCell);
+                            Vec4::save(curHidden + (u * batch + b) * 4, h);
+                            auto y = yPtr + ((t * mDirections + d) * batch + b) * hidden + u * 4;
+                            for (int k = 0; k < 4 && u * 4 + k < hidden; ++k) {
+                                y[k] = h[k];
+                            }
+                        }
+                    }
+                }
+            }
+            MNN_CONCURRENCY_END();
+            std::swap(lastHidden, curHidden);
+        }
+        if (outputs.size() > 1) {
+            core->MNNUnpackCUnitTranspose(outputs[1]->host<float>() + d * batch * hidden, lastHidden, batch, hidden);
+        }
+        if (outputs.size() > 2) {
+            core->MNNUnpackCUnitTranspose(outputs[2]->host<float>() + d * batch * hidden, cell, batch, hidden);
+        }
+    }
+    return NO_ERROR;
+}
+
+class CPULSTMCreator : public CPUBackend::Creator {
+public:
+    virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                const MNN::Op* op, Backend* backend) const override {
+        // Caffe's LSTM is computed by geometry
+        if (inputs.size() < 4) {
+            return nullptr;
+        }
+        return new CPULSTM(backend);
+    }
+};
+
+REGISTER_CPU_OP_CREATOR(CPULSTMCreator, OpType_LSTM);
+
+} // namespace MNN
@@ -0,0 +1,58 @@
+//
+//  CPULSTM.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPULSTM_hpp
+#define CPULSTM_hpp
+
+#include "core/Execution.hpp"
+
+namespace MNN {
+// Onnx's LSTM: one GEMM projects the input of all timesteps, then each step runs the recurrent GEMM and updates the
+// gates and states of the units it computed. The gate rows are reordered as [hU / 4, iofc, 4], hU = ALIGN_UP4(hidden)
+class CPULSTM : public Execution {
+public:
+    CPULSTM(Backend *backend);
+    virtual ~CPULSTM();
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+    // W and R of each direction packed as B of MNNPackedMatMul, bias reordered as the gate rows
+    struct Resource {
+        std::shared_ptr<Tensor> mWeight;
+        std::shared_ptr<Tensor> mRecurrent;
+        std::shared_ptr<Tensor> mBias;
+        Backend* backend;
+        ~Resource();
+    };
+
+private:
+    void _packWeights(const Tensor *W, const Tensor *R, const Tensor *B);
+
+    int mSeqLength  = 0;
+    int mBatch      = 0;
+    int mInputSize  = 0;
+    int mHiddenSize = 0;
+    int mDirections = 1;
+    // Weights are constant and have been packed
+    bool mWeightConst = false;
+    bool mWeightReady = false;
+    // Shared by the sessions of the model on the runtime if the weights are constant
+    std::shared_ptr<Resource> mResource;
+    // Input projection of all timesteps: [4 * hU / 4, seqLength * batch, 4]
+    std::shared_ptr<Tensor> mGates;
+    // Hidden of the last and current step, cell: [hU / 4, batch, 4] each
+    std::shared_ptr<Tensor> mState;
+    // Recurrent projection of a step: [4 * hU / 4, batch, 4]
+    std::shared_ptr<Tensor> mRecurrentGates;
+    // Per thread: transposed input, packed input and packed hidden
+    std::shared_ptr<Tensor> mCache;
+};
+
+} // namespace MNN
+
+#endif /* CPULSTM_hpp */
@@ -65,6 +65,8 @@ extern void ___CPUReduceJoinCreator__OpType_ReduceJoin__();
 extern void ___CPUEltwiseInt8Creator__OpType_EltwiseInt8__();
 extern void ___CPUBatchMatMulCreator__OpType_BatchMatMul__();
 extern void ___CPULayerNormCreator__OpType_LayerNorm__();
+extern void ___CPUAttentionCreator__OpType_Attention__();
+extern void ___CPULSTMCreator__OpType_LSTM__();
 
 void registerCPUOps() {
 ___CPUCropAndResizeCreator__OpType_CropAndResize__();
@@ -132,5 +134,7 @@ ___CPUReduceJoinCreator__OpType_ReduceJoin__();
 ___CPUEltwiseInt8Creator__OpType_EltwiseInt8__();
 ___CPUBatchMatMulCreator__OpType_BatchMatMul__();
 ___CPULayerNormCreator__OpType_LayerNorm__();
+___CPUAttentionCreator__OpType_Attention__();
+___CPULSTMCreator__OpType_LSTM__();
 }
 }
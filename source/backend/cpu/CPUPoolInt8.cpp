@@ -7,144 +7,45 @@
 //
 
 #include "backend/cpu/CPUPoolInt8.hpp"
-#include "core/Macro.h"
-
-#ifdef MNN_USE_NEON
-#include <arm_neon.h>
-#endif
+#include <string.h>
+#include "backend/cpu/compute/Int8FunctionsOpt.h"
 #include "core/Concurrency.h"
-
-#define DST_TILE 16
-#define CACHE_SIZE 128
+#include "core/Macro.h"
 
 namespace MNN {
 
-static void poolingMaxNHWCInt8(const Tensor *src, Tensor *dst, int sx, int sy, int kx, int ky, int px, int py) {
-    const int inputHeight  = src->length(1);
-    const int inputWidth   = src->length(2);
-    const int outputHeight = dst->length(1);
-    const int outputWidth  = dst->length(2);
-    const int channel      = dst->length(3);
-    int8_t result[CACHE_SIZE];
-
-    const auto srcPtr = src->host<int8_t>();
-    auto dstPtr       = dst->host<int8_t>();
-
-    for (int oc = 0; oc < channel; oc += CACHE_SIZE) {
-        const int realChannel = std::min(channel - oc, CACHE_SIZE);
-
-        for (int oy = 0; oy < outputHeight; ++oy) {
-            for (int ox = 0; ox < outputWidth; ++ox) {
-                const int srcOriginX = ox * sx - px;
-                const int srcOriginY = oy * sy - py;
-                const int kxs        = std::max(0, -srcOriginX);
-                const int kxe        = std::min(kx, inputWidth - srcOriginX);
-                const int kys        = std::max(0, -srcOriginY);
-                const int kye        = std::min(ky, inputHeight - srcOriginY);
-
-                const int8_t *srcCurPtr = srcPtr + oc + (srcOriginX + srcOriginY * inputWidth) * channel;
-                memset(result, INT8_MIN, sizeof(int8_t) * realChannel);
-                for (int y = kys; y < kye; ++y) {
-                    const int8_t *srcCurRowPtr = srcCurPtr + (y * inputWidth + kxs) * channel;
-                    for (int x = kxs; x < kxe; ++x) {
-                        const int8_t *srcCurChannlePtr = srcCurRowPtr;
-                        int index                      = 0;
-#ifdef MNN_USE_NEON
-                        for (; index <= realChannel - 16; index += 16) {
-                            int8x16_t maxValue   = vld1q_s8(result + index);
-                            int8x16_t inputValue = vld1q_s8(srcCurChannlePtr);
-                            srcCurChannlePtr += 16;
-                            maxValue = vmaxq_s8(maxValue, inputValue);
-                            vst1q_s8(result + index, maxValue);
-                        }
-                        for (; index <= realChannel - 8; index += 8) {
-                            int8x8_t maxValue   = vld1_s8(result + index);
-                            int8x8_t inputValue = vld1_s8(srcCurChannlePtr);
-                            srcCurChannlePtr += 8;
-                            maxValue = vmax_s8(maxValue, inputValue);
-                            vst1_s8(result + index, maxValue);
-                        }
-#endif
-                        for (; index < realChannel; ++index) {
-                            result[index] = std::max(result[index], *srcCurChannlePtr++);
-                        }
-                        srcCurRowPtr += channel;
-                    }
-                }
-
-                int8_t *dstCurPtr = dstPtr + oc + (ox + oy * outputWidth) * channel;
-                memcpy(dstCurPtr, result, sizeof(int8_t) * realChannel);
-            }
-        }
-    }
-}
+typedef void (*PoolInt8Function)(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx,
+                                 size_t ky);
 
-static void poolingAvgNHWCInt8(const Tensor *src, Tensor *dst, int sx, int sy, int kx, int ky, int px, int py) {
+// Output rows of all batches are split to threads, each pixel pools its window clipped by the input
+static void poolingNHWCInt8(PoolInt8Function pool, const Tensor *src, Tensor *dst, int sx, int sy, int kx, int ky,
+                            int px, int py, int tId, int threadNumber) {
     const int inputHeight  = src->length(1);
     const int inputWidth   = src->length(2);
     const int outputHeight = dst->length(1);
     const int outputWidth  = dst->length(2);
     const int channel      = dst->length(3);
-    int16_t result[CACHE_SIZE];
-
-    const auto srcPtr = src->host<int8_t>();
-    auto dstPtr       = dst->host<int8_t>();
-
-    for (int oc = 0; oc < channel; oc += CACHE_SIZE) {
-        const int realChannel = std::min(channel - oc, CACHE_SIZE);
-
-        for (int oy = 0; oy < outputHeight; ++oy) {
-            for (int ox = 0; ox < outputWidth; ++ox) {
-                const int srcOriginX  = ox * sx - px;
-                const int srcOriginY  = oy * sy - py;
-                const int kxs         = std::max(0, -srcOriginX);
-                const int kxe         = std::min(kx, inputWidth - srcOriginX);
-                const int kys         = std::max(0, -srcOriginY);
-                const int kye         = std::min(ky, inputHeight - srcOriginY);
-                const int kernelCount = (kxe - kxs) * (kye - kys);
-
-                const int8_t *srcCurPtr = srcPtr + oc + (srcOriginX + srcOriginY * inputWidth) * channel;
-                memset(result, 0, sizeof(int16_t) * realChannel);
-                for (int y = kys; y < kye; ++y) {
-                    const int8_t *srcCurRowPtr = srcCurPtr + (y * inputWidth + kxs) * channel;
-                    for (int x = kxs; x < kxe; ++x) {
-                        const int8_t *srcCurChannlePtr = srcCurRowPtr;
-                        int index                      = 0;
-#ifdef MNN_USE_NEON
-                        for (; index <= realChannel - 16; index += 16) {
-                            int16x8_t accResult[2];
-                            accResult[0]         = vld1q_s16(result + index);
-                            accResult[1]         = vld1q_s16(result + index + 8);
-                            int8x16_t inputValue = vld1q_s8(srcCurChannlePtr);
-                            srcCurChannlePtr += 16;
-                            accResult[0] = vaddw_s8(accResult[0], vget_low_s8(inputValue));
-                            accResult[1] = vaddw_s8(accResult[1], vget_high_s8(inputValue));
-                            vst1q_s16(result + index, accResult[0]);
-                            vst1q_s16(result + index + 8, accResult[1]);
-                        }
-                        for (; index <= realChannel - 8; index += 8) {
-                            int16x8_t accResult = vld1q_s16(result + index);
-                            int8x8_t inputValue = vld1_s8(srcCurChannlePtr);
-                            srcCurChannlePtr += 8;
-                            accResult = vaddw_s8(accResult, inputValue);
-                            vst1q_s16(result + index, accResult);
-                        }
-#endif
-                        for (; index < realChannel; ++index) {
-                            result[index] += *srcCurChannlePtr++;
-                        }
-                        srcCurRowPtr += channel;
-                    }
-                }
-
-                int8_t *dstCurPtr = dstPtr + oc + (ox + oy * outputWidth) * channel;
-                int index         = 0;
-                for (; index < realChannel; ++index) {
-                    int16_t a = result[index] > 0 ? (result[index] + kernelCount / 2) / kernelCount
-                                                  : (result[index] - kernelCount / 2) / kernelCount;
-                    dstCurPtr[index] = static_cast<int8_t>(a);
-                }
+    const int rows         = dst->length(0) * outputHeight;
+
+    for (int row = tId; row < rows; row += threadNumber) {
+        const int b       = row / outputHeight;
+        const int oy      = row % outputHeight;
+        const auto srcPtr = src->host<int8_t>() + b * inputHeight * inputWidth * channel;
+        auto dstPtr       = dst->host<int8_t>() + row * outputWidth * channel;
+        const int srcOriginY = oy * sy - py;
+        const int kys        = std::max(0, -srcOriginY);
+        const int kye        = std::min(ky, inputHeight - srcOriginY);
+        for (int ox = 0; ox < outputWidth; ++ox) {
+            const int srcOriginX = ox * sx - px;
+            const int kxs        = std::max(0, -srcOriginX);
+            const int kxe        = std::min(kx, inputWidth - srcOriginX);
+            if (kxe <= kxs || kye <= kys) {
+                // The window only covers padding
+                ::memset(dstPtr + ox * channel, 0, channel);
+                continue;
             }
+            const int8_t *srcCurPtr = srcPtr + ((srcOriginY + kys) * inputWidth + srcOriginX + kxs) * channel;
+            pool(dstPtr + ox * channel, srcCurPtr, channel, inputWidth * channel, kxe - kxs, kye - kys);
         }
     }
 }
@@ -186,9 +87,9 @@ ErrorCode CPUPoolInt8::onResize(const std::vector<Tensor *> &inputs, const std::
     }
 
     const int channel = input->channel();
-    auto poolFunc     = poolingMaxNHWCInt8;
+    PoolInt8Function poolFunc = MNNMaxPoolInt8;
     if (mParameter->type() == MNN::PoolType_AVEPOOL) {
-        poolFunc = poolingAvgNHWCInt8;
+        poolFunc = MNNAvgPoolInt8;
     }
     mInputTemp.reset(Tensor::createDevice<int8_t>({input->batch(), inputHeight, inputWidth, channel}));
     mOutputTemp.reset(Tensor::createDevice<int8_t>({output->batch(), outputHeight, outputWidth, channel}));
@@ -199,8 +100,12 @@ ErrorCode CPUPoolInt8::onResize(const std::vector<Tensor *> &inputs, const std::
         return OUT_OF_MEMORY;
     }
 
-    mThreadFunction = [=](const Tensor *src, Tensor *dst) {
-        poolFunc(src, dst, strideWidth, strideHeight, kernelWidth, kernelHeight, padWidth, padHeight);
+    mThreadNumber   = std::max(1, std::min(static_cast<CPUBackend *>(backend())->threadNumber(),
+                                             output->batch() * outputHeight));
+    auto threadNumber = mThreadNumber;
+    mThreadFunction = [=](const Tensor *src, Tensor *dst, int tId) {
+        poolingNHWCInt8(poolFunc, src, dst, strideWidth, strideHeight, kernelWidth, kernelHeight, padWidth, padHeight,
+                        tId, threadNumber);
     };
 
     backend()->onReleaseBuffer(mInputTemp.get(), Backend::DYNAMIC);
@@ -212,7 +117,10 @@ ErrorCode CPUPoolInt8::onExecute(const std::vector<Tensor *> &inputs, const std:
     auto input  = inputs[0];
     auto output = outputs[0];
     backend()->onCopyBuffer(input, mInputTemp.get());
-    mThreadFunction(mInputTemp.get(), mOutputTemp.get());
+    MNN_CONCURRENCY_BEGIN(tId, mThreadNumber) {
+        mThreadFunction(mInputTemp.get(), mOutputTemp.get(), (int)tId);
+    }
+    MNN_CONCURRENCY_END();
     backend()->onCopyBuffer(mOutputTemp.get(), output);
     return NO_ERROR;
 }
@@ -22,7 +22,8 @@ public:
 
 private:
     const Pool *mParameter;
-    std::function<void(const Tensor *src, Tensor *dst)> mThreadFunction;
+    std::function<void(const Tensor *src, Tensor *dst, int tId)> mThreadFunction;
+    int mThreadNumber = 1;
     // nhwc buffer
     std::shared_ptr<Tensor> mInputTemp;
     std::shared_ptr<Tensor> mOutputTemp;
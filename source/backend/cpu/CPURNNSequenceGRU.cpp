@@ -7,98 +7,57 @@
 //
 
 #include "backend/cpu/CPURNNSequenceGRU.hpp"
-#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 #include "backend/cpu/CPUBackend.hpp"
-#include "backend/cpu/compute/ConvOpt.h"
-#include "math/Matrix.hpp"
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#include "math/VecMath.hpp"
+using Vec4     = MNN::Math::Vec<float, 4>;
+using VecMath4 = MNN::Math::VecMath<Vec4, false>;
 
 namespace MNN {
-
-static inline float sigmoid(float x) {
-    return 1. / (1. + expf(-x));
-}
-
-static inline void ArrayProduct(float* C, float* A, float* B, const int length) {
-    int numUnit4 = length >> 2;
-    if (numUnit4 > 0) {
-        MNNMatrixProd(C, A, B, numUnit4, 0, 0, 0, 1);
-    }
-    for (int i = numUnit4 << 2; i < length; i++) {
-        C[i] = A[i] * B[i];
+// C: [UP_DIV(h, 4), cStride, 4], A: packed by _packA, B: packed by MNNPackForMatMul_B
+static void _packedMatMul(const CoreFunctions* core, float* C, const float* A, const float* B, int e, int l, int h,
+                          int eP, int cStride) {
+    size_t parameters[6];
+    parameters[0] = e * sizeof(float);
+    parameters[1] = l;
+    parameters[2] = h;
+    parameters[3] = cStride * 4 * sizeof(float);
+    parameters[4] = 0;
+    parameters[5] = 0;
+    if (e == eP) {
+        core->MNNPackedMatMul(C, A, B, parameters, nullptr, nullptr);
+    } else {
+        core->MNNPackedMatMulRemain(C, A, B, e, parameters, nullptr, nullptr);
     }
-    return;
 }
 
-static inline void ArrayAdd(float* C, float* A, float* B, const int length) {
-    int numUnit4 = length >> 2;
-    if (numUnit4 > 0) {
-        MNNMatrixAdd(C, A, B, numUnit4, 0, 0, 0, 1);
-    }
-    for (int i = numUnit4 << 2; i < length; i++) {
-        C[i] = A[i] + B[i];
-    }
-    return;
+// e rows of [UP_DIV(l, 4), eStride, 4] -> A of MNNPackedMatMul
+static void _packA(const CoreFunctions* core, float* dst, const float* src, int eStride, int e, int l) {
+    int32_t info[4]   = {1, eStride, e, 1};
+    int32_t stride[4] = {e, l, 0, 0};
+    core->MNNPackC4ForMatMul_A(dst, &src, info, stride);
 }
 
+// Gate g of unit j -> column of the reordered gates, which keep gateNumber gates per 4 units
+static inline int _gateColumn(int g, int j, int gateNumber) {
+    return ((j / 4) * gateNumber + g) * 4 + j % 4;
+}
 
-
-// implement GRU cell function
-// Ref: tensorflow/python/ops/rnn_cell_impl.py
-static void runRNNStep(const float* input, const int inputLength, const bool linearBeforeReset, std::shared_ptr<Tensor>& hiddenState,
-                       const int numUnits, Tensor* gateWeight, Tensor* gateBias,
-                       Tensor* candidateWeight, Tensor* candidateBias,
-                       Tensor* recurrentBias,
-                       std::shared_ptr<Tensor>& inputAndState, std::shared_ptr<Tensor>& gate) {
-    // gate is (r_t, z_t)
-    auto inputAndStatePtr = inputAndState->host<float>();
-    auto hiddenStatePtr   = hiddenState->host<float>();
-    ::memcpy(inputAndStatePtr, input, inputLength * sizeof(float));
-    ::memcpy(inputAndStatePtr + inputLength, hiddenStatePtr, numUnits * sizeof(float));
-
-    inputAndState->setLength(1, inputLength + numUnits);
-
-    // to be fused:
-    Math::Matrix::multi(gate.get(), inputAndState.get(), gateWeight);
-    Math::Matrix::add(gate.get(), gate.get(), gateBias);
-    recurrentBias->setLength(1, 2 * numUnits);
-    Math::Matrix::add(gate.get(), gate.get(), recurrentBias);
-    const int gateSize = gate->elementSize();
-    auto gatePtr       = gate->host<float>();
-    for (int i = 0; i < gateSize; ++i) {
-        gatePtr[i] = sigmoid(gatePtr[i]);
-    }
-
-
-    // reset gate
-    auto resetGatePtr = inputAndStatePtr + inputLength;
-    ArrayProduct(resetGatePtr, gatePtr, hiddenStatePtr, numUnits);
-
-    // deal with recurrent bias and linear_before_reset parameter
-    auto recurrentBiasAddedPtr = inputAndStatePtr + inputLength + numUnits;
-    auto recurrentHiddenBiasPtr = recurrentBias->host<float>() + 2 * numUnits;
-    if (linearBeforeReset) {
-        ArrayProduct(recurrentBiasAddedPtr, gatePtr, recurrentHiddenBiasPtr, numUnits);
-        ArrayAdd(recurrentBiasAddedPtr, recurrentBiasAddedPtr, candidateBias->host<float>(), numUnits);
-    } else {
-        ArrayAdd(recurrentBiasAddedPtr, recurrentHiddenBiasPtr, candidateBias->host<float>(), numUnits);
-    }
-
-    // use r_t to apply Matrix multi and add
-    gate->setLength(1, numUnits);
-    Math::Matrix::multi(gate.get(), inputAndState.get(), candidateWeight);
-    // Math::Matrix::add(gate.get(), gate.get(), candidateBias.get());
-    ArrayAdd(gatePtr, gatePtr, recurrentBiasAddedPtr, numUnits);
-
-    for (int i = 0; i < numUnits; ++i) {
-        hiddenStatePtr[i] =
-            // gatePtr[numUnits + i] * hiddenStatePtr[i] + (1.0 - gatePtr[numUnits + i]) * tanhf(gatePtr[i]);
-
-            // should be h_t = (1- z_t)*h_t_1 + z_t *(~h_t);
-            (1 - gatePtr[numUnits + i]) * hiddenStatePtr[i] + gatePtr[numUnits + i] * tanhf(gatePtr[i]);
+// Split the unit blocks of a step to threads, each part computes gates aligned to hP
+static void _unitRange(int tId, int threadNumber, int unitBlocks, int gatesPerBlock, int hP, int& u0, int& u1) {
+    int granule = 1;
+    while ((granule * gatesPerBlock) % hP != 0) {
+        granule++;
     }
-    // reset gate shape fot the next iteration
-    gate->setLength(1, 2 * numUnits);
-    inputAndState->setLength(1, inputLength + 2 * numUnits);
+    int granules = UP_DIV(unitBlocks, granule);
+    u0           = std::min(tId * granules / threadNumber * granule, unitBlocks);
+    u1           = std::min((tId + 1) * granules / threadNumber * granule, unitBlocks);
 }
 
 CPURNNSequenceGRU::CPURNNSequenceGRU(const Op* op, Backend* backend) : MNN::Execution(backend) {
@@ -107,139 +66,255 @@ CPURNNSequenceGRU::CPURNNSequenceGRU(const Op* op, Backend* backend) : MNN::Exec
     mIsBidirectionalRNN = rnnParam->isBidirectionalRNN();
     mNumUnits           = rnnParam->numUnits();
     mlinearBeforeReset  = rnnParam->linearBeforeReset();
-    // MNN_PRINT("mKeepAllOutputs:%d, mNumUnits:%d, mlinearBeforeReset:%d", mKeepAllOutputs, mNumUnits, mlinearBeforeReset);
-    // auto copyData = [=](std::shared_ptr<Tensor>& tensor, const Blob* src) {
-    //     std::vector<int> shape;
-    //     for (int i = 0; i < src->dims()->size(); ++i) {
-    //         shape.push_back(src->dims()->data()[i]);
-    //     }
-    //     tensor.reset(Tensor::createDevice<float>(shape));
-    //     backend->onAcquireBuffer(tensor.get(), Backend::STATIC);
-    //     ::memcpy(tensor->host<float>(), src->float32s()->data(), src->float32s()->size() * sizeof(float));
-    // };
-    // copyData(mFwGateWeight, rnnParam->fwGateWeight());
-    // copyData(mFwGateBias, rnnParam->fwGateBias());
-    // copyData(mFwCandidateWeight, rnnParam->fwCandidateWeight());
-    // copyData(mFwCandidateBias, rnnParam->fwCandidateBias());
-    // copyData(mFwRecurrentBias, rnnParam->fwRecurrentBias());
-    // MNN_ASSERT(mFwCandidateBias->length(0) == mNumUnits);
-    // if (mIsBidirectionalRNN) {
-    //     copyData(mBwGateWeight, rnnParam->bwGateWeight());
-    //     copyData(mBwGateBias, rnnParam->bwGateBias());
-    //     copyData(mBwCandidateWeight, rnnParam->bwCandidateWeight());
-    //     copyData(mBwCandidateBias, rnnParam->bwCandidateBias());
-    //     copyData(mBwRecurrentBias, rnnParam->bwRecurrentBias());
-    // }
 }
 
 CPURNNSequenceGRU::~CPURNNSequenceGRU() {
-    // backend()->onReleaseBuffer(mFwGateWeight.get(), Backend::STATIC);
-    // backend()->onReleaseBuffer(mFwGateBias.get(), Backend::STATIC);
-    // backend()->onReleaseBuffer(mFwCandidateWeight.get(), Backend::STATIC);
-    // backend()->onReleaseBuffer(mFwCandidateBias.get(), Backend::STATIC);
-    // if (mIsBidirectionalRNN) {
-    //     backend()->onReleaseBuffer(mBwGateWeight.get(), Backend::STATIC);
-    //     backend()->onReleaseBuffer(mBwGateBias.get(), Backend::STATIC);
-    //     backend()->onReleaseBuffer(mBwCandidateWeight.get(), Backend::STATIC);
-    //     backend()->onReleaseBuffer(mBwCandidateBias.get(), Backend::STATIC);
-    // }
+    _releaseWeights();
 }
 
-ErrorCode CPURNNSequenceGRU::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
-
-    MNN_ASSERT(1 + 5 * (mIsBidirectionalRNN + 1) <= inputs.size());
-    auto input                 = inputs[0];
-    const int inputLastDimSize = input->length(2);
-    mHiddenState.reset(Tensor::createDevice<float>(std::vector<int>{1, mNumUnits}));
-    mInputAndState.reset(Tensor::createDevice<float>(std::vector<int>{1, inputLastDimSize + mNumUnits + mNumUnits}));
-    mGate.reset(Tensor::createDevice<float>(std::vector<int>{1, 2 * mNumUnits}));
-
-    backend()->onAcquireBuffer(mHiddenState.get(), Backend::DYNAMIC);
-    backend()->onAcquireBuffer(mInputAndState.get(), Backend::DYNAMIC);
-    backend()->onAcquireBuffer(mGate.get(), Backend::DYNAMIC);
-
-    backend()->onReleaseBuffer(mHiddenState.get(), Backend::DYNAMIC);
-    backend()->onReleaseBuffer(mInputAndState.get(), Backend::DYNAMIC);
-    backend()->onReleaseBuffer(mGate.get(), Backend::DYNAMIC);
-
-    return NO_ERROR;
+void CPURNNSequenceGRU::_releaseWeights() {
+    if (nullptr != mWeight) {
+        for (auto t : {mWeight.get(), mRecurrent.get(), mCandidate.get(), mBias.get()}) {
+            backend()->onReleaseBuffer(t, Backend::STATIC);
+        }
+    }
+    mWeight      = nullptr;
+    mRecurrent   = nullptr;
+    mCandidate   = nullptr;
+    mBias        = nullptr;
+    mWeightReady = false;
 }
 
-ErrorCode CPURNNSequenceGRU::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
-
-    // MNN_PRINT("onExecute backend CPURNNSequenceGRU input:%lu, output:%lu. input0 dims:%d \n", inputs.size(), outputs.size(), inputs[0]->dimensions());
-    auto fwGateWeight = inputs[1];
-    auto fwGateBias = inputs[2];
-    auto fwCandidateWeight = inputs[3];
-    auto fwCandidateBias = inputs[4];
-    auto fwRecurrentBias = inputs[5];
-
-    fwGateWeight->printShape();// mFwGateWeight
-    fwGateBias->printShape();// mFwGateBias
-    fwCandidateWeight->printShape();// mFwCandidateWeight
-    fwCandidateBias->printShape();// mFwCandidateBias
-    fwRecurrentBias->printShape();// mFwRecurrentBias
-
-    // firstly set the hidden state to zero
-    float* const hiddenStatePtr   = mHiddenState->host<float>();
-    const int hiddenStateDataSize = mHiddenState->size();
-    ::memset(hiddenStatePtr, 0, hiddenStateDataSize);
+void CPURNNSequenceGRU::_packWeights(const std::vector<Tensor*>& inputs) {
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    const int units = mNumUnits;
+    const int hU    = ALIGN_UP4(units);
+    const int input = mInputSize;
+    std::vector<float> temp(3 * hU * std::max(input, units));
+    for (int d = 0; d < mDirections; ++d) {
+        // gateWeight: [input + units, 2 * units] of [r, z], candidateWeight: [input + units, units]
+        // gateBias: [2 * units], candidateBias: [units], recurrentBias: [3 * units]
+        auto gateWeight      = inputs[1 + 5 * d]->host<float>();
+        auto gateBias        = inputs[2 + 5 * d]->host<float>();
+        auto candidateWeight = inputs[3 + 5 * d]->host<float>();
+        auto candidateBias   = inputs[4 + 5 * d]->host<float>();
+        auto recurrentBias   = inputs[5 + 5 * d]->host<float>();
+
+        ::memset(temp.data(), 0, temp.size() * sizeof(float));
+        for (int k = 0; k < input; ++k) {
+            auto dst = temp.data() + k * 3 * hU;
+            for (int j = 0; j < units; ++j) {
+                dst[_gateColumn(0, j, 3)] = gateWeight[k * 2 * units + j];
+                dst[_gateColumn(1, j, 3)] = gateWeight[k * 2 * units + units + j];
+                dst[_gateColumn(2, j, 3)] = candidateWeight[k * units + j];
+            }
+        }
+        core->MNNPackForMatMul_B(mWeight->host<float>() + d * mWeight->length(1), temp.data(), 3 * hU, input, false);
+
+        ::memset(temp.data(), 0, temp.size() * sizeof(float));
+        for (int k = 0; k < units; ++k) {
+            auto src = gateWeight + (input + k) * 2 * units;
+            auto dst = temp.data() + k * 2 * hU;
+            for (int j = 0; j < units; ++j) {
+                dst[_gateColumn(0, j, 2)] = src[j];
+                dst[_gateColumn(1, j, 2)] = src[units + j];
+            }
+        }
+        core->MNNPackForMatMul_B(mRecurrent->host<float>() + d * mRecurrent->length(1), temp.data(), 2 * hU, units,
+                                 false);
 
-    auto input                    = inputs[0];
-    auto output                   = outputs[0];
-    float* const inputPtr         = input->host<float>();
-    float* const outputPtr        = output->host<float>();
-    const int batchSize           = input->length(0);
-    const int batchStride         = input->stride(0);
-    const int inputSequenceLength = input->length(1);
-    const int inputCodeLength     = input->length(2);
+        ::memset(temp.data(), 0, temp.size() * sizeof(float));
+        for (int k = 0; k < units; ++k) {
+            ::memcpy(temp.data() + k * hU, candidateWeight + (input + k) * units, units * sizeof(float));
+        }
+        core->MNNPackForMatMul_B(mCandidate->host<float>() + d * mCandidate->length(1), temp.data(), hU, units,
+                                 false);
+
+        auto bias = mBias->host<float>() + d * 4 * hU;
+        ::memset(bias, 0, 4 * hU * sizeof(float));
+        for (int j = 0; j < units; ++j) {
+            bias[_gateColumn(0, j, 2)] = gateBias[j] + recurrentBias[j];
+            bias[_gateColumn(1, j, 2)] = gateBias[units + j] + recurrentBias[units + j];
+            bias[2 * hU + j]           = candidateBias[j];
+            bias[3 * hU + j]           = recurrentBias[2 * units + j];
+        }
+    }
+}
 
-    for (int b = 0; b < batchSize; ++b) {
-        for (int i = 0; i < inputSequenceLength; ++i) {
-            const int inputOffset = b * batchStride + i * inputCodeLength;
-            runRNNStep(inputPtr + inputOffset, inputCodeLength, mlinearBeforeReset, mHiddenState, mNumUnits, fwGateWeight, fwGateBias,
-                       fwCandidateWeight, fwCandidateBias, fwRecurrentBias, mInputAndState, mGate);
-            if (mKeepAllOutputs) {
-                ::memcpy(outputPtr + b * output->stride(0) + i * mNumUnits, hiddenStatePtr, hiddenStateDataSize);
+ErrorCode CPURNNSequenceGRU::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    // X: [seqLength, batch, input]
+    mDirections = mIsBidirectionalRNN ? 2 : 1;
+    MNN_ASSERT(1 + 5 * mDirections <= inputs.size());
+    auto input = inputs[0];
+    mSeqLength = input->length(0);
+    mBatch     = input->length(1);
+    mInputSize = input->length(2);
+    MNN_ASSERT(inputs[1]->length(0) == mInputSize + mNumUnits);
+    const int hU = ALIGN_UP4(mNumUnits);
+
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    MNN_ASSERT(1 == lP);
+    int weightSize    = UP_DIV(3 * hU, hP) * hP * mInputSize;
+    int recurrentSize = UP_DIV(2 * hU, hP) * hP * mNumUnits;
+    int candidateSize = UP_DIV(hU, hP) * hP * mNumUnits;
+    if (nullptr == mWeight || mWeight->length(0) != mDirections || mWeight->length(1) != weightSize) {
+        _releaseWeights();
+        mWeight.reset(Tensor::createDevice<float>({mDirections, weightSize}));
+        mRecurrent.reset(Tensor::createDevice<float>({mDirections, recurrentSize}));
+        mCandidate.reset(Tensor::createDevice<float>({mDirections, candidateSize}));
+        mBias.reset(Tensor::createDevice<float>({mDirections, 4 * hU}));
+        for (auto t : {mWeight.get(), mRecurrent.get(), mCandidate.get(), mBias.get()}) {
+            if (!backend()->onAcquireBuffer(t, Backend::STATIC)) {
+                return OUT_OF_MEMORY;
             }
         }
     }
+    mWeightConst = true;
+    for (int i = 1; i < 1 + 5 * mDirections; ++i) {
+        if (TensorUtils::getDescribe(inputs[i])->usage != Tensor::InsideDescribe::CONSTANT) {
+            mWeightConst = false;
+        }
+    }
+    if (mWeightConst && !mWeightReady) {
+        _packWeights(inputs);
+        mWeightReady = true;
+    }
 
-    if (!mKeepAllOutputs) {
-        float* const outputPtr = outputs[1]->host<float>();
-        ::memcpy(outputPtr, hiddenStatePtr, hiddenStateDataSize);
+    int numberThread = static_cast<CPUBackend*>(backend())->threadNumber();
+    mGates.reset(Tensor::createDevice<float>({3 * hU * mSeqLength * mBatch}));
+    mState.reset(Tensor::createDevice<float>({2, hU * mBatch}));
+    mRecurrentGates.reset(Tensor::createDevice<float>({3, hU * mBatch}));
+    mCache.reset(Tensor::createDevice<float>({numberThread, eP * (ALIGN_UP4(mInputSize) + mInputSize + mNumUnits)}));
+    for (auto t : {mGates.get(), mState.get(), mRecurrentGates.get(), mCache.get()}) {
+        if (!backend()->onAcquireBuffer(t, Backend::DYNAMIC)) {
+            return OUT_OF_MEMORY;
+        }
+    }
+    for (auto t : {mGates.get(), mState.get(), mRecurrentGates.get(), mCache.get()}) {
+        backend()->onReleaseBuffer(t, Backend::DYNAMIC);
     }
-    // backward rnn
-    if (mIsBidirectionalRNN) {
-        // todo: modify the inputOffset
-        MNN_ASSERT(11 <= inputs.size());
-        auto bwGateWeight = inputs[6];
-        auto bwGateBias = inputs[7];
-        auto bwCandidateWeight = inputs[8];
-        auto bwCandidateBias = inputs[9];
-        auto bwRecurrentBias = inputs[10];
+    return NO_ERROR;
+}
 
-        ::memset(hiddenStatePtr, 0, hiddenStateDataSize);
-        auto outputBw            = outputs[1];
-        float* const outputBwPtr = outputBw->host<float>();
-        for (int b = 0; b < batchSize; ++b) {
-            for (int i = inputSequenceLength - 1; i >= 0; i--) {
-                const int inputOffset = b * batchStride + i * inputCodeLength;
-                runRNNStep(inputPtr + inputOffset, inputCodeLength, mlinearBeforeReset, mHiddenState, mNumUnits, bwGateWeight, bwGateBias,
-                           bwCandidateWeight, bwCandidateBias, bwRecurrentBias, mInputAndState, mGate);
-                if (mKeepAllOutputs) {
-                    ::memcpy(outputBwPtr + b * outputBw->stride(0) + (inputSequenceLength - 1 - i) * mNumUnits,
-                             hiddenStatePtr, hiddenStateDataSize);
+ErrorCode CPURNNSequenceGRU::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    if (!mWeightReady) {
+        _packWeights(inputs);
+        mWeightReady = mWeightConst;
+    }
+    auto core = MNNGetCoreFunctions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    int numberThread = static_cast<CPUBackend*>(backend())->threadNumber();
+    const int units  = mNumUnits;
+    const int hU     = ALIGN_UP4(units);
+    const int batch  = mBatch;
+    const int total  = mSeqLength * batch;
+    const int blocks = hU / 4;
+    auto xPtr        = inputs[0]->host<float>();
+    // output: [seqLength, directions, batch, units], or [1, directions, batch, units] for the last hidden
+    auto yPtr        = outputs[0]->host<float>();
+    auto gates       = mGates->host<float>();
+    auto hidden      = mState->host<float>();
+    auto resetHidden = hidden + hU * batch;
+    auto rzGates     = mRecurrentGates->host<float>();
+    auto candidates  = rzGates + 2 * hU * batch;
+    auto cacheSize   = mCache->length(1);
+    auto packedASize = eP * (ALIGN_UP4(mInputSize) + mInputSize);
+
+    for (int d = 0; d < mDirections; ++d) {
+        auto weight    = mWeight->host<float>() + d * mWeight->length(1);
+        auto recurrent = mRecurrent->host<float>() + d * mRecurrent->length(1);
+        auto candidate = mCandidate->host<float>() + d * mCandidate->length(1);
+        auto bias      = mBias->host<float>() + d * 4 * hU;
+        // Input projection of all timesteps
+        MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+            auto transposed = mCache->host<float>() + tId * cacheSize;
+            auto packA      = transposed + eP * ALIGN_UP4(mInputSize);
+            for (int e0 = (int)tId * eP; e0 < total; e0 += numberThread * eP) {
+                int e = std::min(eP, total - e0);
+                core->MNNPackCUnitTranspose(transposed, xPtr + e0 * mInputSize, e, mInputSize);
+                _packA(core, packA, transposed, e, e, mInputSize);
+                _packedMatMul(core, gates + e0 * 4, packA, weight, e, mInputSize, 3 * hU, eP, total);
+            }
+        }
+        MNN_CONCURRENCY_END();
+
+        ::memset(hidden, 0, hU * batch * sizeof(float));
+        for (int step = 0; step < mSeqLength; ++step) {
+            int t = 0 == d ? step : mSeqLength - 1 - step;
+            // r = sigmoid(x * Wr + h * Rr + br), z = sigmoid(x * Wz + h * Rz + bz), resetHidden = r * h
+            MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+                int u0, u1;
+                _unitRange((int)tId, numberThread, blocks, 8, hP, u0, u1);
+                if (u0 < u1) {
+                    auto packA = mCache->host<float>() + tId * cacheSize + packedASize;
+                    for (int b0 = 0; b0 < batch; b0 += eP) {
+                        int e = std::min(eP, batch - b0);
+                        _packA(core, packA, hidden + b0 * 4, batch, e, units);
+                        _packedMatMul(core, rzGates + u0 * 2 * batch * 4 + b0 * 4, packA,
+                                      recurrent + (u0 * 8 / hP) * units * hP, e, units, (u1 - u0) * 8, eP, batch);
+                    }
+                    for (int u = u0; u < u1; ++u) {
+                        for (int b = 0; b < batch; ++b) {
+                            auto pre = gates + (u * 3 * total + t * batch + b) * 4;
+                            auto rec = rzGates + (u * 2 * batch + b) * 4;
+                            auto r   = VecMath4::sigmoid(Vec4::load(pre) + Vec4::load(rec) + Vec4::load(bias + u * 8));
+                            auto z   = VecMath4::sigmoid(Vec4::load(pre + total * 4) + Vec4::load(rec + batch * 4) +
+                                                       Vec4::load(bias + u * 8 + 4));
+                            Vec4::save(rec, r);
+                            Vec4::save(rec + batch * 4, z);
+                            auto offset = (u * batch + b) * 4;
+                            Vec4::save(resetHidden + offset, r * Vec4::load(hidden + offset));
+                        }
+                    }
                 }
             }
+            MNN_CONCURRENCY_END();
+            // c = tanh(x * Wc + resetHidden * Rc + bias), h = (1 - z) * h + z * c
+            MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+                int u0, u1;
+                _unitRange((int)tId, numberThread, blocks, 4, hP, u0, u1);
+                if (u0 < u1) {
+                    auto packA = mCache->host<float>() + tId * cacheSize + packedASize;
+                    for (int b0 = 0; b0 < batch; b0 += eP) {
+                        int e = std::min(eP, batch - b0);
+                        _packA(core, packA, resetHidden + b0 * 4, batch, e, units);
+                        _packedMatMul(core, candidates + u0 * batch * 4 + b0 * 4, packA,
+                                      candidate + (u0 * 4 / hP) * units * hP, e, units, (u1 - u0) * 4, eP, batch);
+                    }
+                    for (int u = u0; u < u1; ++u) {
+                        auto wb = Vec4::load(bias + 2 * hU + u * 4);
+                        auto rb = Vec4::load(bias + 3 * hU + u * 4);
+                        for (int b = 0; b < batch; ++b) {
+                            auto pre = gates + ((u * 3 + 2) * total + t * batch + b) * 4;
+                            auto rec = rzGates + (u * 2 * batch + b) * 4;
+                            auto r   = Vec4::load(rec);
+                            auto z   = Vec4::load(rec + batch * 4);
+                            auto cb  = mlinearBeforeReset ? r * rb + wb : rb + wb;
+                            auto c   = VecMath4::tanh(Vec4::load(pre) + Vec4::load(candidates + (u * batch + b) * 4) + cb);
+                            auto hPtr = hidden + (u * batch + b) * 4;
+                            auto h    = (Vec4(1.0f) - z) * Vec4::load(hPtr) + z * c;
+                            Vec4::save(hPtr, h);
+                            if (mKeepAllOutputs) {
+                                auto y = yPtr + ((t * mDirections + d) * batch + b) * units + u * 4;
+                                for (int k = 0; k < 4 && u * 4 + k < units; ++k) {
+                                    y[k] = h[k];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            MNN_CONCURRENCY_END();
         }
-
         if (!mKeepAllOutputs) {
-            float* const outputBwPtr = outputs[1]->host<float>();
-            ::memcpy(outputBwPtr, hiddenStatePtr, hiddenStateDataSize);
+            core->MNNUnpackCUnitTranspose(yPtr + d * batch * units, hidden, batch, units);
         }
     }
-
     return NO_ERROR;
 }
 
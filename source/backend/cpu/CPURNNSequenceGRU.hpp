@@ -12,7 +12,8 @@
 #include "core/Execution.hpp"
 
 namespace MNN {
-
+// One GEMM projects the input of all timesteps, then each step runs the recurrent GEMMs of reset / update gates and
+// candidate and updates the units it computed. Gate columns are reordered per 4 units, hU = ALIGN_UP4(numUnits)
 class CPURNNSequenceGRU : public Execution {
 public:
     CPURNNSequenceGRU(const Op *op, Backend *backend);
@@ -21,26 +22,35 @@ public:
     virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
 
 private:
+    void _packWeights(const std::vector<Tensor *> &inputs);
+    void _releaseWeights();
+
     bool mKeepAllOutputs;
     bool mIsBidirectionalRNN;
     bool mlinearBeforeReset;
     int mNumUnits;
-
-    std::shared_ptr<Tensor> mHiddenState;
-    std::shared_ptr<Tensor> mInputAndState;
-    std::shared_ptr<Tensor> mGate;
-    // forward weight and bias
-    std::shared_ptr<Tensor> mFwGateWeight;
-    std::shared_ptr<Tensor> mFwGateBias;
-    std::shared_ptr<Tensor> mFwCandidateWeight;
-    std::shared_ptr<Tensor> mFwCandidateBias;
-    std::shared_ptr<Tensor> mFwRecurrentBias; // in onnx format, there is 'recurrentBias' for h_t beside weight bias(gateBias and candidateBias)
-    // backward weight and bias
-    std::shared_ptr<Tensor> mBwGateWeight;
-    std::shared_ptr<Tensor> mBwGateBias;
-    std::shared_ptr<Tensor> mBwCandidateWeight;
-    std::shared_ptr<Tensor> mBwCandidateBias;
-    std::shared_ptr<Tensor> mBwRecurrentBias;
+    int mSeqLength  = 0;
+    int mBatch      = 0;
+    int mInputSize  = 0;
+    int mDirections = 1;
+    // Weights are constant and have been packed
+    bool mWeightConst = false;
+    bool mWeightReady = false;
+    // Per direction, packed as B of MNNPackedMatMul: input weight of [r, z, c] per 4 units, recurrent weight of
+    // [r, z] per 4 units and recurrent weight of candidate
+    std::shared_ptr<Tensor> mWeight;
+    std::shared_ptr<Tensor> mRecurrent;
+    std::shared_ptr<Tensor> mCandidate;
+    // Per direction: bias of [r, z] per 4 units, candidate bias, recurrent candidate bias
+    std::shared_ptr<Tensor> mBias;
+    // Input projection of all timesteps: [3 * hU / 4, seqLength * batch, 4]
+    std::shared_ptr<Tensor> mGates;
+    // Hidden and reset hidden: [hU / 4, batch, 4] each
+    std::shared_ptr<Tensor> mState;
+    // Recurrent projection of a step: [2 * hU / 4, batch, 4] for [r, z] and [hU / 4, batch, 4] for candidate
+    std::shared_ptr<Tensor> mRecurrentGates;
+    // Per thread: transposed input, packed input and packed hidden
+    std::shared_ptr<Tensor> mCache;
 };
 
 } // namespace MNN
@@ -14,11 +14,11 @@
 #include "core/Concurrency.h"
 using Vec4 = MNN::Math::Vec<float, 4>;
 namespace MNN {
-static bool _canBlitFast(const Tensor::InsideDescribe::Region& region, const Tensor* dest) {
-    return OpCommonUtils::canBlitFast(region, dest, 4);
+static bool _canBlitFast(const Tensor::InsideDescribe::Region& region, const Tensor* dest, int pack) {
+    return OpCommonUtils::canBlitFast(region, dest, pack);
 }
-static void _turnToC4Region(const Tensor::InsideDescribe::Region& region, Tensor::InsideDescribe::Region& c4Region, const Tensor* dest) {
-    return OpCommonUtils::turnToPackRegion(region, c4Region, dest, 4);
+static void _turnToC4Region(const Tensor::InsideDescribe::Region& region, Tensor::InsideDescribe::Region& c4Region, const Tensor* dest, int pack) {
+    return OpCommonUtils::turnToPackRegion(region, c4Region, dest, pack);
 }
 static void getBatchChannelArea(const Tensor* t, int& batch, int& channel, int& area) {
     batch = t->batch();
@@ -128,6 +128,31 @@ static int _singleConvert(const Tensor::InsideDescribe::Region& region, const Te
     return res;
 }
 
+// Split the region along one dimension to at most number parts
+static void _splitRegion(const Tensor::InsideDescribe::Region& region, int number, std::vector<Tensor::InsideDescribe::Region>& parts) {
+    int dim = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (region.size[dim] < number && region.size[i] > region.size[dim]) {
+            dim = i;
+        }
+    }
+    auto step = UP_DIV(region.size[dim], number);
+    for (int start = 0; start < region.size[dim]; start += step) {
+        auto part = region;
+        part.size[dim] = std::min(step, region.size[dim] - start);
+        part.src.offset += start * region.src.stride[dim];
+        part.dst.offset += start * region.dst.stride[dim];
+        parts.emplace_back(part);
+    }
+}
+
+// Regions are copied one per thread, split the big ones if they are fewer than threads
+static bool _needSplit(const Tensor::InsideDescribe::Region& region, int regionNumber, int threadNumber) {
+    static const int gSplitSize = 4096;
+    return threadNumber > 1 && regionNumber < threadNumber && nullptr == region.offset &&
+           region.size[0] * region.size[1] * region.size[2] >= gSplitSize;
+}
+
 ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
     MNN_ASSERT(inputs.size() == 1);
     MNN_ASSERT(outputs.size() == 1);
@@ -144,6 +169,7 @@ ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::ve
     mTempInputCopy.clear();
     mOutputPtr = output->host<void>();
     mFast = false;
+    auto pack = static_cast<CPUBackend*>(backend())->functions()->pack;
     // all_srcFormat == dstFormat == NC4HW4 : Fast Exe
     if (outputDes->dimensionFormat == MNN_DATA_FORMAT_NC4HW4) {
         mFast = true;
@@ -153,19 +179,29 @@ ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::ve
                 mFast = false;
                 break;
             }
-            if (!_canBlitFast(slice, output)) {
+            if (!_canBlitFast(slice, output, pack)) {
                 mFast = false;
                 break;
             }
         }
         if (mFast) {
+            auto threadNumber = static_cast<CPUBackend*>(backend())->threadNumber();
+            std::vector<Tensor::InsideDescribe::Region> parts;
             for (int i=0; i< des->regions.size(); ++i) {
                 auto& slice = des->regions[i];
                 if (slice.origin == nullptr) {
                     continue;
                 }
                 Tensor::InsideDescribe::Region newRegion;
-                _turnToC4Region(slice, newRegion, output);
+                _turnToC4Region(slice, newRegion, output, pack);
+                if (_needSplit(newRegion, (int)des->regions.size(), threadNumber)) {
+                    parts.clear();
+                    _splitRegion(newRegion, threadNumber, parts);
+                    for (auto& part : parts) {
+                        mFastBlit.emplace_back(std::make_pair(slice.origin->host<void>(), part));
+                    }
+                    continue;
+                }
                 mFastBlit.emplace_back(std::make_pair(slice.origin->host<void>(), std::move(newRegion)));
             }
             return NO_ERROR;
@@ -186,8 +222,8 @@ ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::ve
         if (TensorUtils::getDescribe(origin)->dimensionFormat != MNN_DATA_FORMAT_NC4HW4) {
             continue;
         }
-        // if NC4HW4's C%4 == 0, change convert to transpose and fuse it
-        if (origin->batch() == 1 && origin->channel() % 4 == 0) {
+        // if NC4HW4's C%pack == 0, change convert to transpose and fuse it
+        if (origin->batch() == 1 && origin->channel() % pack == 0) {
             int channel = origin->channel();
             int area = 1;
             if (origin->dimensions() == 4) {
@@ -200,15 +236,15 @@ ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::ve
             }
             auto regionTmp = slice;
             regionTmp.src.offset = 0;
-            regionTmp.src.stride[0] = area * 4;
+            regionTmp.src.stride[0] = area * pack;
             regionTmp.src.stride[1] = 1;
-            regionTmp.src.stride[2] = 4;
+            regionTmp.src.stride[2] = pack;
             regionTmp.dst.offset = 0;
-            regionTmp.dst.stride[0] = area * 4;
+            regionTmp.dst.stride[0] = area * pack;
             regionTmp.dst.stride[1] = area;
             regionTmp.dst.stride[2] = 1;
-            regionTmp.size[0] = channel / 4;
-            regionTmp.size[1] = 4;
+            regionTmp.size[0] = channel / pack;
+            regionTmp.size[1] = pack;
             regionTmp.size[2] = area;
             bool merge = TensorUtils::fuseRegion(regionTmp, slice);
             if (merge) {
@@ -262,6 +298,30 @@ ErrorCode CPURaster::onResize(const std::vector<Tensor *> &inputs, const std::ve
         mTempInputCopy.emplace_back(std::make_pair(slice.origin->host<void>(), &slice));
         MNN_ASSERT(mTempInputCopy[i].first != nullptr);
     }
+    auto threadNumber = static_cast<CPUBackend*>(backend())->threadNumber();
+    mSplitRegions.clear();
+    std::vector<std::pair<void*, Tensor::InsideDescribe::Region*>> copies;
+    std::vector<int> splitIndex;
+    for (auto& iter : mTempInputCopy) {
+        if (!_needSplit(*iter.second, (int)mTempInputCopy.size(), threadNumber)) {
+            copies.emplace_back(iter);
+            splitIndex.emplace_back(-1);
+            continue;
+        }
+        auto start = mSplitRegions.size();
+        _splitRegion(*iter.second, threadNumber, mSplitRegions);
+        for (auto index = start; index < mSplitRegions.size(); ++index) {
+            copies.emplace_back(std::make_pair(iter.first, nullptr));
+            splitIndex.emplace_back((int)index);
+        }
+    }
+    // mSplitRegions won't grow any more, take the addresses
+    for (int i = 0; i < copies.size(); ++i) {
+        if (splitIndex[i] >= 0) {
+            copies[i].second = mSplitRegions.data() + splitIndex[i];
+        }
+    }
+    mTempInputCopy = std::move(copies);
     return NO_ERROR;
 }
 static void _transpose4Bit(int32_t* dstO, const int32_t* srcO, const Tensor::InsideDescribe::Region& region) {
@@ -342,6 +402,15 @@ static void _1BitcopyWithStrideC4(uint8_t* dstO, const uint8_t* srcO, int size,
         dst+=ds;
     }
 }
+
+// For pack other than 4, unitBytes = pack * bytes
+static void _copyWithStrideUnit(uint8_t* dstO, const uint8_t* srcO, int size, int stride, int ds, int unitBytes) {
+    for (int i=0; i<size; ++i) {
+        ::memcpy(dstO, srcO, unitBytes);
+        srcO += stride * unitBytes;
+        dstO += ds * unitBytes;
+    }
+}
 void CPURaster::executeFaster(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) const {
     auto input = inputs[0];
     auto output = outputs[0];
@@ -350,8 +419,9 @@ void CPURaster::executeFaster(const std::vector<Tensor *> &inputs, const std::ve
         bytes = mFixBytes;
     }
     auto threadNum = static_cast<CPUBackend*>(backend())->threadNumber();
+    auto pack = static_cast<CPUBackend*>(backend())->functions()->pack;
     if (mNeedZero) {
-        ::memset(output->host<void>(), 0, output->elementSize() * bytes);
+        ::memset(output->host<void>(), 0, static_cast<CPUBackend*>(backend())->getTensorSize(output) * bytes);
     }
     auto C4proc = _1BitcopyWithStrideC4;
     switch (bytes) {
@@ -368,7 +438,7 @@ void CPURaster::executeFaster(const std::vector<Tensor *> &inputs, const std::ve
             MNN_ASSERT(false);
             break;
     }
-    auto byteC4 = bytes * 4;
+    auto byteC4 = bytes * pack;
     MNN_CONCURRENCY_BEGIN(tId, threadNum) {
         for (int u=(int)tId; u<mFastBlit.size(); u+=threadNum) {
             auto& iter = mFastBlit[u];
@@ -402,7 +472,11 @@ void CPURaster::executeFaster(const std::vector<Tensor *> &inputs, const std::ve
                 for (int y=0; y<slice.size[1]; ++y) {
                     auto srcY = srcZ + y * slice.src.stride[1] * byteC4;
                     auto dstY = dstZ + y * slice.dst.stride[1] * byteC4;
-                    C4proc(dstY, srcY, slice.size[2], slice.src.stride[2], slice.dst.stride[2]);
+                    if (4 == pack) {
+                        C4proc(dstY, srcY, slice.size[2], slice.src.stride[2], slice.dst.stride[2]);
+                    } else {
+                        _copyWithStrideUnit(dstY, srcY, slice.size[2], slice.src.stride[2], slice.dst.stride[2], byteC4);
+                    }
                 }
             }
         }
@@ -450,18 +524,30 @@ void CPURaster::tensorConvert(Tensor* input, Tensor* output, int bytes) {
     auto& subOb     = output->buffer();
     auto source = TensorUtils::getDescribe(input)->dimensionFormat;
     auto dest   = TensorUtils::getDescribe(output)->dimensionFormat;
+    auto cpuBn = static_cast<CPUBackend*>(backend());
     if (subIb.dimensions <= 1 || source == dest) {
-        ::memcpy(subOb.host, subIb.host, input->size());
+        ::memcpy(subOb.host, subIb.host, cpuBn->getTensorSize(input) * bytes);
         return;
     }
     auto tup = CPUTensorConverter::splitDimensions(subIb, source);
     int area = std::get<1>(tup), batch = std::get<0>(tup), channel = std::get<2>(tup);
     const int bitLength = bytes;
+    auto core = cpuBn->functions();
+    // dim[0].stride is aligned by 4 for NC4HW4, use the pack of backend
+    auto channelC4 = UP_DIV(channel, core->pack);
+    int inputBatchStride = channel * area;
+    int outputBatchStride = channel * area;
+    if (MNN_DATA_FORMAT_NC4HW4 == source) {
+        inputBatchStride = channelC4 * core->pack * area;
+    }
+    if (MNN_DATA_FORMAT_NC4HW4 == dest) {
+        outputBatchStride = channelC4 * core->pack * area;
+    }
 
-    auto numberThread = ((CPUBackend*)backend())->threadNumber();
+    auto numberThread = cpuBn->threadNumber();
     MNN_CONCURRENCY_BEGIN(tId, numberThread) {
         for (int b = tId; b < batch; b+=numberThread) {
-            CPUTensorConverter::convert(subIb.host + b * bitLength * subIb.dim[0].stride, subOb.host + b * bitLength * subOb.dim[0].stride, source, dest, 1, area, channel, bitLength);
+            CPUTensorConverter::convert(subIb.host + b * bitLength * inputBatchStride, subOb.host + b * bitLength * outputBatchStride, source, dest, 1, area, channel, bitLength, core);
         }
     }
     MNN_CONCURRENCY_END();
@@ -487,8 +573,9 @@ ErrorCode CPURaster::onExecute(const std::vector<Tensor *> &inputs, const std::v
         getBatchChannelArea(realInput, srcBatch, srcChannel, srcArea);
         auto sourceFormat = TensorUtils::getDescribe(realInput)->dimensionFormat;
         auto destFormat = TensorUtils::getDescribe(output)->dimensionFormat;
-        auto channelC4 = UP_DIV(srcChannel, 4);
-        int batchStrideC4 = channelC4 * 4 * srcArea * bytes;
+        auto core = static_cast<CPUBackend*>(backend())->functions();
+        auto channelC4 = UP_DIV(srcChannel, core->pack);
+        int batchStrideC4 = channelC4 * core->pack * srcArea * bytes;
         int batchStride = srcChannel * srcArea * bytes;
         int inputBatchStride = batchStride;
         int outputBatchStride = batchStride;
@@ -508,7 +595,7 @@ ErrorCode CPURaster::onExecute(const std::vector<Tensor *> &inputs, const std::v
             for (int b=(int)tId; b<srcBatch; b+=(int)threadNum) {
                 auto inputBatch = realInput->host<uint8_t>() + b * inputBatchStride;
                 auto outputBatch = output->host<uint8_t>() + b * outputBatchStride;
-                auto code = CPUTensorConverter::convert(inputBatch, outputBatch, sourceFormat, destFormat, 1, srcArea, srcChannel, bytes);
+                auto code = CPUTensorConverter::convert(inputBatch, outputBatch, sourceFormat, destFormat, 1, srcArea, srcChannel, bytes, core);
                 if (NO_ERROR != code) {
                     MNN_ERROR("Error in CPURaster's convert\n");
                     break;
@@ -27,6 +27,8 @@ public:
 private:
     std::map<Tensor*, std::shared_ptr<Tensor>> mTempInput;
     std::vector<std::pair<void*, Tensor::InsideDescribe::Region*>> mTempInputCopy;
+    // Parts of big regions split for threads
+    std::vector<Tensor::InsideDescribe::Region> mSplitRegions;
     std::vector<std::pair<void*, Tensor::InsideDescribe::Region>> mFastBlit;
     std::shared_ptr<Tensor> mTempOutput;
     void* mOutputPtr;
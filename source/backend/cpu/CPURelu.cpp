@@ -44,7 +44,7 @@ ErrorCode CPURelu::onExecute(const std::vector<Tensor*>& inputs, const std::vect
 
     const float* srcO = (const float*)ib.host;
     float* dstO       = (float*)ob.host;
-    auto size         = inputs[0]->size() / sizeof(float);
+    auto size         = ((CPUBackend*)backend())->getTensorSize(inputs[0]);
     auto numberThread = ((CPUBackend*)backend())->threadNumber();
     int sizeQuad     = size / 4;
     int remain       = sizeQuad * 4;
@@ -75,7 +75,7 @@ ErrorCode CPURelu6::onExecute(const std::vector<Tensor*>& inputs, const std::vec
 
     const float* srcO = (const float*)ib.host;
     float* dstO       = (float*)ob.host;
-    auto size         = inputs[0]->elementSize();
+    auto size         = ((CPUBackend*)backend())->getTensorSize(inputs[0]);
     auto numberThread = ((CPUBackend*)backend())->threadNumber();
     auto sizeQuad     = size / 4;
     auto remain       = sizeQuad * 4;
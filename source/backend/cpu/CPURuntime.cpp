@@ -45,8 +45,15 @@
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include "backend/cpu/CPURuntime.hpp"
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MNN_CPU_SYSFS_TOPOLOGY
+#endif
 
 #ifdef __ANDROID__
 
@@ -271,6 +278,177 @@ float MNNGetCPUFlops(uint32_t number) {
     return flops;
 }
 
+#ifdef MNN_CPU_SYSFS_TOPOLOGY
+// Parse cpu list such as "0-3,8,10-11", return empty if file not exist
+static std::vector<int> _readCPUList(const char* path) {
+    std::vector<int> result;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return result;
+    }
+    char buffer[4096];
+    auto length = fread(buffer, 1, sizeof(buffer) - 1, fp);
+    fclose(fp);
+    buffer[length] = 0;
+    char* current  = buffer;
+    while (*current >= '0' && *current <= '9') {
+        int sta = (int)strtol(current, &current, 10);
+        int fin = sta;
+        if (*current == '-') {
+            fin = (int)strtol(current + 1, &current, 10);
+        }
+        for (int i = sta; i <= fin; ++i) {
+            result.emplace_back(i);
+        }
+        if (*current != ',') {
+            break;
+        }
+        current++;
+    }
+    return result;
+}
+#endif
+
+const MNNCPUTopology& MNNGetCPUTopology() {
+    static MNNCPUTopology gTopology;
+    static std::once_flag gOnce;
+    std::call_once(gOnce, []() {
+        std::vector<int> cpus;
+        std::vector<int> coreOfCPU;
+#ifdef MNN_CPU_SYSFS_TOPOLOGY
+        cpus = _readCPUList("/sys/devices/system/cpu/online");
+        char path[256];
+        for (auto cpu : cpus) {
+            sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+            auto siblings = _readCPUList(path);
+            coreOfCPU.resize(std::max((int)coreOfCPU.size(), cpu + 1), -1);
+            coreOfCPU[cpu] = siblings.empty() ? cpu : siblings[0];
+        }
+        auto nodes = _readCPUList("/sys/devices/system/node/online");
+        for (auto node : nodes) {
+            sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+            auto nodeCPUs = _readCPUList(path);
+            if (nodeCPUs.empty()) {
+                // Memory only node
+                continue;
+            }
+            gTopology.nodeCPUs.emplace_back(std::move(nodeCPUs));
+        }
+#endif
+        if (cpus.empty()) {
+            int number = (int)std::thread::hardware_concurrency();
+            for (int i = 0; i < std::max(number, 1); ++i) {
+                cpus.emplace_back(i);
+            }
+        }
+        if (gTopology.nodeCPUs.empty()) {
+            gTopology.nodeCPUs.emplace_back(cpus);
+        }
+        int maxCPU = *std::max_element(cpus.begin(), cpus.end());
+        gTopology.cpuNode.resize(maxCPU + 1, 0);
+        gTopology.nodeCores.resize(gTopology.nodeCPUs.size());
+        for (int n = 0; n < gTopology.nodeCPUs.size(); ++n) {
+            for (auto cpu : gTopology.nodeCPUs[n]) {
+                if (cpu > maxCPU) {
+                    continue;
+                }
+                gTopology.cpuNode[cpu] = n;
+                if (cpu >= coreOfCPU.size() || coreOfCPU[cpu] == cpu || coreOfCPU[cpu] < 0) {
+                    gTopology.nodeCores[n].emplace_back(cpu);
+                }
+            }
+        }
+    });
+    return gTopology;
+}
+
+int MNNGetCurrentNUMANode() {
+#ifdef MNN_CPU_SYSFS_TOPOLOGY
+    unsigned cpu = 0, node = 0;
+    if (0 != syscall(SYS_getcpu, &cpu, &node, nullptr)) {
+        return -1;
+    }
+    auto& topology = MNNGetCPUTopology();
+    if (cpu >= topology.cpuNode.size()) {
+        return -1;
+    }
+    return topology.cpuNode[cpu];
+#else
+    return -1;
+#endif
+}
+
+std::vector<int> MNNGetBindCPUIDs(int number, int node) {
+    auto& topology = MNNGetCPUTopology();
+    std::vector<int> result;
+    auto nodeNumber = (int)topology.nodeCPUs.size();
+    node = (node >= 0 && node < nodeNumber) ? node : 0;
+    // Physical cores of local node, then of remote nodes
+    for (int i = 0; i < nodeNumber && result.size() < number; ++i) {
+        for (auto cpu : topology.nodeCores[(node + i) % nodeNumber]) {
+            if (result.size() >= number) {
+                break;
+            }
+            result.emplace_back(cpu);
+        }
+    }
+    // More threads than physical cores, use SMT siblings
+    for (int i = 0; i < nodeNumber && result.size() < number; ++i) {
+        for (auto cpu : topology.nodeCPUs[(node + i) % nodeNumber]) {
+            if (result.size() >= number) {
+                break;
+            }
+            if (std::find(result.begin(), result.end(), cpu) == result.end()) {
+                result.emplace_back(cpu);
+            }
+        }
+    }
+    return result;
+}
+
+int MNNSetThreadAffinity(const std::vector<int>& cpuIDs) {
+#ifdef MNN_CPU_SYSFS_TOPOLOGY
+    // Use raw bit mask so as not to depend on libc's cpu_set_t
+    const int bitsPerWord = 8 * sizeof(unsigned long);
+    unsigned long mask[1024 / (8 * sizeof(unsigned long))];
+    ::memset(mask, 0, sizeof(mask));
+    for (auto cpu : cpuIDs) {
+        if (cpu >= 0 && cpu < 1024) {
+            mask[cpu / bitsPerWord] |= (1UL << (cpu % bitsPerWord));
+        }
+    }
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    int syscallret = (int)syscall(__NR_sched_setaffinity, tid, sizeof(mask), mask);
+    if (syscallret) {
+        MNN_PRINT("syscall error %d\n", syscallret);
+        return -1;
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+std::vector<int> MNNGetThreadAffinity() {
+    std::vector<int> result;
+#ifdef MNN_CPU_SYSFS_TOPOLOGY
+    const int bitsPerWord = 8 * sizeof(unsigned long);
+    unsigned long mask[1024 / (8 * sizeof(unsigned long))];
+    ::memset(mask, 0, sizeof(mask));
+    pid_t tid = (pid_t)syscall(SYS_gettid);
+    // Return the size of mask copied by kernel on success
+    if ((int)syscall(__NR_sched_getaffinity, tid, sizeof(mask), mask) <= 0) {
+        return result;
+    }
+    for (int cpu = 0; cpu < 1024; ++cpu) {
+        if (mask[cpu / bitsPerWord] & (1UL << (cpu % bitsPerWord))) {
+            result.emplace_back(cpu);
+        }
+    }
+#endif
+    return result;
+}
+
 // cpuinfo
 // Reference from: https://github.com/pytorch/cpuinfo
 
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #ifndef CPURuntime_hpp
 #define CPURuntime_hpp
+#include <vector>
 
 #if defined(ENABLE_ARMV82) && (defined(__ANDROID__) || defined(__aarch64__))
 struct cpuinfo_arm_isa {
@@ -131,6 +132,29 @@ int MNNSetCPUThreadsMode(MNNCPUThreadsMode mode);
 //
 float MNNGetCPUFlops(uint32_t number);
 
+/*
+ CPU topology read from /sys/devices/system, only effective on Linux / Android.
+ On other platforms all cpus are treated as one node without SMT.
+ */
+struct MNNCPUTopology {
+    /* NUMA node of each logical cpu */
+    std::vector<int> cpuNode;
+    /* Logical cpus of each NUMA node */
+    std::vector<std::vector<int>> nodeCPUs;
+    /* One logical cpu per physical core of each NUMA node, SMT siblings skipped */
+    std::vector<std::vector<int>> nodeCores;
+};
+/* Read once and cached */
+const MNNCPUTopology& MNNGetCPUTopology();
+/* NUMA node the calling thread runs on, -1 if unknown */
+int MNNGetCurrentNUMANode();
+/* Cpus for `number` threads: distinct physical cores of `node` first, then of other nodes, then SMT siblings */
+std::vector<int> MNNGetBindCPUIDs(int number, int node);
+/* Bind calling thread to cpuIDs, return 0 if success */
+int MNNSetThreadAffinity(const std::vector<int>& cpuIDs);
+/* Cpus the calling thread may run on, empty if unknown */
+std::vector<int> MNNGetThreadAffinity();
+
 #if defined(ENABLE_ARMV82) && (defined(__ANDROID__) || defined(__aarch64__))
 
 void cpuinfo_arm_init(struct cpuinfo_arm_isa* cpuinfo_isa);
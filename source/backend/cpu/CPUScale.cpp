@@ -39,7 +39,7 @@ CPUScale::CPUScale(const Op* op, Backend* bn) : MNN::Execution(bn) {
         if (core->bytes < 4) {
             core->MNNFp32ToLowp(scale->biasData()->data(), (int16_t*)(mScaleBias->host<uint8_t>() + 1 * mScaleBias->length(1)), outputCount);
         } else {
-            ::memcpy(mScaleBias->host<float>() + ALIGN_UP4(outputCount), scale->biasData()->data(), outputCount * sizeof(float));
+            ::memcpy(mScaleBias->host<uint8_t>() + 1 * mScaleBias->length(1), scale->biasData()->data(), outputCount * sizeof(float));
         }
     }
 }
@@ -108,7 +108,37 @@ void NHWC2NCHW(const T* source, T* dest, int b, int c, int area) {
     }
 }
 
-ErrorCode CPUTensorConverter::convert(const void* inputRaw, void* outputRaw, MNN_DATA_FORMAT source, MNN_DATA_FORMAT dest, int batch, int area, int channel, int bitLength) {
+static void _convertFloatWithPack(const float* source, float* dest, MNN_DATA_FORMAT sourceFormat, MNN_DATA_FORMAT destFormat, int b, int c, int area, const CoreFunctions* core) {
+    auto pack = core->pack;
+    int packBatchSize = UP_DIV(c, pack) * pack * area;
+    int batchSize     = c * area;
+    for (int bi = 0; bi < b; ++bi) {
+        if (MNN_DATA_FORMAT_NC4HW4 == sourceFormat) {
+            auto srcBatch = source + bi * packBatchSize;
+            auto dstBatch = dest + bi * batchSize;
+            if (MNN_DATA_FORMAT_NHWC == destFormat) {
+                core->MNNUnpackCUnitTranspose(dstBatch, srcBatch, area, c);
+            } else {
+                core->MNNUnpackCUnit(dstBatch, srcBatch, area, c);
+            }
+        } else {
+            auto srcBatch = source + bi * batchSize;
+            auto dstBatch = dest + bi * packBatchSize;
+            if (MNN_DATA_FORMAT_NHWC == sourceFormat) {
+                core->MNNPackCUnitTranspose(dstBatch, srcBatch, area, c);
+            } else {
+                core->MNNPackCUnit(dstBatch, srcBatch, area, c);
+            }
+        }
+    }
+}
+
+ErrorCode CPUTensorConverter::convert(const void* inputRaw, void* outputRaw, MNN_DATA_FORMAT source, MNN_DATA_FORMAT dest, int batch, int area, int channel, int bitLength, const CoreFunctions* core) {
+    if (nullptr != core && 4 != core->pack && 4 == bitLength && source != dest &&
+        (MNN_DATA_FORMAT_NC4HW4 == source || MNN_DATA_FORMAT_NC4HW4 == dest)) {
+        _convertFloatWithPack((const float*)inputRaw, (float*)outputRaw, source, dest, batch, channel, area, core);
+        return NO_ERROR;
+    }
     auto channelC4 = UP_DIV(channel, 4);
     auto batchStrideC4 = channelC4 * area * 4;
     auto batchStride = area * channel;
@@ -13,6 +13,7 @@
 #include "Tensor_generated.h"
 
 namespace MNN {
+struct CoreFunctions;
 
 class CPUTensorConverter : public Execution {
 public:
@@ -22,7 +23,8 @@ public:
     virtual ~CPUTensorConverter() = default;
     static std::tuple<int, int, int> splitDimensions(const halide_buffer_t& ib, MNN_DATA_FORMAT source);
     static ErrorCode convert(const Tensor* input, const Tensor* output);
-    static ErrorCode convert(const void* inputRaw, void* outputRaw, MNN_DATA_FORMAT inputFormat, MNN_DATA_FORMAT outputFormat, int batch, int area, int channel, int bytes);
+    // NC4HW4 is packed by core->pack if core is set, otherwise by 4
+    static ErrorCode convert(const void* inputRaw, void* outputRaw, MNN_DATA_FORMAT inputFormat, MNN_DATA_FORMAT outputFormat, int batch, int area, int channel, int bytes, const CoreFunctions* core = nullptr);
     virtual ErrorCode onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) override;
 };
 
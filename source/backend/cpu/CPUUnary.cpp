@@ -370,11 +370,31 @@ ErrorCode CPUUnary::onExecute(const std::vector<Tensor *> &inputs, const std::ve
         }
         return NO_ERROR;
     }
-    auto size = input->elementSize();
+    auto size = ((CPUBackend*)backend())->getTensorSize(input);
     auto schedule = ((CPUBackend*)backend())->multiThreadDivide(size);
     auto inputPtr = input->host<float>();
     auto outputPtr = output->host<float>();
     auto precision = static_cast<CPUBackend*>(backend())->precisionMode();
+    // Use the vectorized transcendental functions if the cpu supports them
+    auto core = static_cast<CPUBackend*>(backend())->functions();
+    CoreFunctions::MNNUnaryExecute vecFunction = nullptr;
+    if (nullptr != core->MNNSelectUnaryFunctionForFloat) {
+        vecFunction = core->MNNSelectUnaryFunctionForFloat(mType, precision);
+    }
+    if (nullptr != vecFunction) {
+        MNN_CONCURRENCY_BEGIN(tId, schedule.second) {
+            int start = schedule.first * (int)tId;
+            int realSize = schedule.first;
+            if (tId == schedule.second -1 ) {
+                realSize = size - start;
+            }
+            if (realSize > 0) {
+                vecFunction(outputPtr + start, inputPtr + start, realSize);
+            }
+        }
+        MNN_CONCURRENCY_END();
+        return NO_ERROR;
+    }
     MNN_CONCURRENCY_BEGIN(tId, schedule.second) {
         int start = schedule.first * (int)tId;
         int realSize = schedule.first;
@@ -8,20 +8,70 @@
 #ifdef MNN_USE_THREAD_POOL
 #include "backend/cpu/ThreadPool.hpp"
 #include <string.h>
+#include <limits.h>
+#include <algorithm>
 #include <MNN/MNNDefine.h>
-#ifdef __ANDROID__
-#include <stdint.h>
+#include "backend/cpu/CPURuntime.hpp"
+#include "core/TraceRecorder.hpp"
+#if defined(__linux__) || defined(__ANDROID__)
+#include <linux/futex.h>
 #include <sys/syscall.h>
 #include <unistd.h>
-#include <algorithm>
+#define MNN_THREAD_POOL_FUTEX
 #endif
-//#define MNN_THREAD_LOCK_CPU
 
 #define MNN_THREAD_POOL_MAX_TASKS 2
+// Idle rounds a worker spins before parking
+#define MNN_THREAD_POOL_SPIN_COUNT 1024
+// Owner pops 1/MNN_THREAD_POOL_CHUNK_DIVISOR of its remaining range each time
+#define MNN_THREAD_POOL_CHUNK_DIVISOR 4
 namespace MNN {
+// [begin, end) of a worker's iterations packed as (begin << 32) | end, so that pop / steal is a single CAS
+struct ThreadPool::StealRange {
+    std::atomic<uint64_t> range = {0};
+    // Avoid false sharing between workers
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+static inline uint64_t _packRange(uint32_t begin, uint32_t end) {
+    return ((uint64_t)begin << 32) | (uint64_t)end;
+}
+
+static bool _popFront(std::atomic<uint64_t>& range, int& begin, int& end) {
+    auto current = range.load();
+    uint32_t sta, fin, chunk;
+    do {
+        sta = (uint32_t)(current >> 32);
+        fin = (uint32_t)(current & 0xffffffff);
+        if (sta >= fin) {
+            return false;
+        }
+        chunk = std::max((fin - sta) / MNN_THREAD_POOL_CHUNK_DIVISOR, 1U);
+    } while (!range.compare_exchange_weak(current, _packRange(sta + chunk, fin)));
+    begin = sta;
+    end   = sta + chunk;
+    return true;
+}
+
+static bool _stealBack(std::atomic<uint64_t>& range, int& begin, int& end) {
+    auto current = range.load();
+    uint32_t sta, fin, half;
+    do {
+        sta = (uint32_t)(current >> 32);
+        fin = (uint32_t)(current & 0xffffffff);
+        if (sta >= fin) {
+            return false;
+        }
+        half = (fin - sta + 1) / 2;
+    } while (!range.compare_exchange_weak(current, _packRange(sta, fin - half)));
+    begin = fin - half;
+    end   = fin;
+    return true;
+}
+
 ThreadPool* ThreadPool::gInstance = nullptr;
 static std::mutex gInitMutex;
-int ThreadPool::init(int number) {
+int ThreadPool::init(int number, const std::vector<int>& cpuIDs) {
     if (1 >= number) {
         return 1;
     }
@@ -32,10 +82,16 @@ int ThreadPool::init(int number) {
         }
     }
     if (nullptr == gInstance) {
-        gInstance = new ThreadPool(number);
+        gInstance = new ThreadPool(number, cpuIDs);
     }
     return number;
 }
+std::shared_ptr<ThreadPool> ThreadPool::create(int number, const std::vector<int>& cpuIDs) {
+    if (1 >= number) {
+        return nullptr;
+    }
+    return std::shared_ptr<ThreadPool>(new ThreadPool(number, cpuIDs), [](ThreadPool* pool) { delete pool; });
+}
 void ThreadPool::destroy() {
     std::lock_guard<std::mutex> _l(gInitMutex);
     if (nullptr != gInstance) {
@@ -43,159 +99,87 @@ void ThreadPool::destroy() {
         gInstance = nullptr;
     }
 }
-#ifdef MNN_THREAD_LOCK_CPU
-static int getNumberOfCPU() {
-    FILE* fp = fopen("/proc/cpuinfo", "rb");
-    if (!fp) {
-        return 1;
-    }
-    int number = 0;
-    char buffer[1024];
-    while (!feof(fp)) {
-        char* str = fgets(buffer, 1024, fp);
-        if (!str) {
-            break;
-        }
-        if (memcmp(buffer, "processor", 9) == 0) {
-            number++;
-        }
-    }
-    fclose(fp);
-    if (number < 1) {
-        number = 1;
-    }
-    return number;
-}
-
-static int getCPUMaxFreqKHz(int cpuID) {
-    char path[256];
-    sprintf(path, "/sys/devices/system/cpu/cpufreq/stats/cpu%d/time_in_state", cpuID);
-    FILE* fp = fopen(path, "rb");
-    if (!fp) {
-        sprintf(path, "/sys/devices/system/cpu/cpu%d/cpufreq/stats/time_in_state", cpuID);
-        fp = fopen(path, "rb");
-        if (!fp) {
-            sprintf(path, "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpuID);
-            fp = fopen(path, "rb");
-            if (!fp) {
-                return -1;
-            }
-            int maxfrequency = -1;
-            fscanf(fp, "%d", &maxfrequency);
-            fclose(fp);
-            return maxfrequency;
-        }
-    }
-    int maxfrequency = 0;
-    while (!feof(fp)) {
-        int frequency = 0;
-        int history   = fscanf(fp, "%d %*d", &frequency);
-        if (history != 1) {
-            break;
-        }
-        if (frequency > maxfrequency) {
-            maxfrequency = frequency;
-        }
-    }
-    fclose(fp);
-    return maxfrequency;
-}
-
-static std::vector<int> sortCPUIDByMaxFrequency(int maxNumbers) {
-    const int cpuNumbers = getNumberOfCPU();
-    if (cpuNumbers == 0) {
-        return {};
-    }
-    std::vector<int> cpuIDs;
-    std::vector<std::pair<int, int>> cpusFrequency;
-    cpusFrequency.resize(cpuNumbers);
-    for (int i = 0; i < cpuNumbers; ++i) {
-        int frequency           = getCPUMaxFreqKHz(i);
-        cpusFrequency[i].first  = frequency;
-        cpusFrequency[i].second = i;
-    }
-    maxNumbers = std::min(maxNumbers, cpuNumbers);
-    std::sort(cpusFrequency.rbegin(), cpusFrequency.rend());
-    cpuIDs.resize(maxNumbers);
-    for (int i = 0; i < maxNumbers; ++i) {
-        cpuIDs[i] = cpusFrequency[i].second;
-    }
-    // FUNC_PRINT(cpusFrequency[0].first);
-    return cpuIDs;
-}
-
-static int setSchedAffinity(const std::vector<int>& cpuIDs) {
-#define __NCPUBITS (8 * sizeof(unsigned long))
-    typedef struct {
-        unsigned long __bits[CPU_SETSIZE / __NCPUBITS];
-    } cpu_set_t;
-
-    // set affinity for thread
-
-    pid_t pid = gettid();
-    cpu_set_t mask;
-    CPU_ZERO(&mask);
-    for (int i = 1; i < (int)cpuIDs.size(); i++) {
-        CPU_SET(cpuIDs[i], &mask);
-    }
-
-    int syscallret = syscall(__NR_sched_setaffinity, pid, sizeof(mask), &mask);
-    if (syscallret) {
-        MNN_PRINT("syscall error %d\n", syscallret);
-        return -1;
-    }
-
-    return 0;
-}
-
-#endif // arch
-ThreadPool::ThreadPool(int numberThread) {
+ThreadPool::ThreadPool(int numberThread, const std::vector<int>& cpuIDs) {
     mNumberThread = numberThread;
     mActiveCount  = 0;
     mTaskAvailable.resize(MNN_THREAD_POOL_MAX_TASKS);
     mTasks.resize(MNN_THREAD_POOL_MAX_TASKS);
+    mRanges.resize(MNN_THREAD_POOL_MAX_TASKS);
     for (int t = 0; t < mTasks.size(); ++t) {
         mTaskAvailable[t] = true;
         for (int i = 0; i < mNumberThread; ++i) {
             mTasks[t].second.emplace_back(new std::atomic_bool{false});
+            mRanges[t].emplace_back(new StealRange);
         }
     }
-#ifdef MNN_THREAD_LOCK_CPU
-    std::vector<int> sortedCPUIDs = sortCPUIDByMaxFrequency(numberThread);
-#endif
     for (int i = 1; i < mNumberThread; ++i) {
         int threadIndex = i;
-#ifdef MNN_THREAD_LOCK_CPU
-        mWorkers.emplace_back([this, sortedCPUIDs, threadIndex]() {
-#else
-        mWorkers.emplace_back([this, threadIndex]() {
-#endif
-#ifdef MNN_THREAD_LOCK_CPU
-            int res = setSchedAffinity(sortedCPUIDs);
-#endif
+        // Worker i is bound to cpuIDs[i], cpuIDs[0] is left for the thread calling enqueue
+        int cpuID = threadIndex < cpuIDs.size() ? cpuIDs[threadIndex] : -1;
+        mWorkers.emplace_back([this, threadIndex, cpuID]() {
+            if (cpuID >= 0) {
+                MNNSetThreadAffinity({cpuID});
+            }
+            int spin = 0;
             while (!mStop) {
-                while (mActiveCount > 0) {
-                    for (int i = 0; i < MNN_THREAD_POOL_MAX_TASKS; ++i) {
-                        if (*mTasks[i].second[threadIndex]) {
+                // Read epoch before scanning, so a task enqueued after the scan makes park return at once
+                int epoch = mEpoch;
+                bool busy = false;
+                for (int i = 0; i < MNN_THREAD_POOL_MAX_TASKS; ++i) {
+                    if (*mTasks[i].second[threadIndex]) {
+                        {
+                            TraceRecorder::Scope _trace("task", "threadpool");
                             mTasks[i].first.first(threadIndex);
-                            { *mTasks[i].second[threadIndex] = false; }
                         }
+                        { *mTasks[i].second[threadIndex] = false; }
+                        busy = true;
                     }
+                }
+                if (busy) {
+                    spin = 0;
+                    continue;
+                }
+                if (mActiveCount > 0 || spin < MNN_THREAD_POOL_SPIN_COUNT) {
+                    spin = mActiveCount > 0 ? 0 : spin + 1;
                     std::this_thread::yield();
+                    continue;
                 }
-                std::unique_lock<std::mutex> _l(mQueueMutex);
-                mCondition.wait(_l, [this] { return mStop || mActiveCount > 0; });
+                spin = 0;
+                park(epoch);
             }
         });
     }
 }
 
-ThreadPool::~ThreadPool() {
+void ThreadPool::park(int epoch) {
+    mSleeping++;
+#ifdef MNN_THREAD_POOL_FUTEX
+    syscall(SYS_futex, reinterpret_cast<int*>(&mEpoch), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+#else
     {
-        std::lock_guard<std::mutex> _l(mQueueMutex);
-        mStop = true;
+        std::unique_lock<std::mutex> _l(mQueueMutex);
+        mCondition.wait(_l, [this, epoch] { return mEpoch != epoch; });
     }
+#endif
+    mSleeping--;
+}
+
+void ThreadPool::wakeUp() {
+    mEpoch++;
+    if (mSleeping <= 0) {
+        return;
+    }
+#ifdef MNN_THREAD_POOL_FUTEX
+    syscall(SYS_futex, reinterpret_cast<int*>(&mEpoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    { std::lock_guard<std::mutex> _l(mQueueMutex); }
     mCondition.notify_all();
+#endif
+}
+
+ThreadPool::~ThreadPool() {
+    mStop = true;
+    wakeUp();
     for (auto& worker : mWorkers) {
         worker.join();
     }
@@ -204,60 +188,71 @@ ThreadPool::~ThreadPool() {
             delete c;
         }
     }
+    for (auto& ranges : mRanges) {
+        for (auto r : ranges) {
+            delete r;
+        }
+    }
 }
 
-int ThreadPool::acquireWorkIndex() {
-    if (nullptr == gInstance) {
+int ThreadPool::acquireWorkIndex(ThreadPool* pool) {
+    auto instance = nullptr == pool ? gInstance : pool;
+    if (nullptr == instance) {
         return -1;
     }
-    std::lock_guard<std::mutex> _l(gInstance->mQueueMutex);
+    std::lock_guard<std::mutex> _l(instance->mQueueMutex);
     for (int i = 0; i < MNN_THREAD_POOL_MAX_TASKS; ++i) {
-        if (gInstance->mTaskAvailable[i]) {
-            gInstance->mTaskAvailable[i] = false;
+        if (instance->mTaskAvailable[i]) {
+            instance->mTaskAvailable[i] = false;
             return i;
         }
     }
     return -1;
 }
-void ThreadPool::releaseWorkIndex(int index) {
-    if (nullptr == gInstance) {
+void ThreadPool::releaseWorkIndex(int index, ThreadPool* pool) {
+    auto instance = nullptr == pool ? gInstance : pool;
+    if (nullptr == instance) {
         return;
     }
     if (index < 0 || index >= MNN_THREAD_POOL_MAX_TASKS) {
         return;
     }
-    std::lock_guard<std::mutex> _l(gInstance->mQueueMutex);
-    gInstance->mTaskAvailable[index] = true;
+    std::lock_guard<std::mutex> _l(instance->mQueueMutex);
+    instance->mTaskAvailable[index] = true;
 }
 
-void ThreadPool::active() {
-    if (nullptr == gInstance) {
+void ThreadPool::active(ThreadPool* pool) {
+    auto instance = nullptr == pool ? gInstance : pool;
+    if (nullptr == instance) {
         return;
     }
-    {
-        std::lock_guard<std::mutex> _l(gInstance->mQueueMutex);
-        gInstance->mActiveCount++;
-    }
-    gInstance->mCondition.notify_all();
+    instance->mActiveCount++;
+    instance->wakeUp();
 }
-void ThreadPool::deactive() {
-    if (nullptr == gInstance) {
+void ThreadPool::deactive(ThreadPool* pool) {
+    auto instance = nullptr == pool ? gInstance : pool;
+    if (nullptr == instance) {
         return;
     }
-    gInstance->mActiveCount--;
+    instance->mActiveCount--;
 }
 
-void ThreadPool::enqueue(TASK&& task, int index) {
+void ThreadPool::enqueue(TASK&& task, int index, ScheduleMode mode, ThreadPool* pool) {
     if (1 >= task.second || 0 > index) {
         for (int i = 0; i < task.second; ++i) {
             task.first(i);
         }
         return;
     }
-    MNN_ASSERT(nullptr != gInstance);
-    gInstance->enqueueInternal(std::move(task), index);
+    auto instance = nullptr == pool ? gInstance : pool;
+    MNN_ASSERT(nullptr != instance);
+    instance->enqueueInternal(std::move(task), index, mode);
 }
-void ThreadPool::enqueueInternal(TASK&& task, int index) {
+void ThreadPool::enqueueInternal(TASK&& task, int index, ScheduleMode mode) {
+    if (WORK_STEALING == mode) {
+        enqueueStealing(std::move(task), index);
+        return;
+    }
     if (mActiveCount == 0) {
         for (int i = 0; i < task.second; ++i) {
             task.first(i);
@@ -282,7 +277,59 @@ void ThreadPool::enqueueInternal(TASK&& task, int index) {
             *mTasks[index].second[i] = true;
         }
     }
-    mTasks[index].first.first(0);
+    {
+        TraceRecorder::Scope _trace("task", "threadpool");
+        mTasks[index].first.first(0);
+    }
+    // Time the caller waits for stragglers
+    TraceRecorder::Scope _wait("wait", "threadpool");
+    waitTask(index, workSize);
+}
+
+void ThreadPool::enqueueStealing(TASK&& task, int index) {
+    int size     = task.second;
+    int workSize = std::min(size, mNumberThread);
+    auto& ranges = mRanges[index];
+    for (int i = 0; i < workSize; ++i) {
+        auto sta = (uint32_t)((int64_t)size * i / workSize);
+        auto fin = (uint32_t)((int64_t)size * (i + 1) / workSize);
+        ranges[i]->range = _packRange(sta, fin);
+    }
+    mTasks[index].first = std::make_pair(
+        [workSize, &task, &ranges](int tId) {
+            int sta, fin;
+            auto& own = ranges[tId]->range;
+            while (true) {
+                while (_popFront(own, sta, fin)) {
+                    for (int v = sta; v < fin; ++v) {
+                        task.first(v);
+                    }
+                }
+                // Own range is drained, steal the back half of a busy worker's range
+                bool stolen = false;
+                for (int i = 1; i < workSize && !stolen; ++i) {
+                    stolen = _stealBack(ranges[(tId + i) % workSize]->range, sta, fin);
+                }
+                if (!stolen) {
+                    break;
+                }
+                own = _packRange(sta, fin);
+            }
+        },
+        workSize);
+    for (int i = 1; i < workSize; ++i) {
+        *mTasks[index].second[i] = true;
+    }
+    wakeUp();
+    {
+        TraceRecorder::Scope _trace("task", "threadpool");
+        mTasks[index].first.first(0);
+    }
+    TraceRecorder::Scope _wait("wait", "threadpool");
+    waitTask(index, workSize);
+}
+
+void ThreadPool::waitTask(int index, int workSize) {
     bool complete = true;
     do {
         std::this_thread::yield();
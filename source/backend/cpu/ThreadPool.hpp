@@ -11,6 +11,7 @@
 #ifdef MNN_USE_THREAD_POOL
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -21,26 +22,52 @@ namespace MNN {
 class MNN_PUBLIC ThreadPool {
 public:
     typedef std::pair<std::function<void(int)>, int> TASK;
+    enum ScheduleMode {
+        /** Split task into number() static chunks, workers spin while active */
+        STATIC = 0,
+        /** Per-worker range deques with dynamic chunking and stealing, idle workers park */
+        WORK_STEALING = 1,
+    };
 
     int number() const {
         return mNumberThread;
     }
-    static void enqueue(TASK&& task, int index);
+    /* `pool` == nullptr means the process-wide pool created by init */
+    static void enqueue(TASK&& task, int index, ScheduleMode mode = STATIC, ThreadPool* pool = nullptr);
 
-    static void active();
-    static void deactive();
+    static void active(ThreadPool* pool = nullptr);
+    static void deactive(ThreadPool* pool = nullptr);
 
-    static int acquireWorkIndex();
-    static void releaseWorkIndex(int index);
+    static int acquireWorkIndex(ThreadPool* pool = nullptr);
+    static void releaseWorkIndex(int index, ThreadPool* pool = nullptr);
 
-    static int init(int number);
+    /**
+     * @brief create an independent pool, not shared with the process-wide one.
+     * @param number    thread number, include the thread calling enqueue.
+     * @param cpuIDs    if not empty, bind worker i to cpuIDs[i].
+     * @return created pool, nullptr if number <= 1.
+     */
+    static std::shared_ptr<ThreadPool> create(int number, const std::vector<int>& cpuIDs = std::vector<int>());
+
+    /**
+     * @brief create the process-wide pool if not created.
+     * @param number    thread number, include the thread calling enqueue.
+     * @param cpuIDs    if not empty, bind worker i to cpuIDs[i].
+     * @return thread number of the pool.
+     */
+    static int init(int number, const std::vector<int>& cpuIDs = std::vector<int>());
     static void destroy();
 
 private:
-    void enqueueInternal(TASK&& task, int index);
+    struct StealRange;
+    void enqueueInternal(TASK&& task, int index, ScheduleMode mode);
+    void enqueueStealing(TASK&& task, int index);
+    void waitTask(int index, int workSize);
+    void park(int epoch);
+    void wakeUp();
 
     static ThreadPool* gInstance;
-    ThreadPool(int number = 0);
+    ThreadPool(int number = 0, const std::vector<int>& cpuIDs = std::vector<int>());
     ~ThreadPool();
 
     std::vector<std::thread> mWorkers;
@@ -48,11 +75,15 @@ private:
     std::atomic<bool> mStop = {false};
 
     std::vector<std::pair<TASK, std::vector<std::atomic_bool*>>> mTasks;
+    std::vector<std::vector<StealRange*>> mRanges;
     std::condition_variable mCondition;
     std::mutex mQueueMutex;
 
     int mNumberThread            = 0;
     std::atomic_int mActiveCount = {0};
+    // Bumped on every wake up, parked workers wait for it to change
+    std::atomic_int mEpoch       = {0};
+    std::atomic_int mSleeping    = {0};
 };
 } // namespace MNN
 #endif
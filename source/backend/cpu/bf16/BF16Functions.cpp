@@ -1,8 +1,10 @@
+#include <limits>
 #ifdef MNN_USE_SSE
 #include "../x86_x64/sse/FunctionSummary.hpp"
 #include "../x86_x64/avx/FunctionSummary.hpp"
 #include "../x86_x64/avxfma/FunctionSummary.hpp"
 #include "../x86_x64/avx512/FunctionSummary.hpp"
+#include "../x86_x64/avx512bf16/FunctionSummary.hpp"
 #include "../x86_x64/cpu_id.h"
 #endif
 #include "core/Macro.h"
@@ -566,6 +568,8 @@ bool BF16Functions::init() {
     gInstance->chooseWinoSourceTransform = (decltype(gInstance->chooseWinoSourceTransform))(WinogradFunctionHalf::chooseSourceTransform);
     gInstance->MNNDeconvRunForLineDepthwise = (decltype(gInstance->MNNDeconvRunForLineDepthwise))_MNNDeconvRunForLineDepthwise;
     gInstance->MNNDeconvRunForUnitDepthWise = (decltype(gInstance->MNNDeconvRunForUnitDepthWise))_MNNDeconvRunForUnitDepthWise;
+    gInstance->MNNSelectUnaryFunctionForFloat = nullptr;
+    gInstance->MNNSoftmax = nullptr;
 
 #if !defined(MNN_USE_SSE) && !defined(MNN_USE_NEON)
     gInstance->penalty = 1.5f;
@@ -582,11 +586,41 @@ bool BF16Functions::init() {
         return false;
     }
     if (cpuFlags & libyuv::kCpuHasAVX2) {
+#ifdef MNN_SSE_USE_FP16_INSTEAD
         gInstance->MNNPackForMatMul_B = _AVX_MNNPackForMatMul_B_BF16;
         gInstance->MNNGetMatMulPackMode = _AVX_MNNGetMatMulPackMode_BF16;
         gInstance->MNNPackC4ForMatMul_A = _AVX_MNNPackC4ForMatMul_A_BF16;
         gInstance->MNNPackedMatMul = _AVX_MNNPackedMatMulFMA_BF16;
         gInstance->MNNPackedMatMulRemain = _AVX_MNNPackedMatMulRemainFMA_BF16;
+#else
+        // Emulate VDPBF16PS with fma, so the native kernels below give the same result
+        gInstance->MNNPackForMatMul_B = _AVX_MNNPackForMatMul_B_BF16Pair;
+        gInstance->MNNGetMatMulPackMode = _AVX_MNNGetMatMulPackMode_BF16Pair;
+        gInstance->MNNPackC4ForMatMul_A = _AVX_MNNPackC4ForMatMul_A_BF16Pair;
+        gInstance->MNNPackedMatMul = _AVX_MNNPackedMatMulFMA_BF16Pair;
+        gInstance->MNNPackedMatMulRemain = _AVX_MNNPackedMatMulRemainFMA_BF16Pair;
+        gInstance->MNNConvRunForLineDepthwise = _AVX_MNNConvRunForLineDepthwiseFMA_BF16;
+        gInstance->MNNConvRunForUnitDepthWise = _AVX_MNNConvRunForUnitDepthWiseFMA_BF16;
+#ifdef MNN_AVX512_BF16
+        if ((cpuFlags & libyuv::kCpuHasAVX512BF16) && (cpuFlags & libyuv::kCpuHasAVX512BW) && (cpuFlags & libyuv::kCpuHasAVX512VL)) {
+            gInstance->MNNGetMatMulPackMode = _AVX512BF16_MNNGetMatMulPackMode;
+            gInstance->MNNPackedMatMul = _AVX512BF16_MNNPackedMatMul;
+            gInstance->MNNPackedMatMulRemain = _AVX512BF16_MNNPackedMatMulRemain;
+            gInstance->MNNConvRunForLineDepthwise = _AVX512BF16_MNNConvRunForLineDepthwise;
+            gInstance->MNNConvRunForUnitDepthWise = _AVX512BF16_MNNConvRunForUnitDepthWise;
+#ifdef MNN_AMX
+            // The remain of AMX uses VDPBF16PS on the same pack
+            if ((cpuFlags & libyuv::kCpuHasAMXBF16) && _AMX_Init()) {
+                gInstance->MNNPackForMatMul_B = _AVX_MNNPackForMatMul_B_BF16Tile;
+                gInstance->MNNGetMatMulPackMode = _AMX_MNNGetMatMulPackMode;
+                gInstance->MNNPackC4ForMatMul_A = _AVX_MNNPackC4ForMatMul_A_BF16Tile;
+                gInstance->MNNPackedMatMul = _AMX_MNNPackedMatMul;
+                gInstance->MNNPackedMatMulRemain = _AVX512BF16_MNNPackedMatMulRemainTile;
+            }
+#endif
+        }
+#endif
+#endif
         return true;
     }
 #elif defined(MNN_USE_NEON)
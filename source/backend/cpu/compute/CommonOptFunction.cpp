@@ -9,11 +9,14 @@
 #include "CommonOptFunction.h"
 #include "ConvOpt.h"
 #include "WinogradOptFunction.hpp"
+#include "UnaryFunction.hpp"
+#include "SoftmaxFunction.hpp"
 #include <string.h>
 #include <algorithm>
 #include <math.h>
 #include "math/Vec.hpp"
 #include <vector>
+#include <limits>
 
 #ifndef MNN_USE_NEON
 
@@ -1364,6 +1367,8 @@ void MNNCoreFunctionInit() {
     gCoreFunction->chooseWinoDestTransform = WinogradFunction::chooseDestTransform;
     gCoreFunction->MNNDeconvRunForLineDepthwise = MNNDeconvRunForLineDepthwise;
     gCoreFunction->MNNDeconvRunForUnitDepthWise = MNNDeconvRunForUnitDepthWise;
+    gCoreFunction->MNNSelectUnaryFunctionForFloat = UnaryFunction<Vec4, 4>::select;
+    gCoreFunction->MNNSoftmax = SoftmaxFunction<Vec4, 4>::execute;
     MNNFunctionInit();
 }
 CoreFunctions* MNNGetCoreFunctions() {
@@ -177,6 +177,13 @@ struct CoreFunctions {
                                       size_t weight_y_step, size_t dilateX_step, size_t dilateY_step);
     void(*MNNDeconvRunForLineDepthwise)(const float* dst, float* src, const float* weight, size_t width, size_t src_w_setup,
                                       size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step);
+
+    /**Vectorized transcendental functions, type is UnaryOpOperation, precision is BackendConfig::PrecisionMode, return nullptr if not supported*/
+    typedef void(*MNNUnaryExecute)(float* dst, const float* src, size_t size);
+    MNNUnaryExecute(*MNNSelectUnaryFunctionForFloat)(int type, int precision);
+
+    /**Softmax along channel of float [channel, stride] for the first inside columns, stride = 1 for a contiguous row*/
+    void(*MNNSoftmax)(float* dest, const float* source, size_t channel, size_t inside, size_t stride);
 };
 void MNNCoreFunctionInit();
 CoreFunctions* MNNGetCoreFunctions();
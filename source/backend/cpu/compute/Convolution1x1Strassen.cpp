@@ -17,10 +17,18 @@
 
 namespace MNN {
 Convolution1x1Strassen::Convolution1x1Strassen(const Convolution2DCommon *common, Backend *b, const float *originWeight,
-                                               size_t originWeightSize, const float *bias, size_t biasSize)
+                                               size_t originWeightSize, const float *bias, size_t biasSize,
+                                               const float *packedWeight)
     : CPUConvolution(common, b) {
     auto outputCount = (int)biasSize;
     auto mSrcCount   = (int)originWeightSize / outputCount;
+    // The offline packed weight is the same as packed here, share it as well
+    auto key = makeResourceKey(b, "Strassen1x1_" + std::to_string(outputCount) + "_" + std::to_string(mSrcCount),
+                               originWeight, originWeightSize * sizeof(float), bias, biasSize * sizeof(float));
+    mResource = getSharedResource(b, key);
+    if (nullptr != mResource) {
+        return;
+    }
     mResource.reset(new CPUConvolution::Resource);
     mResource->backend = b;
     if (!mResource->copyBiasAlign(bias, biasSize)) {
@@ -37,7 +45,9 @@ Convolution1x1Strassen::Convolution1x1Strassen(const Convolution2DCommon *common
         MNN_ERROR("Not Enough Memory\n");
         return;
     }
-    if (core->bytes < 4) {
+    if (nullptr != packedWeight) {
+        ::memcpy(mResource->mWeight->host<float>(), packedWeight, mResource->mWeight->size());
+    } else if (core->bytes < 4) {
         AutoRelease<Tensor> tempTensor(Tensor::createDevice<float>({outputCount * mSrcCount}));
         mValid = b->onAcquireBuffer(tempTensor.get(), Backend::STATIC);
         if (!mValid) {
@@ -50,6 +60,7 @@ Convolution1x1Strassen::Convolution1x1Strassen(const Convolution2DCommon *common
     } else {
         core->MNNPackForMatMul_B(mResource->mWeight->host<float>(), originWeight, outputCount, mSrcCount, true);
     }
+    setSharedResource(b, key, mResource);
 }
 Convolution1x1Strassen::Convolution1x1Strassen(std::shared_ptr<CPUConvolution::Resource> resource, const Convolution2DCommon *common, Backend* b) : CPUConvolution(common, b) {
     mResource = resource;
@@ -66,7 +77,9 @@ bool Convolution1x1Strassen::onClone(Backend* bn, const Op* op, Execution** dst)
     if (nullptr == dst) {
         return true;
     }
-    *dst = new Convolution1x1Strassen(mResource, op->main_as_Convolution2D()->common(), bn);
+    auto dstExe = new Convolution1x1Strassen(mResource, op->main_as_Convolution2D()->common(), bn);
+    dstExe->mMaxDepth = mMaxDepth;
+    *dst = dstExe;
     return true;
 }
 
@@ -193,7 +206,7 @@ ErrorCode Convolution1x1Strassen::onResize(const std::vector<Tensor *> &inputs,
     auto memoryPool = ((CPUBackend *)backend())->getBufferAllocator();
     memoryPool->barrierBegin();
     std::shared_ptr<void> __a(nullptr, [memoryPool](void *) { memoryPool->barrierEnd(); });
-    int maxDepth = 5;
+    int maxDepth = mMaxDepth;
     auto icAlign = UP_DIV(ic, lPack) * lPack;
     auto weightTensor = mResource->mWeight.get();
     AutoRelease<Tensor> tempWeight;
@@ -15,8 +15,10 @@
 namespace MNN {
 class Convolution1x1Strassen : public CPUConvolution {
 public:
+    // packedWeight: optional, originWeight already packed by MNNPackForMatMul_B for the backend, used as is
     Convolution1x1Strassen(const Convolution2DCommon *common, Backend *b, const float *originWeight,
-                           size_t originWeightSize, const float *bias, size_t biasSize);
+                           size_t originWeightSize, const float *bias, size_t biasSize,
+                           const float *packedWeight = nullptr);
     Convolution1x1Strassen(std::shared_ptr<CPUConvolution::Resource> resource, const Convolution2DCommon *common, Backend* b);
     virtual ~Convolution1x1Strassen();
 
@@ -24,6 +26,10 @@ public:
 
     virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
     virtual bool onClone(Backend* bn, const Op* op, Execution** dst) override;
+    // Max recursion depth of strassen, 0 means plain matmul
+    void setStrassenDepth(int depth) {
+        mMaxDepth = depth;
+    }
 private:
     std::shared_ptr<CPUConvolution::Resource> mResource;
 
@@ -38,6 +44,7 @@ private:
     std::shared_ptr<Tensor> mTempInputBatch;
     std::shared_ptr<Tensor> mTempOutputBatch;
     bool mNeedPretreat = false;
+    int mMaxDepth = 5;
     std::function<void(const uint8_t* srcBatch, uint8_t* dstBatch)> mPretreatFunction;
 };
 } // namespace MNN
@@ -24,6 +24,12 @@ ConvolutionDepthwise3x3::ConvolutionDepthwise3x3(const Convolution2DCommon *comm
     MNN_ASSERT(3 == common->kernelX() && 3 == common->kernelY());
     MNN_ASSERT(1 == common->strideX() && 1 == common->strideY());
     MNN_ASSERT(1 == common->dilateX() && 1 == common->dilateY());
+    auto key = makeResourceKey(b, "Depthwise3x3_" + std::to_string(common->outputCount()), originWeight,
+                               originWeightSize * sizeof(float), bias, biasSize * sizeof(float));
+    mResource = getSharedResource(b, key);
+    if (nullptr != mResource) {
+        return;
+    }
     mResource.reset(new Resource);
     mResource->backend = b;
     auto core = static_cast<CPUBackend*>(b)->functions();
@@ -79,6 +85,7 @@ ConvolutionDepthwise3x3::ConvolutionDepthwise3x3(const Convolution2DCommon *comm
     if (bytes < 4) {
         core->MNNFp32ToLowp(weightHost, mResource->mWeight->host<int16_t>(), unitSize);
     }
+    setSharedResource(b, key, mResource);
 }
 
 ConvolutionDepthwise3x3::~ConvolutionDepthwise3x3() {
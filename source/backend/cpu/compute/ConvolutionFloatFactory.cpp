@@ -14,52 +14,229 @@
 #include "backend/cpu/compute/ConvolutionIntFactory.hpp"
 #include "backend/cpu/compute/ConvolutionTiledExecutor.hpp"
 #include "backend/cpu/compute/ConvolutionWinograd.hpp"
+#include "core/BufferAllocator.hpp"
 #include "core/Macro.h"
+#include "core/TensorUtils.hpp"
 #include "backend/cpu/OneDNNConvolution.hpp"
+#include <MNN/AutoTime.hpp>
+#include <string.h>
 
 namespace MNN {
+// Algorithms measured when tuning, saved as choice[0] with its parameter in choice[1]
+enum ConvolutionAlgorithm {
+    CONV_TILED    = 0,
+    CONV_WINOGRAD = 1, // parameter: unit
+    CONV_STRASSEN = 2, // parameter: max depth of strassen
+};
 
+static Execution* _createAlgorithm(const std::vector<int>& choice, const Tensor* input, const Tensor* output, Backend* backend,
+                                   const Convolution2DCommon* common, const float* originWeight, size_t originWeightSize,
+                                   const float* bias, size_t biasSize, const float* packedWeight) {
+    switch (choice[0]) {
+        case CONV_WINOGRAD:
+            return new ConvolutionWinograd(common, input, output, backend, originWeight, originWeightSize, bias, biasSize,
+                                           choice[1]);
+        case CONV_STRASSEN: {
+            auto exe = new Convolution1x1Strassen(common, backend, originWeight, originWeightSize, bias, biasSize,
+                                                  packedWeight);
+            exe->setStrassenDepth(choice[1]);
+            return exe;
+        }
+        default:
+            break;
+    }
+    return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize, packedWeight);
+}
+
+static std::string _tuneKey(const Tensor* input, const Tensor* output, const Convolution2DCommon* common, const CPUBackend* backend) {
+    auto core = backend->functions();
+    std::vector<int> values = {input->batch(), input->channel(), input->height(), input->width(), output->channel(),
+                               output->height(), output->width(), common->kernelX(), common->kernelY(),
+                               common->strideX(), common->strideY(), common->dilateX(), common->dilateY(),
+                               common->padX(), common->padY(), backend->threadNumber(), core->bytes, core->pack};
+    std::string key = "Convolution";
+    for (auto v : values) {
+        key += "_" + std::to_string(v);
+    }
+    return key;
+}
+
+// Run each candidate on dummy tensors of the same shape and keep the fastest, return cost in ms
+static float _measureBest(const std::vector<std::vector<int>>& candidates, std::vector<int>& best, const Tensor* input,
+                          const Tensor* output, Backend* backend, const Convolution2DCommon* common,
+                          const float* originWeight, size_t originWeightSize, const float* bias, size_t biasSize,
+                          const float* packedWeight) {
+    auto core = static_cast<CPUBackend*>(backend)->functions();
+    std::shared_ptr<Tensor> tempInput(Tensor::createDevice<float>(input->shape(), Tensor::CAFFE_C4));
+    std::shared_ptr<Tensor> tempOutput(Tensor::createDevice<float>(output->shape(), Tensor::CAFFE_C4));
+    if (!backend->onAcquireBuffer(tempInput.get(), Backend::STATIC) || !backend->onAcquireBuffer(tempOutput.get(), Backend::STATIC)) {
+        return -1.0f;
+    }
+    // Avoid denormals / nan in uninitialized memory affecting the time
+    ::memset(tempInput->host<void>(), 0, (size_t)input->batch() * UP_DIV(input->channel(), core->pack) * core->pack *
+                                         input->height() * input->width() * core->bytes);
+    std::vector<Tensor*> inputs  = {tempInput.get()};
+    std::vector<Tensor*> outputs = {tempOutput.get()};
+    // The candidates are not a part of the static memory plan, the replayed resize creates only the chosen one
+    auto allocator = static_cast<CPUBackend*>(backend)->getBufferAllocator();
+    allocator->pausePlan();
+    float bestCost = -1.0f;
+    const int loop = 3;
+    for (auto& candidate : candidates) {
+        std::shared_ptr<Execution> exe(_createAlgorithm(candidate, input, output, backend, common, originWeight,
+                                                        originWeightSize, bias, biasSize, packedWeight));
+        if (nullptr == exe.get() || !exe->valid()) {
+            continue;
+        }
+        if (NO_ERROR != exe->onResize(inputs, outputs)) {
+            continue;
+        }
+        backend->onExecuteBegin();
+        // Warm up
+        exe->onExecute(inputs, outputs);
+        Timer timer;
+        for (int i = 0; i < loop; ++i) {
+            exe->onExecute(inputs, outputs);
+        }
+        float cost = (float)timer.durationInUs() / 1000.0f / (float)loop;
+        backend->onExecuteEnd();
+        if (bestCost < 0.0f || cost < bestCost) {
+            bestCost = cost;
+            best     = candidate;
+        }
+    }
+    allocator->resumePlan();
+    backend->onReleaseBuffer(tempInput.get(), Backend::STATIC);
+    backend->onReleaseBuffer(tempOutput.get(), Backend::STATIC);
+    return bestCost;
+}
+
+static Execution* _tuneUnit(const Tensor* input, const Tensor* output, Backend* backend,
+                            const Convolution2DCommon* common, const float* originWeight, size_t originWeightSize,
+                            const float* bias, size_t biasSize, const float* packedWeight) {
+    auto cpuBackend = (CPUBackend*)backend;
+    if (input->width() <= 0 || input->height() <= 0 || output->width() <= 0 || output->height() <= 0) {
+        return nullptr;
+    }
+    auto key = _tuneKey(input, output, common, cpuBackend);
+    std::vector<int> choice;
+    if (cpuBackend->getTuneChoice(key, choice) && choice.size() >= 2) {
+        return _createAlgorithm(choice, input, output, backend, common, originWeight, originWeightSize, bias, biasSize,
+                                packedWeight);
+    }
+    if (!cpuBackend->needTuning()) {
+        return nullptr;
+    }
+    std::vector<std::vector<int>> candidates = {{CONV_TILED, 0}};
+    if (common->kernelY() == 1 && common->kernelX() == 1) {
+        for (int depth : {0, 1, 5}) {
+            candidates.push_back({CONV_STRASSEN, depth});
+        }
+    } else if (ConvolutionWinograd::canUseWinograd(common) && cpuBackend->memoryMode() != BackendConfig::Memory_Low) {
+        auto core = cpuBackend->functions();
+        // Same source units as ConvolutionWinograd::bestWinogradUnit supports
+        for (int srcUnit : {4, 6, 8}) {
+            auto unit = srcUnit - common->kernelY() + 1;
+            if (unit >= 2 && nullptr != core->chooseWinoDestTransform(srcUnit, unit)) {
+                candidates.push_back({CONV_WINOGRAD, unit});
+            }
+        }
+    }
+    auto cost = _measureBest(candidates, choice, input, output, backend, common, originWeight, originWeightSize, bias,
+                             biasSize, packedWeight);
+    if (cost < 0.0f) {
+        return nullptr;
+    }
+    cpuBackend->setTuneChoice(key, choice, cost);
+    return _createAlgorithm(choice, input, output, backend, common, originWeight, originWeightSize, bias, biasSize,
+                            packedWeight);
+}
+
+// Return the offline packed weight if it is packed the same way as the backend's MNNPackForMatMul_B
+static const float* _getPackedWeight(const Convolution2D* conv2d, Backend* backend, size_t originWeightSize,
+                                     int outputCount) {
+    auto packed = conv2d->packedWeight();
+    if (nullptr == packed || nullptr == packed->weight() || outputCount <= 0) {
+        return nullptr;
+    }
+    auto core = static_cast<CPUBackend*>(backend)->functions();
+    int eP, lP, hP;
+    core->MNNGetMatMulPackMode(&eP, &lP, &hP);
+    if (core->bytes != 4 || packed->lP() != lP || packed->hP() != hP) {
+        return nullptr;
+    }
+    auto lSize = (int)originWeightSize / outputCount;
+    if (packed->weight()->size() != UP_DIV(outputCount, hP) * UP_DIV(lSize, lP) * hP * lP) {
+        return nullptr;
+    }
+    return packed->weight()->data();
+}
+
+// The converter drops the origin weight of a packed one with --packWeightDropOrigin, restore it for the other algorithms
+static bool _unpackWeight(const Convolution2D* conv2d, std::vector<float>& weight) {
+    auto packed = conv2d->packedWeight();
+    auto common = conv2d->common();
+    if (nullptr == packed || nullptr == packed->weight() || packed->lP() <= 0 || packed->hP() <= 0) {
+        return false;
+    }
+    const int lP = packed->lP(), hP = packed->hP();
+    const int outputCount = common->outputCount(), inputCount = common->inputCount();
+    const int kernelSize  = common->kernelX() * common->kernelY();
+    const int l = inputCount * kernelSize, lU = UP_DIV(l, lP);
+    if (l <= 0 || packed->weight()->size() != UP_DIV(outputCount, hP) * lU * hP * lP) {
+        return false;
+    }
+    auto source = packed->weight()->data();
+    weight.resize(outputCount * l);
+    for (int y = 0; y < outputCount; ++y) {
+        for (int c = 0; c < inputCount; ++c) {
+            for (int k = 0; k < kernelSize; ++k) {
+                int x = k * inputCount + c;
+                weight[(y * inputCount + c) * kernelSize + k] =
+                    source[((y / hP) * lU + x / lP) * hP * lP + (y % hP) * lP + x % lP];
+            }
+        }
+    }
+    return true;
+}
+
+// tune is false for the default shape made without inputs, the choice of it would never be used
 static Execution* _createUnit(const Tensor* input, const Tensor* output, Backend* backend,
                               const Convolution2DCommon* common, const float* originWeight, size_t originWeightSize,
-                              const float* bias, size_t biasSize) {
+                              const float* bias, size_t biasSize, const float* packedWeight, bool tune) {
     auto layer   = common;
 #ifdef MNN_USE_ONEDNN
     return OneDNN::createConvolution(common, backend, originWeight, originWeightSize, bias, biasSize);
 #endif
+    if (tune) {
+        auto tuned = _tuneUnit(input, output, backend, common, originWeight, originWeightSize, bias, biasSize,
+                               packedWeight);
+        if (nullptr != tuned) {
+            return tuned;
+        }
+    }
     bool fastWay = layer->kernelY() == 1 && layer->kernelX() == 1;
     if (fastWay) {
-        return new Convolution1x1Strassen(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return new Convolution1x1Strassen(common, backend, originWeight, originWeightSize, bias, biasSize, packedWeight);
     }
     if (!ConvolutionWinograd::canUseWinograd(common)) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize, packedWeight);
     }
     auto cpuBackend = (CPUBackend*)backend;
     if (cpuBackend->memoryMode() == BackendConfig::Memory_Low) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize, packedWeight);
     }
     auto unit = ConvolutionWinograd::bestWinogradUnit(common, input, output, cpuBackend->threadNumber(), backend);
     if (unit <= 1) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize, packedWeight);
     }
     return new ConvolutionWinograd(common, input, output, backend, originWeight, originWeightSize, bias, biasSize,
                                    unit);
 }
 
-Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
-                                           const MNN::Op* op, Backend* backend) {
+static Execution* _create(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs, const MNN::Op* op,
+                          Backend* backend, bool tune) {
     auto conv2d = op->main_as_Convolution2D();
-    if (inputs.empty()) {
-        // Create Default Inputs and Outputs
-        std::shared_ptr<Tensor> tempInput;
-        std::shared_ptr<Tensor> tempOutput;
-        auto common = conv2d->common();
-        int ow = 2, oh = 2;
-        int iw = (common->kernelX() - 1) * common->dilateX() + common->strideX() * (ow - 1) + 1;
-        int ih = (common->kernelY() - 1) * common->dilateY() + common->strideY() * (oh - 1) + 1;
-        tempInput.reset(Tensor::createDevice<float>({1, conv2d->common()->inputCount(), ih, iw}, Tensor::CAFFE_C4));
-        tempOutput.reset(Tensor::createDevice<float>({1, conv2d->common()->outputCount(), oh, ow}, Tensor::CAFFE_C4));
-        return create({tempInput.get()}, {tempOutput.get()}, op, backend);
-    }
     const float* originWeight = nullptr;
     size_t originWeightSize   = 0;
     std::shared_ptr<ConvolutionCommon::Int8Common> quanCommon;
@@ -80,7 +257,15 @@ Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, c
         // Back to float
         originWeight     = quanCommon->weightFloat.get();
         originWeightSize = quanCommon->weightFloat.size();
-    } else if (nullptr == conv2d->weight() || nullptr == conv2d->bias()) {
+    }
+    std::vector<float> unpackedWeight;
+    if (nullptr == originWeight && (nullptr == conv2d->weight() || 0 == conv2d->weight()->size())) {
+        if (_unpackWeight(conv2d, unpackedWeight)) {
+            originWeight     = unpackedWeight.data();
+            originWeightSize = unpackedWeight.size();
+        }
+    }
+    if ((nullptr == originWeight && nullptr == conv2d->weight()) || nullptr == conv2d->bias()) {
         MNN_ERROR("%s has no weight or bias. The model may be benchmark model, please revert the weight/bias firstly\n", op->name()->c_str());
         return nullptr;
     }
@@ -95,8 +280,9 @@ Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, c
         group = inputs[0]->channel()/ conv2d->common()->inputCount();
     }
     if (1 == group) {
+        auto packedWeight = _getPackedWeight(conv2d, backend, originWeightSize, conv2d->bias()->size());
         return _createUnit(inputs[0], outputs[0], backend, common, originWeight, originWeightSize,
-                           conv2d->bias()->data(), conv2d->bias()->size());
+                           conv2d->bias()->data(), conv2d->bias()->size(), packedWeight, tune);
     }
     // TODO: Use Geometry to split
     // Split
@@ -110,9 +296,25 @@ Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, c
     for (int i = 0; i < group; ++i) {
         auto newConvolution =
             _createUnit(emptyInput.get(), emptyOutput.get(), backend, common, originWeight + groupWeightSize * i,
-                        groupWeightSize, conv2d->bias()->data() + groupOutputCount * i, groupOutputCount);
+                        groupWeightSize, conv2d->bias()->data() + groupOutputCount * i, groupOutputCount, nullptr,
+                        tune);
         subConvolution.push_back(std::shared_ptr<Execution>(newConvolution));
     }
     return new ConvolutionGroup(backend, subConvolution);
 }
+
+Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                           const MNN::Op* op, Backend* backend) {
+    if (!inputs.empty()) {
+        return _create(inputs, outputs, op, backend, true);
+    }
+    // Create Default Inputs and Outputs
+    auto common = op->main_as_Convolution2D()->common();
+    int ow = 2, oh = 2;
+    int iw = (common->kernelX() - 1) * common->dilateX() + common->strideX() * (ow - 1) + 1;
+    int ih = (common->kernelY() - 1) * common->dilateY() + common->strideY() * (oh - 1) + 1;
+    std::shared_ptr<Tensor> tempInput(Tensor::createDevice<float>({1, common->inputCount(), ih, iw}, Tensor::CAFFE_C4));
+    std::shared_ptr<Tensor> tempOutput(Tensor::createDevice<float>({1, common->outputCount(), oh, ow}, Tensor::CAFFE_C4));
+    return _create({tempInput.get()}, {tempOutput.get()}, op, backend, false);
+}
 } // namespace MNN
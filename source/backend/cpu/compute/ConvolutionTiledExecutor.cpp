@@ -40,11 +40,9 @@ static void _initWeight(float *dest, const float *source, float* cache, int dept
 }
 ConvolutionTiledExecutor::ConvolutionTiledExecutor(const Convolution2DCommon* common, Backend* b,
                                                    const float* originWeight, size_t originWeightSize,
-                                                   const float* bias, size_t biasSize)
+                                                   const float* bias, size_t biasSize, const float* packedWeight)
     : MNN::Execution(b) {
     auto outputCount = (int)biasSize;
-    mResource.reset(new CPUConvolution::Resource);
-    mResource->backend = b;
     int eP, lP, hP;
     auto core = static_cast<CPUBackend*>(b)->functions();
     int bytes = core->bytes;
@@ -52,8 +50,32 @@ ConvolutionTiledExecutor::ConvolutionTiledExecutor(const Convolution2DCommon* co
     // Don't use common->inputCount for old model common->inputCount is zero
     auto srcCount    = (int)originWeightSize / outputCount / common->kernelX() / common->kernelY();
     auto lSize = srcCount * common->kernelX() * common->kernelY();
+    auto key = CPUConvolution::makeResourceKey(b, "Tiled_" + std::to_string(outputCount) + "_" + std::to_string(lSize),
+                                               originWeight, originWeightSize * sizeof(float), bias,
+                                               biasSize * sizeof(float));
+    mResource = CPUConvolution::getSharedResource(b, key);
+    if (nullptr != mResource) {
+        mProxy.reset(new ConvolutionTiledExecutorBasic(common, b));
+        return;
+    }
+    mResource.reset(new CPUConvolution::Resource);
+    mResource->backend = b;
     mResource->mWeight.reset(Tensor::createDevice<uint8_t>(
         {UP_DIV(outputCount, hP) * UP_DIV(lSize, lP) * hP * lP * bytes}));
+    if (nullptr != packedWeight) {
+        mValid = backend()->onAcquireBuffer(mResource->mWeight.get(), Backend::STATIC);
+        if (!mValid) {
+            return;
+        }
+        ::memcpy(mResource->mWeight->host<uint8_t>(), packedWeight, mResource->mWeight->size());
+        mValid = mResource->copyBiasAlign(bias, biasSize);
+        if (!mValid) {
+            return;
+        }
+        CPUConvolution::setSharedResource(b, key, mResource);
+        mProxy.reset(new ConvolutionTiledExecutorBasic(common, b));
+        return;
+    }
     std::shared_ptr<Tensor> cache(Tensor::createDevice<uint8_t>({outputCount * srcCount * common->kernelX() * common->kernelY() * (int)sizeof(float)})); // cache must be float
     mValid = backend()->onAcquireBuffer(mResource->mWeight.get(), Backend::STATIC) && backend()->onAcquireBuffer(cache.get(), Backend::STATIC);
     if (!mValid) {
@@ -65,6 +87,7 @@ ConvolutionTiledExecutor::ConvolutionTiledExecutor(const Convolution2DCommon* co
     if (!mValid) {
         return;
     }
+    CPUConvolution::setSharedResource(b, key, mResource);
     mProxy.reset(new ConvolutionTiledExecutorBasic(common, b));
 }
 
@@ -28,8 +28,10 @@ protected:
 };
 class ConvolutionTiledExecutor : public Execution {
 public:
+    // packedWeight: optional, originWeight already packed by MNNPackForMatMul_B for the backend, used as is
     ConvolutionTiledExecutor(const Convolution2DCommon *common, Backend *b, const float *originWeight,
-                             size_t originWeightSize, const float *bias, size_t biasSize);
+                             size_t originWeightSize, const float *bias, size_t biasSize,
+                             const float *packedWeight = nullptr);
     ConvolutionTiledExecutor(std::shared_ptr<CPUConvolution::Resource> res, const Convolution2DCommon *common, Backend* b);
     virtual ~ConvolutionTiledExecutor();
 
@@ -30,13 +30,6 @@ ConvolutionWinograd::ConvolutionWinograd(const Convolution2DCommon *convOp, cons
     : MNN::CPUConvolution(convOp, b) {
     auto core = static_cast<CPUBackend*>(backend())->functions();
     int pack = core->pack, bytes = core->bytes;
-    mResource.reset(new Resource);
-    mResource->backend = b;
-    if (!mResource->copyBiasAlign(bias, biasSize)) {
-        MNN_ERROR("Not Enough Memory\n");
-        mValid = false;
-        return;
-    }
     MNN_ASSERT(mCommon->kernelX() == mCommon->kernelY());
 
     int threadNumber = ((CPUBackend *)backend())->threadNumber();
@@ -62,30 +55,55 @@ ConvolutionWinograd::ConvolutionWinograd(const Convolution2DCommon *convOp, cons
 
     mA = generator.A();
     mB = generator.B();
-    
+    mPostParameters = getPostParameters();
+
+    // Other sessions of the model on the runtime may have transformed the same kernel
+    auto key = makeResourceKey(b, "Winograd_" + std::to_string(unit) + "_" + std::to_string(kernelSize) + "_" +
+                                      std::to_string(outputCount) + "_" + std::to_string(srcCount),
+                               originWeight, originWeightSize * sizeof(float), bias, biasSize * sizeof(float));
+    mResource = getSharedResource(b, key);
+    if (nullptr != mResource) {
+        return;
+    }
+    mResource.reset(new Resource);
+    mResource->backend = b;
+    if (!mResource->copyBiasAlign(bias, biasSize)) {
+        MNN_ERROR("Not Enough Memory\n");
+        mValid = false;
+        return;
+    }
 
     // Transform Kernel
     auto G = generator.G();
     // replace Tensor::createDevice by Tensor::create and allocTransformWeight's alloc=true to avoid malloc by onAcquireBuffer
     std::shared_ptr<Tensor> sourceWeight(Tensor::create<float>(
         std::vector<int>{outputCount, srcCount, kernelSize, kernelSize}, (void *)originWeight, Tensor::CAFFE));
-    auto tempWeight = generator.allocTransformWeight(sourceWeight.get(), lPack, hPack, true);
-    
-    auto shape = tempWeight->shape();
-    shape.push_back(bytes);
-    mResource->mWeight.reset(Tensor::createDevice<uint8_t>(shape));
+    // Transform to [alpha2, oc, ic] and pack each unit by MNNPackForMatMul_B, the layout of B depends on the kernel
+    auto tempWeight = generator.allocTransformWeight(sourceWeight.get(), 1, 1, true);
+    generator.transformWeight(tempWeight.get(), sourceWeight.get(), true);
+    mResource->mWeight.reset(Tensor::createDevice<uint8_t>(
+        {alpha2, UP_DIV(outputCount, hPack), UP_DIV(srcCount, lPack), lPack, hPack, bytes}));
     mValid = backend()->onAcquireBuffer(mResource->mWeight.get(), Backend::STATIC);
     if (!mValid) {
         return;
     }
-    generator.transformWeight(tempWeight.get(), sourceWeight.get(), true);
+    auto unitWeight = tempWeight->host<uint8_t>();
+    AutoStorage<int16_t> lowpWeight;
     if (bytes != 4) {
-        core->MNNFp32ToLowp(tempWeight->host<float>(), mResource->mWeight->host<int16_t>(), tempWeight->elementSize());
-    } else {
-        ::memcpy(mResource->mWeight->host<float>(), tempWeight->host<float>(), tempWeight->size());
+        lowpWeight.reset(tempWeight->elementSize());
+        if (nullptr == lowpWeight.get()) {
+            mValid = false;
+            return;
+        }
+        core->MNNFp32ToLowp(tempWeight->host<float>(), lowpWeight.get(), tempWeight->elementSize());
+        unitWeight = (uint8_t*)lowpWeight.get();
     }
-
-    mPostParameters = getPostParameters();
+    for (int i = 0; i < alpha2; ++i) {
+        core->MNNPackForMatMul_B((float*)(mResource->mWeight->host<uint8_t>() + i * mResource->mWeight->stride(0)),
+                                 (const float*)(unitWeight + i * outputCount * srcCount * bytes), outputCount,
+                                 srcCount, true);
+    }
+    setSharedResource(b, key, mResource);
 }
 ConvolutionWinograd::~ConvolutionWinograd() {
     // Do nothing
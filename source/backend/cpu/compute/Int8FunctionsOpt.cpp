@@ -357,3 +357,87 @@ void MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* src, const
 #undef UNIT
 #endif
 #endif
+
+#ifndef MNN_USE_SSE
+static inline int8_t _avgPoolRound(int32_t sum, int32_t count) {
+    return static_cast<int8_t>(sum > 0 ? (sum + count / 2) / count : (sum - count / 2) / count);
+}
+
+void MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    int c = 0;
+#ifdef MNN_USE_NEON
+    for (; c + 16 <= channel; c += 16) {
+        auto maxValue = vdupq_n_s8(-128);
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = vmaxq_s8(maxValue, vld1q_s8(srcY + x * channel));
+            }
+        }
+        vst1q_s8(dst + c, maxValue);
+    }
+#endif
+    for (; c < channel; ++c) {
+        int8_t maxValue = -128;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = ALIMAX(maxValue, srcY[x * channel]);
+            }
+        }
+        dst[c] = maxValue;
+    }
+}
+
+void MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    const int32_t count = (int32_t)(kx * ky);
+    int c = 0;
+#ifdef MNN_USE_NEON
+    for (; c + 16 <= channel; c += 16) {
+        int32x4_t sum[4] = {vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0)};
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                auto s   = vld1q_s8(srcY + x * channel);
+                auto s0  = vmovl_s8(vget_low_s8(s));
+                auto s1  = vmovl_s8(vget_high_s8(s));
+                sum[0] = vaddw_s16(sum[0], vget_low_s16(s0));
+                sum[1] = vaddw_s16(sum[1], vget_high_s16(s0));
+                sum[2] = vaddw_s16(sum[2], vget_low_s16(s1));
+                sum[3] = vaddw_s16(sum[3], vget_high_s16(s1));
+            }
+        }
+        int32_t temp[16];
+        for (int i = 0; i < 4; ++i) {
+            vst1q_s32(temp + 4 * i, sum[i]);
+        }
+        for (int i = 0; i < 16; ++i) {
+            dst[c + i] = _avgPoolRound(temp[i], count);
+        }
+    }
+#endif
+    for (; c < channel; ++c) {
+        int32_t sum = 0;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                sum += srcY[x * channel];
+            }
+        }
+        dst[c] = _avgPoolRound(sum, count);
+    }
+}
+
+#ifndef MNN_USE_NEON
+void MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                     const float* outputScale, const size_t size) {
+    for (int i = 0; i < size; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            float sum   = static_cast<float>(src0[i * 4 + k]) * scale0[k] + static_cast<float>(src1[i * 4 + k]) * scale1[k];
+            float value = sum * outputScale[k];
+            dst[i * 4 + k] = static_cast<int8_t>(ALIMAX(ALIMIN(value, 127.0f), -127.0f));
+        }
+    }
+}
+#endif
+#endif
@@ -82,6 +82,13 @@ int8_t MNNInt32ToInt8(int data, int bias, float scale, float maxValue ,float min
 void MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* src, const int8_t* weight, const QuanPostTreatParameters* parameters,
                                           size_t width, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step,
                                           size_t dilateY_step);
+// Pool a kx * ky window of NHWC int8, src is the first pixel of the window, the pixel stride is channel
+void MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+// Average rounds half away from zero
+void MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+// dst = (src0 * scale0 + src1 * scale1) * outputScale for size C4 pixels, scales have 4 values
+void MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                     const float* outputScale, const size_t size);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,144 @@
+//
+//  SoftmaxFunction.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/15.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef SoftmaxFunction_hpp
+#define SoftmaxFunction_hpp
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "math/VecMath.hpp"
+
+namespace MNN {
+// Online softmax: one read keeps the running max m and the sum s of exp(x - m), rescaling s
+// by exp(mOld - mNew) when m grows, the second read writes exp(x - m) / s.
+// Instanced by the sources of each instruction set, VEC is Math::Vec<float, N>
+template <typename VEC, int N>
+struct SoftmaxFunction {
+    template <typename V>
+    static inline void _update(V& m, V& s, V x) {
+        using Func = Math::VecMath<V, false>;
+        auto mNew  = V::max(m, x);
+        s          = s * Func::exp(m - mNew) + Func::exp(x - mNew);
+        m          = mNew;
+    }
+    // Four values share one rescale
+    template <typename V>
+    static inline void _update4(V& m, V& s, V x0, V x1, V x2, V x3) {
+        using Func = Math::VecMath<V, false>;
+        auto mNew  = V::max(m, V::max(V::max(x0, x1), V::max(x2, x3)));
+        auto sum   = (Func::exp(x0 - mNew) + Func::exp(x1 - mNew)) + (Func::exp(x2 - mNew) + Func::exp(x3 - mNew));
+        s          = s * Func::exp(m - mNew) + sum;
+        m          = mNew;
+    }
+
+    // Softmax along channel for UNIT vectors of columns, each lane is one column. The UNIT vectors of a
+    // channel are adjacent, so a large stride still uses whole cache lines
+    template <typename V, int UNIT>
+    static void _columns(float* dest, const float* source, size_t channel, size_t stride) {
+        using Func = Math::VecMath<V, false>;
+        constexpr int lane = sizeof(V) / sizeof(float);
+        V m[UNIT];
+        V s[UNIT];
+        for (int j = 0; j < UNIT; ++j) {
+            m[j] = V(-FLT_MAX);
+            s[j] = V(0.0f);
+        }
+        size_t c = 0;
+        for (; c + 4 <= channel; c += 4) {
+            auto src = source + c * stride;
+            for (int j = 0; j < UNIT; ++j) {
+                auto srcJ = src + j * lane;
+                _update4(m[j], s[j], V::load(srcJ), V::load(srcJ + stride), V::load(srcJ + 2 * stride),
+                         V::load(srcJ + 3 * stride));
+            }
+        }
+        for (; c < channel; ++c) {
+            for (int j = 0; j < UNIT; ++j) {
+                _update(m[j], s[j], V::load(source + c * stride + j * lane));
+            }
+        }
+        for (int j = 0; j < UNIT; ++j) {
+            s[j] = V(1.0f) / s[j];
+        }
+        for (c = 0; c < channel; ++c) {
+            auto src = source + c * stride;
+            auto dst = dest + c * stride;
+            for (int j = 0; j < UNIT; ++j) {
+                V::save(dst + j * lane, Func::exp(V::load(src + j * lane) - m[j]) * s[j]);
+            }
+        }
+    }
+
+    // Softmax of a contiguous row, the lanes are merged after the first read
+    static void _row(float* dest, const float* source, size_t size) {
+        using Func = Math::VecMath<VEC, false>;
+        VEC m(-FLT_MAX);
+        VEC s(0.0f);
+        size_t i = 0;
+        for (; i + 4 * N <= size; i += 4 * N) {
+            auto src = source + i;
+            _update4(m, s, VEC::load(src), VEC::load(src + N), VEC::load(src + 2 * N), VEC::load(src + 3 * N));
+        }
+        for (; i + N <= size; i += N) {
+            _update(m, s, VEC::load(source + i));
+        }
+        float temp[N];
+        if (i < size) {
+            // exp(-FLT_MAX - m) is zero, the padding doesn't change the sum
+            for (int k = 0; k < N; ++k) {
+                temp[k] = -FLT_MAX;
+            }
+            ::memcpy(temp, source + i, (size - i) * sizeof(float));
+            _update(m, s, VEC::load(temp));
+        }
+        float maxLane[N];
+        float sumLane[N];
+        VEC::save(maxLane, m);
+        VEC::save(sumLane, s);
+        float maxValue = maxLane[0];
+        for (int k = 1; k < N; ++k) {
+            maxValue = std::max(maxValue, maxLane[k]);
+        }
+        float sumValue = 0.0f;
+        for (int k = 0; k < N; ++k) {
+            sumValue += sumLane[k] * ::expf(maxLane[k] - maxValue);
+        }
+        VEC maxV(maxValue);
+        VEC scale(1.0f / sumValue);
+        for (i = 0; i + N <= size; i += N) {
+            VEC::save(dest + i, Func::exp(VEC::load(source + i) - maxV) * scale);
+        }
+        if (i < size) {
+            ::memcpy(temp, source + i, (size - i) * sizeof(float));
+            VEC::save(temp, Func::exp(VEC::load(temp) - maxV) * scale);
+            ::memcpy(dest + i, temp, (size - i) * sizeof(float));
+        }
+    }
+
+    // source / dest: [channel, stride], compute the first inside columns along channel
+    static void execute(float* dest, const float* source, size_t channel, size_t inside, size_t stride) {
+        if (1 == stride) {
+            _row(dest, source, channel);
+            return;
+        }
+        size_t x = 0;
+        for (; x + 4 * N <= inside; x += 4 * N) {
+            _columns<VEC, 4>(dest + x, source + x, channel, stride);
+        }
+        for (; x + N <= inside; x += N) {
+            _columns<VEC, 1>(dest + x, source + x, channel, stride);
+        }
+        for (; x < inside; ++x) {
+            _columns<Math::Vec<float, 1>, 1>(dest + x, source + x, channel, stride);
+        }
+    }
+};
+} // namespace MNN
+
+#endif /* SoftmaxFunction_hpp */
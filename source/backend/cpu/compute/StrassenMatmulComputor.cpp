@@ -74,11 +74,13 @@ ErrorCode StrassenMatrixComputor::_generateTrivalMatMul(const Tensor* AT, const
     auto cStride = CT->stride(0);
     int eP, lP, hP;
     core->MNNGetMatMulPackMode(&eP, &lP, &hP);
-    auto l = BT->length(1);
+    // B may be aligned to lP beyond the channels of A, the pack of A pads zero for the remain
+    auto l = std::min(BT->length(1), AT->length(0) * core->pack);
     auto numberThread = mSupportMultiThread ? ((CPUBackend*)backend())->threadNumber() : 1;
     auto bExtraStride = bStride - BT->length(1) * BT->length(2);
     AddTensor tileBuffer(Tensor::createDevice<uint8_t>(std::vector<int>{numberThread, UP_DIV(l, lP) * eP * lP * bytes}), backend());
     auto tileHostOrigin  = tileBuffer->host<uint8_t>();
+    auto tileSize = UP_DIV(l, lP) * eP * lP * bytes;
     int unitNumber = e / eP;
     int xCount     = e - unitNumber * eP;
     std::vector<size_t> parameters(6);
@@ -98,8 +100,8 @@ ErrorCode StrassenMatrixComputor::_generateTrivalMatMul(const Tensor* AT, const
     }
 
     mFunctions.emplace_back(
-        std::make_pair([xCount, aHost, bHost, cHost, tileHostOrigin, unitNumber, bExtraStride, numberThread, parameters, eReal, eP, biasPtr, active, packedA, matmul, matmulr, core](int tId) {
-            auto tileHost = tileHostOrigin + eP * parameters[1] * tId * core->bytes;
+        std::make_pair([xCount, aHost, bHost, cHost, tileHostOrigin, tileSize, unitNumber, bExtraStride, numberThread, parameters, eReal, eP, biasPtr, active, packedA, matmul, matmulr, core](int tId) {
+            auto tileHost = tileHostOrigin + tileSize * tId;
             const float* postParametersPtr = nullptr;
             if (!active.empty()) {
                 postParametersPtr = active.data();
@@ -169,7 +171,7 @@ ErrorCode StrassenMatrixComputor::_generateMatMul(const Tensor* AT, const Tensor
     auto remainH = h - hSub * 2;
     auto remainE = e - eSub * 2;
     auto lMinDiv = std::max(core->pack * 2, 2 * lP);
-    if (currentDepth >= mMaxDepth || eSub == 0 || hSub == 0 || lReal % lMinDiv != 0) {
+    if (currentDepth >= mMaxDepth || eSub == 0 || hSub == 0 || lReal % lMinDiv != 0 || l * aUnit != lReal) {
         return _generateTrivalMatMul(AT, BT, CT, COT, postParameters);
     }
 
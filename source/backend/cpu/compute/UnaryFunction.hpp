@@ -0,0 +1,85 @@
+//
+//  UnaryFunction.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef UnaryFunction_hpp
+#define UnaryFunction_hpp
+#include <string.h>
+#include <MNN/MNNForwardType.h>
+#include "MNN_generated.h"
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "math/VecMath.hpp"
+
+namespace MNN {
+// Instanced by the sources of each instruction set, VEC is Math::Vec<float, N>
+template <typename VEC, int N>
+struct UnaryFunction {
+    template <VEC (*FUNC)(VEC)>
+    static void execute(float* dst, const float* src, size_t size) {
+        size_t i = 0;
+        for (; i + N <= size; i += N) {
+            VEC::save(dst + i, FUNC(VEC::load(src + i)));
+        }
+        if (i < size) {
+            float temp[N];
+            ::memset(temp, 0, sizeof(temp));
+            ::memcpy(temp, src + i, (size - i) * sizeof(float));
+            VEC::save(temp, FUNC(VEC::load(temp)));
+            ::memcpy(dst + i, temp, (size - i) * sizeof(float));
+        }
+    }
+    template <bool LOWP>
+    static CoreFunctions::MNNUnaryExecute selectForPrecision(int type) {
+        using Func = Math::VecMath<VEC, LOWP>;
+        switch (type) {
+            case UnaryOpOperation_EXP:
+                return execute<Func::exp>;
+            case UnaryOpOperation_EXPM1:
+                return execute<Func::expm1>;
+            case UnaryOpOperation_LOG:
+                return execute<Func::log>;
+            case UnaryOpOperation_LOG1P:
+                return execute<Func::log1p>;
+            case UnaryOpOperation_SIGMOID:
+                return execute<Func::sigmoid>;
+            case UnaryOpOperation_TANH:
+                return execute<Func::tanh>;
+            case UnaryOpOperation_SINH:
+                return execute<Func::sinh>;
+            case UnaryOpOperation_COSH:
+                return execute<Func::cosh>;
+            case UnaryOpOperation_SIN:
+                return execute<Func::sin>;
+            case UnaryOpOperation_COS:
+                return execute<Func::cos>;
+            case UnaryOpOperation_TAN:
+                return execute<Func::tan>;
+            case UnaryOpOperation_ATAN:
+                return execute<Func::atan>;
+            case UnaryOpOperation_ASINH:
+                return execute<Func::asinh>;
+            case UnaryOpOperation_ACOSH:
+                return execute<Func::acosh>;
+            case UnaryOpOperation_ATANH:
+                return execute<Func::atanh>;
+            case UnaryOpOperation_ERF:
+                return execute<Func::erf>;
+            default:
+                break;
+        }
+        return nullptr;
+    }
+    static CoreFunctions::MNNUnaryExecute select(int type, int precision) {
+        if (BackendConfig::Precision_Low == precision) {
+            return selectForPrecision<true>(type);
+        }
+        return selectForPrecision<false>(type);
+    }
+};
+} // namespace MNN
+
+#endif /* UnaryFunction_hpp */
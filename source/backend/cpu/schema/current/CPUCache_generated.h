@@ -0,0 +1,321 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_CPUCACHE_CPUCACHE_H_
+#define FLATBUFFERS_GENERATED_CPUCACHE_CPUCACHE_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+namespace CPUCache {
+
+struct Tuning;
+struct TuningT;
+
+struct Cache;
+struct CacheT;
+
+inline const flatbuffers::TypeTable *TuningTypeTable();
+
+inline const flatbuffers::TypeTable *CacheTypeTable();
+
+struct TuningT : public flatbuffers::NativeTable {
+  typedef Tuning TableType;
+  std::string key;
+  std::vector<int32_t> choice;
+  float timeCost;
+  TuningT()
+      : timeCost(0.0f) {
+  }
+};
+
+struct Tuning FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef TuningT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return TuningTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEY = 4,
+    VT_CHOICE = 6,
+    VT_TIMECOST = 8
+  };
+  const flatbuffers::String *key() const {
+    return GetPointer<const flatbuffers::String *>(VT_KEY);
+  }
+  const flatbuffers::Vector<int32_t> *choice() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_CHOICE);
+  }
+  float timeCost() const {
+    return GetField<float>(VT_TIMECOST, 0.0f);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_KEY) &&
+           verifier.VerifyString(key()) &&
+           VerifyOffset(verifier, VT_CHOICE) &&
+           verifier.VerifyVector(choice()) &&
+           VerifyField<float>(verifier, VT_TIMECOST) &&
+           verifier.EndTable();
+  }
+  TuningT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(TuningT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Tuning> Pack(flatbuffers::FlatBufferBuilder &_fbb, const TuningT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct TuningBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_key(flatbuffers::Offset<flatbuffers::String> key) {
+    fbb_.AddOffset(Tuning::VT_KEY, key);
+  }
+  void add_choice(flatbuffers::Offset<flatbuffers::Vector<int32_t>> choice) {
+    fbb_.AddOffset(Tuning::VT_CHOICE, choice);
+  }
+  void add_timeCost(float timeCost) {
+    fbb_.AddElement<float>(Tuning::VT_TIMECOST, timeCost, 0.0f);
+  }
+  explicit TuningBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  TuningBuilder &operator=(const TuningBuilder &);
+  flatbuffers::Offset<Tuning> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Tuning>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Tuning> CreateTuning(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> key = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> choice = 0,
+    float timeCost = 0.0f) {
+  TuningBuilder builder_(_fbb);
+  builder_.add_timeCost(timeCost);
+  builder_.add_choice(choice);
+  builder_.add_key(key);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Tuning> CreateTuningDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *key = nullptr,
+    const std::vector<int32_t> *choice = nullptr,
+    float timeCost = 0.0f) {
+  auto key__ = key ? _fbb.CreateString(key) : 0;
+  auto choice__ = choice ? _fbb.CreateVector<int32_t>(*choice) : 0;
+  return CPUCache::CreateTuning(
+      _fbb,
+      key__,
+      choice__,
+      timeCost);
+}
+
+flatbuffers::Offset<Tuning> CreateTuning(flatbuffers::FlatBufferBuilder &_fbb, const TuningT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct CacheT : public flatbuffers::NativeTable {
+  typedef Cache TableType;
+  std::vector<std::unique_ptr<TuningT>> tunings;
+  CacheT() {
+  }
+};
+
+struct Cache FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef CacheT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return CacheTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TUNINGS = 4
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<Tuning>> *tunings() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<Tuning>> *>(VT_TUNINGS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_TUNINGS) &&
+           verifier.VerifyVector(tunings()) &&
+           verifier.VerifyVectorOfTables(tunings()) &&
+           verifier.EndTable();
+  }
+  CacheT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(CacheT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Cache> Pack(flatbuffers::FlatBufferBuilder &_fbb, const CacheT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct CacheBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_tunings(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Tuning>>> tunings) {
+    fbb_.AddOffset(Cache::VT_TUNINGS, tunings);
+  }
+  explicit CacheBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  CacheBuilder &operator=(const CacheBuilder &);
+  flatbuffers::Offset<Cache> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Cache>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Cache> CreateCache(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Tuning>>> tunings = 0) {
+  CacheBuilder builder_(_fbb);
+  builder_.add_tunings(tunings);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Cache> CreateCacheDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<flatbuffers::Offset<Tuning>> *tunings = nullptr) {
+  auto tunings__ = tunings ? _fbb.CreateVector<flatbuffers::Offset<Tuning>>(*tunings) : 0;
+  return CPUCache::CreateCache(
+      _fbb,
+      tunings__);
+}
+
+flatbuffers::Offset<Cache> CreateCache(flatbuffers::FlatBufferBuilder &_fbb, const CacheT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+inline TuningT *Tuning::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new TuningT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void Tuning::UnPackTo(TuningT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = key(); if (_e) _o->key = _e->str(); };
+  { auto _e = choice(); if (_e) { _o->choice.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->choice[_i] = _e->Get(_i); } } };
+  { auto _e = timeCost(); _o->timeCost = _e; };
+}
+
+inline flatbuffers::Offset<Tuning> Tuning::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TuningT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateTuning(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Tuning> CreateTuning(flatbuffers::FlatBufferBuilder &_fbb, const TuningT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const TuningT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _key = _o->key.empty() ? 0 : _fbb.CreateString(_o->key);
+  auto _choice = _o->choice.size() ? _fbb.CreateVector(_o->choice) : 0;
+  auto _timeCost = _o->timeCost;
+  return CPUCache::CreateTuning(
+      _fbb,
+      _key,
+      _choice,
+      _timeCost);
+}
+
+inline CacheT *Cache::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new CacheT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void Cache::UnPackTo(CacheT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = tunings(); if (_e) { _o->tunings.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->tunings[_i] = std::unique_ptr<TuningT>(_e->Get(_i)->UnPack(_resolver)); } } };
+}
+
+inline flatbuffers::Offset<Cache> Cache::Pack(flatbuffers::FlatBufferBuilder &_fbb, const CacheT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateCache(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Cache> CreateCache(flatbuffers::FlatBufferBuilder &_fbb, const CacheT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const CacheT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _tunings = _o->tunings.size() ? _fbb.CreateVector<flatbuffers::Offset<Tuning>> (_o->tunings.size(), [](size_t i, _VectorArgs *__va) { return CreateTuning(*__va->__fbb, __va->__o->tunings[i].get(), __va->__rehasher); }, &_va ) : 0;
+  return CPUCache::CreateCache(
+      _fbb,
+      _tunings);
+}
+
+inline const flatbuffers::TypeTable *TuningTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_INT, 1, -1 },
+    { flatbuffers::ET_FLOAT, 0, -1 }
+  };
+  static const char * const names[] = {
+    "key",
+    "choice",
+    "timeCost"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 3, type_codes, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *CacheTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_SEQUENCE, 1, 0 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    TuningTypeTable
+  };
+  static const char * const names[] = {
+    "tunings"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 1, type_codes, type_refs, nullptr, names
+  };
+  return &tt;
+}
+
+inline const CPUCache::Cache *GetCache(const void *buf) {
+  return flatbuffers::GetRoot<CPUCache::Cache>(buf);
+}
+
+inline const CPUCache::Cache *GetSizePrefixedCache(const void *buf) {
+  return flatbuffers::GetSizePrefixedRoot<CPUCache::Cache>(buf);
+}
+
+inline const char *CacheIdentifier() {
+  return "MCPU";
+}
+
+inline bool CacheBufferHasIdentifier(const void *buf) {
+  return flatbuffers::BufferHasIdentifier(
+      buf, CacheIdentifier());
+}
+
+inline bool VerifyCacheBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<CPUCache::Cache>(CacheIdentifier());
+}
+
+inline bool VerifySizePrefixedCacheBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<CPUCache::Cache>(CacheIdentifier());
+}
+
+inline void FinishCacheBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<CPUCache::Cache> root) {
+  fbb.Finish(root, CacheIdentifier());
+}
+
+inline void FinishSizePrefixedCacheBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<CPUCache::Cache> root) {
+  fbb.FinishSizePrefixed(root, CacheIdentifier());
+}
+
+inline std::unique_ptr<CacheT> UnPackCache(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return std::unique_ptr<CacheT>(GetCache(buf)->UnPack(res));
+}
+
+}  // namespace CPUCache
+
+#endif  // FLATBUFFERS_GENERATED_CPUCACHE_CPUCACHE_H_
@@ -0,0 +1,166 @@
+//
+//  AVX2Backend.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <algorithm>
+
+#include "AVX2Functions.hpp"
+#include "AVX2Backend.hpp"
+#include "core/AutoStorage.h"
+#include "core/BufferAllocator.hpp"
+#include "core/TensorUtils.hpp"
+#include "core/OpCommonUtils.hpp"
+#include "backend/cpu/CPUTensorConvert.hpp"
+
+namespace MNN {
+
+static Backend* _createAVX2Backend(const CPURuntime* runtime, BackendConfig::PrecisionMode precision) {
+    return new AVX2Backend(runtime, precision);
+}
+
+bool AVX2Backend::init(int cpuFlags) {
+    if (!AVX2Functions::init(cpuFlags)) {
+        return false;
+    }
+    CPURuntime::gExtraCreate = _createAVX2Backend;
+    return true;
+}
+
+AVX2Backend::AVX2Backend(const CPURuntime* runtime, BackendConfig::PrecisionMode precision) : CPUBackend(runtime, precision, MNN_FORWARD_CPU_EXTENSION) {
+    mCoreFunctions = AVX2Functions::get();
+}
+
+AVX2Backend::~AVX2Backend() {
+    // nothing to do
+}
+
+// CPUBinaryFloat computes flat arrays of getTensorSize() elements only for these, the others are by shape
+static bool _supportBinary(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs, const MNN::Op* op) {
+    auto type = op->main_as_BinaryOp()->opType();
+    bool scalar = false;
+    switch (type) {
+        case BinaryOpOperation_ADD:
+        case BinaryOpOperation_SUB:
+        case BinaryOpOperation_MUL:
+            scalar = true;
+            break;
+        case BinaryOpOperation_MAXIMUM:
+            break;
+        default:
+            return false;
+    }
+    auto format = TensorUtils::getDescribe(outputs[0])->dimensionFormat;
+    for (auto t : inputs) {
+        if (scalar && t->elementSize() == 1) {
+            continue;
+        }
+        if (t->elementSize() != outputs[0]->elementSize() || TensorUtils::getDescribe(t)->dimensionFormat != format) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Ops reading NC4HW4 by CoreFunctions or as a flat array of getTensorSize() elements
+static bool _supportWidePack(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs, const MNN::Op* op) {
+    if (OpCommonUtils::opCompabilityForLowp(op)) {
+        return true;
+    }
+    switch (op->type()) {
+        case OpType_Raster:
+        case OpType_UnaryOp:
+        case OpType_ReLU:
+        case OpType_ReLU6:
+            return true;
+        case OpType_BinaryOp:
+            return _supportBinary(inputs, outputs, op);
+        default:
+            break;
+    }
+    return false;
+}
+
+Execution* AVX2Backend::onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                 const MNN::Op* op) {
+    for (auto t : outputs) {
+        if (t->getType().code != halide_type_float) {
+            return nullptr;
+        }
+    }
+    auto quantInfo = OpCommonUtils::getQuantInfo(inputs);
+    if (quantInfo.first) {
+        return nullptr;
+    }
+    if (!_supportWidePack(inputs, outputs, op)) {
+        return nullptr;
+    }
+    return CPUBackend::onCreate(inputs, outputs, op);
+}
+
+bool AVX2Backend::onAcquireBuffer(const Tensor* nativeTensor, StorageType storageType) {
+    auto res = CPUBackend::onAcquireBuffer(nativeTensor, storageType);
+    if (!res) {
+        return false;
+    }
+    // Set mask in device for the tensors packed by mCoreFunctions->pack
+    auto& buffer = const_cast<Tensor*>(nativeTensor)->buffer();
+    if (buffer.type == halide_type_of<float>() &&
+        TensorUtils::getDescribe(nativeTensor)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4) {
+        buffer.device = 1;
+    }
+    return true;
+}
+
+void AVX2Backend::_convertPack(const Tensor* srcTensor, const Tensor* dstTensor, bool srcPacked) const {
+    auto source = TensorUtils::getDescribe(srcTensor)->dimensionFormat;
+    auto dest   = TensorUtils::getDescribe(dstTensor)->dimensionFormat;
+    auto tup    = CPUTensorConverter::splitDimensions(srcTensor->buffer(), source);
+    int area = std::get<1>(tup), batch = std::get<0>(tup), channel = std::get<2>(tup);
+    if (source != dest) {
+        // The NC4HW4 side is the packed one
+        auto code = CPUTensorConverter::convert(srcTensor->host<void>(), dstTensor->host<void>(), source, dest, batch, area, channel, 4, mCoreFunctions);
+        MNN_ASSERT(code == ErrorCode::NO_ERROR);
+        return;
+    }
+    // NC4HW4 of different packs, turn to NCHW first
+    AutoStorage<float> temp(batch * area * channel);
+    CPUTensorConverter::convert(srcTensor->host<void>(), temp.get(), source, MNN_DATA_FORMAT_NCHW, batch, area, channel, 4, srcPacked ? mCoreFunctions : nullptr);
+    CPUTensorConverter::convert(temp.get(), dstTensor->host<void>(), MNN_DATA_FORMAT_NCHW, dest, batch, area, channel, 4, srcPacked ? nullptr : mCoreFunctions);
+}
+
+void AVX2Backend::onCopyBuffer(const Tensor* srcTensor, const Tensor* dstTensor) const {
+    bool srcPacked = srcTensor->buffer().device != 0 && TensorUtils::getDescribe(srcTensor)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4;
+    bool dstPacked = dstTensor->buffer().device != 0 && TensorUtils::getDescribe(dstTensor)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4;
+    if (srcPacked == dstPacked) {
+        if (srcPacked) {
+            ::memcpy(dstTensor->host<void>(), srcTensor->host<void>(), getTensorSize(srcTensor) * sizeof(float));
+            return;
+        }
+        CPUBackend::onCopyBuffer(srcTensor, dstTensor);
+        return;
+    }
+    if (nullptr == srcTensor->host<void>() || nullptr == dstTensor->host<void>()) {
+        return;
+    }
+    // One side is float packed by mCoreFunctions->pack, the other side is a tensor of CPUBackend
+    auto other = srcPacked ? dstTensor : srcTensor;
+    if (other->getType() == halide_type_of<float>()) {
+        _convertPack(srcTensor, dstTensor, srcPacked);
+        return;
+    }
+    // Cast by CPUBackend with the same format
+    std::shared_ptr<Tensor> temp(Tensor::create<float>(other->shape(), nullptr, TensorUtils::getDimType(other)));
+    if (srcPacked) {
+        _convertPack(srcTensor, temp.get(), true);
+        CPUBackend::onCopyBuffer(temp.get(), dstTensor);
+        return;
+    }
+    CPUBackend::onCopyBuffer(srcTensor, temp.get());
+    _convertPack(temp.get(), dstTensor, false);
+}
+
+} // namespace MNN
@@ -0,0 +1,37 @@
+//
+//  AVX2Backend.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef AVX2Backend_hpp
+#define AVX2Backend_hpp
+
+#include "backend/cpu/CPUBackend.hpp"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+
+namespace MNN {
+// CPU backend packing NC4HW4 tensors by the vector width, created by CPURuntime for MNN_CPU_WIDE_PACK
+class AVX2Backend : public CPUBackend {
+public:
+    virtual ~AVX2Backend();
+    AVX2Backend(const CPURuntime* runtime, BackendConfig::PrecisionMode precision);
+    virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                const MNN::Op* op) override;
+    virtual bool onAcquireBuffer(const Tensor* nativeTensor, StorageType storageType) override;
+
+    virtual void onCopyBuffer(const Tensor* srcTensor, const Tensor* dstTensor) const override;
+
+    // Called by MNNFunctionInit, returns false if the cpu doesn't support it
+    static bool init(int cpuFlags);
+
+private:
+    void _convertPack(const Tensor* srcTensor, const Tensor* dstTensor, bool srcPacked) const;
+};
+
+} // namespace MNN
+
+#endif /* AVX2Backend_hpp */
@@ -0,0 +1,36 @@
+//
+//  AVX2Functions.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "AVX2Functions.hpp"
+#include "avxfma/FunctionSummary.hpp"
+#include "avx512/FunctionSummary.hpp"
+#include "cpu_id.h"
+
+namespace MNN {
+static CoreFunctions* gInstance = nullptr;
+
+bool AVX2Functions::init(int cpuFlags) {
+    if (!(cpuFlags & libyuv::kCpuHasAVX2) || !(cpuFlags & libyuv::kCpuHasFMA3)) {
+        return false;
+    }
+    gInstance = new CoreFunctions;
+    *gInstance = *MNNGetCoreFunctions();
+#ifdef MNN_AVX512
+    if (cpuFlags & libyuv::kCpuHasAVX512F) {
+        _AVX512_ExtraInit(gInstance);
+        return true;
+    }
+#endif
+    _AVX_ExtraInit(gInstance);
+    return true;
+}
+
+CoreFunctions* AVX2Functions::get() {
+    return gInstance;
+}
+};
@@ -0,0 +1,26 @@
+//
+//  AVX2Functions.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef AVX2Functions_hpp
+#define AVX2Functions_hpp
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/Macro.h"
+#include "backend/cpu/compute/CommonOptFunction.h"
+
+namespace MNN {
+// CoreFunctions packing NC4HW4 by 8 (AVX2) or 16 (AVX-512), the others are the same as MNNGetCoreFunctions()
+class AVX2Functions {
+public:
+    static bool init(int cpuFlags);
+    static CoreFunctions* get();
+};
+};
+
+#endif
@@ -10,9 +10,13 @@
 #include "avx512/FunctionSummary.hpp"
 #include "avx/FunctionSummary.hpp"
 #include "avxfma/FunctionSummary.hpp"
+#ifdef MNN_AVXVNNI
+#include "avxvnni/FunctionSummary.hpp"
+#endif
 #include "backend/cpu/compute/CommonOptFunction.h"
 #include "backend/cpu/compute/ConvOpt.h"
 #include "backend/cpu/compute/Int8FunctionsOpt.h"
+#include "AVX2Backend.hpp"
 #include "cpu_id.h"
 #include "sse/FunctionSummary.hpp"
 // https://stackoverflow.com/a/11230437
@@ -42,6 +46,9 @@ struct FunctionGroup {
     void (*MNNReluWithSlopeChannel)(float* dst, const float* src, const float* slope, size_t sizeQuad, size_t depthQuad) = _SSE_MNNReluWithSlopeChannel;
     void (*MNNReluInt8)(int8_t* dst, const int8_t* src, size_t size) = _SSE_MNNReluInt8;
     void (*MNNHardSwish)(float* dst, const float* src, size_t size) = _SSE_MNNHardSwish;
+    void (*MNNMaxPoolInt8)(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) = _SSE_MNNMaxPoolInt8;
+    void (*MNNAvgPoolInt8)(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) = _SSE_MNNAvgPoolInt8;
+    void (*MNNScaleAddInt8)(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1, const float* outputScale, const size_t size) = _SSE_MNNScaleAddInt8;
 };
 
 static FunctionGroup gFunc;
@@ -86,25 +93,51 @@ void MNNFunctionInit() {
         gFunc.MNNComputeMatMulForE_1 = _AVX_MNNComputeMatMulForE_1;
         gFunc.MNNGemmInt8AddBiasScale_16x4_Unit_FAST = _AVX_MNNGemmInt8AddBiasScale_16x4_Unit_Fast;
         gFunc.MNNReluWithSlopeChannel = _AVX_MNNReluWithSlopeChannel;
+        gFunc.MNNMaxPoolInt8 = _AVX_MNNMaxPoolInt8;
+        gFunc.MNNAvgPoolInt8 = _AVX_MNNAvgPoolInt8;
+        gFunc.MNNScaleAddInt8 = _AVX_MNNScaleAddInt8;
+#ifdef MNN_AVXVNNI
+        if (cpuFlags & libyuv::kCpuHasAVXVNNI) {
+            gFunc.MNNLineDepthWiseInt8AddBiasScaleUnit = _AVXVNNI_MNNLineDepthWiseInt8AddBiasScaleUnit;
+        }
+#endif
         if (cpuFlags & libyuv::kCpuHasFMA3) {
             coreFunction->MNNPackedMatMul       = _AVX_MNNPackedMatMulFMA;
             coreFunction->MNNPackedMatMulRemain = _AVX_MNNPackedMatMulRemainFMA;
             gFunc.MNNComputeMatMulForE_1 = _AVX_MNNComputeMatMulForE_1FMA;
+            coreFunction->MNNSelectUnaryFunctionForFloat = _AVX_MNNSelectUnaryFunctionForFloat;
+            coreFunction->MNNSoftmax = _AVX_MNNSoftmax;
         }
     }
 #ifdef MNN_AVX512
+    // Selected separately: float kernels need AVX512F, int8 pool / eltwise AVX512BW and int8 GEMM / depthwise VNNI
+    if ((cpuFlags & libyuv::kCpuHasAVX512F) && (cpuFlags & libyuv::kCpuHasFMA3)) {
+        gFunc.eP                            = 24;
+        gFunc.lP                            = 1;
+        gFunc.hP                            = 16;
+        coreFunction->MNNPackForMatMul_B    = _AVX512F_MNNPackForMatMul_B;
+        coreFunction->MNNPackC4ForMatMul_A  = _AVX_MNNPackC4ForMatMul_A;
+        coreFunction->MNNPackedMatMul       = _AVX512F_MNNPackedMatMul;
+        coreFunction->MNNPackedMatMulRemain = _AVX512F_MNNPackedMatMulRemain;
+        coreFunction->MNNSelectUnaryFunctionForFloat = _AVX512F_MNNSelectUnaryFunctionForFloat;
+        coreFunction->MNNSoftmax = _AVX512F_MNNSoftmax;
+    }
+    if ((cpuFlags & libyuv::kCpuHasAVX512BW) && (cpuFlags & libyuv::kCpuHasAVX512VL)) {
+        gFunc.MNNReluInt8 = _AVX512_MNNReluInt8;
+        gFunc.MNNFloat2Int8 = _AVX512_MNNFloat2Int8;
+        gFunc.MNNInt8ScaleToFloat = _AVX512_MNNInt8ScaleToFloat;
+        gFunc.MNNMaxPoolInt8 = _AVX512_MNNMaxPoolInt8;
+        gFunc.MNNAvgPoolInt8 = _AVX512_MNNAvgPoolInt8;
+        gFunc.MNNScaleAddInt8 = _AVX512_MNNScaleAddInt8;
+    }
     if (cpuFlags & libyuv::kCpuHasAVX512VNNI) {
-        coreFunction->MNNPackForMatMul_B    = _AVX512_MNNPackForMatMul_B;
-        coreFunction->MNNPackC4ForMatMul_A  = _AVX512_MNNPackC4ForMatMul_A;
-        coreFunction->MNNPackedMatMul = _AVX512_MNNPackedMatMul;
-        coreFunction->MNNPackedMatMulRemain = _AVX512_MNNPackedMatMulRemain;
-        gFunc.eP                    = 24;
-        gFunc.hP                    = 4;
-        gFunc.lP                    = 4;
         gFunc.MNNGemmInt8AddBiasScale_16x4_Unit = _AVX512_MNNGemmInt8AddBiasScale_16x4_Unit;
         gFunc.MNNGemmInt8AddBiasScale_16x4_Unit_FAST = _AVX512_MNNGemmInt8AddBiasScale_16x4_Unit;
+        gFunc.MNNLineDepthWiseInt8AddBiasScaleUnit = _AVX512_MNNLineDepthWiseInt8AddBiasScaleUnit;
     }
 #endif
+    // NC8HW8 / NC16HW16 for MNN_CPU_WIDE_PACK, based on the functions above
+    MNN::AVX2Backend::init(cpuFlags);
 }
 
 // ========= CommonOptFunction.cpp ===========
@@ -125,6 +158,18 @@ void MNNReluInt8(int8_t* dst, const int8_t* src, size_t size) {
     return gFunc.MNNReluInt8(dst, src, size);
 }
 
+void MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    gFunc.MNNMaxPoolInt8(dst, src, channel, srcRowStride, kx, ky);
+}
+
+void MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    gFunc.MNNAvgPoolInt8(dst, src, channel, srcRowStride, kx, ky);
+}
+
+void MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1, const float* outputScale, const size_t size) {
+    gFunc.MNNScaleAddInt8(dst, src0, src1, scale0, scale1, outputScale, size);
+}
+
 void MNNHardSwish(float* dst, const float* src, size_t size) {
     return gFunc.MNNHardSwish(dst, src, size);
 }
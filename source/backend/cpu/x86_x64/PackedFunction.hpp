@@ -0,0 +1,406 @@
+//
+//  PackedFunction.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef PackedFunction_hpp
+#define PackedFunction_hpp
+
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include "core/Macro.h"
+#include "math/Vec.hpp"
+
+// The NC4HW4's functions of CoreFunctions for a pack of P floats, VEC is MNN::Math::Vec<float, P>.
+// Instantiated in avxfma/ for P = 8 and avx512/ for P = 16, see AVX2Functions
+namespace MNN {
+template <typename VEC, int P>
+struct PackedFunction {
+    static void packCUnit(float* dst, const float* src, size_t area, size_t depth) {
+        int depthC = (int)depth / P;
+        int remain = (int)depth - depthC * P;
+        for (int z = 0; z < depthC; ++z) {
+            auto srcZ = src + z * P * area;
+            auto dstZ = dst + z * P * area;
+            for (int x = 0; x < area; ++x) {
+                for (int y = 0; y < P; ++y) {
+                    dstZ[P * x + y] = srcZ[y * area + x];
+                }
+            }
+        }
+        if (remain > 0) {
+            auto srcZ = src + depthC * P * area;
+            auto dstZ = dst + depthC * P * area;
+            for (int x = 0; x < area; ++x) {
+                for (int y = 0; y < remain; ++y) {
+                    dstZ[P * x + y] = srcZ[y * area + x];
+                }
+                for (int y = remain; y < P; ++y) {
+                    dstZ[P * x + y] = 0.0f;
+                }
+            }
+        }
+    }
+    static void unpackCUnit(float* dst, const float* src, size_t area, size_t depth) {
+        int depthC = UP_DIV((int)depth, P);
+        for (int z = 0; z < depthC; ++z) {
+            auto srcZ = src + z * P * area;
+            auto dstZ = dst + z * P * area;
+            auto number = std::min(P, (int)depth - z * P);
+            for (int y = 0; y < number; ++y) {
+                for (int x = 0; x < area; ++x) {
+                    dstZ[y * area + x] = srcZ[P * x + y];
+                }
+            }
+        }
+    }
+    // [area, depth] -> [depth / P, area, P]
+    static void packCUnitTranspose(float* dst, const float* src, size_t area, size_t depth) {
+        int depthC = (int)depth / P;
+        int remain = (int)depth - depthC * P;
+        for (int z = 0; z < depthC; ++z) {
+            auto dstZ = dst + z * P * area;
+            for (int x = 0; x < area; ++x) {
+                VEC::save(dstZ + P * x, VEC::load(src + x * depth + z * P));
+            }
+        }
+        if (remain > 0) {
+            auto dstZ = dst + depthC * P * area;
+            float temp[P];
+            ::memset(temp, 0, sizeof(temp));
+            for (int x = 0; x < area; ++x) {
+                ::memcpy(temp, src + x * depth + depthC * P, remain * sizeof(float));
+                VEC::save(dstZ + P * x, VEC::load(temp));
+            }
+        }
+    }
+    // [depth / P, area, P] -> [area, depth]
+    static void unpackCUnitTranspose(float* dst, const float* src, size_t area, size_t depth) {
+        int depthC = (int)depth / P;
+        int remain = (int)depth - depthC * P;
+        for (int z = 0; z < depthC; ++z) {
+            auto srcZ = src + z * P * area;
+            for (int x = 0; x < area; ++x) {
+                VEC::save(dst + x * depth + z * P, VEC::load(srcZ + P * x));
+            }
+        }
+        if (remain > 0) {
+            auto srcZ = src + depthC * P * area;
+            for (int x = 0; x < area; ++x) {
+                ::memcpy(dst + x * depth + depthC * P, srcZ + P * x, remain * sizeof(float));
+            }
+        }
+    }
+
+    static void convRunForUnitDepthWise(float* dst, const float* src, const float* weight, size_t fw, size_t fh,
+                                        size_t weight_y_step, size_t dilateX_step, size_t dilateY_step) {
+        VEC dstValue(0.0f);
+        for (int fy = 0; fy < fh; ++fy) {
+            const float* srcY    = src + fy * dilateY_step;
+            const float* weightY = weight + fy * weight_y_step;
+            for (int fx = 0; fx < fw; ++fx) {
+                dstValue = VEC::fma(dstValue, VEC::load(srcY + fx * dilateX_step), VEC::load(weightY + P * fx));
+            }
+        }
+        VEC::save(dst, dstValue);
+    }
+    static void convRunForLineDepthwise(float* dst, const float* src, const float* weight, size_t width,
+                                        size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step,
+                                        size_t dilateY_step, size_t height, size_t srcHStep, size_t dstHStep) {
+        for (int y = 0; y < height; ++y) {
+            auto srcY = src + y * srcHStep;
+            auto dstY = dst + y * dstHStep;
+            int dx    = 0;
+            // Two outputs at once share the loads of the weight
+            for (; dx + 1 < width; dx += 2) {
+                VEC dst0(0.0f);
+                VEC dst1(0.0f);
+                const float* src0 = srcY + src_w_setup * dx;
+                const float* src1 = src0 + src_w_setup;
+                for (int fy = 0; fy < fh; ++fy) {
+                    const float* weightY = weight + fy * fw * P;
+                    for (int fx = 0; fx < fw; ++fx) {
+                        auto w   = VEC::load(weightY + P * fx);
+                        auto off = fy * dilateY_step + fx * dilateX_step;
+                        dst0     = VEC::fma(dst0, VEC::load(src0 + off), w);
+                        dst1     = VEC::fma(dst1, VEC::load(src1 + off), w);
+                    }
+                }
+                VEC::save(dstY + dx * P, dst0);
+                VEC::save(dstY + (dx + 1) * P, dst1);
+            }
+            for (; dx < width; ++dx) {
+                convRunForUnitDepthWise(dstY + dx * P, srcY + src_w_setup * dx, weight, fw, fh, fw * P, dilateX_step,
+                                        dilateY_step);
+            }
+        }
+    }
+    static void deconvRunForUnitDepthWise(const float* dst, float* src, const float* weight, size_t fw, size_t fh,
+                                          size_t weight_y_step, size_t dilateX_step, size_t dilateY_step) {
+        auto dstV = VEC::load(dst);
+        for (int fy = 0; fy < fh; ++fy) {
+            float* srcY          = src + fy * dilateY_step;
+            const float* weightY = weight + fy * weight_y_step;
+            for (int fx = 0; fx < fw; ++fx) {
+                auto srcX = srcY + fx * dilateX_step;
+                VEC::save(srcX, VEC::fma(VEC::load(srcX), VEC::load(weightY + P * fx), dstV));
+            }
+        }
+    }
+    static void deconvRunForLineDepthwise(const float* dst, float* src, const float* weight, size_t width,
+                                          size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step,
+                                          size_t dilateY_step) {
+        for (int dx = 0; dx < width; ++dx) {
+            deconvRunForUnitDepthWise(dst + dx * P, src + src_w_setup * dx, weight, fw, fh, fw * P, dilateX_step,
+                                      dilateY_step);
+        }
+    }
+
+    static void axByClampBroadcastUnit(float* C, const float* A, const float* B, size_t width, size_t cStride,
+                                       size_t aStride, size_t height, const float* parameters) {
+        auto minF = VEC(parameters[2]);
+        auto maxF = VEC(parameters[3]);
+        auto beta = VEC(parameters[1]);
+        for (int y = 0; y < height; ++y) {
+            auto a  = A + aStride * y;
+            auto bv = VEC::load(B + P * y) * beta;
+            auto c  = C + cStride * y;
+            for (int x = 0; x < width; ++x) {
+                auto cv = VEC::load(a + P * x) + bv;
+                cv      = VEC::min(cv, maxF);
+                cv      = VEC::max(cv, minF);
+                VEC::save(c + P * x, cv);
+            }
+        }
+    }
+    static void matrixAdd(float* C, const float* A, const float* B, size_t widthC, size_t cStride, size_t aStride,
+                          size_t bStride, size_t height) {
+        for (int y = 0; y < height; ++y) {
+            auto a = A + aStride * y;
+            auto b = B + bStride * y;
+            auto c = C + cStride * y;
+            for (int x = 0; x < widthC; ++x) {
+                VEC::save(c + P * x, VEC::load(a + P * x) + VEC::load(b + P * x));
+            }
+        }
+    }
+    static void matrixSub(float* C, const float* A, const float* B, size_t widthC, size_t cStride, size_t aStride,
+                          size_t bStride, size_t height) {
+        for (int y = 0; y < height; ++y) {
+            auto a = A + aStride * y;
+            auto b = B + bStride * y;
+            auto c = C + cStride * y;
+            for (int x = 0; x < widthC; ++x) {
+                VEC::save(c + P * x, VEC::load(a + P * x) - VEC::load(b + P * x));
+            }
+        }
+    }
+    static void strassenMergeCFunction(float* c11, float* c12, float* c21, float* c22, float* xAddr, size_t cStride,
+                                       size_t eSub, size_t hSub) {
+        for (int y = 0; y < hSub; ++y) {
+            auto c11Y = c11 + y * cStride;
+            auto c12Y = c12 + y * cStride;
+            auto c22Y = c22 + y * cStride;
+            auto c21Y = c21 + y * cStride;
+            auto xY   = xAddr + y * eSub * P;
+            for (int x = 0; x < eSub; ++x) {
+                auto xv   = VEC::load(xY + P * x);
+                auto c21v = VEC::load(c21Y + P * x);
+                auto c11v = VEC::load(c11Y + P * x);
+                auto c22v = VEC::load(c22Y + P * x);
+                auto c12v = VEC::load(c12Y + P * x);
+                c12v      = c12v + xv;
+                c21v      = c12v + c21v;
+                c12v      = c22v + c12v;
+                c22v      = c22v + c21v;
+                c12v      = c11v + c12v;
+                VEC::save(c12Y + P * x, c12v);
+                VEC::save(c22Y + P * x, c22v);
+                VEC::save(c21Y + P * x, c21v);
+            }
+        }
+    }
+    static void scaleAndAddBias(float* dst, const float* src, const float* bias, const float* alpha,
+                                size_t planeNumber, size_t biasNumber) {
+        for (int z = 0; z < biasNumber; ++z) {
+            float* dstZ       = dst + planeNumber * P * z;
+            const float* srcZ = src + planeNumber * P * z;
+            auto biasZ        = VEC::load(bias + P * z);
+            auto alphaZ       = VEC::load(alpha + P * z);
+            for (int p = 0; p < planeNumber; ++p) {
+                VEC::save(dstZ + P * p, VEC::fma(biasZ, VEC::load(srcZ + P * p), alphaZ));
+            }
+        }
+    }
+    static void copyCUnitWithStride(const float* source, float* dest, size_t srcStride, size_t dstStride,
+                                    size_t count) {
+        for (int i = 0; i < count; ++i) {
+            VEC::save(dest + i * dstStride, VEC::load(source + i * srcStride));
+        }
+    }
+    static void addCUnitWithStride(const float* source, float* dest, size_t srcStride, size_t dstStride,
+                                   size_t count) {
+        for (int i = 0; i < count; ++i) {
+            auto d = dest + i * dstStride;
+            VEC::save(d, VEC::load(d) + VEC::load(source + i * srcStride));
+        }
+    }
+
+    // Depthwise 3x3 by winograd F(2, 3), the weight is transformed to [4 * 3, P] for each pack
+    static void convDwF23SourceTransUnit(const float* source, float* dest, size_t unit) {
+        if (unit <= 0) {
+            return;
+        }
+        VEC v0 = VEC::load(source + P * 0);
+        VEC v1 = VEC::load(source + P * 1);
+        source += 2 * P;
+        for (int x = 0; x < unit; ++x) {
+            VEC v2 = VEC::load(source + P * 0);
+            VEC v3 = VEC::load(source + P * 1);
+            VEC::save(dest + P * 0, v0 - v2);
+            VEC::save(dest + P * 1, v1 + v2);
+            VEC::save(dest + P * 2, v2 - v1);
+            VEC::save(dest + P * 3, v3 - v1);
+            source += 2 * P;
+            dest += 4 * P;
+            v0 = v2;
+            v1 = v3;
+        }
+    }
+    static void sourceTransformCommonF23(const float* source, float* dest, int unit, int iw, int pad, int su,
+                                         int eu) {
+        auto transClamp = [&](int x) {
+            auto dstX    = dest + 4 * P * x;
+            auto sx      = x * 2 - pad;
+            auto clampSx = std::max(sx, 0);
+            auto clampEx = std::min(sx + 4, iw);
+            VEC v[4]     = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int i = clampSx; i < clampEx; ++i) {
+                v[i - sx] = VEC::load(source + P * i);
+            }
+            VEC::save(dstX + P * 0, v[0] - v[2]);
+            VEC::save(dstX + P * 1, v[1] + v[2]);
+            VEC::save(dstX + P * 2, v[2] - v[1]);
+            VEC::save(dstX + P * 3, v[3] - v[1]);
+        };
+        for (int x = 0; x < su; ++x) {
+            transClamp(x);
+        }
+        convDwF23SourceTransUnit(source + P * (su * 2 - pad), dest + 4 * P * su, eu - su);
+        for (int x = eu; x < unit; ++x) {
+            transClamp(x);
+        }
+    }
+    static void multiAndDestTransformCommon23(float** cacheLine, const float* weight, float* dest, int cacheLineSize,
+                                              int ow) {
+        int unit = ow / 2;
+        for (int x = 0; x < UP_DIV(ow, 2); ++x) {
+            auto offset = 4 * P * x;
+            VEC m[4]    = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int i = 0; i < cacheLineSize; ++i) {
+                for (int k = 0; k < 4; ++k) {
+                    m[k] = VEC::fma(m[k], VEC::load(weight + i * 4 * P + P * k), VEC::load(cacheLine[i] + offset + P * k));
+                }
+            }
+            VEC::save(dest + 2 * P * x, m[0] + m[1] + m[2]);
+            if (x < unit) {
+                VEC::save(dest + 2 * P * x + P, m[1] - m[2] + m[3]);
+            }
+        }
+    }
+    static void convDwF23MulTransUnit(float** cacheLine, const float* weight, float* dest, size_t ow) {
+        multiAndDestTransformCommon23(cacheLine, weight, dest, 3, (int)ow);
+    }
+
+    // A: [l, EP], B: [h / P, l, P], C: [h / P, e, P]
+    template <int E>
+    static void _matMulUnit(float* C, const float* A, const float* weight, size_t l, size_t aStride,
+                            const VEC& biasV, const VEC& minV, const VEC& maxV) {
+        VEC acc[E];
+        for (int i = 0; i < E; ++i) {
+            acc[i] = biasV;
+        }
+        for (int z = 0; z < l; ++z) {
+            auto w  = VEC::load(weight + P * z);
+            auto aZ = A + z * aStride;
+            for (int i = 0; i < E; ++i) {
+                acc[i] = VEC::fma(acc[i], VEC(aZ[i]), w);
+            }
+        }
+        for (int i = 0; i < E; ++i) {
+            VEC::save(C + P * i, VEC::max(VEC::min(acc[i], maxV), minV));
+        }
+    }
+    // The full tile of MNNPackedMatMul is packed with eP stride, the remain one with parameter[0]
+    template <int E>
+    static void packedMatMul(float* C, const float* A, const float* B, size_t eSize, size_t aStride,
+                             const size_t* parameter, const float* postParameters, const float* bias) {
+        auto l            = parameter[1];
+        auto h            = parameter[2];
+        auto cStride      = parameter[3] / sizeof(float);
+        auto bExtraStride = parameter[5] / sizeof(float);
+        auto bStride      = bExtraStride + l * P;
+        auto hC           = UP_DIV(h, P);
+        int e             = (int)eSize;
+        VEC minV(-std::numeric_limits<float>().max());
+        VEC maxV(std::numeric_limits<float>().max());
+        if (nullptr != postParameters) {
+            minV = VEC(postParameters[2]);
+            maxV = VEC(postParameters[3]);
+        }
+        for (int y = 0; y < hC; ++y) {
+            auto weight = B + y * bStride;
+            auto dstY   = C + y * cStride;
+            VEC biasV(0.0f);
+            if (nullptr != bias) {
+                biasV = VEC::load(bias + P * y);
+            }
+            auto dstX = dstY;
+            auto srcX = A;
+            int x     = 0;
+            for (; x + E <= e; x += E, dstX += P * E, srcX += E) {
+                _matMulUnit<E>(dstX, srcX, weight, l, aStride, biasV, minV, maxV);
+            }
+            for (; x < e; ++x, dstX += P, srcX += 1) {
+                _matMulUnit<1>(dstX, srcX, weight, l, aStride, biasV, minV, maxV);
+            }
+        }
+    }
+    // Pack [l / P, e, P] (with stride offset of e) to [l, eDest]
+    static void packForMatMul_A(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el) {
+        int number = info[0];
+        int eReal  = info[1];
+        int eDest  = info[2];
+        int offset = info[3];
+        for (int n = 0; n < number; ++n) {
+            int e       = el[4 * n + 0];
+            int l       = el[4 * n + 1];
+            int eOffset = el[4 * n + 2];
+            int lOffset = el[4 * n + 3];
+            auto dest   = destOrigin + lOffset * eDest + eOffset;
+            auto source = sourceGroup[n];
+            for (int x = 0; x < l; ++x) {
+                auto srcX  = source + (x / P) * eReal * P + (x % P);
+                auto destX = dest + x * eDest;
+                for (int y = 0; y < e; ++y) {
+                    destX[y] = srcX[y * P * offset];
+                }
+            }
+        }
+    }
+    // transpose: [h, l] -> [h / P, l, P], else [l, h] -> [h / P, l, P]
+    static void packForMatMul_B(float* dest, const float* source, size_t h, size_t l, bool transpose) {
+        if (transpose) {
+            packCUnit(dest, source, l, h);
+            return;
+        }
+        packCUnitTranspose(dest, source, l, h);
+    }
+};
+} // namespace MNN
+
+#endif
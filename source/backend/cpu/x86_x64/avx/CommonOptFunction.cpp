@@ -426,6 +426,111 @@ void _AVX_MNNInt8ScaleToFloat(float* dst, const int8_t* src, const float* scale,
         }
     }
 }
+static inline __m256i _AVX_AvgPoolRound(__m256i sum, __m256i half, __m256 count) {
+    auto adjust = _mm256_blendv_epi8(_mm256_sub_epi32(_mm256_setzero_si256(), half), half, _mm256_cmpgt_epi32(sum, _mm256_setzero_si256()));
+    return _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(sum, adjust)), count));
+}
+
+// Pack 4 x 8 int32 in order to 32 int8, packs works in 128 bit lanes so the 64 bit blocks need reordering
+static inline __m256i _AVX_PackInt32ToInt8(__m256i d0, __m256i d1, __m256i d2, __m256i d3) {
+    auto d01 = _mm256_permute4x64_epi64(_mm256_packs_epi32(d0, d1), 0xD8);
+    auto d23 = _mm256_permute4x64_epi64(_mm256_packs_epi32(d2, d3), 0xD8);
+    return _mm256_permute4x64_epi64(_mm256_packs_epi16(d01, d23), 0xD8);
+}
+
+void _AVX_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    int c = 0;
+    for (; c + 32 <= channel; c += 32) {
+        auto maxValue = _mm256_set1_epi8(-128);
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = _mm256_max_epi8(maxValue, _mm256_loadu_si256((const __m256i*)(srcY + x * channel)));
+            }
+        }
+        _mm256_storeu_si256((__m256i*)(dst + c), maxValue);
+    }
+    for (; c < channel; ++c) {
+        int8_t maxValue = -128;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = std::max(maxValue, srcY[x * channel]);
+            }
+        }
+        dst[c] = maxValue;
+    }
+}
+
+void _AVX_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    const int32_t count = (int32_t)(kx * ky);
+    auto countF         = _mm256_set1_ps((float)count);
+    auto half           = _mm256_set1_epi32(count / 2);
+    int c               = 0;
+    for (; c + 32 <= channel; c += 32) {
+        auto sum0 = _mm256_setzero_si256();
+        auto sum1 = _mm256_setzero_si256();
+        auto sum2 = _mm256_setzero_si256();
+        auto sum3 = _mm256_setzero_si256();
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                auto s0 = _mm_loadu_si128((const __m128i*)(srcY + x * channel));
+                auto s1 = _mm_loadu_si128((const __m128i*)(srcY + x * channel + 16));
+                sum0    = _mm256_add_epi32(sum0, _mm256_cvtepi8_epi32(s0));
+                sum1    = _mm256_add_epi32(sum1, _mm256_cvtepi8_epi32(_mm_unpackhi_epi64(s0, s0)));
+                sum2    = _mm256_add_epi32(sum2, _mm256_cvtepi8_epi32(s1));
+                sum3    = _mm256_add_epi32(sum3, _mm256_cvtepi8_epi32(_mm_unpackhi_epi64(s1, s1)));
+            }
+        }
+        auto d = _AVX_PackInt32ToInt8(_AVX_AvgPoolRound(sum0, half, countF), _AVX_AvgPoolRound(sum1, half, countF),
+                                      _AVX_AvgPoolRound(sum2, half, countF), _AVX_AvgPoolRound(sum3, half, countF));
+        _mm256_storeu_si256((__m256i*)(dst + c), d);
+    }
+    for (; c < channel; ++c) {
+        int32_t sum = 0;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                sum += srcY[x * channel];
+            }
+        }
+        dst[c] = sum > 0 ? (sum + count / 2) / count : (sum - count / 2) / count;
+    }
+}
+
+void _AVX_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                          const float* outputScale, const size_t size) {
+    auto s0       = _mm256_broadcast_ps((const __m128*)scale0);
+    auto s1       = _mm256_broadcast_ps((const __m128*)scale1);
+    auto os       = _mm256_broadcast_ps((const __m128*)outputScale);
+    auto minValue = _mm256_set1_ps(-127.0f);
+    auto maxValue = _mm256_set1_ps(127.0f);
+    auto compute  = [&](__m128i a, __m128i b) {
+        auto f = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(a)), s0),
+                               _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(b)), s1));
+        f      = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(f, os), maxValue), minValue);
+        return _mm256_cvttps_epi32(f);
+    };
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        auto a0 = _mm_loadu_si128((const __m128i*)(src0 + 4 * i));
+        auto a1 = _mm_loadu_si128((const __m128i*)(src0 + 4 * i + 16));
+        auto b0 = _mm_loadu_si128((const __m128i*)(src1 + 4 * i));
+        auto b1 = _mm_loadu_si128((const __m128i*)(src1 + 4 * i + 16));
+        auto d  = _AVX_PackInt32ToInt8(compute(a0, b0), compute(_mm_unpackhi_epi64(a0, a0), _mm_unpackhi_epi64(b0, b0)),
+                                      compute(a1, b1), compute(_mm_unpackhi_epi64(a1, a1), _mm_unpackhi_epi64(b1, b1)));
+        _mm256_storeu_si256((__m256i*)(dst + 4 * i), d);
+    }
+    for (; i < size; ++i) {
+        auto a = _mm_cvtsi32_si128(*(const int32_t*)(src0 + 4 * i));
+        auto b = _mm_cvtsi32_si128(*(const int32_t*)(src1 + 4 * i));
+        auto d = _mm256_castsi256_si128(compute(a, b));
+        d      = _mm_packs_epi16(_mm_packs_epi32(d, d), d);
+        *(int32_t*)(dst + 4 * i) = _mm_cvtsi128_si32(d);
+    }
+}
+
 void _AVX_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dstO, const int8_t* srcO, const int8_t* weightO, const QuanPostTreatParameters* parameters, size_t width, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step) {
     auto dst = dstO;
     auto src = (const int16_t*)srcO;
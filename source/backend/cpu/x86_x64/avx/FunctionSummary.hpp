@@ -62,12 +62,22 @@ void _AVX_MNNExpC8(float* dest, const float* source, const float* parameters, si
 void _AVX_MNNFloat2Int8(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minV, ssize_t maxV, ssize_t zeroPoint);
 void _AVX_MNNInt8ScaleToFloat(float* dst, const int8_t* src, const float* scale, size_t sizeQuad, ssize_t zeroPoint);
 void _AVX_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dstO, const int8_t* srcO, const int8_t* weightO, const QuanPostTreatParameters* parameters, size_t width, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step);
+void _AVX_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _AVX_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _AVX_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                          const float* outputScale, const size_t size);
 void _AVX_MNNComputeMatMulForE_1(const float* A, const float* B, float* C, const float* biasPtr, const MatMulParam* param, size_t tId);
 
 void _AVX_MNNPackC4ForMatMul_A_BF16(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el);
 
 void _AVX_MNNGetMatMulPackMode_BF16(int* eP, int *lP, int* hP);
 void _AVX_MNNPackForMatMul_B_BF16(float* dest, const float* source, size_t h, size_t l, bool transpose);
+// Pair layout of VDPBF16PS, lP = 2, hP = 16, the emulation of avxfma and the AVX512-BF16 kernels share it
+void _AVX_MNNPackForMatMul_B_BF16Pair(float* dest, const float* source, size_t h, size_t l, bool transpose);
+void _AVX_MNNPackC4ForMatMul_A_BF16Pair(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el);
+// Same pairs with lP = 32, a 32 l block of 16 e is one AMX tile
+void _AVX_MNNPackForMatMul_B_BF16Tile(float* dest, const float* source, size_t h, size_t l, bool transpose);
+void _AVX_MNNPackC4ForMatMul_A_BF16Tile(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el);
 
 void _AVX_MNNReluWithSlopeChannel(float* dst, const float* src, const float* slope, size_t sizeQuad, size_t depthQuad);
 
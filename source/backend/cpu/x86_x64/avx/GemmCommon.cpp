@@ -1223,3 +1223,90 @@ void _AVX_MNNPackC4ForMatMul_A_BF16(float* destOrigin, float const** sourceGroup
         }
     }
 }
+
+// Pair layout of VDPBF16PS / TDPBF16PS, the lP of A is 2 for the vector kernels and 32 for the AMX tiles
+// A: [l / lP, eDest, lP], B: [h / 16, l / lP * lP / 2, 16, 2]
+template <int LP>
+static void _AVX_PackForMatMul_B_BF16Pair(int16_t* dest, const int16_t* source, size_t h, size_t l, bool transpose) {
+    auto lAlign  = UP_DIV(l, LP) * LP;
+    int sYstride = 1;
+    int sXstride = h;
+    if (transpose) {
+        sYstride = l;
+        sXstride = 1;
+    }
+    ::memset(dest, 0, UP_DIV(h, 16) * lAlign * 16 * sizeof(int16_t));
+    for (int y = 0; y < h; ++y) {
+        auto destY = dest + (y / 16) * lAlign * 16 + (y % 16) * 2;
+        for (int x = 0; x < l; ++x) {
+            destY[(x / 2) * 32 + x % 2] = source[sXstride * x + sYstride * y];
+        }
+    }
+}
+
+template <int LP>
+static void _AVX_PackC4ForMatMul_A_BF16Pair(int16_t* destOrigin, int16_t const** sourceGroup, const int32_t* info,
+                                           const int32_t* el) {
+    int number = info[0];
+    int eReal  = info[1];
+    int eDest  = info[2];
+    int offset = info[3];
+    if (1 == number) {
+        int l = el[1];
+        if (l % LP != 0) {
+            ::memset(destOrigin, 0, eDest * UP_DIV(l, LP) * LP * sizeof(int16_t));
+        }
+    }
+    for (int n = 0; n < number; ++n) {
+        int e       = el[4 * n + 0];
+        int l       = el[4 * n + 1];
+        int eOffset = el[4 * n + 2];
+        int lOffset = el[4 * n + 3];
+        auto source = sourceGroup[n];
+        auto dest   = destOrigin + eOffset * LP;
+        int x       = 0;
+        if (lOffset % 4 == 0) {
+            // A full C4 unit of source is two pairs, or four continuous values of one AMX row
+            for (; x + 4 <= l; x += 4) {
+                auto dl    = lOffset + x;
+                auto destX = dest + (dl / LP) * eDest * LP + dl % LP;
+                auto srcX  = source + (x / 4) * eReal * 4;
+                if (LP % 4 == 0) {
+                    for (int y = 0; y < e; ++y) {
+                        *(int64_t*)(destX + y * LP) = *(const int64_t*)(srcX + y * 4 * offset);
+                    }
+                } else {
+                    for (int y = 0; y < e; ++y) {
+                        auto src                                 = (const int32_t*)(srcX + y * 4 * offset);
+                        *(int32_t*)(destX + y * LP)              = src[0];
+                        *(int32_t*)(destX + eDest * LP + y * LP) = src[1];
+                    }
+                }
+            }
+        }
+        for (; x < l; ++x) {
+            auto dl    = lOffset + x;
+            auto destX = dest + (dl / LP) * eDest * LP + dl % LP;
+            auto srcX  = source + (x / 4) * eReal * 4 + x % 4;
+            for (int y = 0; y < e; ++y) {
+                destX[y * LP] = srcX[y * 4 * offset];
+            }
+        }
+    }
+}
+
+void _AVX_MNNPackForMatMul_B_BF16Pair(float* dest, const float* source, size_t h, size_t l, bool transpose) {
+    _AVX_PackForMatMul_B_BF16Pair<2>((int16_t*)dest, (const int16_t*)source, h, l, transpose);
+}
+
+void _AVX_MNNPackC4ForMatMul_A_BF16Pair(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el) {
+    _AVX_PackC4ForMatMul_A_BF16Pair<2>((int16_t*)destOrigin, (int16_t const**)sourceGroup, info, el);
+}
+
+void _AVX_MNNPackForMatMul_B_BF16Tile(float* dest, const float* source, size_t h, size_t l, bool transpose) {
+    _AVX_PackForMatMul_B_BF16Pair<32>((int16_t*)dest, (const int16_t*)source, h, l, transpose);
+}
+
+void _AVX_MNNPackC4ForMatMul_A_BF16Tile(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el) {
+    _AVX_PackC4ForMatMul_A_BF16Pair<32>((int16_t*)destOrigin, (int16_t const**)sourceGroup, info, el);
+}
@@ -22,12 +22,27 @@ do { \
 } while (0)
 #endif
 
-// ========= CommonOptFunction.cpp ===========
+// ========= GemmCommon.cpp / GemmAVX512F.cpp ===========
 extern "C" {
-void _AVX512_MNNPackForMatMul_B(float* dest, const float* source, size_t h, size_t l, bool transpose);
-void _AVX512_MNNPackC4ForMatMul_A(float* destOrigin, float const** sourceGroup, const int32_t* info, const int32_t* el);
-void _AVX512_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter, const float* postParameters, const float* bias);
-void _AVX512_MNNPackedMatMulRemain(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
 void _AVX512_MNNGemmInt8AddBiasScale_16x4_Unit(int8_t* dst, const int8_t* src, const int8_t* weight, size_t src_depth_quad, size_t dst_step, size_t dst_depth_quad, const QuanPostTreatParameters* post, size_t realDst);
+// Int8FunctionVNNI.cpp, need AVX512BW / VL and VNNI
+void _AVX512_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* src, const int8_t* weight, const QuanPostTreatParameters* parameters, size_t width, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step);
+// Int8FunctionBW.cpp, need AVX512BW / VL
+void _AVX512_MNNReluInt8(int8_t* dst, const int8_t* src, size_t size);
+void _AVX512_MNNFloat2Int8(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minV, ssize_t maxV, ssize_t zeroPoint);
+void _AVX512_MNNInt8ScaleToFloat(float* dst, const int8_t* src, const float* scale, size_t sizeQuad, ssize_t zeroPoint);
+void _AVX512_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _AVX512_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _AVX512_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1, const float* outputScale, const size_t size);
+// Float GEMM needing AVX512F only, eP = 24, lP = 1, hP = 16
+void _AVX512F_MNNPackForMatMul_B(float* dest, const float* source, size_t h, size_t l, bool transpose);
+void _AVX512F_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter, const float* postParameters, const float* bias);
+void _AVX512F_MNNPackedMatMulRemain(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
+// Replace the NC4HW4 functions of a copied CoreFunctions with the NC16HW16 ones
+void _AVX512_ExtraInit(void* functions);
+// Vectorized transcendental functions, see UnaryFunction.hpp
+MNN::CoreFunctions::MNNUnaryExecute _AVX512F_MNNSelectUnaryFunctionForFloat(int type, int precision);
+// Online softmax, see SoftmaxFunction.hpp
+void _AVX512F_MNNSoftmax(float* dest, const float* source, size_t channel, size_t inside, size_t stride);
 
 }
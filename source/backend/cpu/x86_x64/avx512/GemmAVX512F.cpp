@@ -0,0 +1,141 @@
+//
+//  GemmAVX512F.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/10.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <string.h>
+#include <algorithm>
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+// Float GEMM only using AVX512F, eP = 24, lP = 1, hP = 16, set in FunctionDispatcher.cpp
+// A: [l, eP], B: [h / 16, l, 16], C: [h / 4, e, 4]
+// The accumulator of one e keeps 16 h, that is 4 planes of C
+#define AVX512F_EP 24
+#define AVX512F_HP 16
+
+namespace {
+template <int E>
+static void _AVX512F_MatMulUnit(float* C, const float* A, const float* weight, size_t l, size_t aStride,
+                                size_t cStride, int hC4, const float* postParameters, const float* bias) {
+    __m512 acc[E];
+#pragma GCC unroll 24
+    for (int i = 0; i < E; ++i) {
+        acc[i] = _mm512_setzero_ps();
+    }
+    for (int z = 0; z < l; ++z) {
+        auto w  = _mm512_loadu_ps(weight + AVX512F_HP * z);
+        auto aZ = A + z * aStride;
+#pragma GCC unroll 24
+        for (int i = 0; i < E; ++i) {
+            acc[i] = _mm512_fmadd_ps(_mm512_set1_ps(aZ[i]), w, acc[i]);
+        }
+    }
+    if (nullptr != postParameters) {
+        // The bias is aligned to 4 only
+        auto biasV = _mm512_setzero_ps();
+        if (nullptr != bias) {
+            biasV = _mm512_maskz_loadu_ps((__mmask16)((1 << (4 * hC4)) - 1), bias);
+        }
+        auto minV = _mm512_set1_ps(postParameters[2]);
+        auto maxV = _mm512_set1_ps(postParameters[3]);
+#pragma GCC unroll 24
+        for (int i = 0; i < E; ++i) {
+            acc[i] = _mm512_min_ps(_mm512_max_ps(_mm512_add_ps(acc[i], biasV), minV), maxV);
+        }
+    }
+#pragma GCC unroll 24
+    for (int i = 0; i < E; ++i) {
+        auto dst = C + 4 * i;
+        _mm_storeu_ps(dst, _mm512_castps512_ps128(acc[i]));
+        if (hC4 > 1) {
+            _mm_storeu_ps(dst + cStride, _mm512_extractf32x4_ps(acc[i], 1));
+        }
+        if (hC4 > 2) {
+            _mm_storeu_ps(dst + 2 * cStride, _mm512_extractf32x4_ps(acc[i], 2));
+        }
+        if (hC4 > 3) {
+            _mm_storeu_ps(dst + 3 * cStride, _mm512_extractf32x4_ps(acc[i], 3));
+        }
+    }
+}
+
+template <int E>
+static void _AVX512F_MatMul(float* C, const float* A, const float* B, size_t aStride, const size_t* parameter,
+                            const float* postParameters, const float* bias) {
+    auto l            = parameter[1];
+    auto h            = parameter[2];
+    auto cStride      = parameter[3] / sizeof(float);
+    auto bExtraStride = parameter[5] / sizeof(float);
+    auto bStride      = bExtraStride + l * AVX512F_HP;
+    auto hC4          = UP_DIV(h, 4);
+    auto hC16         = UP_DIV(h, AVX512F_HP);
+    for (int y = 0; y < hC16; ++y) {
+        auto biasY = nullptr != bias ? bias + AVX512F_HP * y : nullptr;
+        _AVX512F_MatMulUnit<E>(C + 4 * y * cStride, A, B + y * bStride, l, aStride, cStride,
+                               std::min((int)hC4 - 4 * y, 4), postParameters, biasY);
+    }
+}
+} // namespace
+
+void _AVX512F_MNNPackForMatMul_B(float* dest, const float* source, size_t h, size_t l, bool transpose) {
+    auto hC16 = UP_DIV(h, AVX512F_HP);
+    if (h % AVX512F_HP != 0) {
+        ::memset(dest, 0, hC16 * AVX512F_HP * l * sizeof(float));
+    }
+    for (int y = 0; y < hC16; ++y) {
+        auto hStart = y * AVX512F_HP;
+        auto hCount = std::min((int)h - (int)hStart, AVX512F_HP);
+        auto destY  = dest + y * l * AVX512F_HP;
+        if (!transpose) {
+            // [l, h]
+            for (int x = 0; x < l; ++x) {
+                ::memcpy(destY + x * AVX512F_HP, source + x * h + hStart, hCount * sizeof(float));
+            }
+            continue;
+        }
+        // [h, l]
+        for (int k = 0; k < hCount; ++k) {
+            auto srcK = source + (hStart + k) * l;
+            for (int x = 0; x < l; ++x) {
+                destY[x * AVX512F_HP + k] = srcK[x];
+            }
+        }
+    }
+}
+
+void _AVX512F_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter,
+                              const float* postParameters, const float* bias) {
+    _AVX512F_MatMul<AVX512F_EP>(C, A, B, AVX512F_EP, parameter, postParameters, bias);
+}
+
+void _AVX512F_MNNPackedMatMulRemain(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter,
+                                    const float* postParameters, const float* bias) {
+    auto aStride = parameter[0] / sizeof(float);
+    if (eSize >= 16) {
+        _AVX512F_MatMul<16>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 16;
+        C += 16 * 4;
+        A += 16;
+    }
+    if (eSize >= 8) {
+        _AVX512F_MatMul<8>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 8;
+        C += 8 * 4;
+        A += 8;
+    }
+    if (eSize >= 4) {
+        _AVX512F_MatMul<4>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 4;
+        C += 4 * 4;
+        A += 4;
+    }
+    for (; eSize > 0; --eSize) {
+        _AVX512F_MatMul<1>(C, A, B, aStride, parameter, postParameters, bias);
+        C += 4;
+        A += 1;
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  Int8FunctionBW.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+// Int8 pool / eltwise kernels, built with AVX512BW / VL only so that they run on cpus without VNNI
+
+namespace {
+static inline __m512i _avgPoolRound(__m512i sum, __m512i half, __m512 count) {
+    auto positive = _mm512_cmpgt_epi32_mask(sum, _mm512_setzero_si512());
+    auto adjust   = _mm512_mask_blend_epi32(positive, _mm512_sub_epi32(_mm512_setzero_si512(), half), half);
+    return _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(sum, adjust)), count));
+}
+} // namespace
+
+void _AVX512_MNNReluInt8(int8_t* dst, const int8_t* src, size_t size) {
+    auto zero = _mm512_setzero_si512();
+    int i     = 0;
+    for (; i + 64 <= size; i += 64) {
+        _mm512_storeu_si512(dst + i, _mm512_max_epi8(_mm512_loadu_si512(src + i), zero));
+    }
+    if (i < size) {
+        __mmask64 mask = (((__mmask64)1) << (size - i)) - 1;
+        _mm512_mask_storeu_epi8(dst + i, mask, _mm512_max_epi8(_mm512_maskz_loadu_epi8(mask, src + i), zero));
+    }
+}
+
+void _AVX512_MNNFloat2Int8(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minV,
+                           ssize_t maxV, ssize_t zeroPoint) {
+    auto scale     = _mm512_broadcast_f32x4(_mm_loadu_ps(scalep));
+    auto minValue  = _mm512_set1_ps(minV);
+    auto maxValue  = _mm512_set1_ps(maxV);
+    auto zero      = _mm512_set1_ps(zeroPoint);
+    auto plus      = _mm512_set1_ps(0.5f);
+    auto minus     = _mm512_set1_ps(-0.5f);
+    auto compute   = [&](__m512 f) {
+        f        = _mm512_add_ps(_mm512_mul_ps(f, scale), zero);
+        f        = _mm512_max_ps(_mm512_min_ps(f, maxValue), minValue);
+        auto neg = _mm512_cmp_ps_mask(f, _mm512_setzero_ps(), _CMP_LT_OQ);
+        f        = _mm512_add_ps(f, _mm512_mask_blend_ps(neg, plus, minus));
+        return _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(f));
+    };
+    int i = 0;
+    for (; i + 4 <= sizeQuad; i += 4) {
+        _mm_storeu_si128((__m128i*)(dst + 4 * i), compute(_mm512_loadu_ps(src + 4 * i)));
+    }
+    if (i < sizeQuad) {
+        __mmask16 mask = (1 << (4 * (sizeQuad - i))) - 1;
+        _mm_mask_storeu_epi8(dst + 4 * i, mask, compute(_mm512_maskz_loadu_ps(mask, src + 4 * i)));
+    }
+}
+
+void _AVX512_MNNInt8ScaleToFloat(float* dst, const int8_t* src, const float* scalep, size_t sizeQuad,
+                                 ssize_t zeroPoint) {
+    auto scale   = _mm512_broadcast_f32x4(_mm_loadu_ps(scalep));
+    auto zero    = _mm512_set1_epi32(zeroPoint);
+    auto compute = [&](__m128i s) {
+        return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_cvtepi8_epi32(s), zero)), scale);
+    };
+    int i = 0;
+    for (; i + 4 <= sizeQuad; i += 4) {
+        _mm512_storeu_ps(dst + 4 * i, compute(_mm_loadu_si128((const __m128i*)(src + 4 * i))));
+    }
+    if (i < sizeQuad) {
+        __mmask16 mask = (1 << (4 * (sizeQuad - i))) - 1;
+        _mm512_mask_storeu_ps(dst + 4 * i, mask, compute(_mm_maskz_loadu_epi8(mask, src + 4 * i)));
+    }
+}
+
+void _AVX512_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    for (int c = 0; c < channel; c += 64) {
+        __mmask64 mask = channel - c >= 64 ? ~((__mmask64)0) : (((__mmask64)1) << (channel - c)) - 1;
+        auto maxValue  = _mm512_set1_epi8(-128);
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = _mm512_max_epi8(maxValue, _mm512_maskz_loadu_epi8(mask, srcY + x * channel));
+            }
+        }
+        _mm512_mask_storeu_epi8(dst + c, mask, maxValue);
+    }
+}
+
+void _AVX512_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    const int32_t count = (int32_t)(kx * ky);
+    auto countF         = _mm512_set1_ps((float)count);
+    auto half           = _mm512_set1_epi32(count / 2);
+    for (int c = 0; c < channel; c += 32) {
+        __mmask32 mask = channel - c >= 32 ? ~((__mmask32)0) : (((__mmask32)1) << (channel - c)) - 1;
+        auto sum0      = _mm512_setzero_si512();
+        auto sum1      = _mm512_setzero_si512();
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                auto s = _mm256_maskz_loadu_epi8(mask, srcY + x * channel);
+                sum0   = _mm512_add_epi32(sum0, _mm512_cvtepi8_epi32(_mm256_castsi256_si128(s)));
+                sum1   = _mm512_add_epi32(sum1, _mm512_cvtepi8_epi32(_mm256_extracti128_si256(s, 1)));
+            }
+        }
+        auto d0 = _mm512_cvtepi32_epi8(_avgPoolRound(sum0, half, countF));
+        auto d1 = _mm512_cvtepi32_epi8(_avgPoolRound(sum1, half, countF));
+        _mm256_mask_storeu_epi8(dst + c, mask, _mm256_inserti128_si256(_mm256_castsi128_si256(d0), d1, 1));
+    }
+}
+
+void _AVX512_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0,
+                             const float* scale1, const float* outputScale, const size_t size) {
+    auto s0       = _mm512_broadcast_f32x4(_mm_loadu_ps(scale0));
+    auto s1       = _mm512_broadcast_f32x4(_mm_loadu_ps(scale1));
+    auto os       = _mm512_broadcast_f32x4(_mm_loadu_ps(outputScale));
+    auto minValue = _mm512_set1_ps(-127.0f);
+    auto maxValue = _mm512_set1_ps(127.0f);
+    auto compute  = [&](__m128i a, __m128i b) {
+        auto f = _mm512_add_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(a)), s0),
+                               _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(b)), s1));
+        f      = _mm512_max_ps(_mm512_min_ps(_mm512_mul_ps(f, os), maxValue), minValue);
+        return _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(f));
+    };
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        auto a = _mm_loadu_si128((const __m128i*)(src0 + 4 * i));
+        auto b = _mm_loadu_si128((const __m128i*)(src1 + 4 * i));
+        _mm_storeu_si128((__m128i*)(dst + 4 * i), compute(a, b));
+    }
+    if (i < size) {
+        __mmask16 mask = (1 << (4 * (size - i))) - 1;
+        auto a         = _mm_maskz_loadu_epi8(mask, src0 + 4 * i);
+        auto b         = _mm_maskz_loadu_epi8(mask, src1 + 4 * i);
+        _mm_mask_storeu_epi8(dst + 4 * i, mask, compute(a, b));
+    }
+}
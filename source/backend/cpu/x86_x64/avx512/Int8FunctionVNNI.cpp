@@ -0,0 +1,130 @@
+//
+//  Int8FunctionVNNI.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <algorithm>
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+// Int8 depthwise kernel, built with AVX512BW / VL and VNNI
+
+namespace {
+enum DepthwiseLoad {
+    // Four pixels of stride 1 are contiguous
+    LOAD_CONTINUE,
+    LOAD_STRIDE,
+    // Less than four pixels, the rest are zero
+    LOAD_PARTIAL,
+};
+
+template <DepthwiseLoad mode>
+static inline __m256i _loadPixel4(const int16_t* src, size_t step, int count) {
+    if (LOAD_CONTINUE == mode) {
+        return _mm256_loadu_si256((const __m256i*)src);
+    }
+    if (LOAD_STRIDE == mode) {
+        return _mm256_set_epi64x(*(const int64_t*)(src + 3 * step), *(const int64_t*)(src + 2 * step),
+                                 *(const int64_t*)(src + 1 * step), *(const int64_t*)(src));
+    }
+    int64_t temp[4] = {0, 0, 0, 0};
+    for (int i = 0; i < count; ++i) {
+        temp[i] = *(const int64_t*)(src + i * step);
+    }
+    return _mm256_loadu_si256((const __m256i*)temp);
+}
+
+// Two taps of a pixel are interleaved to an int16 pair so that one vpdpwssd computes both of them. The result of four
+// pixels is stored in order [0, 2, 1, 3] by 128 bit lanes
+static inline __m512i _pairTap(__m256i s0, __m256i s1) {
+    return _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_unpacklo_epi16(s0, s1)), _mm256_unpackhi_epi16(s0, s1), 1);
+}
+
+static inline __m512i _pairWeight(const int16_t* w0, const int16_t* w1) {
+    auto w = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)w0),
+                                nullptr == w1 ? _mm_setzero_si128() : _mm_loadl_epi64((const __m128i*)w1));
+    return _mm512_broadcast_i32x4(w);
+}
+
+// Compute 4 * N pixels, N independent accumulators hide the latency of vpdpwssd
+template <DepthwiseLoad mode, int N>
+static void _depthwiseUnit(int8_t* dst, const int16_t* src, const int16_t* weight, const QuanPostTreatParameters* parameters,
+                           int count, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step) {
+    __m512i d[N];
+    for (int n = 0; n < N; ++n) {
+        d[n] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)parameters->bias));
+    }
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * fw * 4;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto w           = _pairWeight(weight_y + 4 * fx, weight_y + 4 * fx + 4);
+            for (int n = 0; n < N; ++n) {
+                auto s0 = _loadPixel4<mode>(src_x + 4 * n * src_w_step, src_w_step, count);
+                auto s1 = _loadPixel4<mode>(src_x + 4 * n * src_w_step + dilateX_step, src_w_step, count);
+                d[n]    = _mm512_dpwssd_epi32(d[n], _pairTap(s0, s1), w);
+            }
+        }
+        if (fx < fw) {
+            auto w = _pairWeight(weight_y + 4 * fx, nullptr);
+            for (int n = 0; n < N; ++n) {
+                auto s0 = _loadPixel4<mode>(src_y + fx * dilateX_step + 4 * n * src_w_step, src_w_step, count);
+                d[n]    = _mm512_dpwssd_epi32(d[n], _pairTap(s0, _mm256_setzero_si256()), w);
+            }
+        }
+    }
+    auto scale    = _mm512_broadcast_f32x4(_mm_loadu_ps(parameters->scale));
+    auto minValue = _mm512_set1_epi32(parameters->minValue);
+    auto maxValue = _mm512_set1_epi32(parameters->maxValue);
+    for (int n = 0; n < N; ++n) {
+        auto x   = _mm512_shuffle_i32x4(d[n], d[n], _MM_SHUFFLE(3, 1, 2, 0));
+        auto f   = _mm512_mul_ps(_mm512_cvtepi32_ps(x), scale);
+        auto neg = _mm512_cmp_ps_mask(f, _mm512_setzero_ps(), _CMP_LT_OQ);
+        f        = _mm512_add_ps(f, _mm512_mask_blend_ps(neg, _mm512_set1_ps(0.5f), _mm512_set1_ps(-0.5f)));
+        x        = _mm512_min_epi32(_mm512_max_epi32(_mm512_cvttps_epi32(f), minValue), maxValue);
+        auto r   = _mm512_cvtepi32_epi8(x);
+        if (LOAD_PARTIAL == mode) {
+            _mm_mask_storeu_epi8(dst, (__mmask16)((1 << (4 * count)) - 1), r);
+        } else {
+            _mm_storeu_si128((__m128i*)(dst + 16 * n), r);
+        }
+    }
+}
+} // namespace
+
+void _AVX512_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* srcO, const int8_t* weightO,
+                                                  const QuanPostTreatParameters* parameters, size_t width,
+                                                  size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step,
+                                                  size_t dilateY_step) {
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    int dx      = 0;
+    if (4 == src_w_step) {
+        for (; dx + 8 <= width; dx += 8) {
+            _depthwiseUnit<LOAD_CONTINUE, 2>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step,
+                                             fw, fh, dilateX_step, dilateY_step);
+        }
+        for (; dx + 4 <= width; dx += 4) {
+            _depthwiseUnit<LOAD_CONTINUE, 1>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step,
+                                             fw, fh, dilateX_step, dilateY_step);
+        }
+    } else {
+        for (; dx + 8 <= width; dx += 8) {
+            _depthwiseUnit<LOAD_STRIDE, 2>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step, fw,
+                                           fh, dilateX_step, dilateY_step);
+        }
+        for (; dx + 4 <= width; dx += 4) {
+            _depthwiseUnit<LOAD_STRIDE, 1>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step, fw,
+                                           fh, dilateX_step, dilateY_step);
+        }
+    }
+    if (dx < width) {
+        _depthwiseUnit<LOAD_PARTIAL, 1>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, width - dx,
+                                        src_w_step, fw, fh, dilateX_step, dilateY_step);
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  PackedFunctionAVX512.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "../PackedFunction.hpp"
+
+using namespace MNN;
+namespace {
+using Func = PackedFunction<Math::Vec<float, 16>, 16>;
+constexpr int gEP = 24;
+void _AVX512_MNNGetMatMulPackModeC16(int* eP, int* lP, int* hP) {
+    *eP = gEP;
+    *lP = 1;
+    *hP = 16;
+}
+void _AVX512_MNNPackedMatMulC16(float* C, const float* A, const float* B, const size_t* parameter,
+                            const float* postParameters, const float* bias) {
+    Func::packedMatMul<12>(C, A, B, gEP, gEP, parameter, postParameters, bias);
+}
+void _AVX512_MNNPackedMatMulRemainC16(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter,
+                                  const float* postParameters, const float* bias) {
+    Func::packedMatMul<12>(C, A, B, eSize, parameter[0] / sizeof(float), parameter, postParameters, bias);
+}
+CoreFunctions::WinoTransFunc _AVX512_chooseWinoTransformC16(int k, int w) {
+    return nullptr;
+}
+};
+
+void _AVX512_ExtraInit(void* functions) {
+    auto core                              = (CoreFunctions*)functions;
+    core->pack                             = 16;
+    core->MNNGetMatMulPackMode             = _AVX512_MNNGetMatMulPackModeC16;
+    core->MNNPackC4ForMatMul_A             = Func::packForMatMul_A;
+    core->MNNPackForMatMul_B               = Func::packForMatMul_B;
+    core->MNNPackedMatMul                  = _AVX512_MNNPackedMatMulC16;
+    core->MNNPackedMatMulRemain            = _AVX512_MNNPackedMatMulRemainC16;
+    core->MNNPackCUnit                     = Func::packCUnit;
+    core->MNNUnpackCUnit                   = Func::unpackCUnit;
+    core->MNNPackCUnitTranspose            = Func::packCUnitTranspose;
+    core->MNNUnpackCUnitTranspose          = Func::unpackCUnitTranspose;
+    core->MNNConvRunForUnitDepthWise       = Func::convRunForUnitDepthWise;
+    core->MNNConvRunForLineDepthwise       = Func::convRunForLineDepthwise;
+    core->MNNAxByClampBroadcastUnit        = Func::axByClampBroadcastUnit;
+    core->MNNMultiAndDestTransformCommon23 = Func::multiAndDestTransformCommon23;
+    core->MNNSourceTransformCommonF23      = Func::sourceTransformCommonF23;
+    core->MNNConvDwF23MulTransUnit         = Func::convDwF23MulTransUnit;
+    core->MNNMatrixAdd                     = Func::matrixAdd;
+    core->MNNMatrixSub                     = Func::matrixSub;
+    core->MNNStrassenMergeCFunction        = Func::strassenMergeCFunction;
+    core->MNNScaleAndAddBias               = Func::scaleAndAddBias;
+    core->MNNCopyC4WithStride              = Func::copyCUnitWithStride;
+    core->MNNAddC4WithStride               = Func::addCUnitWithStride;
+    core->MNNDeconvRunForUnitDepthWise     = Func::deconvRunForUnitDepthWise;
+    core->MNNDeconvRunForLineDepthwise     = Func::deconvRunForLineDepthwise;
+    // No winograd transform for pack 16 yet, the convolution falls back to the tiled one
+    core->chooseWinoSourceTransform        = _AVX512_chooseWinoTransformC16;
+    core->chooseWinoDestTransform          = _AVX512_chooseWinoTransformC16;
+}
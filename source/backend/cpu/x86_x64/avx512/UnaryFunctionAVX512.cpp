@@ -0,0 +1,21 @@
+//
+//  UnaryFunctionAVX512.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "backend/cpu/compute/UnaryFunction.hpp"
+#include "backend/cpu/compute/SoftmaxFunction.hpp"
+
+using Vec16 = MNN::Math::Vec<float, 16>;
+
+MNN::CoreFunctions::MNNUnaryExecute _AVX512F_MNNSelectUnaryFunctionForFloat(int type, int precision) {
+    return MNN::UnaryFunction<Vec16, 16>::select(type, precision);
+}
+
+void _AVX512F_MNNSoftmax(float* dest, const float* source, size_t channel, size_t inside, size_t stride) {
+    MNN::SoftmaxFunction<Vec16, 16>::execute(dest, source, channel, inside, stride);
+}
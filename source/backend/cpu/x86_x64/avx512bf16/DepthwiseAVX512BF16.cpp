@@ -0,0 +1,164 @@
+//
+//  DepthwiseAVX512BF16.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+// Two taps along x are interleaved to bf16 pairs for VDPBF16PS, which adds the second tap before the first one.
+// A single last tap of a row is paired with zero. _AVX_MNNConvRunForLineDepthwiseFMA_BF16 emulates the same order
+namespace {
+enum DepthwiseLoad {
+    LOAD_CONTINUE,
+    LOAD_STRIDE,
+    LOAD_PARTIAL,
+};
+
+// 4 pixels of C4
+template <DepthwiseLoad mode>
+static inline __m256i _loadPixel4(const int16_t* src, size_t step, int count) {
+    if (LOAD_CONTINUE == mode) {
+        return _mm256_loadu_si256((const __m256i*)src);
+    }
+    if (LOAD_STRIDE == mode) {
+        return _mm256_set_epi64x(*(const int64_t*)(src + 3 * step), *(const int64_t*)(src + 2 * step),
+                                 *(const int64_t*)(src + 1 * step), *(const int64_t*)(src));
+    }
+    int64_t temp[4] = {0, 0, 0, 0};
+    for (int i = 0; i < count; ++i) {
+        temp[i] = *(const int64_t*)(src + i * step);
+    }
+    return _mm256_loadu_si256((const __m256i*)temp);
+}
+
+static const int16_t gPairIndex[32] = {0, 32, 1, 33, 2,  34, 3,  35, 4,  36, 5,  37, 6,  38, 7,  39,
+                                       8, 40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47};
+
+static inline __m512bh _pair(__m256i first, __m256i second, __m512i index) {
+    return (__m512bh)_mm512_permutex2var_epi16(_mm512_castsi256_si512(first), index, _mm512_castsi256_si512(second));
+}
+
+// N groups of 4 pixels
+template <DepthwiseLoad mode, int N>
+static void _depthwiseUnit(int16_t* dst, const int16_t* src, const int16_t* weight, int count, size_t src_w_step,
+                           size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step) {
+    __m512 acc[N];
+#pragma GCC unroll 4
+    for (int i = 0; i < N; ++i) {
+        acc[i] = _mm512_setzero_ps();
+    }
+    auto index = _mm512_loadu_si512(gPairIndex);
+    auto zero  = _mm256_setzero_si256();
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * fw * 4;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto w = _pair(_mm256_set1_epi64x(*(const int64_t*)(weight_y + 4 * fx)),
+                           _mm256_set1_epi64x(*(const int64_t*)(weight_y + 4 * fx + 4)), index);
+#pragma GCC unroll 4
+            for (int i = 0; i < N; ++i) {
+                auto s = src_x + 4 * i * src_w_step;
+                auto p = _pair(_loadPixel4<mode>(s, src_w_step, count),
+                               _loadPixel4<mode>(s + dilateX_step, src_w_step, count), index);
+                acc[i] = _mm512_dpbf16_ps(acc[i], p, w);
+            }
+        }
+        if (fx < fw) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto w           = _pair(_mm256_set1_epi64x(*(const int64_t*)(weight_y + 4 * fx)), zero, index);
+#pragma GCC unroll 4
+            for (int i = 0; i < N; ++i) {
+                auto p = _pair(_loadPixel4<mode>(src_x + 4 * i * src_w_step, src_w_step, count), zero, index);
+                acc[i] = _mm512_dpbf16_ps(acc[i], p, w);
+            }
+        }
+    }
+#pragma GCC unroll 4
+    for (int i = 0; i < N; ++i) {
+        // Truncate as MNNFP32ToBF16
+        auto d = _mm512_cvtepi32_epi16(_mm512_srli_epi32(_mm512_castps_si512(acc[i]), 16));
+        if (LOAD_PARTIAL == mode) {
+            int64_t temp[4];
+            _mm256_storeu_si256((__m256i*)temp, d);
+            for (int j = 0; j < count; ++j) {
+                *(int64_t*)(dst + 4 * j) = temp[j];
+            }
+        } else {
+            _mm256_storeu_si256((__m256i*)(dst + 16 * i), d);
+        }
+    }
+}
+
+template <DepthwiseLoad mode>
+static int _depthwiseLine(int16_t* dst, const int16_t* src, const int16_t* weight, size_t width, size_t src_w_step,
+                          size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step) {
+    int dx = 0;
+    for (; dx + 16 <= width; dx += 16) {
+        _depthwiseUnit<mode, 4>(dst + 4 * dx, src + dx * src_w_step, weight, 4, src_w_step, fw, fh, dilateX_step,
+                                dilateY_step);
+    }
+    for (; dx + 4 <= width; dx += 4) {
+        _depthwiseUnit<mode, 1>(dst + 4 * dx, src + dx * src_w_step, weight, 4, src_w_step, fw, fh, dilateX_step,
+                                dilateY_step);
+    }
+    return dx;
+}
+} // namespace
+
+void _AVX512BF16_MNNConvRunForUnitDepthWise(float* dstO, const float* srcO, const float* weightO, size_t fw, size_t fh,
+                                            size_t weight_y_step, size_t dilateX_step, size_t dilateY_step) {
+    auto dst    = (int16_t*)dstO;
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    auto acc    = _mm_setzero_ps();
+    auto zero   = _mm_setzero_si128();
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * weight_y_step;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            auto s = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(src_y + fx * dilateX_step)),
+                                        _mm_loadl_epi64((const __m128i*)(src_y + (fx + 1) * dilateX_step)));
+            auto w = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(weight_y + 4 * fx)),
+                                        _mm_loadl_epi64((const __m128i*)(weight_y + 4 * fx + 4)));
+            acc    = _mm_dpbf16_ps(acc, (__m128bh)s, (__m128bh)w);
+        }
+        if (fx < fw) {
+            auto s = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(src_y + fx * dilateX_step)), zero);
+            auto w = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(weight_y + 4 * fx)), zero);
+            acc    = _mm_dpbf16_ps(acc, (__m128bh)s, (__m128bh)w);
+        }
+    }
+    auto d = _mm_srli_epi32(_mm_castps_si128(acc), 16);
+    _mm_storel_epi64((__m128i*)dst, _mm_packus_epi32(d, d));
+}
+
+void _AVX512BF16_MNNConvRunForLineDepthwise(float* dstO, const float* srcO, const float* weightO, size_t width,
+                                            size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step,
+                                            size_t dilateY_step, size_t height, size_t srcHStep, size_t dstHStep) {
+    auto dst    = (int16_t*)dstO;
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    for (int y = 0; y < height; ++y) {
+        auto srcY = src + y * srcHStep;
+        auto dstY = dst + y * dstHStep;
+        int dx    = 0;
+        if (4 == src_w_setup) {
+            dx = _depthwiseLine<LOAD_CONTINUE>(dstY, srcY, weight, width, src_w_setup, fw, fh, dilateX_step,
+                                               dilateY_step);
+        } else {
+            dx = _depthwiseLine<LOAD_STRIDE>(dstY, srcY, weight, width, src_w_setup, fw, fh, dilateX_step,
+                                             dilateY_step);
+        }
+        if (dx < width) {
+            _depthwiseUnit<LOAD_PARTIAL, 1>(dstY + 4 * dx, srcY + dx * src_w_setup, weight, width - dx, src_w_setup,
+                                            fw, fh, dilateX_step, dilateY_step);
+        }
+    }
+}
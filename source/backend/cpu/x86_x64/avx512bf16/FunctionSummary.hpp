@@ -0,0 +1,35 @@
+//
+//  FunctionSummary.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include <stdint.h>
+#include <stddef.h>
+
+// ========= GemmAVX512BF16.cpp / DepthwiseAVX512BF16.cpp ===========
+// Native bf16 kernels of BF16Functions.cpp, need AVX512BW / VL and AVX512-BF16
+// Pack by _AVX_MNNPackForMatMul_B_BF16Pair / _AVX_MNNPackC4ForMatMul_A_BF16Pair, eP = 24, lP = 2, hP = 16
+extern "C" {
+void _AVX512BF16_MNNGetMatMulPackMode(int* eP, int* lP, int* hP);
+void _AVX512BF16_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter, const float* postParameters, const float* bias);
+void _AVX512BF16_MNNPackedMatMulRemain(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
+// Same as _AVX512BF16_MNNPackedMatMulRemain for the lP = 32 pack of AMX
+void _AVX512BF16_MNNPackedMatMulRemainTile(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
+void _AVX512BF16_MNNConvRunForUnitDepthWise(float* dst, const float* src, const float* weight, size_t fw, size_t fh, size_t weight_y_step, size_t dilateX_step, size_t dilateY_step);
+void _AVX512BF16_MNNConvRunForLineDepthwise(float* dst, const float* src, const float* weight, size_t width, size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step, size_t height, size_t srcHStep, size_t dstHStep);
+
+// ========= GemmAMX.cpp ===========
+// Pack by _AVX_MNNPackForMatMul_B_BF16Tile / _AVX_MNNPackC4ForMatMul_A_BF16Tile, eP = 32, lP = 32, hP = 16
+// Ask the OS for the permission of tile data, return false if the tiles can't be used
+bool _AMX_Init();
+void _AMX_MNNGetMatMulPackMode(int* eP, int* lP, int* hP);
+void _AMX_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter, const float* postParameters, const float* bias);
+}
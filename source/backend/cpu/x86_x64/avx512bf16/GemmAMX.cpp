@@ -0,0 +1,101 @@
+//
+//  GemmAMX.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <string.h>
+#include <algorithm>
+#include "GemmCommon.hpp"
+#include "core/Macro.h"
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// TDPBF16PS GEMM, eP = 32, lP = 32, hP = 16, set in BF16Functions.cpp
+// A: [l / 32, e, 32], B: [h / 16, l / 2, 16, 2], C: [h / 4, e, 4]
+// Each 32 l block of 16 e is one A tile and 16 h is one B tile, two A tiles share the B tile
+// The order of the sums in TDPBF16PS is up to the hardware, so it may differ from VDPBF16PS in the last bit
+#define AMX_EP 32
+#define AMX_LP 32
+
+namespace {
+struct TileConfig {
+    uint8_t paletteId;
+    uint8_t startRow;
+    uint8_t reserved[14];
+    uint16_t colsb[16];
+    uint8_t rows[16];
+};
+
+// tmm0, tmm1: C, tmm2, tmm3: A, tmm4: B, each has 16 rows of 64 bytes
+static void _loadTileConfig() {
+    TileConfig config;
+    ::memset(&config, 0, sizeof(TileConfig));
+    config.paletteId = 1;
+    for (int i = 0; i < 5; ++i) {
+        config.rows[i]  = 16;
+        config.colsb[i] = 64;
+    }
+    _tile_loadconfig(&config);
+}
+} // namespace
+
+bool _AMX_Init() {
+#ifdef __linux__
+    // ARCH_REQ_XCOMP_PERM for XFEATURE_XTILEDATA
+    return 0 == syscall(SYS_arch_prctl, 0x1023, 18);
+#else
+    return false;
+#endif
+}
+
+void _AMX_MNNGetMatMulPackMode(int* eP, int* lP, int* hP) {
+    *eP = AMX_EP;
+    *lP = AMX_LP;
+    *hP = 16;
+}
+
+void _AMX_MNNPackedMatMul(float* CO, const float* AO, const float* BO, const size_t* parameter,
+                          const float* postParameters, const float* biasO) {
+    auto C            = (int16_t*)CO;
+    auto A            = (const int16_t*)AO;
+    auto B            = (const int16_t*)BO;
+    auto bias         = (const int16_t*)biasO;
+    auto l            = parameter[1];
+    auto h            = parameter[2];
+    auto cStride      = parameter[3] / sizeof(int16_t);
+    auto bExtraStride = parameter[5] / sizeof(int16_t);
+    auto lC32         = UP_DIV(l, AMX_LP);
+    auto bStride      = bExtraStride + lC32 * AMX_LP * 16;
+    auto hC4          = UP_DIV(h, 4);
+    auto hC16         = UP_DIV(h, 16);
+    // The tile config belongs to the thread, so load it for each call
+    _loadTileConfig();
+    float temp[AMX_EP * 16];
+    for (int y = 0; y < hC16; ++y) {
+        auto weight = B + y * bStride;
+        _tile_zero(0);
+        _tile_zero(1);
+        for (int z = 0; z < lC32; ++z) {
+            auto aZ = A + z * AMX_EP * AMX_LP;
+            _tile_loadd(2, aZ, AMX_LP * sizeof(int16_t));
+            _tile_loadd(3, aZ + 16 * AMX_LP, AMX_LP * sizeof(int16_t));
+            _tile_loadd(4, weight + z * AMX_LP * 16, 32 * sizeof(int16_t));
+            _tile_dpbf16ps(0, 2, 4);
+            _tile_dpbf16ps(1, 3, 4);
+        }
+        _tile_stored(0, temp, 16 * sizeof(float));
+        _tile_stored(1, temp + 16 * 16, 16 * sizeof(float));
+        auto hC4Y = std::min((int)hC4 - 4 * y, 4);
+        BF16PostTreat post(postParameters, nullptr != bias ? bias + 16 * y : nullptr, hC4Y);
+        auto dst = C + 4 * y * cStride;
+        for (int i = 0; i < AMX_EP; ++i) {
+            _AVX512BF16_StoreC4(dst + 4 * i, _mm512_loadu_ps(temp + 16 * i), cStride, hC4Y, post);
+        }
+    }
+    _tile_release();
+}
@@ -0,0 +1,111 @@
+//
+//  GemmAVX512BF16.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <algorithm>
+#include "GemmCommon.hpp"
+#include "core/Macro.h"
+
+// VDPBF16PS GEMM, eP = 24, lP = 2, hP = 16, set in BF16Functions.cpp
+// A: [l / lP, e, lP], B: [h / 16, l / 2, 16, 2], C: [h / 4, e, 4]
+// The fp32 accumulator of one e keeps 16 h, it is rounded to bf16 only once after the post treat
+#define AVX512BF16_EP 24
+
+namespace {
+template <int E, int LP>
+static void _AVX512BF16_MatMulUnit(int16_t* C, const int16_t* A, const int16_t* weight, size_t l, size_t aStride,
+                                   size_t cStride, int hC4, const BF16PostTreat& post) {
+    __m512 acc[E];
+#pragma GCC unroll 24
+    for (int i = 0; i < E; ++i) {
+        acc[i] = _mm512_setzero_ps();
+    }
+    auto lPairs = UP_DIV(l, 2);
+    for (int z = 0; z < lPairs; ++z) {
+        auto w  = (__m512bh)_mm512_loadu_si512(weight + 32 * z);
+        auto aZ = A + (2 * z / LP) * aStride * LP + (2 * z) % LP;
+#pragma GCC unroll 24
+        for (int i = 0; i < E; ++i) {
+            acc[i] = _mm512_dpbf16_ps(acc[i], (__m512bh)_mm512_set1_epi32(*(const int32_t*)(aZ + LP * i)), w);
+        }
+    }
+#pragma GCC unroll 24
+    for (int i = 0; i < E; ++i) {
+        _AVX512BF16_StoreC4(C + 4 * i, acc[i], cStride, hC4, post);
+    }
+}
+
+template <int E, int LP>
+static void _AVX512BF16_MatMul(int16_t* C, const int16_t* A, const int16_t* B, size_t aStride, const size_t* parameter,
+                               const float* postParameters, const int16_t* bias) {
+    auto l            = parameter[1];
+    auto h            = parameter[2];
+    auto cStride      = parameter[3] / sizeof(int16_t);
+    auto bExtraStride = parameter[5] / sizeof(int16_t);
+    auto bStride      = bExtraStride + UP_DIV(l, LP) * LP * 16;
+    auto hC4          = UP_DIV(h, 4);
+    auto hC16         = UP_DIV(h, 16);
+    for (int y = 0; y < hC16; ++y) {
+        auto hC4Y = std::min((int)hC4 - 4 * y, 4);
+        BF16PostTreat post(postParameters, nullptr != bias ? bias + 16 * y : nullptr, hC4Y);
+        _AVX512BF16_MatMulUnit<E, LP>(C + 4 * y * cStride, A, B + y * bStride, l, aStride, cStride, hC4Y, post);
+    }
+}
+
+template <int LP>
+static void _AVX512BF16_MatMulRemain(int16_t* C, const int16_t* A, const int16_t* B, size_t eSize,
+                                     const size_t* parameter, const float* postParameters, const int16_t* bias) {
+    auto aStride = parameter[0] / sizeof(int16_t);
+    if (eSize >= 16) {
+        _AVX512BF16_MatMul<16, LP>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 16;
+        C += 16 * 4;
+        A += 16 * LP;
+    }
+    if (eSize >= 8) {
+        _AVX512BF16_MatMul<8, LP>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 8;
+        C += 8 * 4;
+        A += 8 * LP;
+    }
+    if (eSize >= 4) {
+        _AVX512BF16_MatMul<4, LP>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 4;
+        C += 4 * 4;
+        A += 4 * LP;
+    }
+    for (; eSize > 0; --eSize) {
+        _AVX512BF16_MatMul<1, LP>(C, A, B, aStride, parameter, postParameters, bias);
+        C += 4;
+        A += LP;
+    }
+}
+} // namespace
+
+void _AVX512BF16_MNNGetMatMulPackMode(int* eP, int* lP, int* hP) {
+    *eP = AVX512BF16_EP;
+    *lP = 2;
+    *hP = 16;
+}
+
+void _AVX512BF16_MNNPackedMatMul(float* C, const float* A, const float* B, const size_t* parameter,
+                                 const float* postParameters, const float* bias) {
+    _AVX512BF16_MatMul<AVX512BF16_EP, 2>((int16_t*)C, (const int16_t*)A, (const int16_t*)B, AVX512BF16_EP, parameter,
+                                         postParameters, (const int16_t*)bias);
+}
+
+void _AVX512BF16_MNNPackedMatMulRemain(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter,
+                                       const float* postParameters, const float* bias) {
+    _AVX512BF16_MatMulRemain<2>((int16_t*)C, (const int16_t*)A, (const int16_t*)B, eSize, parameter, postParameters,
+                                (const int16_t*)bias);
+}
+
+void _AVX512BF16_MNNPackedMatMulRemainTile(float* C, const float* A, const float* B, size_t eSize,
+                                           const size_t* parameter, const float* postParameters, const float* bias) {
+    _AVX512BF16_MatMulRemain<32>((int16_t*)C, (const int16_t*)A, (const int16_t*)B, eSize, parameter, postParameters,
+                                 (const int16_t*)bias);
+}
@@ -0,0 +1,55 @@
+//
+//  GemmCommon.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef AVX512BF16_GemmCommon_hpp
+#define AVX512BF16_GemmCommon_hpp
+#include "FunctionSummary.hpp"
+
+// Post treat of 16 h of one e, the bias is aligned to 4 only
+struct BF16PostTreat {
+    BF16PostTreat(const float* postParameters, const int16_t* bias, int hC4) {
+        enable = nullptr != postParameters;
+        biasV  = _mm512_setzero_ps();
+        minV   = _mm512_setzero_ps();
+        maxV   = _mm512_setzero_ps();
+        if (!enable) {
+            return;
+        }
+        if (nullptr != bias) {
+            auto b = _mm256_maskz_loadu_epi16((__mmask16)((1 << (4 * hC4)) - 1), bias);
+            biasV  = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(b), 16));
+        }
+        minV = _mm512_set1_ps(postParameters[2]);
+        maxV = _mm512_set1_ps(postParameters[3]);
+    }
+    bool enable;
+    __m512 biasV;
+    __m512 minV;
+    __m512 maxV;
+};
+
+// Truncate to bf16 as MNNFP32ToBF16 and store hC4 planes of C4
+static inline void _AVX512BF16_StoreC4(int16_t* dst, __m512 acc, size_t cStride, int hC4, const BF16PostTreat& post) {
+    if (post.enable) {
+        acc = _mm512_min_ps(_mm512_max_ps(_mm512_add_ps(acc, post.biasV), post.minV), post.maxV);
+    }
+    auto d  = _mm512_cvtepi32_epi16(_mm512_srli_epi32(_mm512_castps_si512(acc), 16));
+    auto d0 = _mm256_castsi256_si128(d);
+    _mm_storel_epi64((__m128i*)dst, d0);
+    if (hC4 > 1) {
+        _mm_storel_epi64((__m128i*)(dst + cStride), _mm_unpackhi_epi64(d0, d0));
+    }
+    if (hC4 > 2) {
+        auto d1 = _mm256_extracti128_si256(d, 1);
+        _mm_storel_epi64((__m128i*)(dst + 2 * cStride), d1);
+        if (hC4 > 3) {
+            _mm_storel_epi64((__m128i*)(dst + 3 * cStride), _mm_unpackhi_epi64(d1, d1));
+        }
+    }
+}
+#endif
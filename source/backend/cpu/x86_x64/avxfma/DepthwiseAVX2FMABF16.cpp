@@ -0,0 +1,121 @@
+//
+//  DepthwiseAVX2FMABF16.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#if defined(MNN_SUPPORT_BF16) && !defined(MNN_SSE_USE_FP16_INSTEAD)
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+// Emulation of the depthwise of avx512bf16: taps are paired along x, the second tap of a pair is added first and a
+// single last tap of a row is paired with zero, so the result is the same as VDPBF16PS for normal values
+namespace {
+static inline __m128 _load4(const int16_t* src) {
+    return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)src)), 16));
+}
+
+static inline __m256 _load8(const int16_t* src, size_t step) {
+    auto v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)src), _mm_loadl_epi64((const __m128i*)(src + step)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(v), 16));
+}
+
+static inline __m128i _truncate8(__m256 v) {
+    auto d = _mm256_srli_epi32(_mm256_castps_si256(v), 16);
+    return _mm_packus_epi32(_mm256_castsi256_si128(d), _mm256_extracti128_si256(d, 1));
+}
+
+// N pairs of pixels, one ymm for each pair
+template <int N>
+static void _depthwiseUnit(int16_t* dst, const int16_t* src, const int16_t* weight, size_t src_w_step, size_t fw,
+                           size_t fh, size_t dilateX_step, size_t dilateY_step) {
+    __m256 acc[N];
+#pragma GCC unroll 2
+    for (int i = 0; i < N; ++i) {
+        acc[i] = _mm256_setzero_ps();
+    }
+    auto zero = _mm256_setzero_ps();
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * fw * 4;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto w0          = _mm256_castsi256_ps(_mm256_broadcastsi128_si256(_mm_castps_si128(_load4(weight_y + 4 * fx))));
+            auto w1          = _mm256_castsi256_ps(_mm256_broadcastsi128_si256(_mm_castps_si128(_load4(weight_y + 4 * fx + 4))));
+#pragma GCC unroll 2
+            for (int i = 0; i < N; ++i) {
+                auto s = src_x + 2 * i * src_w_step;
+                acc[i] = _mm256_fmadd_ps(_load8(s + dilateX_step, src_w_step), w1, acc[i]);
+                acc[i] = _mm256_fmadd_ps(_load8(s, src_w_step), w0, acc[i]);
+            }
+        }
+        if (fx < fw) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto w0          = _mm256_castsi256_ps(_mm256_broadcastsi128_si256(_mm_castps_si128(_load4(weight_y + 4 * fx))));
+#pragma GCC unroll 2
+            for (int i = 0; i < N; ++i) {
+                acc[i] = _mm256_add_ps(acc[i], zero);
+                acc[i] = _mm256_fmadd_ps(_load8(src_x + 2 * i * src_w_step, src_w_step), w0, acc[i]);
+            }
+        }
+    }
+#pragma GCC unroll 2
+    for (int i = 0; i < N; ++i) {
+        _mm_storeu_si128((__m128i*)(dst + 8 * i), _truncate8(acc[i]));
+    }
+}
+} // namespace
+
+void _AVX_MNNConvRunForUnitDepthWiseFMA_BF16(float* dstO, const float* srcO, const float* weightO, size_t fw, size_t fh,
+                                             size_t weight_y_step, size_t dilateX_step, size_t dilateY_step) {
+    auto dst    = (int16_t*)dstO;
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    auto acc    = _mm_setzero_ps();
+    auto zero   = _mm_setzero_ps();
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * weight_y_step;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            acc = _mm_fmadd_ps(_load4(src_y + (fx + 1) * dilateX_step), _load4(weight_y + 4 * fx + 4), acc);
+            acc = _mm_fmadd_ps(_load4(src_y + fx * dilateX_step), _load4(weight_y + 4 * fx), acc);
+        }
+        if (fx < fw) {
+            acc = _mm_add_ps(acc, zero);
+            acc = _mm_fmadd_ps(_load4(src_y + fx * dilateX_step), _load4(weight_y + 4 * fx), acc);
+        }
+    }
+    auto d = _mm_srli_epi32(_mm_castps_si128(acc), 16);
+    _mm_storel_epi64((__m128i*)dst, _mm_packus_epi32(d, d));
+}
+
+void _AVX_MNNConvRunForLineDepthwiseFMA_BF16(float* dstO, const float* srcO, const float* weightO, size_t width,
+                                             size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step,
+                                             size_t dilateY_step, size_t height, size_t srcHStep, size_t dstHStep) {
+    auto dst    = (int16_t*)dstO;
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    for (int y = 0; y < height; ++y) {
+        auto srcY = src + y * srcHStep;
+        auto dstY = dst + y * dstHStep;
+        int dx    = 0;
+        for (; dx + 4 <= width; dx += 4) {
+            _depthwiseUnit<2>(dstY + 4 * dx, srcY + dx * src_w_setup, weight, src_w_setup, fw, fh, dilateX_step,
+                              dilateY_step);
+        }
+        if (dx + 2 <= width) {
+            _depthwiseUnit<1>(dstY + 4 * dx, srcY + dx * src_w_setup, weight, src_w_setup, fw, fh, dilateX_step,
+                              dilateY_step);
+            dx += 2;
+        }
+        if (dx < width) {
+            _AVX_MNNConvRunForUnitDepthWiseFMA_BF16((float*)(dstY + 4 * dx), (const float*)(srcY + dx * src_w_setup),
+                                                    weightO, fw, fh, fw * 4, dilateX_step, dilateY_step);
+        }
+    }
+}
+#endif
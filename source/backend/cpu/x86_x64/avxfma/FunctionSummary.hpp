@@ -46,5 +46,21 @@ void _AVX_MNNComputeMatMulForE_1FMA(const float* A, const float* B, float* C, co
 void _AVX_MNNPackedMatMulFMA_BF16(float* C, const float* A, const float* B, const size_t* parameter,
                                   const float* postParameters, const float* bias);
 void _AVX_MNNPackedMatMulRemainFMA_BF16(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
+// Emulation of the VDPBF16PS kernels, pack by _AVX_MNNPackForMatMul_B_BF16Pair / _AVX_MNNPackC4ForMatMul_A_BF16Pair
+void _AVX_MNNGetMatMulPackMode_BF16Pair(int* eP, int* lP, int* hP);
+void _AVX_MNNPackedMatMulFMA_BF16Pair(float* C, const float* A, const float* B, const size_t* parameter,
+                                      const float* postParameters, const float* bias);
+void _AVX_MNNPackedMatMulRemainFMA_BF16Pair(float* C, const float* A, const float* B, size_t eSize, const size_t* parameter, const float* postParameters, const float* bias);
+void _AVX_MNNConvRunForUnitDepthWiseFMA_BF16(float* dst, const float* src, const float* weight, size_t fw, size_t fh,
+                                             size_t weight_y_step, size_t dilateX_step, size_t dilateY_step);
+void _AVX_MNNConvRunForLineDepthwiseFMA_BF16(float* dst, const float* src, const float* weight, size_t width,
+                                             size_t src_w_setup, size_t fw, size_t fh, size_t dilateX_step,
+                                             size_t dilateY_step, size_t height, size_t srcHStep, size_t dstHStep);
+// Replace the NC4HW4 functions of a copied CoreFunctions with the NC8HW8 ones
+void _AVX_ExtraInit(void* functions);
+// Vectorized transcendental functions, see UnaryFunction.hpp
+MNN::CoreFunctions::MNNUnaryExecute _AVX_MNNSelectUnaryFunctionForFloat(int type, int precision);
+// Online softmax, see SoftmaxFunction.hpp
+void _AVX_MNNSoftmax(float* dest, const float* source, size_t channel, size_t inside, size_t stride);
 
 }
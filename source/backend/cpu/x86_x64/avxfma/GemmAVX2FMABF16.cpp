@@ -9,6 +9,8 @@
 #include "FunctionSummary.hpp"
 #include "../avx/GemmCommon.hpp"
 #include "core/Macro.h"
+#include <string.h>
+#include <algorithm>
 
 inline __m128i mnn_mm_loadu_si16(const void* x) {
     union S {
@@ -127,4 +129,122 @@ void _AVX_MNNPackedMatMulRemainFMA_BF16(float* C, const float* A, const float* B
     _AVX_MNNPackednMatMulRemainCommon<int16_t>((int16_t*)C, (const int16_t*)A, (const int16_t*)B, eSize, parameter);
     AVX2GemmPostTreatBF16(C, eSize, parameter, postParameters, bias);
 }
+
+#ifndef MNN_SSE_USE_FP16_INSTEAD
+// Emulation of the VDPBF16PS kernels of avx512bf16, eP = 4, lP = 2, hP = 16
+// Each pair adds the odd product before the even one with a fused multiply add, so the result is the same as
+// VDPBF16PS except for denormal inputs, which VDPBF16PS flushes to zero
+#define AVX2_BF16PAIR_EP 4
+namespace {
+template <int E>
+static void _AVX_MatMulBF16PairUnit(int16_t* C, const int16_t* A, const int16_t* B, size_t l, size_t aStride,
+                                    size_t cStride, int hC4, const float* postParameters, const int16_t* bias) {
+    __m256 acc[E][2];
+#pragma GCC unroll 4
+    for (int i = 0; i < E; ++i) {
+        acc[i][0] = _mm256_setzero_ps();
+        acc[i][1] = _mm256_setzero_ps();
+    }
+    auto mask   = _mm256_set1_epi32(0xFFFF0000);
+    auto lPairs = UP_DIV(l, 2);
+    for (int z = 0; z < lPairs; ++z) {
+        auto b0  = _mm256_loadu_si256((const __m256i*)(B + 32 * z));
+        auto b1  = _mm256_loadu_si256((const __m256i*)(B + 32 * z + 16));
+        auto bE0 = _mm256_castsi256_ps(_mm256_slli_epi32(b0, 16));
+        auto bO0 = _mm256_castsi256_ps(_mm256_and_si256(b0, mask));
+        auto bE1 = _mm256_castsi256_ps(_mm256_slli_epi32(b1, 16));
+        auto bO1 = _mm256_castsi256_ps(_mm256_and_si256(b1, mask));
+        auto aZ  = A + z * aStride * 2;
+#pragma GCC unroll 4
+        for (int i = 0; i < E; ++i) {
+            auto a    = _mm256_set1_epi32(*(const int32_t*)(aZ + 2 * i));
+            auto aE   = _mm256_castsi256_ps(_mm256_slli_epi32(a, 16));
+            auto aO   = _mm256_castsi256_ps(_mm256_and_si256(a, mask));
+            acc[i][0] = _mm256_fmadd_ps(aO, bO0, acc[i][0]);
+            acc[i][0] = _mm256_fmadd_ps(aE, bE0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(aO, bO1, acc[i][1]);
+            acc[i][1] = _mm256_fmadd_ps(aE, bE1, acc[i][1]);
+        }
+    }
+    if (nullptr != postParameters) {
+        // The bias is aligned to 4 only
+        auto biasV0 = _mm256_setzero_ps();
+        auto biasV1 = _mm256_setzero_ps();
+        if (nullptr != bias) {
+            int16_t biasTemp[16] = {0};
+            ::memcpy(biasTemp, bias, 4 * hC4 * sizeof(int16_t));
+            biasV0 = LOAD8(biasTemp);
+            biasV1 = LOAD8(biasTemp + 8);
+        }
+        auto minV = _mm256_broadcast_ss(postParameters + 2);
+        auto maxV = _mm256_broadcast_ss(postParameters + 3);
+#pragma GCC unroll 4
+        for (int i = 0; i < E; ++i) {
+            acc[i][0] = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(acc[i][0], biasV0), minV), maxV);
+            acc[i][1] = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(acc[i][1], biasV1), minV), maxV);
+        }
+    }
+#pragma GCC unroll 4
+    for (int i = 0; i < E; ++i) {
+        auto dst = C + 4 * i;
+        for (int j = 0; j < 2 && 2 * j < hC4; ++j) {
+            // Truncate as MNNFP32ToBF16, the value after shift is in [0, 65535] so packus keeps it
+            auto v = _mm256_srli_epi32(_mm256_castps_si256(acc[i][j]), 16);
+            auto d = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            _mm_storel_epi64((__m128i*)(dst + 2 * j * cStride), d);
+            if (2 * j + 1 < hC4) {
+                _mm_storel_epi64((__m128i*)(dst + (2 * j + 1) * cStride), _mm_unpackhi_epi64(d, d));
+            }
+        }
+    }
+}
+
+template <int E>
+static void _AVX_MatMulBF16Pair(int16_t* C, const int16_t* A, const int16_t* B, size_t aStride, const size_t* parameter,
+                                const float* postParameters, const int16_t* bias) {
+    auto l            = parameter[1];
+    auto h            = parameter[2];
+    auto cStride      = parameter[3] / sizeof(int16_t);
+    auto bExtraStride = parameter[5] / sizeof(int16_t);
+    auto bStride      = bExtraStride + UP_DIV(l, 2) * 2 * 16;
+    auto hC4          = UP_DIV(h, 4);
+    auto hC16         = UP_DIV(h, 16);
+    for (int y = 0; y < hC16; ++y) {
+        auto biasY = nullptr != bias ? bias + 16 * y : nullptr;
+        _AVX_MatMulBF16PairUnit<E>(C + 4 * y * cStride, A, B + y * bStride, l, aStride, cStride,
+                                   std::min((int)hC4 - 4 * y, 4), postParameters, biasY);
+    }
+}
+} // namespace
+
+void _AVX_MNNGetMatMulPackMode_BF16Pair(int* eP, int* lP, int* hP) {
+    *eP = AVX2_BF16PAIR_EP;
+    *lP = 2;
+    *hP = 16;
+}
+
+void _AVX_MNNPackedMatMulFMA_BF16Pair(float* C, const float* A, const float* B, const size_t* parameter,
+                                      const float* postParameters, const float* bias) {
+    _AVX_MatMulBF16Pair<AVX2_BF16PAIR_EP>((int16_t*)C, (const int16_t*)A, (const int16_t*)B, AVX2_BF16PAIR_EP,
+                                          parameter, postParameters, (const int16_t*)bias);
+}
+
+void _AVX_MNNPackedMatMulRemainFMA_BF16Pair(float* CO, const float* AO, const float* BO, size_t eSize,
+                                            const size_t* parameter, const float* postParameters, const float* biasO) {
+    auto C       = (int16_t*)CO;
+    auto A       = (const int16_t*)AO;
+    auto B       = (const int16_t*)BO;
+    auto bias    = (const int16_t*)biasO;
+    auto aStride = parameter[0] / sizeof(int16_t);
+    if (eSize >= 2) {
+        _AVX_MatMulBF16Pair<2>(C, A, B, aStride, parameter, postParameters, bias);
+        eSize -= 2;
+        C += 2 * 4;
+        A += 2 * 2;
+    }
+    if (eSize > 0) {
+        _AVX_MatMulBF16Pair<1>(C, A, B, aStride, parameter, postParameters, bias);
+    }
+}
+#endif
 #endif
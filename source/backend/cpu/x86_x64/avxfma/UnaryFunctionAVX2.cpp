@@ -0,0 +1,21 @@
+//
+//  UnaryFunctionAVX2.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "backend/cpu/compute/UnaryFunction.hpp"
+#include "backend/cpu/compute/SoftmaxFunction.hpp"
+
+using Vec8 = MNN::Math::Vec<float, 8>;
+
+MNN::CoreFunctions::MNNUnaryExecute _AVX_MNNSelectUnaryFunctionForFloat(int type, int precision) {
+    return MNN::UnaryFunction<Vec8, 8>::select(type, precision);
+}
+
+void _AVX_MNNSoftmax(float* dest, const float* source, size_t channel, size_t inside, size_t stride) {
+    MNN::SoftmaxFunction<Vec8, 8>::execute(dest, source, channel, inside, stride);
+}
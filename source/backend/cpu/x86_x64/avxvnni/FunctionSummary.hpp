@@ -0,0 +1,21 @@
+//
+//  FunctionSummary.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include <stdint.h>
+#include "backend/cpu/compute/Int8FunctionsOpt.h"
+
+// ========= Int8FunctionAVXVNNI.cpp ===========
+// VEX encoded VNNI of client cores without AVX512
+extern "C" {
+void _AVXVNNI_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* src, const int8_t* weight, const QuanPostTreatParameters* parameters, size_t width, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step);
+}
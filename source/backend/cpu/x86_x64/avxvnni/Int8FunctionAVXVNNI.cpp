@@ -0,0 +1,113 @@
+//
+//  Int8FunctionAVXVNNI.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "FunctionSummary.hpp"
+#include "core/Macro.h"
+
+namespace {
+enum DepthwiseLoad {
+    LOAD_CONTINUE,
+    LOAD_STRIDE,
+    LOAD_PARTIAL,
+};
+
+template <DepthwiseLoad mode>
+static inline __m256i _loadPixel4(const int16_t* src, size_t step, int count) {
+    if (LOAD_CONTINUE == mode) {
+        return _mm256_loadu_si256((const __m256i*)src);
+    }
+    if (LOAD_STRIDE == mode) {
+        return _mm256_set_epi64x(*(const int64_t*)(src + 3 * step), *(const int64_t*)(src + 2 * step),
+                                 *(const int64_t*)(src + 1 * step), *(const int64_t*)(src));
+    }
+    int64_t temp[4] = {0, 0, 0, 0};
+    for (int i = 0; i < count; ++i) {
+        temp[i] = *(const int64_t*)(src + i * step);
+    }
+    return _mm256_loadu_si256((const __m256i*)temp);
+}
+
+static inline __m256i _pairWeight(const int16_t* w0, const int16_t* w1) {
+    auto w = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)w0),
+                                nullptr == w1 ? _mm_setzero_si128() : _mm_loadl_epi64((const __m128i*)w1));
+    return _mm256_broadcastsi128_si256(w);
+}
+
+// Same as the AVX512 one: two taps are interleaved to int16 pairs, d0 holds pixel 0, 2 and d1 holds pixel 1, 3
+template <DepthwiseLoad mode>
+static void _depthwiseUnit(int8_t* dst, const int16_t* src, const int16_t* weight, const QuanPostTreatParameters* parameters,
+                           int count, size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step, size_t dilateY_step) {
+    auto d0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)parameters->bias));
+    auto d1 = d0;
+    for (int fy = 0; fy < fh; ++fy) {
+        const auto src_y    = src + fy * dilateY_step;
+        const auto weight_y = weight + fy * fw * 4;
+        int fx              = 0;
+        for (; fx + 1 < fw; fx += 2) {
+            const auto src_x = src_y + fx * dilateX_step;
+            auto s0          = _loadPixel4<mode>(src_x, src_w_step, count);
+            auto s1          = _loadPixel4<mode>(src_x + dilateX_step, src_w_step, count);
+            auto w           = _pairWeight(weight_y + 4 * fx, weight_y + 4 * fx + 4);
+            d0               = _mm256_dpwssd_avx_epi32(d0, _mm256_unpacklo_epi16(s0, s1), w);
+            d1               = _mm256_dpwssd_avx_epi32(d1, _mm256_unpackhi_epi16(s0, s1), w);
+        }
+        if (fx < fw) {
+            auto s0   = _loadPixel4<mode>(src_y + fx * dilateX_step, src_w_step, count);
+            auto zero = _mm256_setzero_si256();
+            auto w    = _pairWeight(weight_y + 4 * fx, nullptr);
+            d0        = _mm256_dpwssd_avx_epi32(d0, _mm256_unpacklo_epi16(s0, zero), w);
+            d1        = _mm256_dpwssd_avx_epi32(d1, _mm256_unpackhi_epi16(s0, zero), w);
+        }
+    }
+    auto scale = _mm256_broadcast_ps((const __m128*)parameters->scale);
+    auto zero  = _mm256_setzero_ps();
+    auto plus  = _mm256_set1_ps(0.5f);
+    auto minus = _mm256_set1_ps(-0.5f);
+    auto f0    = _mm256_mul_ps(_mm256_cvtepi32_ps(d0), scale);
+    auto f1    = _mm256_mul_ps(_mm256_cvtepi32_ps(d1), scale);
+    f0         = _mm256_add_ps(f0, _mm256_blendv_ps(plus, minus, _mm256_cmp_ps(f0, zero, _CMP_LT_OQ)));
+    f1         = _mm256_add_ps(f1, _mm256_blendv_ps(plus, minus, _mm256_cmp_ps(f1, zero, _CMP_LT_OQ)));
+    // packs works in 128 bit lanes: [0, 1] and [2, 3]
+    auto d     = _mm256_packs_epi32(_mm256_cvttps_epi32(f0), _mm256_cvttps_epi32(f1));
+    auto r     = _mm_packs_epi16(_mm256_castsi256_si128(d), _mm256_extracti128_si256(d, 1));
+    r          = _mm_min_epi8(_mm_max_epi8(r, _mm_set1_epi8(parameters->minValue)), _mm_set1_epi8(parameters->maxValue));
+    if (LOAD_PARTIAL == mode) {
+        int32_t temp[4];
+        _mm_storeu_si128((__m128i*)temp, r);
+        for (int i = 0; i < count; ++i) {
+            *(int32_t*)(dst + 4 * i) = temp[i];
+        }
+    } else {
+        _mm_storeu_si128((__m128i*)dst, r);
+    }
+}
+} // namespace
+
+void _AVXVNNI_MNNLineDepthWiseInt8AddBiasScaleUnit(int8_t* dst, const int8_t* srcO, const int8_t* weightO,
+                                                   const QuanPostTreatParameters* parameters, size_t width,
+                                                   size_t src_w_step, size_t fw, size_t fh, size_t dilateX_step,
+                                                   size_t dilateY_step) {
+    auto src    = (const int16_t*)srcO;
+    auto weight = (const int16_t*)weightO;
+    int dx      = 0;
+    if (4 == src_w_step) {
+        for (; dx + 4 <= width; dx += 4) {
+            _depthwiseUnit<LOAD_CONTINUE>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step, fw,
+                                          fh, dilateX_step, dilateY_step);
+        }
+    } else {
+        for (; dx + 4 <= width; dx += 4) {
+            _depthwiseUnit<LOAD_STRIDE>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, 4, src_w_step, fw, fh,
+                                        dilateX_step, dilateY_step);
+        }
+    }
+    if (dx < width) {
+        _depthwiseUnit<LOAD_PARTIAL>(dst + 4 * dx, src + dx * src_w_step, weight, parameters, width - dx, src_w_step,
+                                     fw, fh, dilateX_step, dilateY_step);
+    }
+}
@@ -73,6 +73,105 @@ void _SSE_MNNReluInt8(int8_t* dst, const int8_t* src, size_t size) {
     }
 }
 
+static inline __m128i _SSE_AvgPoolRound(__m128i sum, __m128i half, __m128 count) {
+    // Round half away from zero: (sum +- count / 2) / count, the float division is exact for int8 windows
+    auto adjust = _mm_blendv_epi8(_mm_sub_epi32(_mm_setzero_si128(), half), half, _mm_cmpgt_epi32(sum, _mm_setzero_si128()));
+    return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_add_epi32(sum, adjust)), count));
+}
+
+void _SSE_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    int c = 0;
+    for (; c + 16 <= channel; c += 16) {
+        auto maxValue = _mm_set1_epi8(-128);
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = _mm_max_epi8(maxValue, _mm_loadu_si128((const __m128i*)(srcY + x * channel)));
+            }
+        }
+        _mm_storeu_si128((__m128i*)(dst + c), maxValue);
+    }
+    for (; c < channel; ++c) {
+        int8_t maxValue = -128;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                maxValue = std::max(maxValue, srcY[x * channel]);
+            }
+        }
+        dst[c] = maxValue;
+    }
+}
+
+void _SSE_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky) {
+    const int32_t count = (int32_t)(kx * ky);
+    auto countF         = _mm_set1_ps((float)count);
+    auto half           = _mm_set1_epi32(count / 2);
+    int c               = 0;
+    for (; c + 16 <= channel; c += 16) {
+        auto sum0 = _mm_setzero_si128();
+        auto sum1 = _mm_setzero_si128();
+        auto sum2 = _mm_setzero_si128();
+        auto sum3 = _mm_setzero_si128();
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                auto s = _mm_loadu_si128((const __m128i*)(srcY + x * channel));
+                sum0   = _mm_add_epi32(sum0, _mm_cvtepi8_epi32(s));
+                sum1   = _mm_add_epi32(sum1, _mm_cvtepi8_epi32(_mm_srli_si128(s, 4)));
+                sum2   = _mm_add_epi32(sum2, _mm_cvtepi8_epi32(_mm_srli_si128(s, 8)));
+                sum3   = _mm_add_epi32(sum3, _mm_cvtepi8_epi32(_mm_srli_si128(s, 12)));
+            }
+        }
+        auto d0 = _mm_packs_epi32(_SSE_AvgPoolRound(sum0, half, countF), _SSE_AvgPoolRound(sum1, half, countF));
+        auto d1 = _mm_packs_epi32(_SSE_AvgPoolRound(sum2, half, countF), _SSE_AvgPoolRound(sum3, half, countF));
+        _mm_storeu_si128((__m128i*)(dst + c), _mm_packs_epi16(d0, d1));
+    }
+    for (; c < channel; ++c) {
+        int32_t sum = 0;
+        for (int y = 0; y < ky; ++y) {
+            auto srcY = src + y * srcRowStride + c;
+            for (int x = 0; x < kx; ++x) {
+                sum += srcY[x * channel];
+            }
+        }
+        dst[c] = sum > 0 ? (sum + count / 2) / count : (sum - count / 2) / count;
+    }
+}
+
+void _SSE_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                          const float* outputScale, const size_t size) {
+    auto s0        = _mm_loadu_ps(scale0);
+    auto s1        = _mm_loadu_ps(scale1);
+    auto os        = _mm_loadu_ps(outputScale);
+    auto minValue  = _mm_set1_ps(-127.0f);
+    auto maxValue  = _mm_set1_ps(127.0f);
+    auto compute   = [&](__m128i a, __m128i b) {
+        auto f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(a)), s0),
+                            _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(b)), s1));
+        f      = _mm_max_ps(_mm_min_ps(_mm_mul_ps(f, os), maxValue), minValue);
+        return _mm_cvttps_epi32(f);
+    };
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        auto a  = _mm_loadu_si128((const __m128i*)(src0 + 4 * i));
+        auto b  = _mm_loadu_si128((const __m128i*)(src1 + 4 * i));
+        auto d0 = _mm_packs_epi32(compute(a, b), compute(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4)));
+        auto d1 = _mm_packs_epi32(compute(_mm_srli_si128(a, 8), _mm_srli_si128(b, 8)),
+                                  compute(_mm_srli_si128(a, 12), _mm_srli_si128(b, 12)));
+        _mm_storeu_si128((__m128i*)(dst + 4 * i), _mm_packs_epi16(d0, d1));
+    }
+    for (; i < size; ++i) {
+        int32_t a, b;
+        ::memcpy(&a, src0 + 4 * i, sizeof(int32_t));
+        ::memcpy(&b, src1 + 4 * i, sizeof(int32_t));
+        auto d = compute(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b));
+        d      = _mm_packs_epi16(_mm_packs_epi32(d, d), d);
+        int32_t r = _mm_cvtsi128_si32(d);
+        ::memcpy(dst + 4 * i, &r, sizeof(int32_t));
+    }
+}
+
 void _SSE_MNNReluWithSlopeChannel(float* dst, const float* src, const float* slope, size_t sizeQuad, size_t depthQuad) {
     auto zero = _mm_set1_ps(0.0f);
     for (int j = 0; j < depthQuad; j++) {
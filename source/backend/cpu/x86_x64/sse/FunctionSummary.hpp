@@ -83,3 +83,7 @@ void _SSE_MNNComputeMatMulForE_1(const float* A, const float* B, float* C, const
 
 void _SSE_MNNPackForMatMul_B_BF16(float* dest, const float* source, size_t h, size_t l, bool transpose);
 void _SSE_MNNReluInt8(int8_t* dst, const int8_t* src, size_t size);
+void _SSE_MNNMaxPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _SSE_MNNAvgPoolInt8(int8_t* dst, const int8_t* src, size_t channel, size_t srcRowStride, size_t kx, size_t ky);
+void _SSE_MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
+                          const float* outputScale, const size_t size);
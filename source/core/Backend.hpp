@@ -39,6 +39,8 @@ public:
         };
         /** user data. */
         BackendConfig* user = NULL;
+        /** CPU only: cpus to bind the threads of the runtime, see ScheduleConfig::cpuIds */
+        std::vector<int> cpuIds;
         enum Mode {
             // The Op will be run in execution->onExecute
             DIRECT = 0,
@@ -123,6 +125,13 @@ public:
     virtual void onResizeEnd() {
         // nothing to do
     }
+    /**
+     * @brief called after onResizeEnd.
+     * @return true if the same resize should run once more, e.g. to use the memory planned by this one.
+     */
+    virtual bool onResizeAgain() {
+        return false;
+    }
 
     /**
      * @brief callback before executing ops.
@@ -163,6 +172,13 @@ public:
      */
     virtual void onCopyBuffer(const Tensor* srcTensor, const Tensor* dstTensor) const = 0;
 
+    /**
+     * @brief measure the memory held by the backend itself in MB, the memory of its runtime is not included.
+     */
+    virtual float onGetMemoryInMB() {
+        return 0.0f;
+    }
+
     /**
      * @brief get runtime datatype.
      * @param op      the run op.
@@ -0,0 +1,257 @@
+//
+//  BatchSession.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/26.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <MNN/BatchSession.hpp>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "core/Macro.h"
+
+namespace MNN {
+typedef std::chrono::steady_clock BatchClock;
+
+struct BatchRequest {
+    const std::map<std::string, const Tensor*>* inputs           = nullptr;
+    std::map<std::string, std::shared_ptr<Tensor>>* outputs      = nullptr;
+    int batch                                                     = 0;
+    // Shapes of the inputs besides the batch, only requests with the same key are run together
+    std::string key;
+    BatchClock::time_point submit;
+    ErrorCode code = NO_ERROR;
+    bool done      = false;
+};
+
+struct BatchSession::Content {
+    Interpreter* net = nullptr;
+    Session* session = nullptr;
+    BatchConfig config;
+    std::map<std::string, Tensor*> inputs;
+
+    std::mutex lock;
+    std::condition_variable queueCondition;
+    std::condition_variable doneCondition;
+    std::list<BatchRequest*> queue;
+    bool stop = false;
+    BatchStatistics statistics;
+    std::thread thread;
+
+    // Total batch of the queued requests with the key
+    int queuedBatch(const std::string& key) const {
+        int batch = 0;
+        for (auto request : queue) {
+            if (request->key == key) {
+                batch += request->batch;
+            }
+        }
+        return batch;
+    }
+    ErrorCode runBatch(const std::vector<BatchRequest*>& requests, int batch);
+    void loop();
+};
+
+static uint64_t _durationInUs(BatchClock::time_point start, BatchClock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+ErrorCode BatchSession::Content::runBatch(const std::vector<BatchRequest*>& requests, int batch) {
+    // Gather inputs to host tensors with the total batch and resize the session if the batch is changed
+    bool needResize = false;
+    std::map<std::string, std::shared_ptr<Tensor>> hostInputs;
+    for (auto& iter : inputs) {
+        auto first = requests[0]->inputs->find(iter.first)->second;
+        auto shape = first->shape();
+        shape[0]   = batch;
+        std::shared_ptr<Tensor> host(Tensor::create(shape, first->getType(), nullptr, first->getDimensionType()));
+        auto dst = host->host<uint8_t>();
+        for (auto request : requests) {
+            auto src  = request->inputs->find(iter.first)->second;
+            auto size = src->size();
+            ::memcpy(dst, src->host<void>(), size);
+            dst += size;
+        }
+        Tensor target(host.get(), iter.second->getDimensionType(), false);
+        if (target.shape() != iter.second->shape()) {
+            net->resizeTensor(iter.second, target.shape());
+            needResize = true;
+        }
+        hostInputs.insert(std::make_pair(iter.first, host));
+    }
+    if (needResize) {
+        net->resizeSession(session);
+        std::unique_lock<std::mutex> _l(lock);
+        statistics.resizes++;
+    }
+    for (auto& iter : inputs) {
+        if (!iter.second->copyFromHostTensor(hostInputs[iter.first].get())) {
+            MNN_ERROR("Copy input %s for batch error\n", iter.first.c_str());
+            return INPUT_DATA_ERROR;
+        }
+    }
+    auto code = net->runSession(session);
+    if (NO_ERROR != code) {
+        return code;
+    }
+
+    // Scatter outputs along the batch
+    for (auto& iter : net->getSessionOutputAll(session)) {
+        auto output = iter.second;
+        if (output->dimensions() < 1 || output->length(0) != batch) {
+            MNN_ERROR("Output %s doesn't have the batch as first dimension\n", iter.first.c_str());
+            return NOT_SUPPORT;
+        }
+        std::shared_ptr<Tensor> host(new Tensor(output, config.outputDimensionType, true));
+        output->copyToHostTensor(host.get());
+        auto shape     = host->shape();
+        auto batchSize = host->size() / batch;
+        auto src       = host->host<uint8_t>();
+        for (auto request : requests) {
+            shape[0] = request->batch;
+            std::shared_ptr<Tensor> result(
+                Tensor::create(shape, host->getType(), nullptr, config.outputDimensionType));
+            ::memcpy(result->host<void>(), src, batchSize * request->batch);
+            src += batchSize * request->batch;
+            (*request->outputs)[iter.first] = result;
+        }
+    }
+    return NO_ERROR;
+}
+
+void BatchSession::Content::loop() {
+    std::unique_lock<std::mutex> _l(lock);
+    while (true) {
+        queueCondition.wait(_l, [this]() { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            break;
+        }
+        // Wait for more requests until the batch is full or the first request is timeout
+        auto key      = queue.front()->key;
+        auto deadline = queue.front()->submit + std::chrono::microseconds(config.timeout);
+        while (!stop && queuedBatch(key) < config.maxBatch) {
+            if (std::cv_status::timeout == queueCondition.wait_until(_l, deadline)) {
+                break;
+            }
+        }
+        std::vector<BatchRequest*> requests;
+        int batch = 0;
+        for (auto iter = queue.begin(); iter != queue.end();) {
+            auto request = *iter;
+            if (request->key == key && batch + request->batch <= config.maxBatch) {
+                batch += request->batch;
+                requests.emplace_back(request);
+                iter = queue.erase(iter);
+                continue;
+            }
+            iter++;
+        }
+        auto start = BatchClock::now();
+        _l.unlock();
+        auto code = runBatch(requests, batch);
+        _l.lock();
+        auto end = BatchClock::now();
+        statistics.runs++;
+        statistics.batches += batch;
+        statistics.runTime += _durationInUs(start, end);
+        for (auto request : requests) {
+            statistics.requests++;
+            statistics.waitTime += _durationInUs(request->submit, start);
+            statistics.maxLatency = std::max(statistics.maxLatency, _durationInUs(request->submit, end));
+            request->code         = code;
+            request->done         = true;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+BatchSession* BatchSession::create(Interpreter* net, const ScheduleConfig& config, const BatchConfig& batch) {
+    if (nullptr == net || batch.maxBatch <= 0 || batch.timeout < 0) {
+        MNN_ERROR("Invalid parameter for BatchSession\n");
+        return nullptr;
+    }
+    auto session = net->createSession(config);
+    if (nullptr == session) {
+        return nullptr;
+    }
+    if (batch.shapeCacheMemory > 0.0f) {
+        net->setSessionShapeCache(session, batch.shapeCacheMemory);
+    }
+    auto content     = new Content;
+    content->net     = net;
+    content->session = session;
+    content->config  = batch;
+    content->inputs  = net->getSessionInputAll(session);
+    content->thread  = std::thread([content]() { content->loop(); });
+    return new BatchSession(content);
+}
+
+BatchSession::BatchSession(Content* content) {
+    mContent = content;
+}
+
+BatchSession::~BatchSession() {
+    {
+        std::unique_lock<std::mutex> _l(mContent->lock);
+        mContent->stop = true;
+        mContent->queueCondition.notify_all();
+    }
+    mContent->thread.join();
+    mContent->net->releaseSession(mContent->session);
+    delete mContent;
+}
+
+ErrorCode BatchSession::run(const std::map<std::string, const Tensor*>& inputs,
+                            std::map<std::string, std::shared_ptr<Tensor>>& outputs) {
+    BatchRequest request;
+    request.inputs  = &inputs;
+    request.outputs = &outputs;
+    request.batch   = -1;
+    std::ostringstream key;
+    for (auto& iter : mContent->inputs) {
+        auto input = inputs.find(iter.first);
+        if (input == inputs.end() || nullptr == input->second || nullptr == input->second->host<void>() ||
+            input->second->dimensions() < 1) {
+            MNN_ERROR("Input %s for BatchSession is not a host tensor\n", iter.first.c_str());
+            return INPUT_DATA_ERROR;
+        }
+        auto tensor = input->second;
+        if (request.batch >= 0 && request.batch != tensor->length(0)) {
+            MNN_ERROR("Inputs for BatchSession have different batch\n");
+            return INPUT_DATA_ERROR;
+        }
+        request.batch = tensor->length(0);
+        key << iter.first << ":" << tensor->getDimensionType() << ":" << (int)tensor->getType().code << ":"
+            << tensor->getType().bits;
+        for (int i = 1; i < tensor->dimensions(); ++i) {
+            key << "," << tensor->length(i);
+        }
+        key << ";";
+    }
+    if (request.batch <= 0 || request.batch > mContent->config.maxBatch) {
+        MNN_ERROR("Invalid batch %d for BatchSession, max is %d\n", request.batch, mContent->config.maxBatch);
+        return INPUT_DATA_ERROR;
+    }
+    request.key = key.str();
+
+    std::unique_lock<std::mutex> _l(mContent->lock);
+    request.submit = BatchClock::now();
+    mContent->queue.emplace_back(&request);
+    mContent->queueCondition.notify_all();
+    mContent->doneCondition.wait(_l, [&request]() { return request.done; });
+    return request.code;
+}
+
+BatchStatistics BatchSession::getStatistics() const {
+    std::unique_lock<std::mutex> _l(mContent->lock);
+    return mContent->statistics;
+}
+
+} // namespace MNN
@@ -8,6 +8,13 @@
 
 #include "core/BufferAllocator.hpp"
 #include "core/Macro.h"
+#include <algorithm>
+#include <limits>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 //#define DUMP_USAGE
 //#define MNN_DEBUG_MEMORY
@@ -28,6 +35,56 @@ public:
         MNNMemoryFreeAlign(ptr.first);
     }
 };
+#ifdef __linux__
+// Value of MPOL_PREFERRED in linux/mempolicy.h
+#define MNN_MPOL_PREFERRED 1
+class NumaAllocator : public BufferAllocator::Allocator {
+public:
+    NumaAllocator(int node) {
+        mNode = node;
+        mPageSize = sysconf(_SC_PAGESIZE);
+    }
+    virtual ~ NumaAllocator() {
+        for (auto& iter : mMapped) {
+            munmap(iter.first, iter.second);
+        }
+    }
+    virtual std::pair<void*, int> onAlloc(int size) override {
+        if (mPageSize <= 0 || size < mPageSize) {
+            // Less than a page can't be bound, take it from the heap
+            return std::make_pair(MNNMemoryAllocAlign(size, MNN_MEMORY_ALIGN_DEFAULT), 0);
+        }
+        // Own pages, so that the policy is set before they are first touched and leaves with them on release
+        auto length = ((size_t)size + mPageSize - 1) / mPageSize * mPageSize;
+        auto ptr    = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == ptr) {
+            return std::make_pair(nullptr, 0);
+        }
+        const int bitsPerWord = 8 * sizeof(unsigned long);
+        unsigned long mask[1024 / (8 * sizeof(unsigned long))] = {0};
+        mask[mNode / bitsPerWord] |= (1UL << (mNode % bitsPerWord));
+        // Failure is harmless: pages keep the default policy
+        syscall(SYS_mbind, ptr, length, MNN_MPOL_PREFERRED, mask, (unsigned long)(1024 + 1), 0);
+        mMapped.insert(std::make_pair(ptr, length));
+        return std::make_pair(ptr, 0);
+    }
+    virtual void onRelease(std::pair<void*, int> ptr) override {
+        MNN_ASSERT(ptr.second == 0);
+        auto iter = mMapped.find(ptr.first);
+        if (iter == mMapped.end()) {
+            MNNMemoryFreeAlign(ptr.first);
+            return;
+        }
+        munmap(iter->first, iter->second);
+        mMapped.erase(iter);
+    }
+private:
+    int mNode;
+    long mPageSize;
+    // Address -> length of the mapped chunks
+    std::map<void*, size_t> mMapped;
+};
+#endif
 class RecurseAllocator : public BufferAllocator::Allocator {
 public:
     RecurseAllocator(BufferAllocator* parent) {
@@ -46,6 +103,183 @@ private:
     BufferAllocator* mParent;
 };
 
+// Bytes of an arena, an arena serves blocks of one size class
+#define MNN_SIZE_CLASS_ARENA (256 * 1024)
+// Sizes up to MNN_SIZE_CLASS_EXACT * align have a class each, above that 4 classes per power of two
+#define MNN_SIZE_CLASS_EXACT 16
+#define MNN_SIZE_CLASS_NUMBER 128
+class SizeClassAllocator : public BufferAllocator::Allocator {
+public:
+    SizeClassAllocator(std::shared_ptr<BufferAllocator::Allocator> parent, int align) {
+        mParent = parent;
+        mAlign  = align;
+        mHeaderSize = UP_DIV((int)sizeof(Arena), align) * align;
+        for (int i = 0; i < MNN_SIZE_CLASS_NUMBER; ++i) {
+            mClasses[i].freeHead = nullptr;
+            mClasses[i].current  = nullptr;
+        }
+    }
+    virtual ~ SizeClassAllocator() {
+        onClear(true);
+    }
+    virtual bool onRecycle() const override {
+        return true;
+    }
+    virtual std::pair<void*, int> onAlloc(int size) override {
+        auto index = _classIndex(size);
+        if (index < 0) {
+            return std::make_pair(nullptr, 0);
+        }
+        auto& sizeClass = mClasses[index];
+        if (nullptr != sizeClass.freeHead) {
+            auto block         = sizeClass.freeHead;
+            auto link          = (FreeLink*)block;
+            sizeClass.freeHead = link->next;
+            link->arena->live += 1;
+            return std::make_pair((void*)link->arena, (int)(block - (uint8_t*)link->arena));
+        }
+        return _bump(index);
+    }
+    virtual std::pair<void*, int> onAllocSeperate(int size) override {
+        auto index = _classIndex(size);
+        if (index < 0) {
+            return std::make_pair(nullptr, 0);
+        }
+        return _bump(index);
+    }
+    virtual void onRelease(std::pair<void*, int> ptr) override {
+        auto arena = (Arena*)ptr.first;
+        MNN_ASSERT(arena->live > 0);
+        auto block   = (uint8_t*)ptr.first + ptr.second;
+        auto link    = (FreeLink*)block;
+        auto& sizeClass = mClasses[arena->sizeClass];
+        link->arena  = arena;
+        link->next   = sizeClass.freeHead;
+        sizeClass.freeHead = block;
+        arena->live -= 1;
+    }
+    virtual void onClear(bool allRelease) override {
+        std::vector<Arena*> remain;
+        for (auto arena : mArenas) {
+            if (allRelease || 0 == arena->live) {
+                mTotalSize -= arena->size;
+                auto& sizeClass = mClasses[arena->sizeClass];
+                if (sizeClass.current == arena) {
+                    sizeClass.current = nullptr;
+                }
+                arena->sizeClass = -1;
+                continue;
+            }
+            remain.emplace_back(arena);
+        }
+        if (remain.size() == mArenas.size()) {
+            return;
+        }
+        // Unlink blocks of the released arenas before giving them back
+        for (int i = 0; i < MNN_SIZE_CLASS_NUMBER; ++i) {
+            uint8_t* head = nullptr;
+            auto block    = mClasses[i].freeHead;
+            while (nullptr != block) {
+                auto link = (FreeLink*)block;
+                auto next = link->next;
+                if (link->arena->sizeClass >= 0) {
+                    link->next = head;
+                    head       = block;
+                }
+                block = next;
+            }
+            mClasses[i].freeHead = head;
+        }
+        for (auto arena : mArenas) {
+            if (arena->sizeClass < 0) {
+                mParent->onRelease(arena->parent);
+            }
+        }
+        mArenas = std::move(remain);
+    }
+    virtual size_t onTotalSize() const override {
+        return mTotalSize;
+    }
+
+private:
+    struct Arena {
+        std::pair<void*, int> parent;
+        size_t size;
+        int sizeClass;
+        int blockSize;
+        int used;
+        int live;
+    };
+    // Stored in the free block itself
+    struct FreeLink {
+        Arena* arena;
+        uint8_t* next;
+    };
+    struct SizeClass {
+        uint8_t* freeHead;
+        Arena* current;
+    };
+    int _classIndex(int size) const {
+        if (size <= 0) {
+            return -1;
+        }
+        int unit = UP_DIV(size, mAlign);
+        if (unit <= MNN_SIZE_CLASS_EXACT) {
+            return unit - 1;
+        }
+        int p = 0;
+        while (((unit - 1) >> (p + 1)) > 0) {
+            p++;
+        }
+        int sub = (unit - 1) >> (p - 2);
+        return MNN_SIZE_CLASS_EXACT + (p - 4) * 4 + (sub - 4);
+    }
+    int _classSize(int index) const {
+        if (index < MNN_SIZE_CLASS_EXACT) {
+            return (index + 1) * mAlign;
+        }
+        int p   = (index - MNN_SIZE_CLASS_EXACT) / 4 + 4;
+        int sub = (index - MNN_SIZE_CLASS_EXACT) % 4 + 4;
+        return (int)std::min(((size_t)(sub + 1) << (p - 2)) * mAlign, (size_t)0x7fffffff);
+    }
+    std::pair<void*, int> _bump(int index) {
+        auto& sizeClass = mClasses[index];
+        auto arena      = sizeClass.current;
+        if (nullptr == arena || arena->used + arena->blockSize > arena->size) {
+            int blockSize = _classSize(index);
+            size_t number = std::max((size_t)1, (size_t)MNN_SIZE_CLASS_ARENA / blockSize);
+            size_t size   = mHeaderSize + number * blockSize;
+            if (size > 0x7fffffff) {
+                return std::make_pair(nullptr, 0);
+            }
+            auto parent = mParent->onAlloc((int)size);
+            if (nullptr == parent.first) {
+                return std::make_pair(nullptr, 0);
+            }
+            arena            = (Arena*)((uint8_t*)parent.first + parent.second);
+            arena->parent    = parent;
+            arena->size      = size;
+            arena->sizeClass = index;
+            arena->blockSize = blockSize;
+            arena->used      = mHeaderSize;
+            arena->live      = 0;
+            mArenas.emplace_back(arena);
+            mTotalSize += size;
+            sizeClass.current = arena;
+        }
+        auto offset = arena->used;
+        arena->used += arena->blockSize;
+        arena->live += 1;
+        return std::make_pair((void*)arena, offset);
+    }
+    std::shared_ptr<BufferAllocator::Allocator> mParent;
+    int mAlign;
+    int mHeaderSize;
+    size_t mTotalSize = 0;
+    SizeClass mClasses[MNN_SIZE_CLASS_NUMBER];
+    std::vector<Arena*> mArenas;
+};
+
 std::shared_ptr<BufferAllocator::Allocator> BufferAllocator::Allocator::createDefault() {
     std::shared_ptr<BufferAllocator::Allocator> _res;
     _res.reset(new DefaultAllocator);
@@ -57,6 +291,23 @@ std::shared_ptr<BufferAllocator::Allocator> BufferAllocator::Allocator::createRe
     return _res;
 }
 
+std::shared_ptr<BufferAllocator::Allocator> BufferAllocator::Allocator::createNuma(int node) {
+#ifdef __linux__
+    if (node >= 0 && node < 1024) {
+        std::shared_ptr<BufferAllocator::Allocator> _res;
+        _res.reset(new NumaAllocator(node));
+        return _res;
+    }
+#endif
+    return createDefault();
+}
+
+std::shared_ptr<BufferAllocator::Allocator> BufferAllocator::Allocator::createSizeClass(std::shared_ptr<Allocator> parent, int align) {
+    std::shared_ptr<BufferAllocator::Allocator> _res;
+    _res.reset(new SizeClassAllocator(parent, align));
+    return _res;
+}
+
 BufferAllocator::Node::~Node() {
     if (nullptr == parent.get()) {
         outside->onRelease(pointer);
@@ -67,7 +318,40 @@ std::pair<void*, int> BufferAllocator::alloc(int size, bool seperate) {
     auto memoryUsed = size / 1024.0f / 1024.0f;
     MNN_PRINT("Alloc: %f\n", memoryUsed);
 #endif
+    if (PLAN_REPLAY == mPlanState && mPlanMatch && !mPlanPaused) {
+        if (mPlanTime < mPlanTimeline.size() && mPlanTimeline[mPlanTime] >= 0) {
+            auto index  = mPlanTimeline[mPlanTime];
+            auto& block = mPlanBlocks[index];
+            if (block.size == size && block.seperate == seperate) {
+                mPlanTime++;
+                auto pointer = std::make_pair(mPlanArena.first, mPlanArena.second + (int)block.offset);
+                mPlanLive[pointer] = index;
+                return pointer;
+            }
+        }
+        mPlanMatch = false;
+    }
+    auto pointer = allocFromFreeList(size, seperate);
+    if (PLAN_RECORD == mPlanState && !mPlanPaused && nullptr != pointer.first) {
+        PlanBlock block;
+        block.size     = size;
+        block.seperate = seperate;
+        // Seperate memory can't be shared with any other
+        block.begin  = seperate ? 0 : (int)mPlanTimeline.size();
+        block.end    = std::numeric_limits<int>::max();
+        block.offset = 0;
+        mPlanLive[pointer] = (int)mPlanBlocks.size();
+        mPlanTimeline.emplace_back((int)mPlanBlocks.size());
+        mPlanBlocks.emplace_back(block);
+    }
+    return pointer;
+}
+
+std::pair<void*, int> BufferAllocator::allocFromFreeList(int size, bool seperate) {
     std::pair<void*, int> pointer;
+    if (mAllocator->onRecycle()) {
+        return seperate ? mAllocator->onAllocSeperate(size) : mAllocator->onAlloc(size);
+    }
     // reuse if possible
     if (!seperate) {
         if (nullptr != mCurrentFreeList) {
@@ -135,6 +419,33 @@ void BufferAllocator::returnMemory(FREELIST* listP, SharedPtr<Node> node, bool p
 }
 
 bool BufferAllocator::free(std::pair<void*, int> pointer) {
+    if (PLAN_NONE != mPlanState) {
+        auto iter = mPlanLive.find(pointer);
+        if (iter != mPlanLive.end()) {
+            auto index = iter->second;
+            mPlanLive.erase(iter);
+            if (!mGroups.empty()) {
+                // Same as the free list, reusable by other groups after barrierEnd
+                mPlanGroupFree.emplace_back(index);
+            } else {
+                planFree(index);
+            }
+        }
+    }
+    if (nullptr != mPlanArena.first && pointer.first == mPlanArena.first && pointer.second >= mPlanArena.second &&
+        pointer.second < mPlanArena.second + (int)mPlanSize) {
+        // Memory of arena, given back by release
+        return true;
+    }
+    if (mAllocator->onRecycle()) {
+        if (!mGroups.empty()) {
+            // Memory freed by one group can't be used by another before barrierEnd
+            mGroupFree.emplace_back(pointer);
+        } else {
+            mAllocator->onRelease(pointer);
+        }
+        return true;
+    }
     // get node
     auto x = mUsedList.find(pointer);
     if (x == mUsedList.end()) {
@@ -158,6 +469,15 @@ bool BufferAllocator::free(std::pair<void*, int> pointer) {
 
 void BufferAllocator::release(bool allRelease) {
     MNN_ASSERT(mGroups.empty());
+    if (allRelease && nullptr != mPlanArena.first) {
+        mAllocator->onRelease(mPlanArena);
+        mPlanArena = std::make_pair(nullptr, 0);
+        mTotalSize -= mPlanSize;
+    }
+    if (mAllocator->onRecycle()) {
+        mAllocator->onClear(allRelease);
+        return;
+    }
     if (allRelease) {
         mUsedList.clear();
         mFreeList.clear();
@@ -178,6 +498,14 @@ void BufferAllocator::barrierBegin() {
 }
 
 void BufferAllocator::barrierEnd() {
+    for (auto index : mPlanGroupFree) {
+        planFree(index);
+    }
+    mPlanGroupFree.clear();
+    for (auto& pointer : mGroupFree) {
+        mAllocator->onRelease(pointer);
+    }
+    mGroupFree.clear();
     for (auto& freeGroup : mGroups) {
         auto freeList = *freeGroup;
         for (auto& iter : freeList) {
@@ -197,6 +525,123 @@ void BufferAllocator::endGroup() {
     mCurrentFreeList = nullptr;
 }
 
+void BufferAllocator::planFree(int index) {
+    if (PLAN_RECORD == mPlanState) {
+        mPlanBlocks[index].end = (int)mPlanTimeline.size();
+        mPlanTimeline.emplace_back(-1 - index);
+        return;
+    }
+    // Freeing earlier than the record is safe, but the block can't be freed later than the record, whose memory
+    // may be given to the next allocation. Stop replay at any difference
+    if (mPlanMatch && mPlanTime < mPlanTimeline.size() && mPlanTimeline[mPlanTime] == -1 - index) {
+        mPlanTime++;
+        return;
+    }
+    mPlanMatch = false;
+}
+
+void BufferAllocator::beginRecord() {
+    MNN_ASSERT(mGroups.empty());
+    mPlanBlocks.clear();
+    mPlanTimeline.clear();
+    mPlanLive.clear();
+    mPlanSize  = 0;
+    mPlanState = mAllocator->onRecycle() ? PLAN_NONE : PLAN_RECORD;
+}
+
+size_t BufferAllocator::endRecord() {
+    MNN_ASSERT(mGroups.empty());
+    if (PLAN_RECORD != mPlanState) {
+        return 0;
+    }
+    mPlanState = PLAN_NONE;
+    mPlanLive.clear();
+    auto alignSize = [this](int size) {
+        return (size_t)UP_DIV(std::max(size, 1), mAlign) * mAlign;
+    };
+    // Greedy by size: place larger blocks first, each at the lowest best fit gap among placed blocks living at
+    // the same time
+    std::vector<int> order(mPlanBlocks.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return mPlanBlocks[a].size > mPlanBlocks[b].size;
+    });
+    std::vector<std::pair<size_t, size_t>> used;
+    size_t total = 0;
+    for (int i = 0; i < order.size(); ++i) {
+        auto& block = mPlanBlocks[order[i]];
+        auto size   = alignSize(block.size);
+        used.clear();
+        for (int j = 0; j < i; ++j) {
+            auto& placed = mPlanBlocks[order[j]];
+            if (placed.begin < block.end && block.begin < placed.end) {
+                used.emplace_back(placed.offset, placed.offset + alignSize(placed.size));
+            }
+        }
+        std::sort(used.begin(), used.end());
+        size_t bestOffset = 0;
+        size_t bestGap    = std::numeric_limits<size_t>::max();
+        size_t current    = 0;
+        for (auto& u : used) {
+            if (u.first > current) {
+                auto gap = u.first - current;
+                if (gap >= size && gap < bestGap) {
+                    bestGap    = gap;
+                    bestOffset = current;
+                }
+            }
+            current = std::max(current, u.second);
+        }
+        if (bestGap == std::numeric_limits<size_t>::max()) {
+            bestOffset = current;
+        }
+        block.offset = bestOffset;
+        total        = std::max(total, bestOffset + size);
+    }
+    if (total > (size_t)std::numeric_limits<int>::max()) {
+        total = 0;
+    }
+    mPlanSize = total;
+    return total;
+}
+
+bool BufferAllocator::beginReplay() {
+    MNN_ASSERT(mGroups.empty());
+    if (0 == mPlanSize || nullptr != mPlanArena.first) {
+        return false;
+    }
+    mPlanArena = mAllocator->onAlloc((int)mPlanSize);
+    if (nullptr == mPlanArena.first) {
+        return false;
+    }
+    mTotalSize += mPlanSize;
+    mPlanTime  = 0;
+    mPlanMatch = true;
+    mPlanState = PLAN_REPLAY;
+    return true;
+}
+
+bool BufferAllocator::endReplay() {
+    MNN_ASSERT(mGroups.empty());
+    if (PLAN_REPLAY != mPlanState) {
+        return false;
+    }
+    mPlanState = PLAN_NONE;
+    mPlanLive.clear();
+    mPlanGroupFree.clear();
+    return mPlanMatch && mPlanTime == mPlanTimeline.size();
+}
+
+void BufferAllocator::pausePlan() {
+    mPlanPaused = true;
+}
+
+void BufferAllocator::resumePlan() {
+    mPlanPaused = false;
+}
+
 std::pair<void*, int> BufferAllocator::getFromFreeList(FREELIST* list, int size, bool permiteSplit) {
 #ifdef MNN_DEBUG_MEMORY
     return std::make_pair(nullptr, 0);
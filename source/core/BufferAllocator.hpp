@@ -27,8 +27,35 @@ public:
         virtual ~ Allocator() = default;
         virtual std::pair<void*, int> onAlloc(int size) = 0;
         virtual void onRelease(std::pair<void*, int> ptr) = 0;
+
+        // Allocators that reuse released memory by themselves return true, BufferAllocator then forwards to them
+        // instead of keeping its own free list. The hooks below are only called for them
+        virtual bool onRecycle() const {
+            return false;
+        }
+        // Memory that must not come from released memory
+        virtual std::pair<void*, int> onAllocSeperate(int size) {
+            return onAlloc(size);
+        }
+        // Give cached memory back to parent: all of it if allRelease, otherwise the part not in use
+        virtual void onClear(bool allRelease) {
+            // Do nothing
+        }
+        virtual size_t onTotalSize() const {
+            return 0;
+        }
+
         static std::shared_ptr<Allocator> createDefault();
         static std::shared_ptr<Allocator> createRecurse(BufferAllocator* parent);
+        // Prefer pages on the given NUMA node, same as createDefault where NUMA policy is not supported
+        static std::shared_ptr<Allocator> createNuma(int node);
+        /**
+         * Size-class allocator over arenas from parent: O(1) alloc / free by intrusive free lists, no split or
+         * merge. Faster than the default free list when resizing often, but may keep more memory.
+         * The memory from parent must be host memory, the allocator can't be shared by several BufferAllocator.
+         */
+        static std::shared_ptr<Allocator> createSizeClass(std::shared_ptr<Allocator> parent,
+                                                          int align = MNN_MEMORY_ALIGN_DEFAULT);
     };
     /**
      * @brief init buffer allocator with pointer alignment.
@@ -76,9 +103,33 @@ public:
      * @return total size allocated indeed.
      */
     size_t totalSize() const {
+        if (mAllocator->onRecycle()) {
+            return mAllocator->onTotalSize();
+        }
         return mTotalSize;
     }
 
+    /*
+     Static memory plan by lifetime.
+     beginRecord / endRecord wrap one pass of alloc / free. endRecord gives every recorded allocation an offset
+     in one arena so that allocations living at the same time don't overlap (greedy by size, best fit),
+     and returns the arena size, 0 if nothing to plan.
+     beginReplay / endReplay wrap the next pass, which must alloc / free in the same order: the allocations are
+     served from the arena, from the first difference on by the free list. endReplay returns false if the pass
+     differed from the record.
+     Not supported if the allocator recycles by itself.
+     */
+    void beginRecord();
+    size_t endRecord();
+    bool beginReplay();
+    bool endReplay();
+    /*
+     Allocations between pausePlan / resumePlan are neither recorded nor served from the arena, for memory freed
+     within the pass that the next pass doesn't allocate again, such as the scratch memory of measuring.
+     */
+    void pausePlan();
+    void resumePlan();
+
     /*
      For multi thread case,
      we must assume that the memory use by different thread don't conflict
@@ -107,6 +158,8 @@ private:
 
     static void returnMemory(FREELIST* list, SharedPtr<Node> node, bool permitMerge = true);
     std::pair<void*, int> getFromFreeList(FREELIST* list, int size, bool permiteSplit = true);
+    std::pair<void*, int> allocFromFreeList(int size, bool seperate);
+    void planFree(int index);
 
     std::map<std::pair<void*, int>, SharedPtr<Node>> mUsedList;
     FREELIST mFreeList;
@@ -114,8 +167,31 @@ private:
 
     FREELIST* mCurrentFreeList = nullptr;
     std::vector<std::shared_ptr<FREELIST>> mGroups;
+    // Memory freed in groups while mAllocator recycles by itself, given back at barrierEnd
+    std::vector<std::pair<void*, int>> mGroupFree;
     std::shared_ptr<Allocator> mAllocator;
     int mAlign;
+
+    enum PlanState { PLAN_NONE, PLAN_RECORD, PLAN_REPLAY };
+    struct PlanBlock {
+        int size;
+        bool seperate;
+        // Lifetime [begin, end) in the order of alloc / free
+        int begin;
+        int end;
+        size_t offset;
+    };
+    PlanState mPlanState = PLAN_NONE;
+    std::vector<PlanBlock> mPlanBlocks;
+    // Index of block for alloc, -1 - index for free
+    std::vector<int> mPlanTimeline;
+    std::map<std::pair<void*, int>, int> mPlanLive;
+    std::vector<int> mPlanGroupFree;
+    size_t mPlanTime = 0;
+    size_t mPlanSize = 0;
+    bool mPlanMatch  = true;
+    bool mPlanPaused = false;
+    std::pair<void*, int> mPlanArena;
 };
 } // namespace MNN
 #endif
@@ -22,11 +22,11 @@
         std::pair<std::function<void(int)>, int> task; \
         task.second = __num__;                         \
         task.first  = [&](int __iter__) {
-#define MNN_CONCURRENCY_END()                                      \
-    }                                                              \
-    ;                                                              \
-    auto cpuBn = (CPUBackend*)backend();                           \
-    MNN::ThreadPool::enqueue(std::move(task), cpuBn->taskIndex()); \
+#define MNN_CONCURRENCY_END()                                                                                  \
+    }                                                                                                          \
+    ;                                                                                                          \
+    auto cpuBn = (CPUBackend*)backend();                                                                       \
+    MNN::ThreadPool::enqueue(std::move(task), cpuBn->taskIndex(), cpuBn->scheduleMode(), cpuBn->threadPool()); \
     }
 
 #else
@@ -63,6 +63,13 @@ public:
     virtual bool onClone(Backend* bn, const Op* op, Execution** dst) {
         return false;
     }
+
+    /**
+     * @brief drop the state kept across executions, such as the key / value cache of attention
+     */
+    virtual void onReset() {
+        // Do nothing
+    }
 public:
     /**
      * @brief designed for plugin system. not ready yet.
@@ -9,6 +9,8 @@
 #include "core/FileLoader.hpp"
 #if defined(_MSC_VER)
 #include "Windows.h"
+#else
+#include <sys/mman.h>
 #endif
 namespace MNN {
 FileLoader::FileLoader(const char* file) {
@@ -32,6 +34,11 @@ FileLoader::FileLoader(const char* file) {
 }
 
 FileLoader::~FileLoader() {
+#if !defined(_MSC_VER)
+    if (nullptr != mMapBuffer) {
+        ::munmap(mMapBuffer, mTotalSize);
+    }
+#endif
     if (nullptr != mFile) {
         fclose(mFile);
     }
@@ -72,6 +79,43 @@ bool FileLoader::read() {
     return true;
 }
 
+bool FileLoader::map() {
+#if defined(_MSC_VER)
+    return false;
+#else
+    if (nullptr == mFile || nullptr != mMapBuffer) {
+        return nullptr != mMapBuffer;
+    }
+    if (0 != fseek(mFile, 0, SEEK_END)) {
+        return false;
+    }
+    auto size = ftell(mFile);
+    rewind(mFile);
+    if (size <= 0) {
+        return false;
+    }
+    // Private, so that makeMapWritable can enable copy on write
+    auto ptr = ::mmap(nullptr, (size_t)size, PROT_READ, MAP_PRIVATE, fileno(mFile), 0);
+    if (MAP_FAILED == ptr) {
+        return false;
+    }
+    mMapBuffer = (uint8_t*)ptr;
+    mTotalSize = (size_t)size;
+    return true;
+#endif
+}
+
+bool FileLoader::makeMapWritable() {
+#if defined(_MSC_VER)
+    return false;
+#else
+    if (nullptr == mMapBuffer) {
+        return false;
+    }
+    return 0 == ::mprotect(mMapBuffer, mTotalSize, PROT_READ | PROT_WRITE);
+#endif
+}
+
 bool FileLoader::merge(AutoStorage<uint8_t>& buffer) {
     buffer.reset((int)mTotalSize);
     if (buffer.get() == nullptr) {
@@ -26,10 +26,27 @@ public:
 
     bool merge(AutoStorage<uint8_t>& buffer);
 
+    /**
+     * @brief map the whole file read-only instead of read + merge. The pages stay shared with the page cache (and
+     * other processes mapping the same file). Accessing the mapping after the file is truncated raises SIGBUS.
+     * @return false if mapping is not supported or failed, read() can be used then.
+     */
+    bool map();
+
+    /**
+     * @brief allow writing the mapping, written pages are copied on write and never reach the file.
+     */
+    bool makeMapWritable();
+
+    uint8_t* mapBuffer() const {
+        return mMapBuffer;
+    }
+
 private:
     std::vector<std::pair<size_t, void*>> mBlocks;
     FILE* mFile                 = nullptr;
     static const int gCacheSize = 4096;
     size_t mTotalSize           = 0;
+    uint8_t* mMapBuffer         = nullptr;
 };
 } // namespace MNN
@@ -15,23 +15,46 @@
 #include "MNN_generated.h"
 #include "core/AutoStorage.h"
 #include "core/FileLoader.hpp"
+#include "core/ModelRegistry.hpp"
 #include "core/Pipeline.hpp"
 #include "core/RuntimeFactory.hpp"
 #include "core/Session.hpp"
+#include "core/TensorUtils.hpp"
+#include "core/TraceRecorder.hpp"
 
 namespace MNN {
 
 struct Content {
     AutoStorage<uint8_t> buffer;
+    // Set by createFromMappedFile, used instead of buffer
+    std::unique_ptr<FileLoader> mapFile;
+    uint8_t* modelBuffer() const {
+        if (nullptr != mapFile) {
+            return mapFile->mapBuffer();
+        }
+        return buffer.get();
+    }
+    size_t modelSize() const {
+        if (nullptr != mapFile) {
+            return mapFile->size();
+        }
+        return buffer.size();
+    }
     const Net* net = nullptr;
     std::vector<std::unique_ptr<Session>> sessions;
     std::map<const Tensor*, const Session*> tensorMap;
     Interpreter::SessionMode callBackMode = Interpreter::Session_Debug;
     Interpreter::SessionMode inputMode    = Interpreter::Session_Input_Inside;
+    Interpreter::SessionMode traceMode    = Interpreter::Session_Trace_Off;
     AutoStorage<uint8_t> cacheBuffer;
     size_t cacheOffset = 0;
     std::string cacheFile;
     std::mutex lock;
+    // Id in ModelRegistry while the buffer is kept unchanged, -1 if not registered
+    int64_t modelId = -1;
+    ~Content() {
+        ModelRegistry::remove(modelId);
+    }
 };
 
 Interpreter* Interpreter::createFromFile(const char* file) {
@@ -61,6 +84,25 @@ Interpreter* Interpreter::createFromFile(const char* file) {
     loader.reset();
     return createFromBufferInternal(net);
 }
+Interpreter* Interpreter::createFromMappedFile(const char* file) {
+    if (nullptr == file) {
+        MNN_PRINT("NULL file for create interpreter\n");
+        return nullptr;
+    }
+    std::unique_ptr<FileLoader> loader(new FileLoader(file));
+    if (!loader->valid()) {
+        MNN_PRINT("Create interpreter failed, open %s error\n", file);
+        return nullptr;
+    }
+    if (!loader->map()) {
+        loader.reset();
+        return createFromFile(file);
+    }
+    auto net     = new Content;
+    net->mapFile = std::move(loader);
+    return createFromBufferInternal(net);
+}
+
 Interpreter* Interpreter::createFromBuffer(const void* buffer, size_t size) {
     if (nullptr == buffer || 0 == size) {
         MNN_PRINT("Buffer is null for create interpreter\n");
@@ -83,19 +125,25 @@ Interpreter* Interpreter::createFromBufferInternal(Content* net) {
         return nullptr;
     }
 #ifndef MNN_BUILD_MINI
-    flatbuffers::Verifier verify((const uint8_t*)(net->buffer.get()), net->buffer.size());
+    flatbuffers::Verifier verify((const uint8_t*)(net->modelBuffer()), net->modelSize());
     if (false == VerifyNetBuffer(verify)) {
         MNN_PRINT("Invalidate buffer to create interpreter\n");
         delete net;
         return nullptr;
     }
 #endif
-    net->net = GetNet(net->buffer.get());
+    net->net = GetNet(net->modelBuffer());
     if (nullptr == net->net->oplists()) {
         MNN_ERROR("Model has no oplist\n");
         delete net;
         return nullptr;
     }
+    // Trainable params of a mapped model are used in place and updated by training
+    if (nullptr != net->mapFile && net->net->usage() == Usage_TRAIN && !net->mapFile->makeMapWritable()) {
+        MNN_ERROR("Can't write the mapped model for training\n");
+        delete net;
+        return nullptr;
+    }
     int opSize = net->net->oplists()->size();
     for (int i = 0; i < opSize; ++i) {
         auto op = net->net->oplists()->GetAs<Op>(i);
@@ -105,24 +153,33 @@ Interpreter* Interpreter::createFromBufferInternal(Content* net) {
             return nullptr;
         }
     }
+    if (net->net->usage() != Usage_TRAIN) {
+        net->modelId = ModelRegistry::add(net->modelBuffer(), net->modelSize());
+    }
     return new Interpreter(net);
 }
 
 void Interpreter::setSessionMode(SessionMode mode) {
     if (mode == Session_Input_Inside || mode == Session_Input_User) {
         mNet->inputMode = mode;
+    } else if (mode == Session_Trace_Off || mode == Session_Trace_On) {
+        mNet->traceMode = mode;
     } else {
         mNet->callBackMode = mode;
     }
 }
 
+bool Interpreter::dumpTrace(const char* file) {
+    return TraceRecorder::dump(file);
+}
+
 void Interpreter::setCacheFile(const char* cacheFile, size_t keySize) {
-    if (nullptr == cacheFile || nullptr == mNet->buffer.get()) {
+    if (nullptr == cacheFile || nullptr == mNet->modelBuffer()) {
         MNN_ERROR("Empty cacheFile or the interpreter invalid\n");
         return;
     }
     mNet->cacheFile   = std::string(cacheFile);
-    mNet->cacheOffset = mNet->buffer.size() > keySize ? keySize : mNet->buffer.size();
+    mNet->cacheOffset = mNet->modelSize() > keySize ? keySize : mNet->modelSize();
     std::unique_ptr<FileLoader> loader(new FileLoader(cacheFile));
     if (!loader->valid()) {
         MNN_ERROR("Load Cache file error.\n");
@@ -142,7 +199,7 @@ void Interpreter::setCacheFile(const char* cacheFile, size_t keySize) {
         MNN_ERROR("Alloc memory for Cache error.\n");
         return;
     }
-    if (0 != ::memcmp(mNet->cacheBuffer.get(), mNet->buffer.get(), mNet->cacheOffset)) {
+    if (0 != ::memcmp(mNet->cacheBuffer.get(), mNet->modelBuffer(), mNet->cacheOffset)) {
         MNN_ERROR("Cache model file key does not match.\n");
         mNet->cacheBuffer.release();
         return;
@@ -174,7 +231,7 @@ Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>&
 }
 
 Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>& configs, const RuntimeInfo& runtime) {
-    if (nullptr == mNet->buffer.get()) {
+    if (nullptr == mNet->modelBuffer()) {
         MNN_ERROR("The model buffer has been released. Can't create session\n");
         return nullptr;
     }
@@ -187,11 +244,14 @@ Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>&
     auto validForResize = info.validForResize;
     RuntimeInfo rt = runtime;
     auto newSession =
-        std::unique_ptr<Session>(new Session(std::move(info), mNet->callBackMode, mNet->inputMode, std::move(rt)));
+        std::unique_ptr<Session>(new Session(std::move(info), mNet->callBackMode, mNet->inputMode, std::move(rt),
+                                             nullptr != mNet->mapFile));
     if (!newSession->valid()) {
         MNN_PRINT("Invalide Session!!\n");
         return nullptr;
     }
+    newSession->setTrace(mNet->traceMode == Session_Trace_On);
+    newSession->setConfigs(configs);
     auto result = newSession.get();
     bool valid  = false;
     if (mNet->cacheBuffer.get() != nullptr) {
@@ -213,7 +273,7 @@ Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>&
                     break;
                 }
                 // Write key
-                auto tsize = fwrite((const char*)mNet->buffer.get(), 1, mNet->cacheOffset, f);
+                auto tsize = fwrite((const char*)mNet->modelBuffer(), 1, mNet->cacheOffset, f);
                 if (tsize != mNet->cacheOffset) {
                     MNN_ERROR("Write %s error\n", mNet->cacheFile.c_str());
                     break;
@@ -244,6 +304,58 @@ Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>&
     return result;
 }
 
+Session* Interpreter::cloneSession(const Session* session) {
+    if (nullptr == session) {
+        return nullptr;
+    }
+    if (nullptr == mNet->modelBuffer()) {
+        MNN_ERROR("The model buffer has been released. Can't clone session\n");
+        return nullptr;
+    }
+    auto& configs = session->getConfigs();
+    if (configs.empty()) {
+        MNN_ERROR("The session isn't created by interpreter, can't clone it\n");
+        return nullptr;
+    }
+    // Use new runtimes, the allocators and the thread pool task of a runtime can't be used concurrently
+    RuntimeInfo runtime = createRuntime(configs);
+    if (runtime.first.empty()) {
+        MNN_ERROR("Runtime not valid for clone session\n");
+        return nullptr;
+    }
+    std::unique_lock<std::mutex> _l(mNet->lock);
+    auto info = Schedule::schedule(mNet->net, configs);
+    auto newSession =
+        std::unique_ptr<Session>(new Session(std::move(info), mNet->callBackMode, mNet->inputMode, std::move(runtime),
+                                             nullptr != mNet->mapFile));
+    if (!newSession->valid()) {
+        MNN_PRINT("Invalide Session!!\n");
+        return nullptr;
+    }
+    newSession->setTrace(mNet->traceMode == Session_Trace_On);
+    newSession->setConfigs(configs);
+    newSession->shareExecution(session);
+    auto result = newSession.get();
+    bool shapeValid = true;
+    for (auto& iter : session->getInputAll()) {
+        auto dst = result->getInput(iter.first.c_str());
+        if (nullptr == dst) {
+            continue;
+        }
+        TensorUtils::copyShape(iter.second, dst, true);
+        shapeValid = shapeValid && iter.second->elementSize() > 0;
+    }
+    if (mNet->cacheBuffer.get() != nullptr) {
+        result->loadCache(mNet->cacheBuffer.get() + mNet->cacheOffset, mNet->cacheBuffer.size() - mNet->cacheOffset);
+    }
+    if (shapeValid && mNet->inputMode == Session_Input_Inside) {
+        result->resize(mNet->net->usage() == Usage_INFERENCE_STATIC);
+    }
+    result->loadCache(nullptr, 0);
+    mNet->sessions.emplace_back(std::move(newSession));
+    return result;
+}
+
 Session* Interpreter::createSession(const ScheduleConfig& config) {
     return createMultiPathSession({config});
 }
@@ -316,13 +428,18 @@ const std::map<std::string, Tensor*>& Interpreter::getSessionOutputAll(const Ses
 
 void Interpreter::resizeSession(Session* session) {
     std::unique_lock<std::mutex> _l(mNet->lock);
-    if (mNet->buffer.get() == nullptr) {
+    if (mNet->modelBuffer() == nullptr) {
         MNN_ERROR("The model buffer has been released. Can't resize session\n");
         return;
     }
     session->resize();
 }
 
+void Interpreter::setSessionShapeCache(Session* session, float memoryLimit) {
+    std::unique_lock<std::mutex> _l(mNet->lock);
+    session->setShapeCache(memoryLimit);
+}
+
 ErrorCode Interpreter::runSessionWithCallBack(const Session* session, const TensorCallBack& before,
                                               const TensorCallBack& after, bool sync) const {
     auto beforeWrap = [&before](const std::vector<Tensor*>& tensors, const OperatorInfo* info) {
@@ -346,8 +463,11 @@ const Backend* Interpreter::getBackend(const Session* session, const Tensor* ten
 void Interpreter::releaseModel() {
     std::unique_lock<std::mutex> _l(mNet->lock);
     if (mNet->buffer.get() != nullptr && mNet->net->usage() != Usage_INFERENCE_STATIC) {
+        ModelRegistry::remove(mNet->modelId);
+        mNet->modelId = -1;
         mNet->buffer.release();
     }
+    // A mapped model is kept: sessions use its constants directly and its clean pages belong to the page cache
     mNet->cacheBuffer.release();
 }
 
@@ -394,15 +514,25 @@ const char* Interpreter::bizCode() const {
 }
 
 std::pair<const void*, size_t> Interpreter::getModelBuffer() const {
-    return std::make_pair(mNet->buffer.get(), mNet->buffer.size());
+    return std::make_pair(mNet->modelBuffer(), mNet->modelSize());
 }
 ErrorCode Interpreter::updateSessionToModel(Session* session) {
     std::unique_lock<std::mutex> _l(mNet->lock);
-    if (mNet->buffer.get() == nullptr) {
+    if (mNet->modelBuffer() == nullptr) {
         MNN_ERROR("Can't updateSessionToModel because you called releaseModel before\n");
         return INPUT_DATA_ERROR;
     }
-    return session->updateToModel((Net*)mNet->net);
+    if (nullptr != mNet->mapFile && !mNet->mapFile->makeMapWritable()) {
+        MNN_ERROR("Can't updateSessionToModel because the mapped model can't be written\n");
+        return INPUT_DATA_ERROR;
+    }
+    auto code = session->updateToModel((Net*)mNet->net);
+    if (mNet->modelId >= 0) {
+        // Resources made from the former weights can't be shared with new sessions
+        ModelRegistry::remove(mNet->modelId);
+        mNet->modelId = ModelRegistry::add(mNet->modelBuffer(), mNet->modelSize());
+    }
+    return code;
 }
 
 bool Interpreter::getSessionInfo(const Session* session, SessionInfoCode code, void* ptr) {
@@ -413,9 +543,9 @@ bool Interpreter::getSessionInfo(const Session* session, SessionInfoCode code, v
     return session->getInfo(code, ptr);
 }
 
-static void _getDefaultBackend(RuntimeInfo& rt) {
+static void _getDefaultBackend(RuntimeInfo& rt, bool reuseCPU) {
     auto defaultType = MNN_FORWARD_CPU;
-    if (rt.first.find(defaultType) != rt.first.end()) {
+    if (reuseCPU && rt.first.find(defaultType) != rt.first.end()) {
         rt.second = rt.first[defaultType];
     }
     if (rt.second == nullptr) {
@@ -428,11 +558,14 @@ static void _getDefaultBackend(RuntimeInfo& rt) {
 RuntimeInfo Interpreter::createRuntime(const std::vector<ScheduleConfig>& configs) {
     RuntimeInfo res;
     auto& mRuntimes = res.first;
+    // The backup backend must keep the default layout, so a wide packed CPU runtime can't be the default one
+    bool reuseCPU   = true;
     for (auto& config : configs) {
         Backend::Info compute;
         compute.type      = Schedule::getApprociateType(config);
         compute.numThread = config.numThread;
         compute.user      = config.backendConfig;
+        compute.cpuIds    = config.cpuIds;
         if (mRuntimes.find(compute.type) == mRuntimes.end()) {
             auto newBn = RuntimeFactory::create(compute);
             if (nullptr == newBn) {
@@ -440,9 +573,12 @@ RuntimeInfo Interpreter::createRuntime(const std::vector<ScheduleConfig>& config
                 continue;
             }
             mRuntimes[compute.type].reset(newBn);
+            if (MNN_FORWARD_CPU == compute.type && nullptr != compute.user && (compute.user->flags & MNN_CPU_WIDE_PACK)) {
+                reuseCPU = false;
+            }
         }
     }
-    _getDefaultBackend(res);
+    _getDefaultBackend(res, reuseCPU);
     return res;
 }
 
@@ -0,0 +1,75 @@
+//
+//  ModelRegistry.cpp
+//  MNN
+//
+//  Created by MNN on 2021/05/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "core/ModelRegistry.hpp"
+#include <map>
+#include <mutex>
+
+namespace MNN {
+struct ModelRange {
+    size_t size;
+    int64_t id;
+};
+struct ModelRegistryContent {
+    std::mutex lock;
+    // Start address -> range, registered buffers don't overlap
+    std::map<uintptr_t, ModelRange> models;
+    int64_t nextId = 0;
+};
+
+static ModelRegistryContent* _registry() {
+    // Never freed, models may be released while static objects are destroyed
+    static ModelRegistryContent* registry = new ModelRegistryContent;
+    return registry;
+}
+
+int64_t ModelRegistry::add(const void* buffer, size_t size) {
+    auto registry = _registry();
+    std::unique_lock<std::mutex> _l(registry->lock);
+    ModelRange range;
+    range.size = size;
+    range.id   = registry->nextId++;
+    registry->models[(uintptr_t)buffer] = range;
+    return range.id;
+}
+
+void ModelRegistry::remove(int64_t id) {
+    if (id < 0) {
+        return;
+    }
+    auto registry = _registry();
+    std::unique_lock<std::mutex> _l(registry->lock);
+    for (auto iter = registry->models.begin(); iter != registry->models.end(); ++iter) {
+        if (iter->second.id == id) {
+            registry->models.erase(iter);
+            return;
+        }
+    }
+}
+
+bool ModelRegistry::find(const void* ptr, size_t size, int64_t& id, size_t& offset) {
+    if (nullptr == ptr) {
+        return false;
+    }
+    auto registry = _registry();
+    auto address  = (uintptr_t)ptr;
+    std::unique_lock<std::mutex> _l(registry->lock);
+    auto iter = registry->models.upper_bound(address);
+    if (iter == registry->models.begin()) {
+        return false;
+    }
+    iter--;
+    if (address + size > iter->first + iter->second.size) {
+        return false;
+    }
+    id     = iter->second.id;
+    offset = address - iter->first;
+    return true;
+}
+
+} // namespace MNN
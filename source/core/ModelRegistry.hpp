@@ -0,0 +1,38 @@
+//
+//  ModelRegistry.hpp
+//  MNN
+//
+//  Created by MNN on 2021/05/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef ModelRegistry_hpp
+#define ModelRegistry_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <MNN/MNNDefine.h>
+
+namespace MNN {
+
+/**
+ * Model buffers alive in the process. Resources made from the data of a model, such as packed weights, are keyed by
+ * the id of the model and the offset of the data in it instead of by the data. Ids are never reused, so a key can't
+ * match a later model placed at the same address.
+ */
+class MNN_PUBLIC ModelRegistry {
+public:
+    /** register a buffer whose content won't change until it's removed, return its id */
+    static int64_t add(const void* buffer, size_t size);
+    /** remove the buffer before it's freed or changed, do nothing for a negative id */
+    static void remove(int64_t id);
+    /**
+     * @brief find the model holding [ptr, ptr + size).
+     * @return false if the data isn't in a registered buffer, such as a temporary copy.
+     */
+    static bool find(const void* ptr, size_t size, int64_t& id, size_t& offset);
+};
+
+} // namespace MNN
+
+#endif /* ModelRegistry_hpp */
@@ -149,7 +149,7 @@ bool OpCommonUtils::canBlitFast(const Tensor::InsideDescribe::Region& region, co
         dstChannel = dest->length(1);
     }
     return canBlitFast(region, std::make_tuple(srcArea, inputChannel, inputBatch),
-                       std::make_tuple(dstArea, dstChannel, dstBatch));
+                       std::make_tuple(dstArea, dstChannel, dstBatch), pack);
 }
 
 void OpCommonUtils::turnToPackRegion(const Tensor::InsideDescribe::Region& region,
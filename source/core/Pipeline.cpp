@@ -11,6 +11,7 @@
 #include "core/Backend.hpp"
 #include "core/Macro.h"
 #include "core/TensorUtils.hpp"
+#include "core/TraceRecorder.hpp"
 #include "core/WrapExecution.hpp"
 #include "geometry/GeometryComputerUtils.hpp"
 #include "shape/SizeComputer.hpp"
@@ -105,9 +106,9 @@ void Pipeline::UnitInfo::setUp(const Command& command, int index) {
 }
 
 Pipeline::Pipeline(std::vector<Schedule::PipelineInfo>&& infos, std::shared_ptr<Backend> backend,
-                   std::shared_ptr<Backend> cpuBackend, bool allocInput, bool geometry)
+                   std::shared_ptr<Backend> cpuBackend, bool allocInput, bool netHold, bool geometry)
 #ifndef MNN_BUILD_MINI
-    : mContext(cpuBackend, true), mUseGeometry(geometry) {
+    : mContext(new GeometryComputer::Context(cpuBackend, true, backend->type())), mUseGeometry(geometry) {
 #else
 {
 #endif
@@ -118,7 +119,8 @@ Pipeline::Pipeline(std::vector<Schedule::PipelineInfo>&& infos, std::shared_ptr<
     mAllocInput    = allocInput;
     mInfo          = std::move(infos);
 #ifndef MNN_BUILD_MINI
-    GeometryComputerUtils::buildConstantTensors(mInfo, mBackupBackend, !mAllocInput, mConstTensors, mMidConstTensors);
+    // The net buffer is kept alive by user or by a mapped model file, const tensors can use it directly
+    GeometryComputerUtils::buildConstantTensors(mInfo, mBackupBackend, !mAllocInput || netHold, mConstTensors, mMidConstTensors);
 #endif
 }
 void Pipeline::cloneExecution(const std::map<const Op*, std::shared_ptr<Execution>>& cache) {
@@ -134,6 +136,62 @@ void Pipeline::cloneExecution(const std::map<const Op*, std::shared_ptr<Executio
     }
 }
 
+Pipeline::State::State(std::shared_ptr<Backend> major, std::shared_ptr<Backend> backup) {
+    backend       = major;
+    backupBackend = backup;
+#ifndef MNN_BUILD_MINI
+    context.reset(new GeometryComputer::Context(backup, true, major->type()));
+#endif
+}
+
+Pipeline::State::~State() {
+    executions.clear();
+    originExecution.clear();
+    for (auto& t : midConstTensors) {
+        backupBackend->onReleaseBuffer(t.get(), Backend::STATIC);
+    }
+}
+
+void Pipeline::swapState(State& state) {
+    std::vector<std::shared_ptr<Tensor>> midConstTensors;
+    if (mInit) {
+        // The headers are still the current ones, keep them to release the memory with the state
+        for (auto t : mMidConstTensors) {
+            if (t->elementSize() > 0) {
+                std::shared_ptr<Tensor> header(new Tensor);
+                TensorUtils::copyHeader(t, header.get());
+                midConstTensors.emplace_back(header);
+            }
+        }
+    }
+    std::swap(mInit, state.init);
+    std::swap(mBackend, state.backend);
+    std::swap(mBackupBackend, state.backupBackend);
+#ifndef MNN_BUILD_MINI
+    std::swap(mContext, state.context);
+#endif
+    std::swap(mOriginExecution, state.originExecution);
+    std::swap(mExecutions, state.executions);
+    std::swap(mDebugInfos, state.debugInfos);
+    std::swap(mBuffer.command, state.buffer.command);
+    std::swap(mBuffer.extras, state.buffer.extras);
+    // The memory of coming mid const tensors is released by pipeline again
+    state.midConstTensors = std::move(midConstTensors);
+}
+
+float Pipeline::getStateMemory() const {
+    float summer = mBackend->onGetMemoryInMB();
+    if (mBackupBackend != mBackend) {
+        summer += mBackupBackend->onGetMemoryInMB();
+    }
+    if (mInit) {
+        for (auto t : mMidConstTensors) {
+            summer += t->size() / 1024.0f / 1024.0f;
+        }
+    }
+    return summer;
+}
+
 ErrorCode Pipeline::encode(bool isStatic, bool supportDebug) {
     // Static Model just copy info to command buffer
     if (isStatic) {
@@ -148,7 +206,7 @@ ErrorCode Pipeline::encode(bool isStatic, bool supportDebug) {
         }
     } else {
 #ifndef MNN_BUILD_MINI
-        mContext.clear();
+        mContext->clear();
         mBuffer.command.clear();
         mBuffer.extras.clear();
         /** Size Compute and compute Const Begin */
@@ -156,6 +214,12 @@ ErrorCode Pipeline::encode(bool isStatic, bool supportDebug) {
             TensorUtils::getDescribe(t)->backend = mBackupBackend.get();
             TensorUtils::getDescribe(t)->usage   = Tensor::InsideDescribe::CONSTANT;
         }
+        for (auto& info : mInfo) {
+            // Const tensors using the net buffer directly, so that they are not allocated as inputs
+            if (info.op->type() == OpType_Const && nullptr != info.outputs[0]->host<void>()) {
+                TensorUtils::getDescribe(info.outputs[0])->backend = mBackupBackend.get();
+            }
+        }
         if (mInit) {
             for (auto t : mMidConstTensors) {
                 if (t->elementSize() > 0) {
@@ -165,7 +229,7 @@ ErrorCode Pipeline::encode(bool isStatic, bool supportDebug) {
             }
         }
         mInit = true;
-        auto res = GeometryComputerUtils::shapeComputeAndGeometryTransform(mInfo, mBuffer, mContext, mBackupBackend, mUseGeometry);
+        auto res = GeometryComputerUtils::shapeComputeAndGeometryTransform(mInfo, mBuffer, *mContext, mBackupBackend, mUseGeometry);
         if (res != NO_ERROR) {
             return res;
         }
@@ -285,6 +349,40 @@ ErrorCode Pipeline::encode(bool isStatic, bool supportDebug) {
 }
 
 ErrorCode Pipeline::allocMemory() {
+    // Inputs not allocated yet are allocated by the pass, their memory is released by the next pass
+    std::vector<Tensor*> unallocated;
+    for (auto& c : mBuffer.command) {
+        for (auto t : c.inputs) {
+            auto des = TensorUtils::getDescribe(t);
+            if (des->memoryType == Tensor::InsideDescribe::MEMORY_VIRTUAL) {
+                for (auto& r : des->regions) {
+                    if (nullptr == TensorUtils::getDescribe(r.origin)->backend) {
+                        unallocated.emplace_back(r.origin);
+                    }
+                    if (nullptr != r.offset && nullptr == TensorUtils::getDescribe(r.offset)->backend) {
+                        unallocated.emplace_back(r.offset);
+                    }
+                }
+            } else if (nullptr == des->backend) {
+                unallocated.emplace_back(t);
+            }
+        }
+    }
+    auto code = _allocMemory();
+    // The backend may plan memory by the pass before and ask to resize again
+    while (NO_ERROR == code && mBackend->onResizeAgain()) {
+        for (auto& exe : mExecutions) {
+            exe = nullptr;
+        }
+        for (auto t : unallocated) {
+            TensorUtils::getDescribe(t)->backend = nullptr;
+        }
+        code = _allocMemory();
+    }
+    return code;
+}
+
+ErrorCode Pipeline::_allocMemory() {
     // Compute RefCount
     for (auto& iter : mBuffer.command) {
         for (auto t : iter.inputs) {
@@ -480,10 +578,24 @@ ErrorCode Pipeline::allocMemory() {
     return NO_ERROR;
 }
 
+static const char* _traceName(const Command& cmd) {
+    if (!TraceRecorder::active()) {
+        return nullptr;
+    }
+    if (nullptr != cmd.op->name()) {
+        return cmd.op->name()->c_str();
+    }
+    if (!cmd.name.empty()) {
+        return cmd.name.c_str();
+    }
+    return EnumNameOpType(cmd.op->type());
+}
+
 ErrorCode Pipeline::execute() {
     mBackend->onExecuteBegin();
     for (int i = 0; i < mBuffer.command.size(); ++i) {
         auto& cmd = mBuffer.command[i];
+        TraceRecorder::Scope _trace(_traceName(cmd), "op");
         auto code = mExecutions[i]->onExecute(cmd.inputs, cmd.outputs);
         if (NO_ERROR != code) {
             mBackend->onExecuteEnd();
@@ -505,6 +617,7 @@ ErrorCode Pipeline::executeCallBack(const TensorCallBackWithInfo& before, const
         auto& info = mDebugInfos[i];
         auto run   = before(cmd.inputs, &info);
         if (run) {
+            TraceRecorder::Scope _trace(_traceName(cmd), "op");
             auto code = mExecutions[i]->onExecute(cmd.inputs, cmd.outputs);
             if (NO_ERROR != code) {
                 mBackend->onExecuteEnd();
@@ -24,7 +24,7 @@ class SizeComputer;
 class Pipeline : public NonCopyable {
 public:
     Pipeline(std::vector<Schedule::PipelineInfo>&& info, std::shared_ptr<Backend> major,
-             std::shared_ptr<Backend> backup, bool allocInput, bool useGeometry);
+             std::shared_ptr<Backend> backup, bool allocInput, bool netHold, bool useGeometry);
     ~Pipeline();
     class UnitInfo : public OperatorInfo {
     public:
@@ -36,6 +36,31 @@ public:
     const std::map<const Op*, std::shared_ptr<Execution>>& getCache() {
         return mOriginExecution;
     }
+    std::pair<std::shared_ptr<Backend>, std::shared_ptr<Backend>> getBackends() const {
+        return std::make_pair(mBackend, mBackupBackend);
+    }
+    /** prepared state for one group of input shapes, kept by session's shape cache */
+    struct State {
+        State(std::shared_ptr<Backend> major, std::shared_ptr<Backend> backup);
+        ~State();
+        std::shared_ptr<Backend> backend;
+        std::shared_ptr<Backend> backupBackend;
+#ifndef MNN_BUILD_MINI
+        /** geometry context allocating the const tensors of the commands by backupBackend */
+        std::shared_ptr<GeometryComputer::Context> context;
+#endif
+        std::map<const Op*, std::shared_ptr<Execution>> originExecution;
+        std::vector<std::shared_ptr<Execution>> executions;
+        std::vector<UnitInfo> debugInfos;
+        CommandBuffer buffer;
+        /** headers of mid const tensors whose static memory is held by the state */
+        std::vector<std::shared_ptr<Tensor>> midConstTensors;
+        bool init = false;
+    };
+    /** exchange the prepared state, the tensors' info should be exchanged by the caller */
+    void swapState(State& state);
+    /** memory in MB held by the current state: the memory of its backends and its mid const tensors */
+    float getStateMemory() const;
 public:
     /** encode :
        1. compute shape for every op's inputs and outputs;
@@ -52,6 +77,7 @@ public:
     std::vector<Schedule::PipelineInfo>& getPipelineInfo();
 
 private:
+    ErrorCode _allocMemory();
     std::shared_ptr<Backend> mBackend;
     std::shared_ptr<Backend> mBackupBackend;
     std::vector<std::shared_ptr<Execution>> mExecutions;
@@ -64,7 +90,7 @@ private:
     bool mInit = false;
     std::map<const Op*, std::shared_ptr<Execution>> mOriginExecution;
 #ifndef MNN_BUILD_MINI
-    GeometryComputer::Context mContext;
+    std::shared_ptr<GeometryComputer::Context> mContext;
     bool mUseGeometry = true;
 #endif
 };
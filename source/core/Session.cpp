@@ -9,19 +9,21 @@
 #include "core/Session.hpp"
 #include <string.h>
 #include <MNN/AutoTime.hpp>
+#include <algorithm>
 #include <map>
 #include <set>
 #include "MNN_generated.h"
 #include "core/AutoStorage.h"
 #include "core/RuntimeFactory.hpp"
 #include "core/TensorUtils.hpp"
+#include "core/TraceRecorder.hpp"
 #include "core/WrapExecution.hpp"
 
 using namespace std;
 
 namespace MNN {
 Session::Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBackMode,
-                 Interpreter::SessionMode inputMode, RuntimeInfo&& runtime) {
+                 Interpreter::SessionMode inputMode, RuntimeInfo&& runtime, bool netHold) {
     mRuntime = std::move(runtime);
     if (info.pipelineInfo.empty()) {
         mValid = false;
@@ -33,28 +35,54 @@ Session::Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBac
     mTensors              = std::move(info.allTensors);
     for (auto& iter : info.pipelineInfo) {
         auto rt    = mRuntime.first.find(iter.first.type)->second.get();
-        auto cpuRuntime = mRuntime.second;
-        std::shared_ptr<Backend> first(rt->onCreate(iter.first.user));
-        std::shared_ptr<Backend> second;
-        if (first->type() == MNN_FORWARD_CPU) {
-            second = first;
-        } else {
-            BackendConfig defaultConfig;
-            second.reset(cpuRuntime->onCreate(&defaultConfig));
+        std::shared_ptr<BackendConfig> config;
+        if (nullptr != iter.first.user) {
+            config.reset(new BackendConfig(*iter.first.user));
         }
-        std::shared_ptr<Pipeline> newPipeline(new Pipeline(std::move(iter.second), first, second, inputMode == Interpreter::Session_Input_Inside, rt->onGetCompilerType() == Runtime::Compiler_Geometry));
+        mBackendInfos.emplace_back(std::make_pair(iter.first.type, config));
+        std::shared_ptr<Backend> first;
+        std::shared_ptr<Backend> second;
+        _createBackends((int)mBackendInfos.size() - 1, first, second);
+        std::shared_ptr<Pipeline> newPipeline(new Pipeline(std::move(iter.second), first, second, inputMode == Interpreter::Session_Input_Inside, netHold, rt->onGetCompilerType() == Runtime::Compiler_Geometry));
         mPipelines.emplace_back(std::move(newPipeline));
     }
     mInputs       = std::move(info.inputTensors);
     mOutputs      = std::move(info.outputTensor);
     mCallBackMode = callBackMode;
+    mInputMode    = inputMode;
+}
+
+void Session::_createBackends(int index, std::shared_ptr<Backend>& major, std::shared_ptr<Backend>& backup) const {
+    auto& info = mBackendInfos[index];
+    auto rt    = mRuntime.first.find(info.first)->second.get();
+    major.reset(rt->onCreate(info.second.get()));
+    if (major->type() == MNN_FORWARD_CPU) {
+        backup = major;
+    } else {
+        BackendConfig defaultConfig;
+        backup.reset(mRuntime.second->onCreate(&defaultConfig));
+    }
+}
+
+Session::ShapeCache::~ShapeCache() {
+    states.clear();
+    for (auto& t : tensors) {
+        // The headers don't own the memory
+        t->buffer().host = nullptr;
+        TensorUtils::getDescribe(t.get())->memoryType = Tensor::InsideDescribe::MEMORY_BACKEND;
+    }
 }
 
 Session::~Session() {
+    mShapeCurrent = nullptr;
+    mShapeCache.clear();
     for (auto& t : mTensors) {
         TensorUtils::clearHandleData(t.second.get());
     }
     mPipelines.clear();
+    // The shared executions are released with the pipelines, then the backends holding their resources
+    mSharedBackends.clear();
+    mSharedRuntimes.clear();
     mRuntime.first.clear();
     mTensors.clear();
     mRuntime.second = nullptr;
@@ -79,6 +107,17 @@ std::pair<const void*, size_t> Session::getCache() {
     }
     return std::make_pair(nullptr, 0);
 }
+void Session::setShapeCache(float memoryLimit) {
+    mShapeCacheLimit = memoryLimit;
+    if (memoryLimit <= 0.0f) {
+        mShapeCurrent = nullptr;
+        mShapeCache.clear();
+        for (auto& iter : mRuntime.first) {
+            iter.second->onGabageCollect(0);
+        }
+    }
+}
+
 void Session::cloneExecution(const std::map<const Op*, std::shared_ptr<Execution>>& cache, int pipelineIndex) {
     mPipelines[pipelineIndex]->cloneExecution(cache);
 }
@@ -86,11 +125,38 @@ const std::map<const Op*, std::shared_ptr<Execution>>& Session::getExecution(int
     return mPipelines[pipelineIndex]->getCache();
 }
 
+void Session::shareExecution(const Session* session) {
+    MNN_ASSERT(session->mPipelines.size() == mPipelines.size());
+    for (int i = 0; i < mPipelines.size() && i < session->mPipelines.size(); ++i) {
+        mPipelines[i]->cloneExecution(session->mPipelines[i]->getCache());
+        auto backends = session->mPipelines[i]->getBackends();
+        mSharedBackends.emplace_back(backends.first);
+        mSharedBackends.emplace_back(backends.second);
+    }
+    // The backends hold raw pointer of their runtime
+    mSharedRuntimes.emplace_back(session->mRuntime);
+    mSharedBackends.insert(mSharedBackends.end(), session->mSharedBackends.begin(), session->mSharedBackends.end());
+    mSharedRuntimes.insert(mSharedRuntimes.end(), session->mSharedRuntimes.begin(), session->mSharedRuntimes.end());
+}
+
+void Session::setConfigs(const std::vector<ScheduleConfig>& configs) {
+    mConfigs = configs;
+    mConfigBackends.clear();
+    for (auto& config : mConfigs) {
+        if (nullptr != config.backendConfig) {
+            std::shared_ptr<BackendConfig> backendConfig(new BackendConfig(*config.backendConfig));
+            config.backendConfig = backendConfig.get();
+            mConfigBackends.emplace_back(backendConfig);
+        }
+    }
+}
+
 ErrorCode Session::run() const {
     if (mNeedResize) {
         MNN_ERROR("Can't run session because not resized\n");
         return COMPUTE_SIZE_ERROR;
     }
+    TraceRecorder::Enable _trace(mTrace);
     for (auto& iter : mPipelines) {
         auto error = iter->execute();
         if (NO_ERROR != error) {
@@ -106,6 +172,7 @@ ErrorCode Session::runWithCallBack(const TensorCallBackWithInfo& before, const T
         MNN_ERROR("Can't run session because not resized\n");
         return COMPUTE_SIZE_ERROR;
     }
+    TraceRecorder::Enable _trace(mTrace);
     for (auto& iter : mPipelines) {
         auto error = iter->executeCallBack(before, end);
         if (NO_ERROR != error) {
@@ -125,12 +192,128 @@ void Session::_clearCache() {
     }
 }
 
+std::vector<int> Session::_getShapeKey() const {
+    std::vector<int> key;
+    for (auto& iter : mInputs) {
+        auto& buffer = iter.second->buffer();
+        key.emplace_back(buffer.dimensions);
+        for (int i = 0; i < buffer.dimensions; ++i) {
+            key.emplace_back(buffer.dim[i].extent);
+        }
+    }
+    return key;
+}
+
+bool Session::_swapShapeCache() {
+    auto key = _getShapeKey();
+    if (nullptr == mShapeCurrent || mShapeCurrent->key == key) {
+        // Nothing prepared or the same shapes, resize in place
+        return false;
+    }
+    auto current  = mShapeCurrent;
+    mShapeCurrent = nullptr;
+    for (auto iter = mShapeCache.begin(); iter != mShapeCache.end(); ++iter) {
+        auto cache = *iter;
+        if (cache->key != key) {
+            continue;
+        }
+        for (int i = 0; i < mPipelines.size(); ++i) {
+            mPipelines[i]->swapState(*cache->states[i]);
+        }
+        current->states = std::move(cache->states);
+        // The input memory is set by user before resize if inputs are outside
+        bool inputOutside = Interpreter::Session_Input_User == mInputMode;
+        std::vector<halide_buffer_t> inputBuffers;
+        if (inputOutside) {
+            for (auto& input : mInputs) {
+                inputBuffers.emplace_back(input.second->buffer());
+            }
+        }
+        for (int i = 0; i < mTensors.size(); ++i) {
+            TensorUtils::copyHeader(cache->tensors[i].get(), mTensors[i].second.get());
+        }
+        if (inputOutside) {
+            int index = 0;
+            for (auto& input : mInputs) {
+                input.second->buffer().host   = inputBuffers[index].host;
+                input.second->buffer().device = inputBuffers[index].device;
+                index++;
+            }
+        }
+        mShapeCache.erase(iter);
+        mShapeCache.push_front(current);
+        mShapeCurrent = cache;
+        return true;
+    }
+    // Keep current state with its backends, and prepare the new shapes by new backends
+    for (int i = 0; i < mPipelines.size(); ++i) {
+        std::shared_ptr<Backend> major;
+        std::shared_ptr<Backend> backup;
+        _createBackends(i, major, backup);
+        std::shared_ptr<Pipeline::State> state(new Pipeline::State(major, backup));
+        mPipelines[i]->swapState(*state);
+        current->states.emplace_back(state);
+    }
+    mShapeCache.push_front(current);
+    return false;
+}
+
+void Session::_updateShapeCache() {
+    for (auto& t : mTensors) {
+        if (t.second->buffer().type.code == halide_type_handle) {
+            MNN_ERROR("Shape cache doesn't support handle tensor, disable it\n");
+            setShapeCache(0.0f);
+            return;
+        }
+    }
+    std::shared_ptr<ShapeCache> current(new ShapeCache);
+    current->key = _getShapeKey();
+    for (auto& t : mTensors) {
+        std::shared_ptr<Tensor> header(new Tensor);
+        TensorUtils::copyHeader(t.second.get(), header.get());
+        current->tensors.emplace_back(header);
+    }
+    // Each state has backends of its own, see _swapShapeCache
+    for (auto& iter : mPipelines) {
+        current->memory += iter->getStateMemory();
+    }
+    mShapeCurrent   = current;
+    // Drop the least recently used states over the limit
+    float summer = 0.0f;
+    for (auto& cache : mShapeCache) {
+        summer += cache->memory;
+    }
+    bool dropped = false;
+    while (!mShapeCache.empty() && summer > mShapeCacheLimit) {
+        summer -= mShapeCache.back()->memory;
+        mShapeCache.pop_back();
+        dropped = true;
+    }
+    if (dropped) {
+        for (auto& iter : mRuntime.first) {
+            iter.second->onGabageCollect(0);
+        }
+    }
+}
+
 ErrorCode Session::resize(bool isStatic) {
+    TraceRecorder::Enable _trace(mTrace);
+    bool shapeCache = mShapeCacheLimit > 0.0f && (!isStatic);
+    if (shapeCache && (mNeedResize || mNeedMalloc)) {
+        if (mNeedResize && _swapShapeCache()) {
+            mNeedResize = false;
+            mNeedMalloc = false;
+            return NO_ERROR;
+        }
+        // The current state is prepared again in place
+        mShapeCurrent = nullptr;
+    }
     if (mNeedResize) {
         if (!isStatic) {
             _clearCache();
         }
         bool debug = mCallBackMode == Interpreter::Session_Debug;
+        TraceRecorder::Scope _scope("encode", "resize");
         for (auto& iter : mPipelines) {
             auto error = iter->encode(isStatic, debug);
             if (NO_ERROR != error) {
@@ -145,6 +328,7 @@ ErrorCode Session::resize(bool isStatic) {
         mNeedResize = true;
         // Turn Pipeline to Command Buffer and Malloc resource
         // TODO: Seperate Schedule and Malloc
+        TraceRecorder::Scope _scope("allocMemory", "resize");
         for (auto& iter : mPipelines) {
             auto error = iter->allocMemory();
             if (NO_ERROR != error) {
@@ -156,20 +340,28 @@ ErrorCode Session::resize(bool isStatic) {
         }
         mNeedMalloc = false;
         mNeedResize = false;
+        if (shapeCache) {
+            _updateShapeCache();
+        }
     }
     return NO_ERROR;
 }
+
+float Session::_getMemory() const {
+    float summer = mRuntime.second->onGetMemoryInMB();
+    for (auto& r : mRuntime.first) {
+        if (r.second.get() != mRuntime.second.get()) {
+            summer += r.second->onGetMemoryInMB();
+        }
+    }
+    return summer;
+}
+
 bool Session::getInfo(Interpreter::SessionInfoCode code, void* ptr) const {
     switch (code) {
         case Interpreter::MEMORY: {
-            auto dst     = (float*)ptr;
-            float summer = mRuntime.second->onGetMemoryInMB();
-            for (auto& r : mRuntime.first) {
-                if (r.second.get() != mRuntime.second.get()) {
-                    summer += r.second->onGetMemoryInMB();
-                }
-            }
-            *dst = summer;
+            auto dst = (float*)ptr;
+            *dst     = _getMemory();
             return true;
         } break;
         // TODO: Support other debug info
@@ -247,7 +439,9 @@ ErrorCode Session::updateToModel(Net* net) const {
                 return INVALID_VALUE;
             }
         }
-        ::memcpy((void*)blob->float32s()->data(), tensor->host<float>(), tensor->size());
+        if (blob->float32s()->data() != tensor->host<float>()) {
+            ::memcpy((void*)blob->float32s()->data(), tensor->host<float>(), tensor->size());
+        }
     }
 
     return NO_ERROR;
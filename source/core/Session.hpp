@@ -10,6 +10,7 @@
 #define Session_hpp
 
 #include <MNN/Tensor.hpp>
+#include <list>
 #include <map>
 #include <memory>
 #include <vector>
@@ -25,7 +26,7 @@ struct Net;
 class MNN_PUBLIC Session {
 public:
     Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBackMode, Interpreter::SessionMode inputMode,
-            RuntimeInfo&& runtime);
+            RuntimeInfo&& runtime, bool netHold = false);
     ~Session();
 
 public:
@@ -48,6 +49,18 @@ public:
 
     void cloneExecution(const std::map<const Op*, std::shared_ptr<Execution>>& cache, int pipelineIndex);
     const std::map<const Op*, std::shared_ptr<Execution>>& getExecution(int pipelineIndex);
+
+    /**
+     * @brief clone the executions of a session scheduled by the same configs. The backends of the session are kept
+     * alive, for the shared resources of the executions are released by them.
+     */
+    void shareExecution(const Session* session);
+
+    /** keep the schedule configs, the backend configs are copied */
+    void setConfigs(const std::vector<ScheduleConfig>& configs);
+    const std::vector<ScheduleConfig>& getConfigs() const {
+        return mConfigs;
+    }
 public:
     /**
      * @brief resize tensors and buffers responding to input changes.
@@ -67,6 +80,11 @@ public:
         mNeedMalloc = flag;
     }
 
+    /** record the timeline when resize or run, see TraceRecorder */
+    void setTrace(bool trace) {
+        mTrace = trace;
+    }
+
 public:
     /**
      * @brief get backend that create the tensor.
@@ -110,6 +128,12 @@ public:
      */
     ErrorCode updateToModel(Net* net) const;
 
+    /**
+     * @brief keep prepared states of former input shapes, resize back to one of them only swaps the state.
+     * @param memoryLimit   memory in MB the kept states may use, 0 disables the cache.
+     */
+    void setShapeCache(float memoryLimit);
+
     bool loadCache(const void* buffer, size_t size);
     std::pair<const void*, size_t> getCache();
 
@@ -121,9 +145,24 @@ protected:
 private:
     void _clearCache();
     void _setUpTensorInfo(const Schedule::ScheduleInfo& info);
+    void _createBackends(int index, std::shared_ptr<Backend>& major, std::shared_ptr<Backend>& backup) const;
+    float _getMemory() const;
+    std::vector<int> _getShapeKey() const;
+    bool _swapShapeCache();
+    void _updateShapeCache();
+
+    struct ShapeCache {
+        ~ShapeCache();
+        std::vector<int> key;
+        /** headers of mTensors when the state is prepared */
+        std::vector<std::shared_ptr<Tensor>> tensors;
+        std::vector<std::shared_ptr<Pipeline::State>> states;
+        float memory = 0.0f;
+    };
 
 private:
     RuntimeInfo mRuntime;
+    std::vector<std::pair<MNNForwardType, std::shared_ptr<BackendConfig>>> mBackendInfos;
     std::vector<std::shared_ptr<Pipeline>> mPipelines;
     std::vector<std::pair<int, std::shared_ptr<Tensor>>> mTensors;
     std::map<std::string, Tensor*> mInputs;
@@ -132,6 +171,16 @@ private:
     bool mValid      = true;
     bool mNeedMalloc = true;
     Interpreter::SessionMode mCallBackMode;
+    Interpreter::SessionMode mInputMode;
+    bool mTrace = false;
+    float mShapeCacheLimit = 0.0f;
+    std::shared_ptr<ShapeCache> mShapeCurrent;
+    std::list<std::shared_ptr<ShapeCache>> mShapeCache;
+    std::vector<ScheduleConfig> mConfigs;
+    std::vector<std::shared_ptr<BackendConfig>> mConfigBackends;
+    /** backends and runtimes of the session whose executions are shared */
+    std::vector<std::shared_ptr<Backend>> mSharedBackends;
+    std::vector<RuntimeInfo> mSharedRuntimes;
 };
 } // namespace MNN
 
@@ -110,6 +110,16 @@ void TensorUtils::copyShape(const Tensor* source, Tensor* dest, bool copyFormat)
     }
 }
 
+void TensorUtils::copyHeader(const Tensor* source, Tensor* dest) {
+    auto& ob = dest->buffer();
+    auto& ib = source->buffer();
+    auto dim = ob.dim;
+    *dest->mDescribe = *source->mDescribe;
+    ob     = ib;
+    ob.dim = dim;
+    ::memcpy(ob.dim, ib.dim, ib.dimensions * sizeof(halide_dimension_t));
+}
+
 void TensorUtils::setShape(Tensor* dest, const std::vector<int>& alldims) {
     auto& ob      = dest->buffer();
     ob.dimensions = alldims.size();
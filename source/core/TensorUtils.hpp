@@ -116,6 +116,13 @@ public:
      */
     static void copyShape(const Tensor* source, Tensor* dest, bool copyFormat = false);
 
+    /**
+     * @brief copy buffer and extra info from source tensor to dest tensor, the memory is shared.
+     * @param source        header prodiver tensor.
+     * @param dest          header consumer tensor.
+     */
+    static void copyHeader(const Tensor* source, Tensor* dest);
+
     /**
      * @brief set shape for dest tensor from a common int vector.
      * @param dest          shape consumer tensor.
@@ -0,0 +1,197 @@
+//
+//  TraceRecorder.cpp
+//  MNN
+//
+//  Created by MNN on 2021/05/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "core/TraceRecorder.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Events kept for each thread, must be power of 2
+#define MNN_TRACE_BUFFER_SIZE (1 << 14)
+
+namespace MNN {
+std::atomic<int> TraceRecorder::gActive{0};
+
+struct TraceEvent {
+    char name[TraceRecorder::NAME_LENGTH];
+    const char* category;
+    int64_t start;
+    int64_t duration;
+};
+
+// Written only by its thread, count is published with release so that dump reads complete events
+struct TraceBuffer {
+    int tid;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> count = {0};
+};
+
+struct TraceRegistry {
+    std::mutex lock;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    // Buffers of exited threads, reused by new threads so that the buffers are bounded by the live threads
+    std::vector<TraceBuffer*> freeBuffers;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+static TraceRegistry* _registry() {
+    // Never freed, the workers of the thread pool may still record while static objects are destroyed
+    static TraceRegistry* registry = new TraceRegistry;
+    return registry;
+}
+
+static int64_t _now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                _registry()->origin)
+        .count();
+}
+
+// Returns the buffer of the thread to the registry at thread exit, its events are kept until reused
+struct TraceBufferOwner {
+    TraceBuffer* buffer = nullptr;
+    ~TraceBufferOwner() {
+        if (nullptr != buffer) {
+            auto registry = _registry();
+            std::unique_lock<std::mutex> _l(registry->lock);
+            registry->freeBuffers.emplace_back(buffer);
+        }
+    }
+};
+
+static TraceBuffer* _threadBuffer() {
+    thread_local static TraceBufferOwner owner;
+    if (nullptr == owner.buffer) {
+        auto registry = _registry();
+        std::unique_lock<std::mutex> _l(registry->lock);
+        if (!registry->freeBuffers.empty()) {
+            owner.buffer = registry->freeBuffers.back();
+            registry->freeBuffers.pop_back();
+            return owner.buffer;
+        }
+        std::unique_ptr<TraceBuffer> newBuffer(new TraceBuffer);
+        newBuffer->events.resize(MNN_TRACE_BUFFER_SIZE);
+        newBuffer->tid = (int)registry->buffers.size();
+        owner.buffer   = newBuffer.get();
+        registry->buffers.emplace_back(std::move(newBuffer));
+    }
+    return owner.buffer;
+}
+
+// Record for all sessions and dump at exit if MNN_TRACE_FILE is set
+class TraceEnvDumper {
+public:
+    TraceEnvDumper() {
+        auto file = getenv("MNN_TRACE_FILE");
+        if (nullptr != file && file[0] != '\0') {
+            mFile = file;
+            TraceRecorder::begin();
+        }
+    }
+    ~TraceEnvDumper() {
+        if (!mFile.empty()) {
+            TraceRecorder::end();
+            TraceRecorder::dump(mFile.c_str());
+        }
+    }
+
+private:
+    std::string mFile;
+};
+static TraceEnvDumper gEnvDumper;
+
+void TraceRecorder::begin() {
+    // Make the origin earlier than any event
+    _registry();
+    gActive++;
+}
+
+void TraceRecorder::end() {
+    gActive--;
+}
+
+void TraceRecorder::Scope::_begin(const char* name, const char* category) {
+    mRecord   = true;
+    mName     = name;
+    mCategory = category;
+    mStart    = _now();
+}
+
+void TraceRecorder::Scope::_end() {
+    auto end    = _now();
+    auto buffer = _threadBuffer();
+    auto count  = buffer->count.load(std::memory_order_relaxed);
+    auto& event = buffer->events[count & (MNN_TRACE_BUFFER_SIZE - 1)];
+    ::strncpy(event.name, mName, NAME_LENGTH - 1);
+    event.name[NAME_LENGTH - 1] = '\0';
+    event.category              = mCategory;
+    event.start                 = mStart;
+    event.duration              = end - mStart;
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+static void _writeString(FILE* f, const char* str) {
+    fputc('"', f);
+    for (auto c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', f);
+            fputc(*c, f);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(f, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+bool TraceRecorder::dump(const char* file) {
+    if (nullptr == file) {
+        return false;
+    }
+    FILE* f = fopen(file, "w");
+    if (nullptr == f) {
+        MNN_ERROR("Can't open %s to dump trace\n", file);
+        return false;
+    }
+    auto registry = _registry();
+    std::unique_lock<std::mutex> _l(registry->lock);
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (auto& buffer : registry->buffers) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+                first ? "" : ",\n", buffer->tid, buffer->tid);
+        first      = false;
+        auto count = buffer->count.load(std::memory_order_acquire);
+        auto sta   = count > MNN_TRACE_BUFFER_SIZE ? count - MNN_TRACE_BUFFER_SIZE : 0;
+        for (auto i = sta; i < count; ++i) {
+            auto& event = buffer->events[i & (MNN_TRACE_BUFFER_SIZE - 1)];
+            fprintf(f, ",\n{\"name\":");
+            _writeString(f, event.name);
+            fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", event.category,
+                    buffer->tid, (double)event.start / 1000.0, (double)event.duration / 1000.0);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return true;
+}
+
+void TraceRecorder::clear() {
+    auto registry = _registry();
+    std::unique_lock<std::mutex> _l(registry->lock);
+    for (auto& buffer : registry->buffers) {
+        buffer->count.store(0, std::memory_order_release);
+    }
+}
+
+} // namespace MNN
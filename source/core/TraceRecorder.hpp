@@ -0,0 +1,90 @@
+//
+//  TraceRecorder.hpp
+//  MNN
+//
+//  Created by MNN on 2021/05/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef TraceRecorder_hpp
+#define TraceRecorder_hpp
+
+#include <stdint.h>
+#include <atomic>
+#include <MNN/MNNDefine.h>
+
+namespace MNN {
+
+/**
+ * Timeline of ops, thread pool tasks and resize phases, dumped as Chrome Trace Event JSON for chrome://tracing or
+ * Perfetto. Each thread records into its own ring buffer without lock, only the latest events of a thread are kept
+ * when the buffer is full. The buffer of an exited thread is reused by a later thread. Recording is process-wide while
+ * any user (a traced session or MNN_TRACE_FILE) is active. If the env MNN_TRACE_FILE is set, recording is always
+ * active and the trace is dumped to it at exit.
+ */
+class MNN_PUBLIC TraceRecorder {
+public:
+    /** names longer than it are truncated */
+    static constexpr int NAME_LENGTH = 48;
+
+    static inline bool active() {
+        return gActive.load(std::memory_order_relaxed) > 0;
+    }
+    /** start / stop recording, they are counted so that users can be nested */
+    static void begin();
+    static void end();
+    /**
+     * @brief write the recorded events of all threads, should be called when no traced session is running.
+     * @return false if the file can't be opened.
+     */
+    static bool dump(const char* file);
+    /** drop the recorded events */
+    static void clear();
+
+    /** record the duration between construction and destruction, do nothing if name is NULL or not active */
+    class Scope {
+    public:
+        Scope(const char* name, const char* category) {
+            if (nullptr != name && active()) {
+                _begin(name, category);
+            }
+        }
+        ~Scope() {
+            if (mRecord) {
+                _end();
+            }
+        }
+
+    private:
+        void _begin(const char* name, const char* category);
+        void _end();
+        bool mRecord = false;
+        const char* mName;
+        const char* mCategory;
+        int64_t mStart;
+    };
+    /** begin / end recording in the scope if enable is true */
+    class Enable {
+    public:
+        Enable(bool enable) : mEnable(enable) {
+            if (mEnable) {
+                begin();
+            }
+        }
+        ~Enable() {
+            if (mEnable) {
+                end();
+            }
+        }
+
+    private:
+        bool mEnable;
+    };
+
+private:
+    static std::atomic<int> gActive;
+};
+
+} // namespace MNN
+
+#endif /* TraceRecorder_hpp */
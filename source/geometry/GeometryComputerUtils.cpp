@@ -271,6 +271,7 @@ ErrorCode GeometryComputerUtils::shapeComputeAndGeometryTransform(
             }
         }
         GeometryComputerUtils::makeRaster(tmpBuffer, buffer, geoContext);
+        GeometryComputerUtils::fuseRaster(buffer);
 #ifdef MNN_ADD_NAME
         std::unordered_map<std::string, int> nameIdx;
         auto getName = [&nameIdx](const std::string& name) {
@@ -376,6 +377,254 @@ void GeometryComputerUtils::makeRaster(const CommandBuffer& srcBuffer, CommandBu
         ctx.getRasterCacheCreateRecurrse(o, dstBuffer);
     }
 }
+// Range [lo, hi] of dst written by the region, return false if it doesn't write every element of the range
+static bool _denseDstRange(const Tensor::InsideDescribe::Region& region, int& lo, int& hi) {
+    std::vector<std::pair<int, int>> dims;
+    for (int i = 0; i < 3; ++i) {
+        if (region.size[i] > 1) {
+            dims.emplace_back(std::make_pair(region.dst.stride[i], region.size[i]));
+        }
+    }
+    std::sort(dims.begin(), dims.end());
+    int expect = 1;
+    for (auto& d : dims) {
+        if (d.first != expect) {
+            return false;
+        }
+        expect *= d.second;
+    }
+    lo = region.dst.offset;
+    hi = lo + expect - 1;
+    return true;
+}
+
+static int _srcExtent(const Tensor::InsideDescribe::Region& region, int exceptDim) {
+    int extent = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (i != exceptDim && region.size[i] > 1) {
+            extent += (region.size[i] - 1) * region.src.stride[i];
+        }
+    }
+    return extent;
+}
+
+static bool _isCopy(const Tensor::InsideDescribe::Region& region) {
+    for (int i = 0; i < 3; ++i) {
+        if (region.size[i] > 1 && region.src.stride[i] != region.dst.stride[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _fuseable(const Tensor* t, int bytes) {
+    auto des = TensorUtils::getDescribe(t);
+    return des->dimensionFormat != MNN_DATA_FORMAT_NC4HW4 && t->getType().bytes() == bytes;
+}
+
+// Split the region reading producer's output to parts that each read from one region of producer and fuse them
+static bool _fuseRasterRegion(const Tensor::InsideDescribe::Region& region, const std::vector<Tensor::InsideDescribe::Region>& producer,
+                              std::vector<Tensor::InsideDescribe::Region>& fused) {
+    if (nullptr != region.offset) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        if (region.size[i] > 1 && region.src.stride[i] <= 0) {
+            return false;
+        }
+    }
+    std::vector<std::pair<int, int>> ranges(producer.size());
+    for (int k = 0; k < producer.size(); ++k) {
+        auto& p = producer[k];
+        if (nullptr == p.origin || nullptr != p.offset) {
+            return false;
+        }
+        if (!_denseDstRange(p, ranges[k].first, ranges[k].second)) {
+            return false;
+        }
+    }
+    {
+        // Regions written later may overwrite the former, don't fuse then
+        auto sorted = ranges;
+        std::sort(sorted.begin(), sorted.end());
+        for (int k = 1; k < sorted.size(); ++k) {
+            if (sorted[k].first <= sorted[k - 1].second) {
+                return false;
+            }
+        }
+    }
+    auto find = [&](int lo, int hi) {
+        for (int k = 0; k < ranges.size(); ++k) {
+            if (ranges[k].first <= lo && hi <= ranges[k].second) {
+                return k;
+            }
+        }
+        return -1;
+    };
+    std::vector<std::pair<Tensor::InsideDescribe::Region, int>> parts;
+    auto whole = find(region.src.offset, region.src.offset + _srcExtent(region, -1));
+    if (whole >= 0) {
+        parts.emplace_back(std::make_pair(region, whole));
+    } else {
+        for (int i = 0; i < 3 && parts.empty(); ++i) {
+            if (region.size[i] <= 1) {
+                continue;
+            }
+            auto extent = _srcExtent(region, i);
+            int start   = 0;
+            int current = -1;
+            bool valid  = true;
+            std::vector<std::pair<Tensor::InsideDescribe::Region, int>> split;
+            for (int j = 0; j <= region.size[i]; ++j) {
+                int k = -1;
+                if (j < region.size[i]) {
+                    auto lo = region.src.offset + j * region.src.stride[i];
+                    k       = find(lo, lo + extent);
+                    if (k < 0) {
+                        valid = false;
+                        break;
+                    }
+                }
+                if (k == current) {
+                    continue;
+                }
+                if (current >= 0) {
+                    auto part = region;
+                    part.size[i] = j - start;
+                    part.src.offset += start * region.src.stride[i];
+                    part.dst.offset += start * region.dst.stride[i];
+                    split.emplace_back(std::make_pair(part, current));
+                }
+                start   = j;
+                current = k;
+            }
+            if (valid) {
+                parts = std::move(split);
+            }
+        }
+    }
+    if (parts.empty()) {
+        return false;
+    }
+    for (auto& part : parts) {
+        auto src   = producer[part.second];
+        auto& dst  = part.first;
+        // Only fuse the cases TensorUtils::fuseRegion is sure about: copy, or read the whole output of a region
+        int number = dst.size[0] * dst.size[1] * dst.size[2];
+        int total  = src.size[0] * src.size[1] * src.size[2];
+        if (!_isCopy(src) && number != total) {
+            return false;
+        }
+        if (!TensorUtils::fuseRegion(src, dst)) {
+            return false;
+        }
+    }
+    for (auto& part : parts) {
+        fused.emplace_back(part.first);
+    }
+    return true;
+}
+
+void GeometryComputerUtils::fuseRaster(CommandBuffer& buffer) {
+    auto isRaster = [](const Command& cmd) {
+        auto op = cmd.op;
+        if (!cmd.buffer.empty()) {
+            op = flatbuffers::GetRoot<Op>(cmd.buffer.data());
+        }
+        return op->type() == OpType_Raster && cmd.inputs.size() == 1 && cmd.outputs.size() == 1 &&
+               TensorUtils::getDescribe(cmd.inputs[0])->memoryType == Tensor::InsideDescribe::MEMORY_VIRTUAL;
+    };
+    std::map<const Tensor*, int> producers;
+    std::map<const Tensor*, int> useCount;
+    for (int i = 0; i < buffer.command.size(); ++i) {
+        auto& cmd = buffer.command[i];
+        for (auto t : cmd.inputs) {
+            auto des = TensorUtils::getDescribe(t);
+            if (des->memoryType == Tensor::InsideDescribe::MEMORY_VIRTUAL) {
+                for (auto& r : des->regions) {
+                    useCount[r.origin] += 1;
+                    if (nullptr != r.offset) {
+                        useCount[r.offset] += 1;
+                    }
+                }
+            } else {
+                useCount[t] += 1;
+            }
+        }
+        if (isRaster(cmd)) {
+            producers[cmd.outputs[0]] = i;
+        }
+    }
+    // Rasters whose outputs are no longer used after fusion
+    std::vector<const Tensor*> unused;
+    for (int i = 0; i < buffer.command.size(); ++i) {
+        auto& cmd = buffer.command[i];
+        if (!isRaster(cmd)) {
+            continue;
+        }
+        auto des   = TensorUtils::getDescribe(cmd.inputs[0]);
+        auto bytes = cmd.outputs[0]->getType().bytes();
+        std::vector<Tensor::InsideDescribe::Region> regions;
+        bool changed = false;
+        for (auto& r : des->regions) {
+            auto iter  = producers.find(r.origin);
+            bool fused = false;
+            if (iter != producers.end() && _fuseable(r.origin, bytes)) {
+                auto& srcRegions = TensorUtils::getDescribe(buffer.command[iter->second].inputs[0])->regions;
+                bool valid       = true;
+                for (auto& s : srcRegions) {
+                    valid = valid && nullptr != s.origin && _fuseable(s.origin, bytes);
+                }
+                auto size = regions.size();
+                if (valid && _fuseRasterRegion(r, srcRegions, regions)) {
+                    for (int k = (int)size; k < regions.size(); ++k) {
+                        useCount[regions[k].origin] += 1;
+                    }
+                    if (0 == --useCount[r.origin]) {
+                        unused.emplace_back(r.origin);
+                    }
+                    fused = true;
+                } else {
+                    regions.resize(size);
+                }
+            }
+            if (!fused) {
+                regions.emplace_back(r);
+            }
+            changed = changed || fused;
+        }
+        if (changed) {
+            des->regions = std::move(regions);
+        }
+    }
+    if (unused.empty()) {
+        return;
+    }
+    std::vector<bool> removed(buffer.command.size(), false);
+    while (!unused.empty()) {
+        auto t = unused.back();
+        unused.pop_back();
+        if (TensorUtils::getDescribe(t)->usage != Tensor::InsideDescribe::NORMAL) {
+            continue;
+        }
+        auto index = producers[t];
+        removed[index] = true;
+        for (auto& r : TensorUtils::getDescribe(buffer.command[index].inputs[0])->regions) {
+            if (0 == --useCount[r.origin] && producers.find(r.origin) != producers.end()) {
+                unused.emplace_back(r.origin);
+            }
+        }
+    }
+    std::vector<Command> commands;
+    commands.reserve(buffer.command.size());
+    for (int i = 0; i < buffer.command.size(); ++i) {
+        if (!removed[i]) {
+            commands.emplace_back(std::move(buffer.command[i]));
+        }
+    }
+    buffer.command = std::move(commands);
+}
+
 Command GeometryComputerUtils::makeBinary(int type, Tensor* input0, Tensor* input1, Tensor* output) {
     flatbuffers::FlatBufferBuilder builder;
     BinaryOpBuilder builder_(builder);
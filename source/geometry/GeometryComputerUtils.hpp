@@ -14,6 +14,11 @@ namespace MNN {
 class GeometryComputerUtils {
 public:
     MNN_PUBLIC static void makeRaster(const CommandBuffer& srcBuffer, CommandBuffer& dstBuffer, GeometryComputer::Context& ctx);
+    /**
+     Compose the regions of a raster reading the output of other rasters with the regions of them, so that it reads
+     their sources directly. Rasters whose outputs are no longer used are removed.
+     */
+    MNN_PUBLIC static void fuseRaster(CommandBuffer& buffer);
     static void addConvert(const CommandBuffer& srcBuffer, CommandBuffer& dstBuffer, GeometryComputer::Context& ctx);
     static Command makeCommand(flatbuffers::FlatBufferBuilder& builder, const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs);
     static Command makeBinary(int type, Tensor* input0, Tensor* input1, Tensor* output);
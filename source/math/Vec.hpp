@@ -11,6 +11,7 @@
 #include "core/Macro.h"
 #include <array>
 #include <algorithm>  // supply std::max and std::min
+#include <cmath>
 #ifdef MNN_USE_NEON
 #include <arm_neon.h>
 #endif
@@ -115,6 +116,75 @@ struct Vec {
         }
         return dst;
     }
+    // a + b * c
+    static VecType fma(const VecType& a, const VecType& b, const VecType& c) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = a.value[i] + b.value[i] * c.value[i];
+        }
+        return dst;
+    }
+    VecType operator/(const VecType& lr) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = value[i] / lr.value[i];
+        }
+        return dst;
+    }
+    static VecType abs(const VecType& v) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = std::abs(v.value[i]);
+        }
+        return dst;
+    }
+    static VecType sqrt(const VecType& v) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = std::sqrt(v.value[i]);
+        }
+        return dst;
+    }
+    // Round to the nearest integer, ties may go either way, |v| < 2^31
+    static VecType round(const VecType& v) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = std::round(v.value[i]);
+        }
+        return dst;
+    }
+    // a < b ? x : y
+    static VecType selectLess(const VecType& a, const VecType& b, const VecType& x, const VecType& y) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = a.value[i] < b.value[i] ? x.value[i] : y.value[i];
+        }
+        return dst;
+    }
+    // x * 2^n, n is integer in [-126, 127]
+    static VecType ldexp(const VecType& x, const VecType& n) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            dst.value[i] = std::ldexp(x.value[i], (int)n.value[i]);
+        }
+        return dst;
+    }
+    // x = m * 2^e, m in [0.5, 1), only for positive normal x
+    static VecType frexp(const VecType& x, VecType& e) {
+        VecType dst;
+        for (int i = 0; i < N; ++i) {
+            int exponent;
+            dst.value[i] = std::frexp(x.value[i], &exponent);
+            e.value[i]   = (T)exponent;
+        }
+        return dst;
+    }
+    // Stop -ffast-math from reassociating the computation through v
+    static void keep(VecType& v) {
+#ifdef __GNUC__
+        __asm__("" : "+m"(v.value));
+#endif
+    }
 };
 
 #ifdef MNN_USE_NEON
@@ -154,6 +224,10 @@ struct Vec<float, 4> {
         VecType dst = { vminq_f32(v1.value, v2.value) };
         return dst;
     }
+    static VecType fma(const VecType& a, const VecType& b, const VecType& c) {
+        VecType dst = { vmlaq_f32(a.value, b.value, c.value) };
+        return dst;
+    }
     VecType operator+(const VecType& lr) {
         VecType dst = { vaddq_f32(value, lr.value) };
         return dst;
@@ -182,6 +256,68 @@ struct Vec<float, 4> {
         VecType dst = { vnegq_f32(value) };
         return dst;
     }
+    VecType operator/(const VecType& lr) {
+#ifdef __aarch64__
+        VecType dst = { vdivq_f32(value, lr.value) };
+#else
+        auto r = vrecpeq_f32(lr.value);
+        r      = vmulq_f32(vrecpsq_f32(lr.value, r), r);
+        r      = vmulq_f32(vrecpsq_f32(lr.value, r), r);
+        VecType dst = { vmulq_f32(value, r) };
+#endif
+        return dst;
+    }
+    static VecType abs(const VecType& v) {
+        VecType dst = { vabsq_f32(v.value) };
+        return dst;
+    }
+    static VecType sqrt(const VecType& v) {
+#ifdef __aarch64__
+        VecType dst = { vsqrtq_f32(v.value) };
+#else
+        auto x = vmaxq_f32(v.value, vdupq_n_f32(1.17549435e-38f));
+        auto r = vrsqrteq_f32(x);
+        r      = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+        r      = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+        VecType dst = { vmulq_f32(v.value, r) };
+#endif
+        return dst;
+    }
+    // Round to the nearest integer, ties may go either way, |v| < 2^31
+    static VecType round(const VecType& v) {
+#ifdef __aarch64__
+        VecType dst = { vrndnq_f32(v.value) };
+#else
+        auto half = vbslq_f32(vdupq_n_u32(0x80000000), v.value, vdupq_n_f32(0.5f));
+        VecType dst = { vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(v.value, half))) };
+#endif
+        return dst;
+    }
+    // a < b ? x : y
+    static VecType selectLess(const VecType& a, const VecType& b, const VecType& x, const VecType& y) {
+        VecType dst = { vbslq_f32(vcltq_f32(a.value, b.value), x.value, y.value) };
+        return dst;
+    }
+    // x * 2^n, n is integer in [-126, 127]
+    static VecType ldexp(const VecType& x, const VecType& n) {
+        auto p = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n.value), vdupq_n_s32(127)), 23);
+        VecType dst = { vmulq_f32(x.value, vreinterpretq_f32_s32(p)) };
+        return dst;
+    }
+    // x = m * 2^e, m in [0.5, 1), only for positive normal x
+    static VecType frexp(const VecType& x, VecType& e) {
+        auto bits = vreinterpretq_s32_f32(x.value);
+        e.value   = vcvtq_f32_s32(vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(126)));
+        auto m    = vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007fffff)), vdupq_n_s32(0x3f000000));
+        VecType dst = { vreinterpretq_f32_s32(m) };
+        return dst;
+    }
+    // Stop -ffast-math from reassociating the computation through v
+    static void keep(VecType& v) {
+#ifdef __GNUC__
+        __asm__("" : "+w"(v.value));
+#endif
+    }
 };
 
 template<>
@@ -374,6 +510,53 @@ struct Vec<float, 4> {
         VecType dst = { _mm_min_ps(v1.value, v2.value) };
         return dst;
     }
+    static VecType fma(const VecType& a, const VecType& b, const VecType& c) {
+        VecType dst = { _mm_add_ps(a.value, _mm_mul_ps(b.value, c.value)) };
+        return dst;
+    }
+    VecType operator/(const VecType& lr) {
+        VecType dst = { _mm_div_ps(value, lr.value) };
+        return dst;
+    }
+    static VecType abs(const VecType& v) {
+        VecType dst = { _mm_andnot_ps(_mm_set1_ps(-0.f), v.value) };
+        return dst;
+    }
+    static VecType sqrt(const VecType& v) {
+        VecType dst = { _mm_sqrt_ps(v.value) };
+        return dst;
+    }
+    // Round to the nearest integer, ties may go either way, |v| < 2^31
+    static VecType round(const VecType& v) {
+        VecType dst = { _mm_cvtepi32_ps(_mm_cvtps_epi32(v.value)) };
+        return dst;
+    }
+    // a < b ? x : y
+    static VecType selectLess(const VecType& a, const VecType& b, const VecType& x, const VecType& y) {
+        auto mask = _mm_cmplt_ps(a.value, b.value);
+        VecType dst = { _mm_or_ps(_mm_and_ps(mask, x.value), _mm_andnot_ps(mask, y.value)) };
+        return dst;
+    }
+    // x * 2^n, n is integer in [-126, 127]
+    static VecType ldexp(const VecType& x, const VecType& n) {
+        auto p = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n.value), _mm_set1_epi32(127)), 23);
+        VecType dst = { _mm_mul_ps(x.value, _mm_castsi128_ps(p)) };
+        return dst;
+    }
+    // x = m * 2^e, m in [0.5, 1), only for positive normal x
+    static VecType frexp(const VecType& x, VecType& e) {
+        auto bits = _mm_castps_si128(x.value);
+        e.value   = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+        auto m    = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f000000));
+        VecType dst = { _mm_castsi128_ps(m) };
+        return dst;
+    }
+    // Stop -ffast-math from reassociating the computation through v
+    static void keep(VecType& v) {
+#ifdef __GNUC__
+        __asm__("" : "+x"(v.value));
+#endif
+    }
 };
 template<>
 struct Vec<int8_t, 16> {
@@ -472,6 +655,238 @@ private:
         return _mm_or_si128(_mm_slli_epi16(dst_odd, 8), _mm_srli_epi16(_mm_slli_epi16(dst_even,8), 8));
     }
 };
+// Only used by the sources compiled for the instruction set, see x86_x64/CMakeLists.txt
+#ifdef __AVX__
+template<>
+struct Vec<float, 8> {
+    using VecType = Vec<float, 8>;
+    __m256 value;
+    VecType operator+(const VecType& lr) {
+        VecType dst = { _mm256_add_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator-(const VecType& lr) {
+        VecType dst = { _mm256_sub_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator*(const VecType& lr) {
+        VecType dst = { _mm256_mul_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator*(float lr) {
+        VecType dst = { _mm256_mul_ps(value, _mm256_set1_ps(lr)) };
+        return dst;
+    }
+    VecType& operator=(const VecType& lr) {
+        value = lr.value;
+        return *this;
+    }
+    VecType operator-() {
+        VecType dst = { _mm256_xor_ps(value, _mm256_set1_ps(-0.f)) };
+        return dst;
+    }
+    Vec() {
+    }
+    Vec(const float v) {
+        value = _mm256_set1_ps(v);
+    }
+    Vec(__m256&& v) {
+        value = v;
+    }
+    Vec(const VecType& lr) {
+        value = lr.value;
+    }
+    float operator[](size_t i) {
+        float temp[8];
+        _mm256_storeu_ps(temp, value);
+        return temp[i];
+    }
+    static VecType load(const float* addr) {
+        VecType v = { _mm256_loadu_ps(addr) };
+        return v;
+    }
+    static void save(float* addr, const VecType& v) {
+        _mm256_storeu_ps(addr, v.value);
+    }
+    static VecType max(const VecType& v1, const VecType& v2) {
+        VecType dst = { _mm256_max_ps(v1.value, v2.value) };
+        return dst;
+    }
+    static VecType min(const VecType& v1, const VecType& v2) {
+        VecType dst = { _mm256_min_ps(v1.value, v2.value) };
+        return dst;
+    }
+    static VecType fma(const VecType& a, const VecType& b, const VecType& c) {
+#ifdef __FMA__
+        VecType dst = { _mm256_fmadd_ps(b.value, c.value, a.value) };
+#else
+        VecType dst = { _mm256_add_ps(a.value, _mm256_mul_ps(b.value, c.value)) };
+#endif
+        return dst;
+    }
+    VecType operator/(const VecType& lr) {
+        VecType dst = { _mm256_div_ps(value, lr.value) };
+        return dst;
+    }
+    static VecType abs(const VecType& v) {
+        VecType dst = { _mm256_andnot_ps(_mm256_set1_ps(-0.f), v.value) };
+        return dst;
+    }
+    static VecType sqrt(const VecType& v) {
+        VecType dst = { _mm256_sqrt_ps(v.value) };
+        return dst;
+    }
+    // Round to the nearest integer, ties may go either way, |v| < 2^31
+    static VecType round(const VecType& v) {
+        VecType dst = { _mm256_round_ps(v.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+        return dst;
+    }
+    // a < b ? x : y
+    static VecType selectLess(const VecType& a, const VecType& b, const VecType& x, const VecType& y) {
+        VecType dst = { _mm256_blendv_ps(y.value, x.value, _mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)) };
+        return dst;
+    }
+    // x * 2^n, n is integer in [-126, 127]
+    static VecType ldexp(const VecType& x, const VecType& n) {
+#ifdef __AVX2__
+        auto p = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n.value), _mm256_set1_epi32(127)), 23);
+        VecType dst = { _mm256_mul_ps(x.value, _mm256_castsi256_ps(p)) };
+#else
+        auto ni = _mm256_cvtps_epi32(n.value);
+        auto lo = _mm_slli_epi32(_mm_add_epi32(_mm256_castsi256_si128(ni), _mm_set1_epi32(127)), 23);
+        auto hi = _mm_slli_epi32(_mm_add_epi32(_mm256_extractf128_si256(ni, 1), _mm_set1_epi32(127)), 23);
+        auto p  = _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        VecType dst = { _mm256_mul_ps(x.value, _mm256_castsi256_ps(p)) };
+#endif
+        return dst;
+    }
+    // x = m * 2^e, m in [0.5, 1), only for positive normal x
+    static VecType frexp(const VecType& x, VecType& e) {
+        auto bits = _mm256_castps_si256(x.value);
+#ifdef __AVX2__
+        e.value = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+#else
+        auto lo = _mm_sub_epi32(_mm_srli_epi32(_mm256_castsi256_si128(bits), 23), _mm_set1_epi32(126));
+        auto hi = _mm_sub_epi32(_mm_srli_epi32(_mm256_extractf128_si256(bits, 1), 23), _mm_set1_epi32(126));
+        e.value = _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+#endif
+        VecType dst = { _mm256_or_ps(_mm256_and_ps(x.value, _mm256_castsi256_ps(_mm256_set1_epi32(0x007fffff))),
+                                     _mm256_castsi256_ps(_mm256_set1_epi32(0x3f000000))) };
+        return dst;
+    }
+    // Stop -ffast-math from reassociating the computation through v
+    static void keep(VecType& v) {
+#ifdef __GNUC__
+        __asm__("" : "+x"(v.value));
+#endif
+    }
+};
+#endif
+#ifdef __AVX512F__
+template<>
+struct Vec<float, 16> {
+    using VecType = Vec<float, 16>;
+    __m512 value;
+    VecType operator+(const VecType& lr) {
+        VecType dst = { _mm512_add_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator-(const VecType& lr) {
+        VecType dst = { _mm512_sub_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator*(const VecType& lr) {
+        VecType dst = { _mm512_mul_ps(value, lr.value) };
+        return dst;
+    }
+    VecType operator*(float lr) {
+        VecType dst = { _mm512_mul_ps(value, _mm512_set1_ps(lr)) };
+        return dst;
+    }
+    VecType& operator=(const VecType& lr) {
+        value = lr.value;
+        return *this;
+    }
+    VecType operator-() {
+        VecType dst = { _mm512_sub_ps(_mm512_setzero_ps(), value) };
+        return dst;
+    }
+    Vec() {
+    }
+    Vec(const float v) {
+        value = _mm512_set1_ps(v);
+    }
+    Vec(__m512&& v) {
+        value = v;
+    }
+    Vec(const VecType& lr) {
+        value = lr.value;
+    }
+    float operator[](size_t i) {
+        float temp[16];
+        _mm512_storeu_ps(temp, value);
+        return temp[i];
+    }
+    static VecType load(const float* addr) {
+        VecType v = { _mm512_loadu_ps(addr) };
+        return v;
+    }
+    static void save(float* addr, const VecType& v) {
+        _mm512_storeu_ps(addr, v.value);
+    }
+    static VecType max(const VecType& v1, const VecType& v2) {
+        VecType dst = { _mm512_max_ps(v1.value, v2.value) };
+        return dst;
+    }
+    static VecType min(const VecType& v1, const VecType& v2) {
+        VecType dst = { _mm512_min_ps(v1.value, v2.value) };
+        return dst;
+    }
+    static VecType fma(const VecType& a, const VecType& b, const VecType& c) {
+        VecType dst = { _mm512_fmadd_ps(b.value, c.value, a.value) };
+        return dst;
+    }
+    VecType operator/(const VecType& lr) {
+        VecType dst = { _mm512_div_ps(value, lr.value) };
+        return dst;
+    }
+    static VecType abs(const VecType& v) {
+        VecType dst = { _mm512_abs_ps(v.value) };
+        return dst;
+    }
+    static VecType sqrt(const VecType& v) {
+        VecType dst = { _mm512_sqrt_ps(v.value) };
+        return dst;
+    }
+    // Round to the nearest integer, ties may go either way, |v| < 2^31
+    static VecType round(const VecType& v) {
+        VecType dst = { _mm512_roundscale_ps(v.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+        return dst;
+    }
+    // a < b ? x : y
+    static VecType selectLess(const VecType& a, const VecType& b, const VecType& x, const VecType& y) {
+        VecType dst = { _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.value, b.value, _CMP_LT_OQ), y.value, x.value) };
+        return dst;
+    }
+    // x * 2^n, n is integer in [-126, 127]
+    static VecType ldexp(const VecType& x, const VecType& n) {
+        VecType dst = { _mm512_scalef_ps(x.value, n.value) };
+        return dst;
+    }
+    // x = m * 2^e, m in [0.5, 1), only for positive normal x
+    static VecType frexp(const VecType& x, VecType& e) {
+        e.value     = _mm512_add_ps(_mm512_getexp_ps(x.value), _mm512_set1_ps(1.0f));
+        VecType dst = { _mm512_getmant_ps(x.value, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src) };
+        return dst;
+    }
+    // Stop -ffast-math from reassociating the computation through v
+    static void keep(VecType& v) {
+#ifdef __GNUC__
+        __asm__("" : "+v"(v.value));
+#endif
+    }
+};
+#endif
 #endif
 } // namespace Math
 } // namespace MNN
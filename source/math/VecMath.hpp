@@ -0,0 +1,263 @@
+//
+//  VecMath.hpp
+//  MNN
+//
+//  Created by MNN on 2021/03/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef VecMath_hpp
+#define VecMath_hpp
+#include <limits>
+#include "math/Vec.hpp"
+
+namespace MNN {
+namespace Math {
+
+/**
+ Polynomial approximations of float transcendental functions on Vec, most come from Cephes.
+ The error is the max ULP against double precision over the whole input range unless noted, the
+ worst of the SSE / AVX2 / AVX512 / generic versions. Denormal results may be flushed to 0.
+ LOWP uses shorter polynomials for exp / log, and the functions built on them, for
+ BackendConfig::Precision_Low. The others are the same in both precisions.
+ */
+template <typename VEC, bool LOWP>
+struct VecMath {
+    template <int N>
+    static VEC poly(VEC x, const float (&c)[N]) {
+        VEC p(c[0]);
+        for (int i = 1; i < N; ++i) {
+            p = VEC::fma(VEC(c[i]), p, x);
+        }
+        return p;
+    }
+    static VEC copySign(VEC r, VEC x) {
+        return VEC::selectLess(x, VEC(0.0f), -r, r);
+    }
+
+    /** exp(x): 2 ULP, lowp: 68 ULP. Out of [-87.3, 88.3] it gives 0 / inf */
+    static VEC exp(VEC x) {
+        static const float P[]   = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+                                    4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+        static const float PLow[] = {4.0917621438e-02f, 1.6753975791e-01f, 5.0008928645e-01f};
+        auto xc = VEC::max(VEC::min(x, VEC(88.3762626647949f)), VEC(-87.3365447504f));
+        auto n  = VEC::round(xc * 1.44269504088896341f);
+        // Cody-Waite, ln2 = 0.693359375 - 2.12194440e-4
+        auto r = VEC::fma(xc, n, VEC(-0.693359375f));
+        VEC::keep(r);
+        r = VEC::fma(r, n, VEC(2.12194440e-4f));
+        auto p = LOWP ? poly(r, PLow) : poly(r, P);
+        p = VEC::fma(r, r * r, p) + 1.0f;
+        // Don't distribute 2^n into the sum, which underflows near -87
+        VEC::keep(p);
+        auto y = VEC::ldexp(p, n);
+        y      = VEC::selectLess(x, VEC(-87.3365447504f), VEC(0.0f), y);
+        return VEC::selectLess(VEC(88.3762626647949f), x, VEC(std::numeric_limits<float>::infinity()), y);
+    }
+
+    // log(1 + m) for m in [sqrt(0.5) - 1, sqrt(2) - 1], adding e * ln2
+    static VEC logCore(VEC m, VEC e) {
+        static const float P[]    = {7.0376836292E-2f, -1.1514610310E-1f, 1.1676998740E-1f,
+                                     -1.2420140846E-1f, 1.4249322787E-1f, -1.6668057665E-1f,
+                                     2.0000714765E-1f, -2.4999993993E-1f, 3.3333331174E-1f};
+        static const float PLow[] = {-1.4776730845e-01f, 2.1891518286e-01f, -2.5235286953e-01f, 3.3275316618e-01f};
+        auto z = m * m;
+        auto y = (LOWP ? poly(m, PLow) : poly(m, P)) * z * m;
+        y      = VEC::fma(y, e, VEC(-2.12194440e-4f));
+        y      = VEC::fma(y, z, VEC(-0.5f));
+        return VEC::fma(m + y, e, VEC(0.693359375f));
+    }
+    // Split x = (1 + m) * 2^e with m in [sqrt(0.5) - 1, sqrt(2) - 1]
+    static VEC logReduce(VEC x, VEC& e) {
+        auto m = VEC::frexp(x, e);
+        e      = VEC::selectLess(m, VEC(0.707106781186547524f), e - 1.0f, e);
+        m      = VEC::selectLess(m, VEC(0.707106781186547524f), m + m, m);
+        return m - 1.0f;
+    }
+    // log of 0 / denormal is -inf, of negative is nan
+    static VEC logSpecial(VEC x, VEC y) {
+        auto special = VEC::selectLess(x, VEC(0.0f), VEC(std::numeric_limits<float>::quiet_NaN()),
+                                       VEC(-std::numeric_limits<float>::infinity()));
+        return VEC::selectLess(x, VEC(std::numeric_limits<float>::min()), special, y);
+    }
+
+    /** log(x): 2 ULP, lowp: 188 ULP */
+    static VEC log(VEC x) {
+        VEC e;
+        auto m = logReduce(x, e);
+        return logSpecial(x, logCore(m, e));
+    }
+
+    /** log(1 + x): 3 ULP, lowp: 188 ULP */
+    static VEC log1p(VEC x) {
+        auto u = x + 1.0f;
+        VEC e;
+        auto m = logReduce(u, e);
+        // Use x itself when 1 + x is in [sqrt(0.5), sqrt(2)), avoid the rounding of 1 + x
+        auto inRange = VEC::selectLess(x, VEC(-0.292893218813452f), VEC(0.0f),
+                                       VEC::selectLess(x, VEC(0.414213562373095f), VEC(1.0f), VEC(0.0f)));
+        m = VEC::selectLess(VEC(0.5f), inRange, x, m);
+        e = VEC::selectLess(VEC(0.5f), inRange, VEC(0.0f), e);
+        return logSpecial(u, logCore(m, e));
+    }
+
+    /** exp(x) - 1: 3 ULP, lowp: 134 ULP */
+    static VEC expm1(VEC x) {
+        static const float P[] = {2.48015873e-5f, 1.98412698e-4f, 1.38888889e-3f, 8.33333333e-3f,
+                                  4.16666667e-2f, 1.66666667e-1f, 5.0e-1f, 1.0f};
+        auto small = poly(x, P) * x;
+        auto big   = exp(x) - 1.0f;
+        return VEC::selectLess(VEC::abs(x), VEC(0.5f), small, big);
+    }
+
+    /** 1 / (1 + exp(-x)): 5 ULP, lowp: 85 ULP */
+    static VEC sigmoid(VEC x) {
+        return VEC(1.0f) / (exp(-x) + 1.0f);
+    }
+
+    /** tanh(x): 3 ULP, lowp: 30 ULP */
+    static VEC tanh(VEC x) {
+        static const float P[] = {-5.70498872745E-3f, 2.06390887954E-2f, -5.37397155531E-2f, 1.33314422036E-1f,
+                                  -3.33332819422E-1f};
+        auto a     = VEC::abs(x);
+        auto z     = x * x;
+        auto small = VEC::fma(x, poly(z, P) * z, x);
+        auto big   = VEC(1.0f) - VEC(2.0f) / (exp(a + a) + 1.0f);
+        return VEC::selectLess(a, VEC(0.625f), small, copySign(big, x));
+    }
+
+    /** sinh(x): 2 ULP, lowp: 76 ULP */
+    static VEC sinh(VEC x) {
+        static const float P[] = {2.03721912945E-4f, 8.33028376239E-3f, 1.66667160211E-1f};
+        auto a     = VEC::abs(x);
+        auto z     = x * x;
+        auto small = VEC::fma(x, poly(z, P) * z, x);
+        auto e     = exp(a);
+        auto big   = e * 0.5f - VEC(0.5f) / e;
+        return VEC::selectLess(a, VEC(1.0f), small, copySign(big, x));
+    }
+
+    /** cosh(x): 2 ULP, lowp: 68 ULP, inf from |x| > 88.3 */
+    static VEC cosh(VEC x) {
+        auto e = exp(VEC::abs(x));
+        return e * 0.5f + VEC(0.5f) / e;
+    }
+
+    // sin(x + offset * pi / 2)
+    static VEC sinCore(VEC x, float offset) {
+        static const float S[] = {-1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f};
+        static const float C[] = {2.443315711809948E-5f, -1.388731625493765E-3f, 4.166664568298827E-2f};
+        auto y = VEC::round(x * 0.636619772367581343f);
+        // Cody-Waite, pi / 2 = 1.5703125 + 4.837512969970703125e-4 + 7.54978995489188216e-8
+        auto r = VEC::fma(x, y, VEC(-1.5703125f));
+        VEC::keep(r);
+        r = VEC::fma(r, y, VEC(-4.837512969970703125e-4f));
+        VEC::keep(r);
+        r = VEC::fma(r, y, VEC(-7.54978995489188216e-8f));
+        auto z = r * r;
+        auto s = VEC::fma(r, poly(z, S) * z, r);
+        auto c = VEC::fma(VEC::fma(VEC(1.0f), z, VEC(-0.5f)), poly(z, C), z * z);
+        // Quadrant in [-2, 2]: 0 -> s, 1 -> c, 2 -> -s, -1 -> -c
+        auto q    = y + offset;
+        q         = q - VEC::round(q * 0.25f) * 4.0f;
+        auto odd  = VEC::abs(VEC::abs(q) - 1.0f);
+        auto res  = VEC::selectLess(odd, VEC(0.5f), c, s);
+        auto sign = VEC::selectLess(q, VEC(-0.5f), VEC(-1.0f), VEC::selectLess(VEC(1.5f), q, VEC(-1.0f), VEC(1.0f)));
+        return res * sign;
+    }
+
+    /** sin(x): 6 ULP for |x| < 10, absolute error 1e-7 for |x| < 8192 */
+    static VEC sin(VEC x) {
+        return sinCore(x, 0.0f);
+    }
+
+    /** cos(x): 6 ULP for |x| < 10, absolute error 1e-7 for |x| < 8192 */
+    static VEC cos(VEC x) {
+        return sinCore(x, 1.0f);
+    }
+
+    /** tan(x): 6 ULP for |x| < 10 */
+    static VEC tan(VEC x) {
+        static const float P[] = {9.38540185543E-3f, 3.11992232697E-3f, 2.44301354525E-2f,
+                                  5.34112807005E-2f, 1.33387994085E-1f, 3.33331568548E-1f};
+        auto y = VEC::round(x * 0.636619772367581343f);
+        auto r = VEC::fma(x, y, VEC(-1.5703125f));
+        VEC::keep(r);
+        r = VEC::fma(r, y, VEC(-4.837512969970703125e-4f));
+        VEC::keep(r);
+        r = VEC::fma(r, y, VEC(-7.54978995489188216e-8f));
+        auto z = r * r;
+        auto t = VEC::fma(r, poly(z, P) * z, r);
+        // Odd quadrant: -1 / t
+        auto q = VEC::abs(y - VEC::round(y * 0.5f) * 2.0f);
+        return VEC::selectLess(VEC(0.5f), q, VEC(-1.0f) / t, t);
+    }
+
+    /** atan(x): 4 ULP */
+    static VEC atan(VEC x) {
+        static const float P[] = {8.05374449538e-2f, -1.38776856032E-1f, 1.99777106478E-1f, -3.33329491539E-1f};
+        auto a  = VEC::abs(x);
+        // tan(3 * pi / 8) and tan(pi / 8)
+        auto t  = VEC::selectLess(VEC(0.414213562373095f), a, (a - 1.0f) / (a + 1.0f), a);
+        auto y0 = VEC::selectLess(VEC(0.414213562373095f), a, VEC(0.785398163397448309f), VEC(0.0f));
+        t       = VEC::selectLess(VEC(2.414213562373095f), a, VEC(-1.0f) / a, t);
+        y0      = VEC::selectLess(VEC(2.414213562373095f), a, VEC(1.57079632679489662f), y0);
+        auto z  = t * t;
+        auto r  = y0 + VEC::fma(t, poly(z, P) * z, t);
+        return copySign(r, x);
+    }
+
+    /** asinh(x): 6 ULP, lowp: 64 ULP */
+    static VEC asinh(VEC x) {
+        static const float P[] = {2.0122003309E-2f, -4.2699340972E-2f, 7.4847586088E-2f, -1.6666288134E-1f};
+        auto a     = VEC::abs(x);
+        auto z     = x * x;
+        auto small = VEC::fma(x, poly(z, P) * z, x);
+        // log(2a) for big a, avoid the overflow of a * a
+        auto big   = VEC::selectLess(VEC(1500.0f), a, a, a + VEC::sqrt(VEC::fma(VEC(1.0f), a, a)));
+        big        = log(big) + VEC::selectLess(VEC(1500.0f), a, VEC(0.693147180559945309f), VEC(0.0f));
+        return VEC::selectLess(a, VEC(0.5f), small, copySign(big, x));
+    }
+
+    /** acosh(x): 5 ULP, lowp: 64 ULP, nan for x < 1 */
+    static VEC acosh(VEC x) {
+        static const float P[] = {1.7596881071E-3f, -7.5272886713E-3f, 2.6454905019E-2f, -1.1784741703E-1f,
+                                  1.4142135263E0f};
+        auto z     = x - 1.0f;
+        auto small = poly(z, P) * VEC::sqrt(VEC::max(z, VEC(0.0f)));
+        auto big   = VEC::selectLess(VEC(1500.0f), x, x, x + VEC::sqrt(z * (x + 1.0f)));
+        big        = log(big) + VEC::selectLess(VEC(1500.0f), x, VEC(0.693147180559945309f), VEC(0.0f));
+        auto r     = VEC::selectLess(z, VEC(0.5f), small, big);
+        return VEC::selectLess(x, VEC(1.0f), VEC(std::numeric_limits<float>::quiet_NaN()), r);
+    }
+
+    /** atanh(x): 3 ULP, lowp: 35 ULP, +-inf for +-1 and nan out of it */
+    static VEC atanh(VEC x) {
+        static const float P[] = {1.81740078349E-1f, 8.24370301058E-2f, 1.46691431730E-1f, 1.99782164500E-1f,
+                                  3.33337300303E-1f};
+        auto a     = VEC::abs(x);
+        auto z     = x * x;
+        auto small = VEC::fma(x, poly(z, P) * z, x);
+        auto big   = log1p((a + a) / (VEC(1.0f) - a)) * 0.5f;
+        auto r     = VEC::selectLess(a, VEC(0.5f), small, copySign(big, x));
+        auto edge  = VEC::selectLess(VEC(1.0f), a, VEC(std::numeric_limits<float>::quiet_NaN()),
+                                     copySign(VEC(std::numeric_limits<float>::infinity()), x));
+        return VEC::selectLess(a, VEC(1.0f), r, edge);
+    }
+
+    /** erf(x): 9 ULP, rational approximation as Eigen, it is +-1 out of [-4, 4] */
+    static VEC erf(VEC x) {
+        static const float P[] = {-2.72614225801306e-10f, 2.77068142495902e-08f, -2.10102402082508e-06f,
+                                  -5.69250639462346e-05f, -7.34990630326855e-04f, -2.95459980854025e-03f,
+                                  -1.60960333262415e-02f};
+        static const float Q[] = {-1.45660718464996e-05f, -2.13374055278905e-04f, -1.68282697438203e-03f,
+                                  -7.37332916720468e-03f, -1.42647390514189e-02f};
+        auto xc = VEC::max(VEC::min(x, VEC(4.0f)), VEC(-4.0f));
+        auto z  = xc * xc;
+        return poly(z, P) * xc / poly(z, Q);
+    }
+};
+} // namespace Math
+} // namespace MNN
+
+#endif /* VecMath_hpp */
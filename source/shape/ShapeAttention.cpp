@@ -0,0 +1,59 @@
+//
+//  ShapeAttention.cpp
+//  MNN
+//
+//  Created by MNN on 2021/03/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "shape/SizeComputer.hpp"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+
+namespace MNN {
+class AttentionSizeComputer : public SizeComputer {
+    virtual bool onComputeSize(const MNN::Op *op, const std::vector<Tensor *> &inputs,
+                               const std::vector<Tensor *> &outputs) const override {
+        // query: [..., seqQ, dim], key: [..., seqK, dim], value: [..., seqK, dimV] -> [..., seqQ, dimV]
+        MNN_ASSERT(3 == inputs.size());
+        MNN_ASSERT(1 == outputs.size());
+        auto query = inputs[0];
+        auto key   = inputs[1];
+        auto value = inputs[2];
+        auto dims  = query->dimensions();
+        if (dims < 2 || key->dimensions() != dims || value->dimensions() != dims) {
+            return false;
+        }
+        for (int i = 0; i < dims - 2; ++i) {
+            if (key->length(i) != query->length(i) || value->length(i) != query->length(i)) {
+                return false;
+            }
+        }
+        if (key->length(dims - 1) != query->length(dims - 1) || key->length(dims - 2) != value->length(dims - 2)) {
+            return false;
+        }
+        auto &ob      = outputs[0]->buffer();
+        ob.dimensions = dims;
+        for (int i = 0; i < dims - 1; ++i) {
+            ob.dim[i].extent = query->length(i);
+        }
+        ob.dim[dims - 1].extent = value->length(dims - 1);
+        ob.type                 = query->getType();
+        TensorUtils::getDescribe(outputs[0])->dimensionFormat = TensorUtils::getDescribe(query)->dimensionFormat;
+        return true;
+    }
+
+    virtual float onComputeFlops(const MNN::Op *op, const std::vector<Tensor *> &inputs,
+                                 const std::vector<Tensor *> &outputs) const override {
+        auto dims = inputs[0]->dimensions();
+        float seqK = inputs[1]->length(dims - 2);
+        float dim  = inputs[0]->length(dims - 1);
+        float dimV = inputs[2]->length(dims - 1);
+        float rows = (float)inputs[0]->elementSize() / dim;
+        return rows * seqK * (dim + dimV) / FLOPS_M;
+    }
+};
+
+REGISTER_SHAPE(AttentionSizeComputer, OpType_Attention);
+
+} // namespace MNN
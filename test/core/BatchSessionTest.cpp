@@ -0,0 +1,110 @@
+//
+//  BatchSessionTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/26.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <thread>
+#include <MNN/BatchSession.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+class BatchSessionTest : public MNNTestCase {
+public:
+    virtual ~BatchSessionTest() = default;
+    static void fill(Tensor* tensor, int seed) {
+        auto ptr = tensor->host<float>();
+        for (int i = 0; i < tensor->elementSize(); ++i) {
+            ptr[i] = (float)((i * 7 + seed * 13) % 17) / 17.0f;
+        }
+    }
+    virtual bool run() {
+        auto x = _Input({1, 3, 8, 8}, NCHW);
+        x->setName("x");
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(0.05f, 0.1f, y, {3, 8}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y      = _Relu(_Convert(y, NCHW));
+        y->setName("y");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        ScheduleConfig config;
+        config.numThread = 1;
+
+        // Reference of each request with batch 1
+        const int threadNumber = 6;
+        const int loop         = 4;
+        std::vector<std::vector<float>> expects(threadNumber * loop);
+        auto reference = net->createSession(config);
+        auto input     = net->getSessionInput(reference, nullptr);
+        for (int i = 0; i < expects.size(); ++i) {
+            fill(input, i);
+            net->runSession(reference);
+            auto output = net->getSessionOutput(reference, nullptr);
+            expects[i].assign(output->host<float>(), output->host<float>() + output->elementSize());
+        }
+        net->releaseSession(reference);
+
+        BatchConfig batchConfig;
+        batchConfig.maxBatch = 4;
+        batchConfig.timeout  = 20000;
+        std::unique_ptr<BatchSession> batchSession(BatchSession::create(net.get(), config, batchConfig));
+        std::vector<bool> results(threadNumber, true);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadNumber; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int l = 0; l < loop; ++l) {
+                    int index = t * loop + l;
+                    std::unique_ptr<Tensor> tensor(Tensor::create<float>({1, 3, 8, 8}, nullptr, Tensor::CAFFE));
+                    fill(tensor.get(), index);
+                    std::map<std::string, std::shared_ptr<Tensor>> outputs;
+                    if (NO_ERROR != batchSession->run({{"x", tensor.get()}}, outputs) ||
+                        outputs["y"]->elementSize() != expects[index].size()) {
+                        results[t] = false;
+                        return;
+                    }
+                    auto ptr = outputs["y"]->host<float>();
+                    for (int i = 0; i < expects[index].size(); ++i) {
+                        if (fabsf(ptr[i] - expects[index][i]) > 1e-5f) {
+                            MNN_ERROR("Batch result error for request %d: %f - %f\n", index, ptr[i],
+                                      expects[index][i]);
+                            results[t] = false;
+                            return;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (auto r : results) {
+            if (!r) {
+                return false;
+            }
+        }
+        auto statistics = batchSession->getStatistics();
+        if (statistics.requests != threadNumber * loop || statistics.batches != threadNumber * loop) {
+            MNN_ERROR("Batch statistics error: %d requests, %d batches\n", (int)statistics.requests,
+                      (int)statistics.batches);
+            return false;
+        }
+        // Concurrent requests should be merged
+        if (statistics.runs >= statistics.requests) {
+            MNN_ERROR("Requests are not batched: %d runs for %d requests\n", (int)statistics.runs,
+                      (int)statistics.requests);
+            return false;
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(BatchSessionTest, "core/batch_session");
@@ -0,0 +1,78 @@
+//
+//  BindCoreTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/05/07.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#if defined(MNN_USE_THREAD_POOL) && defined(__linux__)
+#include <sched.h>
+#include <MNN/MNNDefine.h>
+#include "MNNTestSuite.h"
+#include "backend/cpu/CPUBackend.hpp"
+#include "core/RuntimeFactory.hpp"
+
+using namespace MNN;
+
+// A runtime binding cores uses its own pool, and binds the executing thread only while it executes
+class BindCoreTest : public MNNTestCase {
+public:
+    virtual ~BindCoreTest() = default;
+    static bool getAffinity(cpu_set_t& set) {
+        CPU_ZERO(&set);
+        return 0 == sched_getaffinity(0, sizeof(set), &set);
+    }
+    virtual bool run() {
+        cpu_set_t origin, bound, restored;
+        if (!getAffinity(origin)) {
+            return true;
+        }
+        BackendConfig config;
+        config.flags = MNN_CPU_BIND_CORE;
+        Backend::Info info;
+        info.type      = MNN_FORWARD_CPU;
+        info.numThread = 2;
+        info.user      = &config;
+        auto creator   = MNNGetExtraRuntimeCreator(MNN_FORWARD_CPU);
+        std::shared_ptr<Runtime> runtime(creator->onCreate(info));
+        std::shared_ptr<Backend> backend(runtime->onCreate());
+        auto cpuBackend = static_cast<CPUBackend*>(backend.get());
+        if (nullptr == cpuBackend->threadPool()) {
+            // No cpu topology to bind on this platform
+            return true;
+        }
+        config.flags = 0;
+        // Given cpus, see ScheduleConfig::cpuIds
+        info.cpuIds = {0};
+        std::shared_ptr<Runtime> givenRuntime(creator->onCreate(info));
+        std::shared_ptr<Backend> givenBackend(givenRuntime->onCreate());
+        if (nullptr == static_cast<CPUBackend*>(givenBackend.get())->threadPool()) {
+            MNN_ERROR("Runtime with given cpus should use its own thread pool\n");
+            return false;
+        }
+        info.cpuIds.clear();
+        std::shared_ptr<Runtime> sharedRuntime(creator->onCreate(info));
+        std::shared_ptr<Backend> sharedBackend(sharedRuntime->onCreate());
+        if (nullptr != static_cast<CPUBackend*>(sharedBackend.get())->threadPool()) {
+            MNN_ERROR("Runtime without binding should use the process-wide thread pool\n");
+            return false;
+        }
+
+        backend->onExecuteBegin();
+        getAffinity(bound);
+        backend->onExecuteEnd();
+        getAffinity(restored);
+        if (CPU_COUNT(&bound) != 1) {
+            MNN_ERROR("Executing thread should be bound to one cpu, but %d\n", CPU_COUNT(&bound));
+            return false;
+        }
+        if (!CPU_EQUAL(&restored, &origin)) {
+            MNN_ERROR("Affinity of the executing thread is not restored\n");
+            return false;
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(BindCoreTest, "core/bind_core");
+#endif
@@ -9,6 +9,7 @@
 #include "MNNTestSuite.h"
 #include "core/BufferAllocator.hpp"
 #include "core/MNNMemoryUtils.h"
+#include <string.h>
 
 using namespace MNN;
 
@@ -56,3 +57,200 @@ public:
     }
 };
 MNNTestSuiteRegister(BufferAllocatorTest, "core/buffer_allocator");
+
+class BufferAllocatorSizeClassTest : public MNNTestCase {
+public:
+    virtual ~BufferAllocatorSizeClassTest() = default;
+    virtual bool run() {
+        auto alignment = MNN_MEMORY_ALIGN_DEFAULT;
+        BufferAllocator allocator(BufferAllocator::Allocator::createSizeClass(BufferAllocator::Allocator::createDefault()));
+
+        // same class reuse, freed memory is reused first
+        auto p1 = allocator.alloc(100);
+        MNNTEST_ASSERT(nullptr != p1.first);
+        MNNTEST_ASSERT(((size_t)p1.first + p1.second) % alignment == 0);
+        auto total = allocator.totalSize();
+        MNNTEST_ASSERT(total >= 100);
+        allocator.free(p1);
+        auto p2 = allocator.alloc(90);
+        MNNTEST_ASSERT(p1 == p2);
+        MNNTEST_ASSERT(allocator.totalSize() == total);
+
+        // separate memory never reuses released memory
+        allocator.free(p2);
+        auto p3 = allocator.alloc(100, true);
+        MNNTEST_ASSERT(p3 != p1);
+
+        // live blocks don't overlap, include big ones with own arena
+        std::vector<std::pair<void*, int>> blocks;
+        std::vector<int> sizes = {1, 64, 65, 1000, 4096, 5000, 100000, 1 << 20, 3 << 20};
+        for (auto size : sizes) {
+            auto p = allocator.alloc(size);
+            MNNTEST_ASSERT(nullptr != p.first);
+            MNNTEST_ASSERT(((size_t)p.first + p.second) % alignment == 0);
+            ::memset((uint8_t*)p.first + p.second, 0, size);
+            blocks.emplace_back(p);
+        }
+        for (int i = 0; i < blocks.size(); ++i) {
+            auto si = (uint8_t*)blocks[i].first + blocks[i].second;
+            for (int j = i + 1; j < blocks.size(); ++j) {
+                auto sj = (uint8_t*)blocks[j].first + blocks[j].second;
+                MNNTEST_ASSERT(si + sizes[i] <= sj || sj + sizes[j] <= si);
+            }
+        }
+
+        // memory freed in a group is not visible to other groups before barrierEnd
+        allocator.barrierBegin();
+        allocator.beginGroup();
+        auto g1 = allocator.alloc(5000);
+        allocator.free(g1);
+        allocator.endGroup();
+        allocator.beginGroup();
+        auto g2 = allocator.alloc(5000);
+        MNNTEST_ASSERT(g1 != g2);
+        allocator.endGroup();
+        allocator.barrierEnd();
+        auto g3 = allocator.alloc(5000);
+        MNNTEST_ASSERT(g3 == g1);
+
+        // release unused arenas, then everything
+        for (auto& p : blocks) {
+            allocator.free(p);
+        }
+        auto before = allocator.totalSize();
+        allocator.release(false);
+        MNNTEST_ASSERT(allocator.totalSize() < before);
+        allocator.release();
+        MNNTEST_ASSERT(allocator.totalSize() == 0);
+        return true;
+    }
+};
+MNNTestSuiteRegister(BufferAllocatorSizeClassTest, "core/buffer_allocator_size_class");
+
+class BufferAllocatorPlanTest : public MNNTestCase {
+public:
+    virtual ~BufferAllocatorPlanTest() = default;
+    virtual bool run() {
+        BufferAllocator allocator(BufferAllocator::Allocator::createDefault());
+        std::vector<std::pair<std::pair<void*, int>, int>> live;
+        bool overlap = false;
+        auto alloc = [&](int size, bool seperate) {
+            auto p = allocator.alloc(size, seperate);
+            auto dst = (uint8_t*)p.first + p.second;
+            for (auto& l : live) {
+                auto src = (uint8_t*)l.first.first + l.first.second;
+                if (!(dst + size <= src || src + l.second <= dst)) {
+                    overlap = true;
+                }
+            }
+            ::memset(dst, 0, size);
+            live.emplace_back(std::make_pair(p, size));
+            return p;
+        };
+        // Memory freed in group is still in use until barrierEnd
+        auto retire = [&](std::pair<void*, int> p) {
+            for (auto iter = live.begin(); iter != live.end(); ++iter) {
+                if (iter->first == p) {
+                    live.erase(iter);
+                    break;
+                }
+            }
+        };
+        auto free = [&](std::pair<void*, int> p, bool inGroup) {
+            allocator.free(p);
+            if (!inGroup) {
+                retire(p);
+            }
+        };
+        auto pass = [&](int first, bool scratch) {
+            live.clear();
+            auto a = alloc(first, false);
+            auto b = alloc(2000, false);
+            if (scratch) {
+                // Not recorded, the replay doesn't allocate it
+                allocator.pausePlan();
+                free(alloc(1500, false), false);
+                allocator.resumePlan();
+            }
+            free(a, false);
+            auto c = alloc(3000, false);
+            free(b, false);
+            auto d = alloc(2500, false);
+            alloc(500, true);
+            allocator.barrierBegin();
+            allocator.beginGroup();
+            auto t1 = alloc(800, false);
+            free(t1, true);
+            allocator.endGroup();
+            allocator.beginGroup();
+            auto t2 = alloc(800, false);
+            free(t2, true);
+            allocator.endGroup();
+            allocator.barrierEnd();
+            retire(t1);
+            retire(t2);
+            free(c, false);
+            alloc(5000, false);
+            free(d, false);
+        };
+
+        // record with free list, then replay from one arena
+        allocator.beginRecord();
+        pass(1000, true);
+        auto current = allocator.totalSize();
+        auto planned = allocator.endRecord();
+        MNNTEST_ASSERT(!overlap);
+        MNNTEST_ASSERT(planned > 0 && planned < current);
+        allocator.release();
+        MNNTEST_ASSERT(allocator.beginReplay());
+        pass(1000, false);
+        MNNTEST_ASSERT(allocator.endReplay());
+        MNNTEST_ASSERT(!overlap);
+        MNNTEST_ASSERT(allocator.totalSize() == planned);
+
+        // a different pass falls back to free list
+        allocator.release();
+        MNNTEST_ASSERT(allocator.totalSize() == 0);
+        MNNTEST_ASSERT(allocator.beginReplay());
+        pass(4000, false);
+        MNNTEST_ASSERT(!allocator.endReplay());
+        MNNTEST_ASSERT(!overlap);
+        allocator.release();
+        MNNTEST_ASSERT(allocator.totalSize() == 0);
+        return true;
+    }
+};
+MNNTestSuiteRegister(BufferAllocatorPlanTest, "core/buffer_allocator_plan");
+
+class BufferAllocatorNumaTest : public MNNTestCase {
+public:
+    virtual ~BufferAllocatorNumaTest() = default;
+    virtual bool run() {
+        // Node 0 exists on any machine, the memory works the same where the policy is not supported
+        auto numa = BufferAllocator::Allocator::createNuma(0);
+        std::vector<int> sizes = {5, 4095, 4096, 100000, (1 << 20) + 3};
+        for (int loop = 0; loop < 2; ++loop) {
+            std::vector<std::pair<void*, int>> chunks;
+            for (auto size : sizes) {
+                auto p = numa->onAlloc(size);
+                MNNTEST_ASSERT(nullptr != p.first && 0 == p.second);
+                MNNTEST_ASSERT((size_t)p.first % MNN_MEMORY_ALIGN_DEFAULT == 0);
+                ::memset(p.first, loop + 1, size);
+                chunks.emplace_back(p);
+            }
+            for (int i = 0; i < chunks.size(); ++i) {
+                auto ptr = (uint8_t*)chunks[i].first;
+                MNNTEST_ASSERT(ptr[0] == loop + 1 && ptr[sizes[i] - 1] == loop + 1);
+                numa->onRelease(chunks[i]);
+            }
+        }
+        BufferAllocator allocator(numa);
+        auto p = allocator.alloc(1 << 20);
+        MNNTEST_ASSERT(nullptr != p.first);
+        allocator.free(p);
+        allocator.release();
+        MNNTEST_ASSERT(allocator.totalSize() == 0);
+        return true;
+    }
+};
+MNNTestSuiteRegister(BufferAllocatorNumaTest, "core/buffer_allocator_numa");
@@ -0,0 +1,115 @@
+//
+//  CloneSessionTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <thread>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+class CloneSessionTest : public MNNTestCase {
+public:
+    virtual ~CloneSessionTest() = default;
+    static void fill(Tensor* tensor, int seed) {
+        auto ptr = tensor->host<float>();
+        for (int i = 0; i < tensor->elementSize(); ++i) {
+            ptr[i] = (float)((i * 7 + seed * 13) % 17) / 17.0f - 0.5f;
+        }
+    }
+    virtual bool run() {
+        // Weights are much larger than activations, so the memory of a clone shows whether they are shared
+        const int channel = 96;
+        auto x = _Input({1, channel, 6, 6}, NCHW);
+        x->setName("x");
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(0.01f, 0.1f, y, {channel, channel}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y      = _Relu(y);
+        y      = _Conv(0.02f, 0.0f, y, {channel, channel}, {1, 1}, VALID, {1, 1}, {1, 1}, 1);
+        y      = _Convert(y, NCHW);
+        y->setName("y");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        ScheduleConfig config;
+        config.numThread = 1;
+        auto session     = net->createSession(config);
+
+        const int threadNumber = 4;
+        const int loop         = 3;
+        std::vector<std::vector<float>> expects(threadNumber * loop);
+        auto input = net->getSessionInput(session, nullptr);
+        for (int i = 0; i < expects.size(); ++i) {
+            fill(input, i);
+            net->runSession(session);
+            auto output = net->getSessionOutput(session, nullptr);
+            expects[i].assign(output->host<float>(), output->host<float>() + output->elementSize());
+        }
+
+        float originMemory = 0.0f;
+        net->getSessionInfo(session, Interpreter::MEMORY, &originMemory);
+        std::vector<Session*> clones(threadNumber);
+        for (int t = 0; t < threadNumber; ++t) {
+            // Clone of a clone shares the same weights
+            clones[t] = net->cloneSession(t == 0 ? session : clones[t - 1]);
+            if (nullptr == clones[t]) {
+                MNN_ERROR("Clone session failed\n");
+                return false;
+            }
+            float memory = 0.0f;
+            net->getSessionInfo(clones[t], Interpreter::MEMORY, &memory);
+            auto weightMemory = (channel * channel * 10) * sizeof(float) / 1024.0f / 1024.0f;
+            if (memory > originMemory - weightMemory) {
+                MNN_ERROR("Weights are not shared by clone: %f MB, origin %f MB\n", memory, originMemory);
+                return false;
+            }
+        }
+        // The clones are still valid without the origin session
+        net->releaseSession(session);
+
+        std::vector<bool> results(threadNumber, true);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadNumber; ++t) {
+            threads.emplace_back([&, t]() {
+                auto current = clones[t];
+                auto input   = net->getSessionInput(current, nullptr);
+                for (int l = 0; l < loop; ++l) {
+                    int index = t * loop + l;
+                    fill(input, index);
+                    if (NO_ERROR != net->runSession(current)) {
+                        results[t] = false;
+                        return;
+                    }
+                    auto ptr = net->getSessionOutput(current, nullptr)->host<float>();
+                    for (int i = 0; i < expects[index].size(); ++i) {
+                        if (fabsf(ptr[i] - expects[index][i]) > 1e-4f) {
+                            MNN_ERROR("Clone result error for %d: %f - %f\n", index, ptr[i], expects[index][i]);
+                            results[t] = false;
+                            return;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (auto r : results) {
+            if (!r) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(CloneSessionTest, "core/clone_session");
@@ -0,0 +1,84 @@
+//
+//  MappedModelTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/05/07.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+// A mapped model runs the same as a read one, and can still be updated from a session
+class MappedModelTest : public MNNTestCase {
+public:
+    virtual ~MappedModelTest() = default;
+    static std::vector<float> infer(Interpreter* net) {
+        ScheduleConfig config;
+        config.numThread = 1;
+        auto session     = net->createSession(config);
+        auto input       = net->getSessionInput(session, nullptr);
+        for (int i = 0; i < input->elementSize(); ++i) {
+            input->host<float>()[i] = (float)(i % 7) / 7.0f;
+        }
+        net->runSession(session);
+        auto output = net->getSessionOutput(session, nullptr);
+        std::vector<float> result(output->host<float>(), output->host<float>() + output->elementSize());
+        if (NO_ERROR != net->updateSessionToModel(session)) {
+            result.clear();
+        }
+        net->releaseSession(session);
+        return result;
+    }
+    virtual bool run() {
+        auto x = _Input({1, 8, 4, 4}, NCHW);
+        x->setName("x");
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(0.01f, 0.1f, y, {8, 8}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y      = _Convert(y, NCHW);
+        y      = y + _Const(0.5f);
+        y->setName("y");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        const char* file = "mapped_model_test.mnn";
+        FILE* f          = fopen(file, "wb");
+        if (nullptr == f) {
+            MNN_ERROR("Can't write %s\n", file);
+            return false;
+        }
+        fwrite(builder.GetBufferPointer(), 1, builder.GetSize(), f);
+        fclose(f);
+
+        std::shared_ptr<Interpreter> readNet(Interpreter::createFromFile(file));
+        std::shared_ptr<Interpreter> mappedNet(Interpreter::createFromMappedFile(file));
+        if (nullptr == readNet || nullptr == mappedNet) {
+            remove(file);
+            return false;
+        }
+        auto expect = infer(readNet.get());
+        auto result = infer(mappedNet.get());
+        mappedNet.reset();
+        remove(file);
+        if (expect.empty() || result.size() != expect.size()) {
+            MNN_ERROR("Mapped model run or update failed\n");
+            return false;
+        }
+        for (int i = 0; i < expect.size(); ++i) {
+            if (fabsf(result[i] - expect[i]) > 1e-5f) {
+                MNN_ERROR("Mapped model result error at %d: %f - %f\n", i, result[i], expect[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(MappedModelTest, "core/mapped_model");
@@ -10,6 +10,9 @@
 #include "MNN_generated.h"
 #include <MNN/Tensor.hpp>
 #include "core/TensorUtils.hpp"
+#include "core/Backend.hpp"
+#include "core/Execution.hpp"
+#include "geometry/GeometryComputerUtils.hpp"
 
 using namespace MNN;
 class RegionFuseTest : public MNNTestCase {
@@ -83,3 +86,113 @@ public:
     }
 };
 MNNTestSuiteRegister(RegionFuseTest, "core/regionfuse");
+
+// concat + transpose in two rasters is fused into one raster reading the inputs of concat
+class RasterFuseTest : public MNNTestCase {
+public:
+    using Region = Tensor::InsideDescribe::Region;
+    virtual ~RasterFuseTest() = default;
+    virtual bool run() {
+        const int batch = 2, height = 48, width = 64;
+        Backend::Info compute;
+        compute.type      = MNN_FORWARD_CPU;
+        compute.numThread = 4;
+        std::unique_ptr<Runtime> runtime(MNNGetExtraRuntimeCreator(compute.type)->onCreate(compute));
+        std::unique_ptr<Backend> backend(runtime->onCreate());
+        std::unique_ptr<OpT> opt(new OpT);
+        opt->type = OpType_Raster;
+        flatbuffers::FlatBufferBuilder builder;
+        builder.Finish(Op::Pack(builder, opt.get()));
+        auto op = flatbuffers::GetRoot<Op>(builder.GetBufferPointer());
+
+        auto makeTensor = [](std::vector<int> shape) {
+            std::shared_ptr<Tensor> t(Tensor::createDevice<float>(shape, Tensor::CAFFE));
+            return t;
+        };
+        // A, B: [batch, height, width], M = concat(A, B) at axis 0, O = transpose(M, (1, 0, 2))
+        auto a = makeTensor({batch, height, width});
+        auto b = makeTensor({batch, height, width});
+        auto m = makeTensor({2 * batch, height, width});
+        auto o = makeTensor({height, 2 * batch, width});
+        auto mInput = makeTensor({2 * batch, height, width});
+        auto oInput = makeTensor({height, 2 * batch, width});
+        for (auto t : {a, b, o}) {
+            backend->onAcquireBuffer(t.get(), Backend::STATIC);
+            TensorUtils::getDescribe(t.get())->backend = backend.get();
+        }
+        TensorUtils::getDescribe(o.get())->usage = Tensor::InsideDescribe::OUTPUT;
+        auto size = batch * height * width;
+        for (int i = 0; i < size; ++i) {
+            a->host<float>()[i] = (float)i;
+            b->host<float>()[i] = (float)(-i);
+        }
+        auto mDes        = TensorUtils::getDescribe(mInput.get());
+        mDes->memoryType = Tensor::InsideDescribe::MEMORY_VIRTUAL;
+        for (int i = 0; i < 2; ++i) {
+            Region region;
+            region.origin     = i == 0 ? a.get() : b.get();
+            region.size[2]    = size;
+            region.dst.offset = i * size;
+            mDes->regions.emplace_back(region);
+        }
+        auto oDes        = TensorUtils::getDescribe(oInput.get());
+        oDes->memoryType = Tensor::InsideDescribe::MEMORY_VIRTUAL;
+        Region region;
+        region.origin        = m.get();
+        region.size[0]       = height;
+        region.size[1]       = 2 * batch;
+        region.size[2]       = width;
+        region.src.stride[0] = width;
+        region.src.stride[1] = height * width;
+        region.src.stride[2] = 1;
+        region.dst.stride[0] = 2 * batch * width;
+        region.dst.stride[1] = width;
+        region.dst.stride[2] = 1;
+        oDes->regions.emplace_back(region);
+
+        CommandBuffer cmdBuffer;
+        Command concat;
+        concat.op      = op;
+        concat.inputs  = {mInput.get()};
+        concat.outputs = {m.get()};
+        cmdBuffer.command.emplace_back(concat);
+        Command transpose;
+        transpose.op      = op;
+        transpose.inputs  = {oInput.get()};
+        transpose.outputs = {o.get()};
+        cmdBuffer.command.emplace_back(transpose);
+        GeometryComputerUtils::fuseRaster(cmdBuffer);
+        if (1 != cmdBuffer.command.size() || 2 != oDes->regions.size()) {
+            MNN_ERROR("rasterfuse: concat is not fused\n");
+            return false;
+        }
+        for (auto& r : oDes->regions) {
+            if (r.origin != a.get() && r.origin != b.get()) {
+                MNN_ERROR("rasterfuse: fused region doesn't read inputs\n");
+                return false;
+            }
+        }
+        std::unique_ptr<Execution> exe(backend->onCreate(cmdBuffer.command[0].inputs, cmdBuffer.command[0].outputs, op));
+        backend->onResizeBegin();
+        exe->onResize(cmdBuffer.command[0].inputs, cmdBuffer.command[0].outputs);
+        backend->onResizeEnd();
+        backend->onExecuteBegin();
+        exe->onExecute(cmdBuffer.command[0].inputs, cmdBuffer.command[0].outputs);
+        backend->onExecuteEnd();
+        for (int y = 0; y < height; ++y) {
+            for (int z = 0; z < 2 * batch; ++z) {
+                for (int x = 0; x < width; ++x) {
+                    auto index    = (z % batch) * height * width + y * width + x;
+                    float expect  = z < batch ? (float)index : (float)(-index);
+                    auto computed = o->host<float>()[(y * 2 * batch + z) * width + x];
+                    if (computed != expect) {
+                        MNN_ERROR("rasterfuse: %d, %d, %d: %f != %f\n", y, z, x, computed, expect);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(RasterFuseTest, "core/rasterfuse");
@@ -0,0 +1,84 @@
+//
+//  ShapeCacheTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/03/02.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+class ShapeCacheTest : public MNNTestCase {
+public:
+    virtual ~ShapeCacheTest() = default;
+    static bool runShape(Interpreter* net, Session* session, int size, const float** result) {
+        auto input = net->getSessionInput(session, nullptr);
+        net->resizeTensor(input, {1, 3, size, size});
+        net->resizeSession(session);
+        auto ptr = input->host<float>();
+        for (int i = 0; i < input->elementSize(); ++i) {
+            ptr[i] = (float)((i * 7 + size) % 17) / 17.0f;
+        }
+        if (NO_ERROR != net->runSession(session)) {
+            return false;
+        }
+        *result = net->getSessionOutput(session, nullptr)->host<float>();
+        return true;
+    }
+    virtual bool run() {
+        auto x = _Input({1, 3, 8, 8}, NCHW);
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(0.05f, 0.1f, y, {3, 8}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y      = _Relu(_Convert(y, NCHW));
+        y      = _Transpose(y, {0, 2, 3, 1});
+        y      = _Concat({y, y * y}, -1);
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        ScheduleConfig config;
+        auto reference = net->createSession(config);
+        auto session   = net->createSession(config);
+        const std::vector<int> sizes = {8, 16, 8, 12, 16, 8, 24, 12};
+        for (auto limit : {100.0f, 0.001f}) {
+            net->setSessionShapeCache(session, limit);
+            std::map<int, const float*> outputs;
+            const float* unused = nullptr;
+            // The state prepared before enabling the cache is not kept
+            if (!runShape(net.get(), session, 4, &unused)) {
+                return false;
+            }
+            for (auto size : sizes) {
+                const float* expect = nullptr;
+                const float* result = nullptr;
+                if (!runShape(net.get(), reference, size, &expect) || !runShape(net.get(), session, size, &result)) {
+                    MNN_ERROR("Run session error for size %d\n", size);
+                    return false;
+                }
+                int count = net->getSessionOutput(session, nullptr)->elementSize();
+                for (int i = 0; i < count; ++i) {
+                    if (fabsf(expect[i] - result[i]) > 1e-5f) {
+                        MNN_ERROR("Shape cache result error for size %d: %f - %f\n", size, expect[i], result[i]);
+                        return false;
+                    }
+                }
+                // A kept state is swapped in with its memory
+                if (limit > 1.0f && outputs.find(size) != outputs.end() && outputs[size] != result) {
+                    MNN_ERROR("Shape cache doesn't reuse the state for size %d\n", size);
+                    return false;
+                }
+                outputs[size] = result;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ShapeCacheTest, "core/shape_cache");
@@ -0,0 +1,112 @@
+//
+//  SharedResourceTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+// Sessions of a model created on the same runtime share the packed weights of the executions
+class SharedResourceTest : public MNNTestCase {
+public:
+    virtual ~SharedResourceTest() = default;
+    static void fill(Tensor* tensor, int seed) {
+        auto ptr = tensor->host<float>();
+        for (int i = 0; i < tensor->elementSize(); ++i) {
+            ptr[i] = (float)((i * 7 + seed * 13) % 17) / 17.0f - 0.5f;
+        }
+    }
+    static bool compare(Interpreter* net, Session* session, const std::vector<float>& expect) {
+        auto ptr = net->getSessionOutput(session, nullptr)->host<float>();
+        for (int i = 0; i < expect.size(); ++i) {
+            if (fabsf(ptr[i] - expect[i]) > 1e-4f) {
+                MNN_ERROR("Shared resource result error at %d: %f - %f\n", i, ptr[i], expect[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+    static Interpreter* createNet(int channel, float weight) {
+        auto x = _Input({1, channel, 6, 6}, NCHW);
+        x->setName("x");
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(weight, 0.1f, y, {channel, channel}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y      = _Relu(y);
+        y      = _Conv(weight * 2.0f, 0.0f, y, {channel, channel}, {1, 1}, VALID, {1, 1}, {1, 1}, 1);
+        y      = _Conv(weight * 3.0f, 0.0f, y, {channel, channel}, {3, 3}, SAME, {1, 1}, {1, 1}, channel);
+        y      = _Convert(y, NCHW);
+        y->setName("y");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        return Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize());
+    }
+    virtual bool run() {
+        const int channel = 96;
+        std::shared_ptr<Interpreter> net(createNet(channel, 0.01f));
+        ScheduleConfig config;
+        config.numThread = 1;
+        auto runtime     = Interpreter::createRuntime({config});
+
+        auto first = net->createSession(config, runtime);
+        fill(net->getSessionInput(first, nullptr), 0);
+        net->runSession(first);
+        auto output = net->getSessionOutput(first, nullptr);
+        std::vector<float> expect(output->host<float>(), output->host<float>() + output->elementSize());
+        float firstMemory = 0.0f;
+        net->getSessionInfo(first, Interpreter::MEMORY, &firstMemory);
+
+        auto second = net->createSession(config, runtime);
+        float totalMemory = 0.0f;
+        net->getSessionInfo(second, Interpreter::MEMORY, &totalMemory);
+        auto weightMemory = (channel * channel * 10) * sizeof(float) / 1024.0f / 1024.0f;
+        if (totalMemory - firstMemory > firstMemory - weightMemory) {
+            MNN_ERROR("Weights are not shared: %f MB for two sessions, %f MB for one\n", totalMemory, firstMemory);
+            return false;
+        }
+        // The shared weights are kept until the last session using them is released
+        net->releaseSession(first);
+        fill(net->getSessionInput(second, nullptr), 0);
+        net->runSession(second);
+        if (!compare(net.get(), second, expect)) {
+            return false;
+        }
+        net->releaseSession(second);
+        auto third = net->createSession(config, runtime);
+        fill(net->getSessionInput(third, nullptr), 0);
+        net->runSession(third);
+        if (!compare(net.get(), third, expect)) {
+            return false;
+        }
+
+        // Another model of the same shapes on the runtime uses its own weights, also after the first is released
+        for (int i = 0; i < 2; ++i) {
+            std::shared_ptr<Interpreter> otherNet(createNet(channel, 0.02f));
+            auto reference = otherNet->createSession(config);
+            fill(otherNet->getSessionInput(reference, nullptr), 0);
+            otherNet->runSession(reference);
+            output = otherNet->getSessionOutput(reference, nullptr);
+            std::vector<float> otherExpect(output->host<float>(), output->host<float>() + output->elementSize());
+            auto other = otherNet->createSession(config, runtime);
+            fill(otherNet->getSessionInput(other, nullptr), 0);
+            otherNet->runSession(other);
+            if (!compare(otherNet.get(), other, otherExpect)) {
+                return false;
+            }
+            net->releaseModel();
+        }
+        net->releaseSession(third);
+        return true;
+    }
+};
+MNNTestSuiteRegister(SharedResourceTest, "core/shared_resource");
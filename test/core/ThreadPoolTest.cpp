@@ -8,6 +8,7 @@
 
 #ifdef MNN_USE_THREAD_POOL
 #include <MNN/MNNDefine.h>
+#include <chrono>
 #include "MNNTestSuite.h"
 #include "backend/cpu/ThreadPool.hpp"
 
@@ -43,4 +44,88 @@ public:
 };
 
 MNNTestSuiteRegister(ThreadPoolTest, "core/threadpool");
+
+class ThreadPoolWorkStealingTest : public MNNTestCase {
+public:
+    virtual ~ThreadPoolWorkStealingTest() = default;
+    virtual bool run() {
+        MNN::ThreadPool::init(4);
+        auto workIndex = ThreadPool::acquireWorkIndex();
+        bool res = true;
+        for (int size : {2, 4, 7, 100, 1023}) {
+            std::vector<std::atomic_int> counts(size);
+            for (auto& c : counts) {
+                c = 0;
+            }
+            auto func = [&counts](int index) {
+                // Imbalanced work so that idle workers have to steal
+                if (index % 7 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                counts[index]++;
+            };
+            ThreadPool::enqueue(std::make_pair(std::move(func), size), workIndex, ThreadPool::WORK_STEALING);
+            for (int i = 0; i < size; ++i) {
+                if (counts[i] != 1) {
+                    MNN_ERROR("Work stealing run index %d for %d times, size = %d\n", i, (int)counts[i], size);
+                    res = false;
+                }
+            }
+        }
+        ThreadPool::releaseWorkIndex(workIndex);
+        MNN::ThreadPool::destroy();
+        return res;
+    }
+};
+
+MNNTestSuiteRegister(ThreadPoolWorkStealingTest, "core/threadpool_work_stealing");
+
+class ThreadPoolIndependentTest : public MNNTestCase {
+public:
+    virtual ~ThreadPoolIndependentTest() = default;
+    virtual bool run() {
+        // More tenants than MNN_THREAD_POOL_MAX_TASKS, each with its own pool
+        std::vector<std::shared_ptr<ThreadPool>> pools;
+        for (int i = 0; i < 4; ++i) {
+            pools.emplace_back(ThreadPool::create(3));
+        }
+        std::atomic_int errors(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < pools.size(); ++i) {
+            auto pool = pools[i].get();
+            threads.emplace_back([pool, i, &errors]() {
+                auto workIndex = ThreadPool::acquireWorkIndex(pool);
+                if (workIndex < 0) {
+                    errors++;
+                    return;
+                }
+                auto mode = i % 2 == 0 ? ThreadPool::STATIC : ThreadPool::WORK_STEALING;
+                ThreadPool::active(pool);
+                for (int loop = 0; loop < 10; ++loop) {
+                    std::vector<std::atomic_int> counts(17);
+                    for (auto& c : counts) {
+                        c = 0;
+                    }
+                    auto func = [&counts](int index) {
+                        counts[index]++;
+                    };
+                    ThreadPool::enqueue(std::make_pair(std::move(func), 17), workIndex, mode, pool);
+                    for (auto& c : counts) {
+                        if (c != 1) {
+                            errors++;
+                        }
+                    }
+                }
+                ThreadPool::deactive(pool);
+                ThreadPool::releaseWorkIndex(workIndex, pool);
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return errors == 0;
+    }
+};
+
+MNNTestSuiteRegister(ThreadPoolIndependentTest, "core/threadpool_independent");
 #endif
@@ -0,0 +1,100 @@
+//
+//  TraceTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/05/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+#include "core/TraceRecorder.hpp"
+using namespace MNN;
+using namespace MNN::Express;
+
+static std::string _dumpTrace(const char* file) {
+    if (!Interpreter::dumpTrace(file)) {
+        return "";
+    }
+    std::ifstream input(file);
+    std::stringstream content;
+    content << input.rdbuf();
+    input.close();
+    remove(file);
+    return content.str();
+}
+
+static int _countThreads(const std::string& trace) {
+    int count = 0;
+    for (auto pos = trace.find("\"thread_name\""); pos != std::string::npos;
+         pos      = trace.find("\"thread_name\"", pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+class TraceTest : public MNNTestCase {
+public:
+    virtual ~TraceTest() = default;
+    virtual bool run() {
+        auto x = _Input({1, 16, 8, 8}, NCHW);
+        x->setName("x");
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(0.01f, 0.1f, y, {16, 16}, {3, 3}, SAME, {1, 1}, {1, 1}, 1);
+        y->setName("trace_conv");
+        y = _Relu(y);
+        y->setName("trace_relu");
+        y = _Convert(y, NCHW);
+        y->setName("y");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        net->setSessionMode(Interpreter::Session_Trace_On);
+        ScheduleConfig config;
+        config.numThread = 2;
+        auto session     = net->createSession(config);
+        net->runSession(session);
+        net->releaseSession(session);
+
+        const char* file = "trace_test.json";
+        auto trace       = _dumpTrace(file);
+        if (trace.empty()) {
+            MNN_ERROR("Dump trace failed\n");
+            return false;
+        }
+        const char* expects[] = {"\"traceEvents\"", "\"name\":\"trace_conv\"", "\"name\":\"trace_relu\"",
+                                 "\"name\":\"encode\"", "\"name\":\"allocMemory\""};
+        for (auto expect : expects) {
+            if (trace.find(expect) == std::string::npos) {
+                MNN_ERROR("Can't find %s in trace\n", expect);
+                return false;
+            }
+        }
+
+        // Threads exiting one after another reuse the same buffer
+        auto threadNumber = _countThreads(trace);
+        {
+            TraceRecorder::Enable enable(true);
+            for (int i = 0; i < 4; ++i) {
+                std::thread thread([]() { TraceRecorder::Scope scope("trace_thread", "test"); });
+                thread.join();
+            }
+        }
+        trace = _dumpTrace(file);
+        if (trace.find("\"name\":\"trace_thread\"") == std::string::npos || _countThreads(trace) > threadNumber + 1) {
+            MNN_ERROR("Trace buffers of exited threads are not reused\n");
+            return false;
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(TraceTest, "core/trace");
@@ -0,0 +1,96 @@
+//
+//  WidePackTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/03/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+static std::vector<float> _makeWeight(int size, int seed) {
+    std::vector<float> weight(size);
+    for (int i = 0; i < size; ++i) {
+        weight[i] = (float)((i * 13 + seed) % 23 - 11) / 23.0f;
+    }
+    return weight;
+}
+
+// Channels not aligned to 8 / 16, compare MNN_CPU_WIDE_PACK with the default layout
+class WidePackTest : public MNNTestCase {
+public:
+    virtual ~WidePackTest() = default;
+    virtual bool run() {
+        auto x = _Input({1, 3, 17, 17}, NCHW);
+        auto y = _Convert(x, NC4HW4);
+        y      = _Conv(_makeWeight(3 * 13 * 9, 0), _makeWeight(13, 1), y, {3, 13}, {3, 3}, SAME);
+        y      = _Relu6(y);
+        y      = _Conv(_makeWeight(13 * 25, 2), _makeWeight(13, 3), y, {13, 13}, {5, 5}, SAME, {2, 2}, {1, 1}, 13);
+        auto z = _Conv(_makeWeight(13 * 20, 4), _makeWeight(20, 5), y, {13, 20}, {1, 1});
+        z      = z + _Conv(_makeWeight(13 * 20, 6), _makeWeight(20, 7), y, {13, 20}, {1, 1}) * z;
+        z      = _Tanh(_Relu(z, 0.1f));
+        z      = _Deconv(_makeWeight(20 * 6 * 9, 8), _makeWeight(6, 9), z, {20, 6}, {3, 3}, VALID, {2, 2});
+        z      = _Deconv(_makeWeight(6 * 9, 10), _makeWeight(6, 11), z, {6, 6}, {3, 3}, SAME, {1, 1}, {1, 1}, 6);
+        z      = _Scale(z, 6, _makeWeight(6, 12), _makeWeight(6, 13));
+        auto conv = _Convert(z, NCHW);
+        conv->setName("conv");
+        auto area = 19 * 19;
+        auto matmulWeight = _makeWeight(area * 10, 14);
+        auto matmul = _MatMul(_Reshape(conv, {6, -1}), _Const(matmulWeight.data(), {area, 10}, NCHW));
+        matmul->setName("matmul");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({conv, matmul}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        ScheduleConfig config;
+        config.saveTensors = {"conv"};
+        auto reference = net->createSession(config);
+        BackendConfig bnConfig;
+        bnConfig.flags       = MNN_CPU_WIDE_PACK;
+        config.backendConfig = &bnConfig;
+        config.numThread     = 2;
+        auto session         = net->createSession(config);
+        for (auto s : {reference, session}) {
+            auto input = net->getSessionInput(s, nullptr);
+            auto ptr   = input->host<float>();
+            for (int i = 0; i < input->elementSize(); ++i) {
+                ptr[i] = (float)((i * 7) % 17) / 17.0f;
+            }
+            if (NO_ERROR != net->runSession(s)) {
+                MNN_ERROR("Run session error\n");
+                return false;
+            }
+        }
+        for (auto name : {"conv", "matmul"}) {
+            auto expect = net->getSessionOutput(reference, name);
+            auto result = net->getSessionOutput(session, name);
+            std::shared_ptr<Tensor> expectHost(new Tensor(expect, Tensor::CAFFE));
+            std::shared_ptr<Tensor> resultHost(new Tensor(result, Tensor::CAFFE));
+            expect->copyToHostTensor(expectHost.get());
+            result->copyToHostTensor(resultHost.get());
+            auto count = expectHost->elementSize();
+            if (count != resultHost->elementSize()) {
+                MNN_ERROR("Wide pack shape error for %s\n", name);
+                return false;
+            }
+            for (int i = 0; i < count; ++i) {
+                auto e = expectHost->host<float>()[i];
+                auto r = resultHost->host<float>()[i];
+                if (fabsf(e - r) > 1e-3f * fmaxf(1.0f, fabsf(e))) {
+                    MNN_ERROR("Wide pack result error for %s at %d: %f - %f\n", name, i, e, r);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(WidePackTest, "core/wide_pack");
@@ -0,0 +1,96 @@
+//
+//  KVCacheTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/02.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/Module.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+#include "TestUtils.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+#define HEAD 2
+#define DIM 8
+class KVCacheTest : public MNNTestCase {
+public:
+    static void fill(VARP x, int seed) {
+        auto size = x->getInfo()->size;
+        auto ptr  = x->writeMap<float>();
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = ((i * 37 + seed * 101) % 23 - 11) / 11.0f;
+        }
+    }
+    // Feed tokens of each step, compared with causal attention over all tokens fed since the last clearCache
+    static bool runSteps(Module* module, const std::vector<int>& steps, float scale) {
+        VARP keys;
+        VARP values;
+        int seed = 0;
+        for (auto seq : steps) {
+            auto q = _Input({HEAD, seq, DIM}, NCHW);
+            auto k = _Input({HEAD, seq, DIM}, NCHW);
+            auto v = _Input({HEAD, seq, DIM}, NCHW);
+            fill(q, seed++);
+            fill(k, seed++);
+            fill(v, seed++);
+            keys   = nullptr == keys ? k : _Concat({keys, k}, 1);
+            values = nullptr == values ? v : _Concat({values, v}, 1);
+            // Token i of the step only attends to the keys up to itself
+            int total = keys->getInfo()->dim[1];
+            std::vector<float> mask(seq * total, 0.0f);
+            for (int i = 0; i < seq; ++i) {
+                for (int j = total - seq + i + 1; j < total; ++j) {
+                    mask[i * total + j] = -1e9f;
+                }
+            }
+            auto scores = _MatMul(q, keys, false, true) * _Scalar<float>(scale);
+            scores      = scores + _Const(mask.data(), {seq, total}, NCHW);
+            auto expect = _MatMul(_Softmax(scores), values);
+            auto y      = module->onForward({q, k, v})[0];
+            auto size   = y->getInfo()->size;
+            if (!checkVector<float>(y->readMap<float>(), expect->readMap<float>(), size, 1e-4f)) {
+                MNN_ERROR("KVCache error for seq = %d, total = %d\n", seq, total);
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        float scale = 1.0f / sqrtf(DIM);
+        auto q      = _Input({HEAD, 1, DIM}, NCHW);
+        auto k      = _Input({HEAD, 1, DIM}, NCHW);
+        auto v      = _Input({HEAD, 1, DIM}, NCHW);
+        q->setName("q");
+        k->setName("k");
+        v->setName("v");
+        auto y = _Attention(q, k, v, scale, true);
+        y->setName("y");
+        std::unique_ptr<NetT> net(new NetT);
+        Variable::save({y}, net.get());
+        flatbuffers::FlatBufferBuilder builder;
+        builder.Finish(Net::Pack(builder, net.get()));
+        std::shared_ptr<Module> module(
+            Module::load({"q", "k", "v"}, {"y"}, builder.GetBufferPointer(), builder.GetSize()));
+        // Prefill then decode one token per step, growing over the preallocated keys
+        std::vector<int> steps = {5};
+        for (int i = 0; i < 300; ++i) {
+            steps.emplace_back(1);
+        }
+        if (!runSteps(module.get(), steps, scale)) {
+            return false;
+        }
+        module->clearCache();
+        if (!runSteps(module.get(), {3, 1, 1, 4}, scale)) {
+            return false;
+        }
+        // A prompt longer than a key tile, masked across the tiles
+        module->clearCache();
+        return runSteps(module.get(), {270, 2}, scale);
+    }
+};
+MNNTestSuiteRegister(KVCacheTest, "expr/KVCacheTest");
@@ -37,8 +37,9 @@ inline int8_t int32ToInt8(int data, int bias, float scale) {
 // y = Conv(x, w), x and y is C4 ordered format, weight is [oc, ic, kh, kw] raw format.
 static std::vector<int8_t> naiveConvInt8C4(const int8_t* x, const int8_t* weight, const int* bias, const float* scale,
                                            int ow, int oh, int iw, int ih, int ic, int oc, int kw, int kh, int padX, int padY, int padValue = 0,
-                                           int strideX = 1, int strideY = 1, int dilateX = 1, int dilateY = 1, int batch = 1) {
+                                           int strideX = 1, int strideY = 1, int dilateX = 1, int dilateY = 1, int batch = 1, int group = 1) {
     int ic4 = (ic + 3) / 4, oc4 = (oc + 3) / 4;
+    int icGroup = ic / group, ocGroup = oc / group;
     std::vector<int8_t> yCorrect(batch * oc4 * oh * ow * 4, 0);
     for (int b = 0; b < batch; ++b) {
         for (int oz = 0; oz < oc; ++oz) {
@@ -46,7 +47,8 @@ static std::vector<int8_t> naiveConvInt8C4(const int8_t* x, const int8_t* weight
             for (int oy = 0; oy < oh; ++oy) {
                 for (int ox = 0; ox < ow; ++ox) {
                     int32_t yInt32 = 0;
-                    for (int sz = 0; sz < ic; ++sz) {
+                    const int g    = oz / ocGroup;
+                    for (int sz = g * icGroup; sz < (g + 1) * icGroup; ++sz) {
                         int szC4 = sz / 4, szRemain = sz % 4;
                         for (int ky = 0; ky < kh; ++ky) {
                             for (int kx = 0; kx < kw; ++kx) {
@@ -55,7 +57,7 @@ static std::vector<int8_t> naiveConvInt8C4(const int8_t* x, const int8_t* weight
                                 if (ix >= 0 && ix < iw && iy >= 0 && iy < ih) {
                                     xValue = x[(((b * ic4 + szC4) * ih + iy) * iw + ix) * 4 + szRemain];
                                 }
-                                yInt32 += xValue * weight[((oz * ic + sz) * kh + ky) * kw + kx];
+                                yInt32 += xValue * weight[((oz * icGroup + sz - g * icGroup) * kh + ky) * kw + kx];
                             }
                         }
                     }
@@ -69,10 +71,11 @@ static std::vector<int8_t> naiveConvInt8C4(const int8_t* x, const int8_t* weight
 
 class ConvInt8TestCommon : public MNNTestCase {
 protected:
-    static bool testKernel(INTS inputShape, INTS kernel, INTS channel, INTS pad, INTS strides, INTS dilate, int nbit = 8, bool overflow = false) {
+    static bool testKernel(INTS inputShape, INTS kernel, INTS channel, INTS pad, INTS strides, INTS dilate, int nbit = 8, bool overflow = false, int group = 1) {
         std::vector<int> bias(channel[1]);
         std::vector<float> scale(channel[1]);
-        std::vector<int8_t> weight(channel[1] * channel[0] * kernel[0] * kernel[1]);
+        const int icGroup = channel[0] / group;
+        std::vector<int8_t> weight(channel[1] * icGroup * kernel[0] * kernel[1]);
         int iw = inputShape[0], ih = inputShape[1];
         VARP x     = _Input({1, channel[0], ih, iw}, NC4HW4, halide_type_of<int8_t>());
         auto xInfo = x->getInfo();
@@ -84,8 +87,8 @@ protected:
         for (int i = 0; i < channel[1]; ++i) {
             bias[i]  = (10000 + i * i * 10 - i * i * i) % 12580;
             scale[i] = ((127 - i) * i % 128) / 20000.0f;
-            for (int j = 0; j < channel[0]; ++j) {
-                auto weightCurrent = weight.data() + (i * channel[0] + j) * kernel[0] * kernel[1];
+            for (int j = 0; j < icGroup; ++j) {
+                auto weightCurrent = weight.data() + (i * icGroup + j) * kernel[0] * kernel[1];
                 for (int k = 0; k < kernel[0] * kernel[1]; ++k) {
                     weightCurrent[k] = ((i * i + j * j + k * k) % (xMax - xMin + 1)) + xMin; // w in [xMin, xMax]
                 }
@@ -94,16 +97,17 @@ protected:
         VARP y;
         if (overflow) {
             y     = _Conv(std::vector<int8_t>(weight), std::vector<int>(bias), std::vector<float>(scale), x,
-                               channel, kernel, PaddingMode::CAFFE, strides, dilate, 1, pad, false, 0, 0, -127, 127, true);
+                               channel, kernel, PaddingMode::CAFFE, strides, dilate, group, pad, false, 0, 0, -127, 127, true);
         } else {
             y     = _Conv(std::vector<int8_t>(weight), std::vector<int>(bias), std::vector<float>(scale), x,
-                               channel, kernel, PaddingMode::CAFFE, strides, dilate, 1, pad, false, 0, 0, -127, 127, false);
+                               channel, kernel, PaddingMode::CAFFE, strides, dilate, group, pad, false, 0, 0, -127, 127, false);
         }
         auto yInfo = y->getInfo();
         auto yPtr  = y->readMap<int8_t>();
         auto ow = yInfo->dim[3], oh = yInfo->dim[2];
         auto targetValues = naiveConvInt8C4(xPtr, weight.data(), bias.data(), scale.data(),
-                                            ow, oh, iw, ih, channel[0], channel[1], kernel[0], kernel[1], pad[0], pad[1]);
+                                            ow, oh, iw, ih, channel[0], channel[1], kernel[0], kernel[1], pad[0], pad[1], 0,
+                                            strides[0], strides[1], dilate[0], dilate[1], 1, group);
         for (int i = 0; i < targetValues.size(); ++i) {
             int8_t targetValue = targetValues[i], computeResult = yPtr[i];
             if (targetValue != computeResult) {
@@ -179,5 +183,31 @@ public:
         return true;
     }
 };
+class ConvInt8DepthwiseTest : public ConvInt8TestCommon {
+public:
+    virtual bool run() {
+        // Odd / even kernel width, stride and dilate, widths not divided by 4 and channel tails
+        std::vector<std::vector<INTS>> cases = {
+            // kernel, strides, dilate, {w, h}, {channel}
+            {{3, 3}, {1, 1}, {1, 1}, {37, 23}, {16}},
+            {{3, 3}, {2, 2}, {1, 1}, {38, 21}, {12}},
+            {{5, 5}, {1, 1}, {2, 2}, {29, 17}, {7}},
+            {{4, 2}, {1, 2}, {1, 1}, {15, 9}, {9}},
+            {{1, 1}, {1, 1}, {1, 1}, {6, 5}, {4}},
+        };
+        for (auto& c : cases) {
+            INTS channel = {c[4][0], c[4][0]};
+            INTS pad     = {c[0][0] / 2, c[0][1] / 2};
+            auto res     = testKernel(c[3], c[0], channel, pad, c[1], c[2], 8, false, channel[0]);
+            if (!res) {
+                MNN_ERROR("Error for test kernel %dx%d, stride %d, dilate %d for depthwise convint8\n", c[0][0],
+                          c[0][1], c[1][0], c[2][0]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
 MNNTestSuiteRegister(ConvInt8Im2colGemmTest, "op/ConvInt8/im2col_gemm");
+MNNTestSuiteRegister(ConvInt8DepthwiseTest, "op/ConvInt8/depthwise");
 MNNTestSuiteRegister(ConvInt8WinogradTest, "op/ConvInt8/winograd");
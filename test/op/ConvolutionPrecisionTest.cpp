@@ -0,0 +1,159 @@
+//
+//  ConvolutionPrecisionTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <string.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+struct ConvolutionCase {
+    const char* name;
+    int ic;
+    int oc;
+    int group;
+    int kernel;
+    int stride;
+    int dilate;
+    int pad;
+    bool relu6;
+    int ih;
+    int iw;
+};
+
+// Keep the value representable by bf16, so the only error of Precision_Low is the accumulation and the output
+static float _bf16Value(float value) {
+    uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(float));
+    bits &= 0xFFFF0000;
+    ::memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+// Compare convolution and depthwise with double precision for Precision_Normal / Precision_Low, Precision_Low uses
+// the bf16 kernels if MNN_SUPPORT_BF16 is on
+class ConvolutionPrecisionTest : public MNNTestCase {
+public:
+    virtual ~ConvolutionPrecisionTest() = default;
+    virtual bool run() {
+        // Channels and widths are not aligned to the pack of the kernels to check the remain
+        const std::vector<ConvolutionCase> cases = {
+            {"conv1x1", 37, 20, 1, 1, 1, 1, 0, false, 7, 9},     {"conv3x3", 13, 33, 1, 3, 1, 1, 1, true, 11, 10},
+            {"conv3x3s2", 8, 17, 1, 3, 2, 1, 1, false, 13, 15}, {"depthwise3x3", 20, 20, 20, 3, 1, 1, 1, true, 9, 23},
+            {"depthwise5x5d2", 12, 12, 12, 5, 2, 2, 4, false, 17, 19},
+        };
+        std::vector<VARP> outputs;
+        std::vector<std::vector<float>> weights(cases.size()), biases(cases.size());
+        for (int n = 0; n < cases.size(); ++n) {
+            auto& c    = cases[n];
+            auto x     = _Input({1, c.ic, c.ih, c.iw}, NCHW);
+            auto count = c.oc * c.ic / c.group * c.kernel * c.kernel;
+            weights[n].resize(count);
+            biases[n].resize(c.oc);
+            for (int i = 0; i < count; ++i) {
+                weights[n][i] = _bf16Value((float)((i * 53 + 7) % 97 - 48) / 96.0f);
+            }
+            for (int i = 0; i < c.oc; ++i) {
+                biases[n][i] = _bf16Value((float)((i * 29 + 3) % 31 - 15) / 8.0f);
+            }
+            x->setName(std::string("x_") + c.name);
+            auto weight = weights[n];
+            auto bias   = biases[n];
+            auto y      = _Conv(std::move(weight), std::move(bias), x, {c.ic, c.oc}, {c.kernel, c.kernel}, CAFFE,
+                           {c.stride, c.stride}, {c.dilate, c.dilate}, c.group, {c.pad, c.pad}, false, c.relu6);
+            y = _Convert(y, NCHW);
+            y->setName(std::string("y_") + c.name);
+            outputs.emplace_back(y);
+        }
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save(outputs, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        for (auto precision : {BackendConfig::Precision_Normal, BackendConfig::Precision_Low}) {
+            // bf16 keeps 8 bits of mantissa and the output is truncated
+            double relative = BackendConfig::Precision_Low == precision ? 1.0 / 64.0 : 1e-5;
+            ScheduleConfig config;
+            BackendConfig bnConfig;
+            bnConfig.precision   = precision;
+            config.backendConfig = &bnConfig;
+            config.numThread     = 2;
+            auto session         = net->createSession(config);
+            std::vector<std::vector<float>> inputs(cases.size());
+            for (int n = 0; n < cases.size(); ++n) {
+                auto& c    = cases[n];
+                auto input = net->getSessionInput(session, (std::string("x_") + c.name).c_str());
+                auto size  = c.ic * c.ih * c.iw;
+                inputs[n].resize(size);
+                for (int i = 0; i < size; ++i) {
+                    inputs[n][i] = _bf16Value((float)((i * 37 + 11) % 101 - 50) / 25.0f);
+                }
+                // The session tensors of the bf16 backend don't store float, copy with host tensors
+                std::shared_ptr<Tensor> host(new Tensor(input, Tensor::CAFFE));
+                ::memcpy(host->host<float>(), inputs[n].data(), size * sizeof(float));
+                input->copyFromHostTensor(host.get());
+            }
+            if (NO_ERROR != net->runSession(session)) {
+                MNN_ERROR("Run session error\n");
+                return false;
+            }
+            for (int n = 0; n < cases.size(); ++n) {
+                auto& c         = cases[n];
+                auto output     = net->getSessionOutput(session, (std::string("y_") + c.name).c_str());
+                auto oh         = output->height();
+                auto ow         = output->width();
+                auto icG        = c.ic / c.group;
+                auto ocG        = c.oc / c.group;
+                std::shared_ptr<Tensor> host(new Tensor(output, Tensor::CAFFE));
+                output->copyToHostTensor(host.get());
+                auto outputPtr  = host->host<float>();
+                auto& weight    = weights[n];
+                for (int oz = 0; oz < c.oc; ++oz) {
+                    auto g = oz / ocG;
+                    for (int oy = 0; oy < oh; ++oy) {
+                        for (int ox = 0; ox < ow; ++ox) {
+                            double expect = biases[n][oz];
+                            double sumAbs = fabs(expect);
+                            for (int sz = 0; sz < icG; ++sz) {
+                                for (int ky = 0; ky < c.kernel; ++ky) {
+                                    for (int kx = 0; kx < c.kernel; ++kx) {
+                                        int iy = oy * c.stride - c.pad + ky * c.dilate;
+                                        int ix = ox * c.stride - c.pad + kx * c.dilate;
+                                        if (iy < 0 || iy >= c.ih || ix < 0 || ix >= c.iw) {
+                                            continue;
+                                        }
+                                        double value = (double)inputs[n][((g * icG + sz) * c.ih + iy) * c.iw + ix] *
+                                                       weight[((oz * icG + sz) * c.kernel + ky) * c.kernel + kx];
+                                        expect += value;
+                                        sumAbs += fabs(value);
+                                    }
+                                }
+                            }
+                            if (c.relu6) {
+                                expect = fmin(fmax(expect, 0.0), 6.0);
+                            }
+                            auto result = outputPtr[(oz * oh + oy) * ow + ox];
+                            if (fabs(result - expect) > relative * sumAbs + 1e-5) {
+                                MNN_ERROR("%s error for precision %d at %d, %d, %d: %f, expect %f\n", c.name,
+                                          precision, oz, oy, ox, result, expect);
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+            net->releaseSession(session);
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ConvolutionPrecisionTest, "op/ConvolutionPrecision");
@@ -326,6 +326,81 @@ public:
     }
 };
 
+// Weights packed offline for each matmul pack mode, the matched one is used directly, others fall back
+class ConvolutionPackedWeightTest : public MNNTestCase {
+public:
+    virtual ~ConvolutionPackedWeightTest() = default;
+    virtual bool run() {
+        using namespace MNN::Express;
+        const int batch = 1, ic = 5, oc = 10, is = 6;
+        for (int k = 1; k <= 3; k += 2) {
+            const int kernelSize = k * k;
+            std::vector<float> weightData(oc * ic * kernelSize), biasData(oc), inputData(batch * ic * is * is);
+            for (int i = 0; i < weightData.size(); ++i) {
+                weightData[i] = (float)((i * 7) % 13) / 13.0f - 0.5f;
+            }
+            for (int i = 0; i < biasData.size(); ++i) {
+                biasData[i] = (float)(i % 3) / 3.0f;
+            }
+            for (int i = 0; i < inputData.size(); ++i) {
+                inputData[i] = (float)((i * 5) % 11) / 11.0f;
+            }
+            std::vector<float> outputData;
+            reference_conv2d(inputData, weightData, biasData, outputData, batch, ic, oc, is, is, PadMode_CAFFE, 0, 0,
+                             k, k, 1, 1, 1);
+            std::vector<std::pair<int, int>> packModes = {{1, 4}, {4, 4}, {1, 8}, {1, 16}};
+            for (auto& mode : packModes) {
+                const int lP = mode.first, hP = mode.second;
+                const int l = ic * kernelSize, lU = UP_DIV(l, lP), hU = UP_DIV(oc, hP);
+                std::unique_ptr<OpT> convOp(new OpT);
+                convOp->type       = OpType_Convolution;
+                convOp->main.type  = OpParameter_Convolution2D;
+                convOp->main.value = new Convolution2DT;
+                auto conv2D        = convOp->main.AsConvolution2D();
+                conv2D->common.reset(new Convolution2DCommonT);
+                conv2D->common->outputCount = oc;
+                conv2D->common->inputCount  = ic;
+                conv2D->common->kernelX     = k;
+                conv2D->common->kernelY     = k;
+                conv2D->weight              = weightData;
+                conv2D->bias                = biasData;
+                conv2D->packedWeight.reset(new PackedWeightT);
+                conv2D->packedWeight->lP = lP;
+                conv2D->packedWeight->hP = hP;
+                auto& packed             = conv2D->packedWeight->weight;
+                packed.resize(hU * lU * hP * lP, 0.0f);
+                for (int y = 0; y < oc; ++y) {
+                    for (int c = 0; c < ic; ++c) {
+                        for (int z = 0; z < kernelSize; ++z) {
+                            int x = z * ic + c;
+                            packed[((y / hP) * lU + x / lP) * hP * lP + (y % hP) * lP + x % lP] =
+                                weightData[(y * ic + c) * kernelSize + z];
+                        }
+                    }
+                }
+                // The converter drops the origin weight if --packWeightDropOrigin is set
+                for (int keepOrigin = 1; keepOrigin >= 0; --keepOrigin) {
+                    if (!keepOrigin) {
+                        conv2D->weight.clear();
+                    }
+                    auto input = _Input({batch, ic, is, is}, NCHW, halide_type_of<float>());
+                    ::memcpy(input->writeMap<float>(), inputData.data(), inputData.size() * sizeof(float));
+                    auto output = Variable::create(Expr::create(convOp.get(), {_Convert(input, NC4HW4)}));
+                    output      = _Convert(output, NCHW);
+                    auto outputPtr = output->readMap<float>();
+                    if (!checkVectorByRelativeError<float>(outputPtr, outputData.data(), outputData.size(), 0.05)) {
+                        MNN_ERROR("Packed weight conv test failed for kernel %d, lP = %d, hP = %d, keep origin %d\n",
+                                  k, lP, hP, keepOrigin);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+
 MNNTestSuiteRegister(ConvolutionTestOnCPU, "op/convolution/conv2d");
+MNNTestSuiteRegister(ConvolutionPackedWeightTest, "op/convolution/packed_weight");
 MNNTestSuiteRegister(DepthwiseConvolutionTestOnCPU, "op/convolution/depthwise_conv");
 MNNTestSuiteRegister(GroupConvolutionTestOnCPU, "op/convolution/conv_group");
@@ -0,0 +1,71 @@
+//
+//  EltwiseInt8Test.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+
+using namespace MNN::Express;
+using namespace MNN;
+
+class EltwiseInt8Test : public MNNTestCase {
+public:
+    static bool test(int batch, int channel, int h, int w) {
+        auto x    = _Input({batch, channel, h, w}, NC4HW4, halide_type_of<int8_t>());
+        auto y    = _Input({batch, channel, h, w}, NC4HW4, halide_type_of<int8_t>());
+        auto xPtr = x->writeMap<int8_t>();
+        auto yPtr = y->writeMap<int8_t>();
+        const int size = x->getInfo()->size;
+        for (int i = 0; i < size; ++i) {
+            xPtr[i] = (int8_t)((i * 37 + 11) % 255 - 127);
+            yPtr[i] = (int8_t)((i * 53 + 7) % 255 - 127);
+        }
+        std::vector<float> xScale(channel), yScale(channel), outputScale(channel);
+        for (int c = 0; c < channel; ++c) {
+            xScale[c]      = 0.01f + 0.002f * (c % 13);
+            yScale[c]      = 0.02f - 0.001f * (c % 7);
+            outputScale[c] = 30.0f + (c % 5);
+        }
+        auto z    = _EltwiseSumInt8(x, y, {}, {}, {}, xScale, {}, {}, {}, yScale, {}, {}, {}, outputScale);
+        auto zPtr = z->readMap<int8_t>();
+        if (nullptr == zPtr) {
+            MNN_ERROR("EltwiseInt8 compute error\n");
+            return false;
+        }
+        const int c4 = (channel + 3) / 4;
+        for (int b = 0; b < batch; ++b) {
+            for (int c = 0; c < channel; ++c) {
+                for (int i = 0; i < h * w; ++i) {
+                    const int index = ((b * c4 + c / 4) * h * w + i) * 4 + c % 4;
+                    float value = ((float)xPtr[index] * xScale[c] + (float)yPtr[index] * yScale[c]) * outputScale[c];
+                    int target  = (int)std::max(std::min(value, 127.0f), -127.0f);
+                    // Fused multiply add of some kernels may change the truncated result by one
+                    if (abs(target - zPtr[index]) > 1) {
+                        MNN_PRINT("EltwiseInt8 error at batch %d channel %d pixel %d: %d -> %d\n", b, c, i, target,
+                                  zPtr[index]);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        for (int channel : {4, 7, 32}) {
+            if (!test(2, channel, 5, 7)) {
+                return false;
+            }
+            if (!test(1, channel, 3, 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(EltwiseInt8Test, "op/EltwiseInt8");
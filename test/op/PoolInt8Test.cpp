@@ -0,0 +1,121 @@
+//
+//  PoolInt8Test.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+
+using namespace MNN::Express;
+using namespace MNN;
+
+// x and y are C4 ordered, windows are clipped by the input and average rounds half away from zero
+static std::vector<int8_t> naivePoolInt8C4(const int8_t* x, int batch, int channel, int ih, int iw, int oh, int ow,
+                                           int kh, int kw, int sy, int sx, int py, int px, bool isMax) {
+    const int c4 = (channel + 3) / 4;
+    std::vector<int8_t> y(batch * c4 * oh * ow * 4, 0);
+    for (int b = 0; b < batch; ++b) {
+        for (int c = 0; c < channel; ++c) {
+            const int cC4 = c / 4, cRemain = c % 4;
+            for (int oy = 0; oy < oh; ++oy) {
+                for (int ox = 0; ox < ow; ++ox) {
+                    int maxValue = -128, sum = 0, count = 0;
+                    for (int ky = 0; ky < kh; ++ky) {
+                        for (int kx = 0; kx < kw; ++kx) {
+                            int iy = oy * sy - py + ky, ix = ox * sx - px + kx;
+                            if (iy < 0 || iy >= ih || ix < 0 || ix >= iw) {
+                                continue;
+                            }
+                            int value = x[(((b * c4 + cC4) * ih + iy) * iw + ix) * 4 + cRemain];
+                            maxValue  = std::max(maxValue, value);
+                            sum += value;
+                            count++;
+                        }
+                    }
+                    int result = 0;
+                    if (count > 0) {
+                        result = isMax ? maxValue : (sum > 0 ? (sum + count / 2) / count : (sum - count / 2) / count);
+                    }
+                    y[(((b * c4 + cC4) * oh + oy) * ow + ox) * 4 + cRemain] = result;
+                }
+            }
+        }
+    }
+    return y;
+}
+
+class PoolInt8Test : public MNNTestCase {
+public:
+    static bool test(int batch, int channel, int ih, int iw, int kernel, int stride, int pad, bool isMax, bool isGlobal) {
+        auto x    = _Input({batch, channel, ih, iw}, NC4HW4, halide_type_of<int8_t>());
+        auto xPtr = x->writeMap<int8_t>();
+        const int size = x->getInfo()->size;
+        for (int i = 0; i < size; ++i) {
+            xPtr[i] = (int8_t)((i * 37 + 11) % 255 - 127);
+        }
+        std::unique_ptr<OpT> op(new OpT);
+        op->type       = OpType_PoolInt8;
+        op->main.type  = OpParameter_Pool;
+        op->main.value = new PoolT;
+        auto pool       = op->main.AsPool();
+        pool->kernelX   = kernel;
+        pool->kernelY   = kernel;
+        pool->strideX   = stride;
+        pool->strideY   = stride;
+        pool->padX      = pad;
+        pool->padY      = pad;
+        pool->isGlobal  = isGlobal;
+        pool->padType   = PoolPadType_CAFFE;
+        pool->ceilModel = false;
+        pool->type      = isMax ? PoolType_MAXPOOL : PoolType_AVEPOOL;
+        auto y          = Variable::create(Expr::create(op.get(), {x}));
+        auto yInfo      = y->getInfo();
+        auto yPtr       = y->readMap<int8_t>();
+        if (nullptr == yInfo || nullptr == yPtr) {
+            MNN_ERROR("PoolInt8 compute error\n");
+            return false;
+        }
+        const int oh = yInfo->dim[2], ow = yInfo->dim[3];
+        int kh = std::min(kernel, ih), kw = std::min(kernel, iw), sy = stride, sx = stride, p = pad;
+        if (isGlobal) {
+            kh = ih, kw = iw, sy = ih, sx = iw, p = 0;
+        }
+        auto target = naivePoolInt8C4(x->readMap<int8_t>(), batch, channel, ih, iw, oh, ow, kh, kw, sy, sx, p, p, isMax);
+        for (int b = 0; b < batch; ++b) {
+            for (int c = 0; c < channel; ++c) {
+                for (int i = 0; i < oh * ow; ++i) {
+                    const int index = ((b * ((channel + 3) / 4) + c / 4) * oh * ow + i) * 4 + c % 4;
+                    if (target[index] != yPtr[index]) {
+                        MNN_PRINT("PoolInt8 %s error at batch %d channel %d pixel %d: %d -> %d\n",
+                                  isMax ? "max" : "avg", b, c, i, target[index], yPtr[index]);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        // Channels cover the 16 / 32 / 64 vector width and their tails
+        for (int channel : {3, 16, 37, 64, 100}) {
+            for (bool isMax : {true, false}) {
+                if (!test(2, channel, 13, 11, 3, 2, 1, isMax, false)) {
+                    return false;
+                }
+                if (!test(1, channel, 8, 9, 2, 2, 0, isMax, false)) {
+                    return false;
+                }
+                if (!test(2, channel, 7, 5, 1, 1, 0, isMax, true)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(PoolInt8Test, "op/PoolInt8");
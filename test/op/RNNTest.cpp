@@ -0,0 +1,231 @@
+//
+//  RNNTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+#include "TestUtils.h"
+
+using namespace MNN::Express;
+using namespace MNN;
+
+static std::vector<float> _values(int size, int seed) {
+    std::vector<float> res(size);
+    for (int i = 0; i < size; ++i) {
+        res[i] = (float)((i * 37 + seed * 101) % 199 - 99) / 200.0f;
+    }
+    return res;
+}
+
+static VARP _makeConst(const std::vector<float>& values, INTS shape) {
+    return _Const(values.data(), shape, NCHW, halide_type_of<float>());
+}
+
+static VARP _makeInput(const std::vector<float>& values, INTS shape) {
+    auto x = _Input(shape, NCHW);
+    ::memcpy(x->writeMap<float>(), values.data(), values.size() * sizeof(float));
+    return x;
+}
+
+static float _sigmoid(float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+class LSTMTest : public MNNTestCase {
+public:
+    virtual ~LSTMTest() = default;
+    static bool test(int seq, int batch, int input, int hidden, int directions, bool initState) {
+        auto x  = _values(seq * batch * input, 0);
+        auto w  = _values(directions * 4 * hidden * input, 1);
+        auto r  = _values(directions * 4 * hidden * hidden, 2);
+        auto b  = _values(directions * 4 * hidden, 3);
+        auto h0 = _values(directions * batch * hidden, 4);
+        auto c0 = _values(directions * batch * hidden, 5);
+        std::unique_ptr<OpT> op(new OpT);
+        op->type       = OpType_LSTM;
+        op->main.type  = OpParameter_LSTM;
+        op->main.value = new LSTMT;
+        op->main.AsLSTM()->outputCount = hidden;
+        std::vector<VARP> inputs = {_makeInput(x, {seq, batch, input}), _makeConst(w, {directions, 4 * hidden, input}),
+                                    _makeConst(r, {directions, 4 * hidden, hidden}),
+                                    _makeConst(b, {directions, 4 * hidden})};
+        if (initState) {
+            inputs.emplace_back(_makeInput(h0, {directions, batch, hidden}));
+            inputs.emplace_back(_makeInput(c0, {directions, batch, hidden}));
+        }
+        auto expr = Expr::create(op.get(), inputs, 3);
+        auto y    = Variable::create(expr, 0);
+        auto yh   = Variable::create(expr, 1);
+        auto yc   = Variable::create(expr, 2);
+
+        // Onnx's LSTM, gate order is iofc
+        std::vector<float> expectY(seq * directions * batch * hidden);
+        std::vector<float> expectH(directions * batch * hidden);
+        std::vector<float> expectC(directions * batch * hidden);
+        for (int d = 0; d < directions; ++d) {
+            for (int n = 0; n < batch; ++n) {
+                std::vector<float> hState(hidden, 0.0f), cState(hidden, 0.0f), gates(4 * hidden);
+                if (initState) {
+                    for (int j = 0; j < hidden; ++j) {
+                        hState[j] = h0[(d * batch + n) * hidden + j];
+                        cState[j] = c0[(d * batch + n) * hidden + j];
+                    }
+                }
+                for (int step = 0; step < seq; ++step) {
+                    int t = 0 == d ? step : seq - 1 - step;
+                    for (int g = 0; g < 4 * hidden; ++g) {
+                        float sum = b[d * 4 * hidden + g];
+                        for (int k = 0; k < input; ++k) {
+                            sum += x[(t * batch + n) * input + k] * w[(d * 4 * hidden + g) * input + k];
+                        }
+                        for (int k = 0; k < hidden; ++k) {
+                            sum += hState[k] * r[(d * 4 * hidden + g) * hidden + k];
+                        }
+                        gates[g] = sum;
+                    }
+                    for (int j = 0; j < hidden; ++j) {
+                        float gI  = _sigmoid(gates[j]);
+                        float gO  = _sigmoid(gates[hidden + j]);
+                        float gF  = _sigmoid(gates[2 * hidden + j]);
+                        float gC  = tanhf(gates[3 * hidden + j]);
+                        cState[j] = gF * cState[j] + gI * gC;
+                        hState[j] = gO * tanhf(cState[j]);
+                        expectY[((t * directions + d) * batch + n) * hidden + j] = hState[j];
+                    }
+                }
+                for (int j = 0; j < hidden; ++j) {
+                    expectH[(d * batch + n) * hidden + j] = hState[j];
+                    expectC[(d * batch + n) * hidden + j] = cState[j];
+                }
+            }
+        }
+        auto info = y->getInfo();
+        if (nullptr == info || info->dim != std::vector<int>({seq, directions, batch, hidden})) {
+            MNN_ERROR("LSTM shape error\n");
+            return false;
+        }
+        if (!checkVector<float>(y->readMap<float>(), expectY.data(), expectY.size(), 1e-4f) ||
+            !checkVector<float>(yh->readMap<float>(), expectH.data(), expectH.size(), 1e-4f) ||
+            !checkVector<float>(yc->readMap<float>(), expectC.data(), expectC.size(), 1e-4f)) {
+            MNN_ERROR("LSTM error: seq = %d, batch = %d, input = %d, hidden = %d, directions = %d\n", seq, batch, input,
+                      hidden, directions);
+            return false;
+        }
+        return true;
+    }
+    virtual bool run() {
+        // Cover hidden not aligned to 4, batch larger than eP and both directions
+        return test(1, 1, 4, 4, 1, false) && test(7, 3, 5, 6, 1, true) && test(5, 2, 9, 13, 2, false) &&
+               test(3, 19, 16, 32, 2, true) && test(2, 4, 3, 67, 1, true);
+    }
+};
+MNNTestSuiteRegister(LSTMTest, "op/LSTM");
+
+class GRUTest : public MNNTestCase {
+public:
+    virtual ~GRUTest() = default;
+    static bool test(int seq, int batch, int input, int units, bool bidirectional, bool linearBeforeReset,
+                     bool keepAllOutputs) {
+        int directions = bidirectional ? 2 : 1;
+        auto x         = _values(seq * batch * input, 0);
+        std::unique_ptr<OpT> op(new OpT);
+        op->type       = OpType_RNNSequenceGRU;
+        op->main.type  = OpParameter_RNNParam;
+        op->main.value = new RNNParamT;
+        auto param     = op->main.AsRNNParam();
+        param->numUnits           = units;
+        param->isBidirectionalRNN = bidirectional;
+        param->linearBeforeReset  = linearBeforeReset;
+        param->keepAllOutputs     = keepAllOutputs;
+        std::vector<VARP> inputs  = {_makeInput(x, {seq, batch, input})};
+        // Per direction: gateWeight, gateBias, candidateWeight, candidateBias, recurrentBias
+        std::vector<std::vector<float>> weights;
+        for (int d = 0; d < directions; ++d) {
+            std::vector<std::pair<int, INTS>> shapes = {{(input + units) * 2 * units, {input + units, 2 * units}},
+                                                        {2 * units, {1, 2 * units}},
+                                                        {(input + units) * units, {input + units, units}},
+                                                        {units, {1, units}},
+                                                        {3 * units, {1, 3 * units}}};
+            for (auto& s : shapes) {
+                weights.emplace_back(_values(s.first, (int)weights.size() + 1));
+                inputs.emplace_back(_makeConst(weights.back(), s.second));
+            }
+        }
+        auto y = Variable::create(Expr::create(op.get(), inputs, 1));
+
+        int outputSeq = keepAllOutputs ? seq : 1;
+        std::vector<float> expect(outputSeq * directions * batch * units);
+        for (int d = 0; d < directions; ++d) {
+            auto& gateWeight      = weights[5 * d + 0];
+            auto& gateBias        = weights[5 * d + 1];
+            auto& candidateWeight = weights[5 * d + 2];
+            auto& candidateBias   = weights[5 * d + 3];
+            auto& recurrentBias   = weights[5 * d + 4];
+            for (int n = 0; n < batch; ++n) {
+                std::vector<float> h(units, 0.0f), gates(2 * units), resetH(units);
+                for (int step = 0; step < seq; ++step) {
+                    int t   = 0 == d ? step : seq - 1 - step;
+                    auto xt = x.data() + (t * batch + n) * input;
+                    // gates: [r, u]
+                    for (int j = 0; j < 2 * units; ++j) {
+                        float sum = gateBias[j] + recurrentBias[j];
+                        for (int k = 0; k < input; ++k) {
+                            sum += xt[k] * gateWeight[k * 2 * units + j];
+                        }
+                        for (int k = 0; k < units; ++k) {
+                            sum += h[k] * gateWeight[(input + k) * 2 * units + j];
+                        }
+                        gates[j] = _sigmoid(sum);
+                    }
+                    for (int j = 0; j < units; ++j) {
+                        resetH[j] = gates[j] * h[j];
+                    }
+                    for (int j = 0; j < units; ++j) {
+                        float rb  = recurrentBias[2 * units + j];
+                        float sum = candidateBias[j] + (linearBeforeReset ? gates[j] * rb : rb);
+                        for (int k = 0; k < input; ++k) {
+                            sum += xt[k] * candidateWeight[k * units + j];
+                        }
+                        for (int k = 0; k < units; ++k) {
+                            sum += resetH[k] * candidateWeight[(input + k) * units + j];
+                        }
+                        float u = gates[units + j];
+                        h[j]    = (1.0f - u) * h[j] + u * tanhf(sum);
+                    }
+                    if (keepAllOutputs) {
+                        ::memcpy(expect.data() + ((t * directions + d) * batch + n) * units, h.data(),
+                                 units * sizeof(float));
+                    }
+                }
+                if (!keepAllOutputs) {
+                    ::memcpy(expect.data() + (d * batch + n) * units, h.data(), units * sizeof(float));
+                }
+            }
+        }
+        auto info = y->getInfo();
+        if (nullptr == info || info->dim != std::vector<int>({outputSeq, directions, batch, units})) {
+            MNN_ERROR("GRU shape error\n");
+            return false;
+        }
+        if (!checkVector<float>(y->readMap<float>(), expect.data(), expect.size(), 1e-4f)) {
+            MNN_ERROR("GRU error: seq = %d, batch = %d, input = %d, units = %d, bidirectional = %d, linearBeforeReset = "
+                      "%d, keepAllOutputs = %d\n",
+                      seq, batch, input, units, bidirectional, linearBeforeReset, keepAllOutputs);
+            return false;
+        }
+        return true;
+    }
+    virtual bool run() {
+        return test(1, 1, 4, 4, false, false, true) && test(6, 3, 5, 7, false, true, true) &&
+               test(5, 2, 9, 13, true, false, true) && test(4, 19, 16, 32, true, true, false) &&
+               test(3, 2, 3, 66, false, false, false);
+    }
+};
+MNNTestSuiteRegister(GRUTest, "op/GRU");
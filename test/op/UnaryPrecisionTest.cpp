@@ -0,0 +1,104 @@
+//
+//  UnaryPrecisionTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/03/12.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <string.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN;
+using namespace MNN::Express;
+
+struct UnaryCase {
+    const char* name;
+    VARP (*func)(VARP);
+    double (*ref)(double);
+    float minValue;
+    float maxValue;
+};
+
+static double _sigmoid(double x) {
+    return 1.0 / (1.0 + ::exp(-x));
+}
+
+// Compare the transcendental functions with double precision for Precision_Normal / Precision_Low
+class UnaryPrecisionTest : public MNNTestCase {
+public:
+    virtual ~UnaryPrecisionTest() = default;
+    virtual bool run() {
+        // Not aligned to the vector size to check the remain
+        const int size = 1003;
+        const std::vector<UnaryCase> cases = {
+            {"exp", _Exp, ::exp, -80.0f, 80.0f},          {"log", _Log, ::log, 1e-3f, 1e3f},
+            {"log1p", _Log1p, ::log1p, -0.9f, 100.0f},    {"expm1", _Expm1, ::expm1, -10.0f, 10.0f},
+            {"sigmoid", _Sigmoid, _sigmoid, -30.0f, 30.0f}, {"tanh", _Tanh, ::tanh, -8.0f, 8.0f},
+            {"sinh", _Sinh, ::sinh, -10.0f, 10.0f},       {"cosh", _Cosh, ::cosh, -10.0f, 10.0f},
+            {"sin", _Sin, ::sin, -10.0f, 10.0f},          {"cos", _Cos, ::cos, -10.0f, 10.0f},
+            {"tan", _Tan, ::tan, -1.5f, 1.5f},            {"atan", _Atan, ::atan, -100.0f, 100.0f},
+            {"asinh", _Asinh, ::asinh, -100.0f, 100.0f},  {"acosh", _Acosh, ::acosh, 1.0f, 100.0f},
+            {"atanh", _Atanh, ::atanh, -0.99f, 0.99f},    {"erf", _Erf, ::erf, -4.0f, 4.0f},
+        };
+        std::vector<VARP> outputs;
+        for (auto& c : cases) {
+            auto x = _Input({size}, NCHW);
+            x->setName(std::string("x_") + c.name);
+            auto y = c.func(x);
+            y->setName(std::string("y_") + c.name);
+            outputs.emplace_back(y);
+        }
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save(outputs, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        for (auto precision : {BackendConfig::Precision_Normal, BackendConfig::Precision_Low}) {
+            // The error bounds of VecMath.hpp with some margin
+            double relative = BackendConfig::Precision_Low == precision ? 3e-5 : 1e-6;
+            double absolute = BackendConfig::Precision_Low == precision ? 1e-6 : 1e-7;
+            ScheduleConfig config;
+            BackendConfig bnConfig;
+            bnConfig.precision   = precision;
+            config.backendConfig = &bnConfig;
+            config.numThread     = 2;
+            auto session         = net->createSession(config);
+            std::vector<std::vector<float>> inputs(cases.size());
+            for (int n = 0; n < cases.size(); ++n) {
+                auto& c    = cases[n];
+                auto input = net->getSessionInput(session, (std::string("x_") + c.name).c_str());
+                inputs[n].resize(size);
+                for (int i = 0; i < size; ++i) {
+                    inputs[n][i] = c.minValue + (c.maxValue - c.minValue) * (float)i / (float)(size - 1);
+                }
+                ::memcpy(input->host<float>(), inputs[n].data(), size * sizeof(float));
+            }
+            if (NO_ERROR != net->runSession(session)) {
+                MNN_ERROR("Run session error\n");
+                return false;
+            }
+            for (int n = 0; n < cases.size(); ++n) {
+                auto& c     = cases[n];
+                auto output = net->getSessionOutput(session, (std::string("y_") + c.name).c_str());
+                for (int i = 0; i < size; ++i) {
+                    auto x      = inputs[n][i];
+                    auto expect = c.ref(x);
+                    auto result = output->host<float>()[i];
+                    if (fabs(result - expect) > relative * fabs(expect) + absolute) {
+                        MNN_ERROR("%s error for precision %d: %s(%f) = %f, expect %f\n", c.name, precision, c.name, x,
+                                  result, expect);
+                        return false;
+                    }
+                }
+            }
+            net->releaseSession(session);
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(UnaryPrecisionTest, "op/unary/precision");
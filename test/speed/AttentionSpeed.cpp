@@ -0,0 +1,60 @@
+//
+//  AttentionSpeed.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/03/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#define MNN_OPEN_TIME_TRACE
+#include <MNN/AutoTime.hpp>
+#include "MNNTestSuite.h"
+using namespace MNN::Express;
+#define HEAD 8
+#define DIM 64
+#define TIME 5
+// Fused Attention against MatMul - Softmax - MatMul, which materializes the [seq, seq] scores
+class AttentionSpeed : public MNNTestCase {
+public:
+    static void test(VARP output, std::vector<VARP> inputs, const char* name, int seq) {
+        MNN_PRINT("Test %s for seq = %d, %d times\n", name, seq, TIME);
+        AUTOTIME;
+        for (int i = 0; i < TIME; ++i) {
+            for (auto x : inputs) {
+                x->writeMap<float>();
+            }
+            output->readMap<float>();
+        }
+    }
+    virtual bool run() {
+        for (int seq : {512, 2048}) {
+            auto query = _Input({1, HEAD, seq, DIM}, NCHW);
+            auto key   = _Input({1, HEAD, seq, DIM}, NCHW);
+            auto value = _Input({1, HEAD, seq, DIM}, NCHW);
+            for (auto x : {query, key, value}) {
+                auto ptr = x->writeMap<float>();
+                for (int i = 0; i < HEAD * seq * DIM; ++i) {
+                    ptr[i] = (float)(i % 97 - 48) / 48.0f;
+                }
+            }
+            float scale    = 1.0f / sqrtf((float)DIM);
+            auto fused     = _Attention(query, key, value, scale);
+            auto unfused   = _MatMul(_Softmax(_MatMul(query, key, false, true) * _Scalar<float>(scale)), value);
+            auto fusedPtr  = fused->readMap<float>();
+            auto unfusePtr = unfused->readMap<float>();
+            for (int i = 0; i < HEAD * seq * DIM; ++i) {
+                if (fabsf(fusedPtr[i] - unfusePtr[i]) > 1e-4f) {
+                    MNN_ERROR("Attention error: %f - %f\n", fusedPtr[i], unfusePtr[i]);
+                    return false;
+                }
+            }
+            test(fused, {query, key, value}, "fused Attention", seq);
+            test(unfused, {query, key, value}, "MatMul - Softmax - MatMul", seq);
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(AttentionSpeed, "speed/Attention");
@@ -0,0 +1,78 @@
+//
+//  RNNSpeed.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/04/06.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#define MNN_OPEN_TIME_TRACE
+#include <MNN/AutoTime.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+#define SEQ 100
+#define INPUT 256
+#define HIDDEN 256
+#define TIME 5
+// Speech like LSTM / GRU of long sequence
+class RNNSpeed : public MNNTestCase {
+public:
+    static VARP _weight(INTS shape) {
+        int size = 1;
+        for (auto s : shape) {
+            size *= s;
+        }
+        std::vector<float> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = (float)(i % 97 - 48) / 480.0f;
+        }
+        return _Const(values.data(), shape, NCHW, halide_type_of<float>());
+    }
+    static void test(VARP output, VARP input, const char* name, int batch) {
+        MNN_PRINT("Test %s for seq = %d, batch = %d, input = %d, hidden = %d, %d times\n", name, SEQ, batch, INPUT,
+                  HIDDEN, TIME);
+        AUTOTIME;
+        for (int i = 0; i < TIME; ++i) {
+            input->writeMap<float>();
+            output->readMap<float>();
+        }
+    }
+    virtual bool run() {
+        for (int batch : {1, 8}) {
+            auto x   = _Input({SEQ, batch, INPUT}, NCHW);
+            auto ptr = x->writeMap<float>();
+            for (int i = 0; i < SEQ * batch * INPUT; ++i) {
+                ptr[i] = (float)(i % 31 - 15) / 15.0f;
+            }
+            {
+                std::unique_ptr<OpT> op(new OpT);
+                op->type       = OpType_LSTM;
+                op->main.type  = OpParameter_LSTM;
+                op->main.value = new LSTMT;
+                op->main.AsLSTM()->outputCount = HIDDEN;
+                auto y = Variable::create(Expr::create(
+                    op.get(), {x, _weight({1, 4 * HIDDEN, INPUT}), _weight({1, 4 * HIDDEN, HIDDEN}), _weight({1, 4 * HIDDEN})},
+                    3));
+                test(y, x, "LSTM", batch);
+            }
+            {
+                std::unique_ptr<OpT> op(new OpT);
+                op->type       = OpType_RNNSequenceGRU;
+                op->main.type  = OpParameter_RNNParam;
+                op->main.value = new RNNParamT;
+                op->main.AsRNNParam()->numUnits       = HIDDEN;
+                op->main.AsRNNParam()->keepAllOutputs = true;
+                auto y = Variable::create(Expr::create(
+                    op.get(), {x, _weight({INPUT + HIDDEN, 2 * HIDDEN}), _weight({1, 2 * HIDDEN}),
+                               _weight({INPUT + HIDDEN, HIDDEN}), _weight({1, HIDDEN}), _weight({1, 3 * HIDDEN})}));
+                test(y, x, "GRU", batch);
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(RNNSpeed, "speed/RNN");
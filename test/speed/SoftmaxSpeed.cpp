@@ -0,0 +1,74 @@
+//
+//  SoftmaxSpeed.cpp
+//  MNNTests
+//
+//  Created by MNN on 2021/03/15.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#define MNN_OPEN_TIME_TRACE
+#include <MNN/AutoTime.hpp>
+#include "MNNTestSuite.h"
+using namespace MNN::Express;
+// Attention sized: [head, seq, seq]
+#define HEAD 8
+#define SEQ 1024
+#define TIME 20
+class SoftmaxSpeed : public MNNTestCase {
+public:
+    // Softmax of axis on [outside, channel, inside], compared with double
+    static bool check(VARP input, VARP output, int outside, int channel, int inside) {
+        auto src = input->readMap<float>();
+        auto dst = output->readMap<float>();
+        for (int y = 0; y < outside; ++y) {
+            for (int x = 0; x < inside; ++x) {
+                auto srcX       = src + y * channel * inside + x;
+                auto dstX       = dst + y * channel * inside + x;
+                double maxValue = srcX[0];
+                for (int c = 1; c < channel; ++c) {
+                    maxValue = fmax(maxValue, srcX[c * inside]);
+                }
+                double sumValue = 0.0;
+                for (int c = 0; c < channel; ++c) {
+                    sumValue += exp(srcX[c * inside] - maxValue);
+                }
+                for (int c = 0; c < channel; ++c) {
+                    auto expect = exp(srcX[c * inside] - maxValue) / sumValue;
+                    if (fabs(dstX[c * inside] - expect) > 1e-5 * expect + 1e-7) {
+                        MNN_ERROR("Softmax error: %f, expect %f\n", dstX[c * inside], expect);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    static bool test(int axis, const char* name) {
+        auto input  = _Input({HEAD, SEQ, SEQ}, NCHW);
+        auto output = _Softmax(input, axis);
+        auto ptr    = input->writeMap<float>();
+        for (int i = 0; i < HEAD * SEQ * SEQ; ++i) {
+            ptr[i] = (((i % 2001) * 7919) % 2001 - 1000) / 100.0f;
+        }
+        int inside = 2 == axis ? 1 : SEQ;
+        if (!check(input, output, HEAD, SEQ, inside)) {
+            return false;
+        }
+        MNN_PRINT("Test Softmax %s for %d x %d x %d, %d times\n", name, HEAD, SEQ, SEQ, TIME);
+        {
+            AUTOTIME;
+            for (int i = 0; i < TIME; ++i) {
+                input->writeMap<float>();
+                output->readMap<float>();
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        return test(2, "last axis") && test(1, "inside > 1");
+    }
+};
+MNNTestSuiteRegister(SoftmaxSpeed, "speed/Softmax");
@@ -62,6 +62,10 @@ public:
     bool saveStaticModel = false;
     int optimizePrefer = 0;
     float targetVersion = 1.2;
+    // If not empty, store float convolution weights packed for this CPU target: SSE, AVX2 or AVX512
+    std::string packWeightTarget = "";
+    // Drop the origin weights and keep the packed ones only, backends other than CPU can't create the convolutions
+    bool packWeightDropOrigin = false;
 };
 
 #endif // CONFIG_HPP
@@ -61,6 +61,10 @@ cxxopts::Options Cli::initializeMNNConvertArgs(modelConfig &modelPath, int argc,
             "for sparsity.", cxxopts::value<std::string>())(
         "saveStaticModel", "save static model with fix shape, default: false", cxxopts::value<bool>())(
         "targetVersion", "compability for old mnn engine, default: 1.2f", cxxopts::value<float>())(
+        "packWeight", "save float convolution weights packed for a CPU target to skip repacking when creating session, "
+                      "ex: [SSE,AVX2,AVX512], other CPU targets unpack them when creating session", cxxopts::value<std::string>())(
+        "packWeightDropOrigin", "with --packWeight, drop the origin weights to save the model size, only CPU backends "
+                                "can run the model then, default: false", cxxopts::value<bool>())(
         "inputConfigFile", "set input config file for static model, ex: ~/config.txt", cxxopts::value<std::string>());
 
     auto result = options.parse(argc, argv);
@@ -186,6 +190,18 @@ cxxopts::Options Cli::initializeMNNConvertArgs(modelConfig &modelPath, int argc,
     if (result.count("optimizePrefer")) {
         modelPath.optimizePrefer = result["optimizePrefer"].as<int>();
     }
+    if (result.count("packWeight")) {
+        const std::string target = result["packWeight"].as<std::string>();
+        if (target != "SSE" && target != "AVX2" && target != "AVX512") {
+            std::cout << "packWeight Input ERROR, only support SSE, AVX2, AVX512" << std::endl;
+            std::cout << options.help({""}) << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        modelPath.packWeightTarget = target;
+    }
+    if (result.count("packWeightDropOrigin")) {
+        modelPath.packWeightDropOrigin = true;
+    }
     // Int8 calibration table path.
     if (result.count("compressionParamsFile")) {
         modelPath.compressionParamsFile =
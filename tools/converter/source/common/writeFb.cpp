@@ -57,6 +57,54 @@ static std::vector<float> findMinMax(const float *weights, const int count) {
     return {min, max};
 }
 
+// Same layout as the CPU ConvolutionTiledExecutor / Convolution1x1Strassen weight: swap kernel and input channel,
+// then MNNPackForMatMul_B(transpose = true) to [UP_DIV(oc, hP), UP_DIV(l, lP), hP, lP]
+static std::unique_ptr<MNN::PackedWeightT> packWeightForTarget(const std::vector<float>& weight, int outputCount,
+                                                                int kernelSize, const std::string& target) {
+    int lP = 1;
+    int hP = 4;
+    if (target == "AVX512") {
+        hP = 16;
+    }
+    const int inputCount = (int)weight.size() / outputCount / kernelSize;
+    const int l          = inputCount * kernelSize;
+    const int lU         = (l + lP - 1) / lP;
+    const int hU         = (outputCount + hP - 1) / hP;
+    std::unique_ptr<MNN::PackedWeightT> packed(new MNN::PackedWeightT);
+    packed->target = target;
+    packed->lP     = lP;
+    packed->hP     = hP;
+    packed->weight.resize(hU * lU * hP * lP, 0.0f);
+    for (int y = 0; y < outputCount; ++y) {
+        for (int c = 0; c < inputCount; ++c) {
+            for (int k = 0; k < kernelSize; ++k) {
+                int x   = k * inputCount + c;
+                int dst = ((y / hP) * lU + x / lP) * hP * lP + (y % hP) * lP + x % lP;
+                packed->weight[dst] = weight[(y * inputCount + c) * kernelSize + k];
+            }
+        }
+    }
+    return packed;
+}
+
+// Inverse of packWeightForTarget, for a source MNN model saved without the origin weights
+static void unpackWeight(const MNN::PackedWeightT* packed, std::vector<float>& weight, int outputCount,
+                         int inputCount, int kernelSize) {
+    const int lP = packed->lP;
+    const int hP = packed->hP;
+    const int lU = (inputCount * kernelSize + lP - 1) / lP;
+    weight.resize(outputCount * inputCount * kernelSize);
+    for (int y = 0; y < outputCount; ++y) {
+        for (int c = 0; c < inputCount; ++c) {
+            for (int k = 0; k < kernelSize; ++k) {
+                int x   = k * inputCount + c;
+                int src = ((y / hP) * lU + x / lP) * hP * lP + (y % hP) * lP + x % lP;
+                weight[(y * inputCount + c) * kernelSize + k] = packed->weight[src];
+            }
+        }
+    }
+}
+
 int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, modelConfig config) {
     auto RemoveParams = [](std::unique_ptr<MNN::OpT>& op) {
         const auto opType = op->type;
@@ -447,6 +495,46 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
         }
     }
 
+    auto PackWeight = [&](std::unique_ptr<MNN::OpT>& op) {
+        if (op->type != MNN::OpType_Convolution) {
+            return;
+        }
+        auto param   = op->main.AsConvolution2D();
+        auto& common = param->common;
+        if (param->weight.empty() && nullptr != param->packedWeight && nullptr != common) {
+            unpackWeight(param->packedWeight.get(), param->weight, common->outputCount, common->inputCount,
+                         common->kernelX * common->kernelY);
+        }
+        // Packed weight from a source MNN model may be stale after optimization, always rebuild it
+        param->packedWeight.reset();
+        if (config.packWeightTarget.empty()) {
+            return;
+        }
+        if (nullptr == common || nullptr != param->quanParameter || param->weight.empty() || common->group != 1) {
+            return;
+        }
+        int kernelSize = common->kernelX * common->kernelY;
+        if (common->outputCount <= 0 || kernelSize <= 0 || param->weight.size() % (common->outputCount * kernelSize) != 0) {
+            return;
+        }
+        param->packedWeight = packWeightForTarget(param->weight, common->outputCount, kernelSize, config.packWeightTarget);
+        if (config.packWeightDropOrigin) {
+            // The runtime unpacks it by inputCount if the backend packs differently
+            common->inputCount = (int)param->weight.size() / common->outputCount / kernelSize;
+            param->weight.clear();
+        }
+    };
+    {
+        for (auto& op : netT->oplists) {
+            PackWeight(op);
+        }
+        for (auto& subgraph : netT->subgraphs) {
+            for (auto& op : subgraph->nodes) {
+                PackWeight(op);
+            }
+        }
+    }
+
     std::set<std::string> notSupportOps;
     auto CheckIfNotSupported = [&] (const std::unique_ptr<MNN::OpT>& op) {
         if (op->type == MNN::OpType_Extra) {
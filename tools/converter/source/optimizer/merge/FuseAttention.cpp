@@ -0,0 +1,177 @@
+//
+//  FuseAttention.cpp
+//  MNNConverter
+//
+//  Created by MNN on 2021/03/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "../TemplateMerge.hpp"
+#include "MNN/expr/ExprCreator.hpp"
+#include "MNN_generated.h"
+#include "MergeHelpers.hpp"
+
+namespace MNN {
+namespace Express {
+
+// Read the transpose flags of MatMul / BatchMatMul
+static bool GetMatMulTranspose(EXPRP expr, bool* transposeA, bool* transposeB) {
+    const Op* op = expr->get();
+    if (!op) {
+        return false;
+    }
+    if (op->type() == OpType_MatMul && op->main_type() == OpParameter_MatMul) {
+        *transposeA = op->main_as_MatMul()->transposeA();
+        *transposeB = op->main_as_MatMul()->transposeB();
+        return true;
+    }
+    if (op->type() == OpType_BatchMatMul && op->main_type() == OpParameter_BatchMatMulParam) {
+        *transposeA = op->main_as_BatchMatMulParam()->adjX();
+        *transposeB = op->main_as_BatchMatMulParam()->adjY();
+        return true;
+    }
+    return false;
+}
+
+// Return the input of a Permute / Transpose which only swaps the last two dimensions, or nullptr
+static VARP SwapLastTwoInput(VARP x) {
+    EXPRP expr   = x->expr().first;
+    const Op* op = expr->get();
+    if (!op) {
+        return nullptr;
+    }
+    std::vector<int> perm;
+    if (op->type() == OpType_Permute && op->main_type() == OpParameter_Permute) {
+        auto dims = op->main_as_Permute()->dims();
+        if (nullptr == dims) {
+            return nullptr;
+        }
+        perm.assign(dims->begin(), dims->end());
+    } else if (op->type() == OpType_Transpose && expr->inputs().size() == 2 &&
+               helpers::IsConstant(expr->inputs().at(1)->expr().first)) {
+        auto* info = expr->inputs().at(1)->getInfo();
+        auto* ptr  = expr->inputs().at(1)->readMap<int>();
+        if (!info || !ptr) {
+            return nullptr;
+        }
+        perm.assign(ptr, ptr + info->size);
+    } else {
+        return nullptr;
+    }
+    const int rank = perm.size();
+    if (rank < 2 || perm[rank - 2] != rank - 1 || perm[rank - 1] != rank - 2) {
+        return nullptr;
+    }
+    for (int i = 0; i < rank - 2; ++i) {
+        if (perm[i] != i) {
+            return nullptr;
+        }
+    }
+    return expr->inputs().at(0);
+}
+
+// MatMul(Softmax(MatMul(Q, K^T) * scale), V) -> Attention(Q, K, V)
+class FuseAttention {
+public:
+    FuseAttention();
+
+private:
+    VARP query_var_;
+    VARP key_var_;
+    VARP value_var_;
+    float scale_ = 1.0f;
+};
+
+FuseAttention::FuseAttention() {
+    auto match = [this](EXPRP expr) -> bool {
+        bool transpose_a = false;
+        bool transpose_b = false;
+        if (!expr->get() || !GetMatMulTranspose(expr, &transpose_a, &transpose_b) || transpose_a || transpose_b) {
+            return false;
+        }
+        EXPRP softmax = expr->inputs().at(0)->expr().first;
+        if (!helpers::IsSoftmax(softmax) || softmax->get()->main_type() != OpParameter_Axis) {
+            return false;
+        }
+        VARP scores  = softmax->inputs().at(0);
+        float scale  = 1.0f;
+        EXPRP factor = scores->expr().first;
+        if (helpers::IsBinaryMul(factor) || helpers::IsBinaryRealDiv(factor)) {
+            int const_index = -1;
+            if (helpers::IsConstant(factor->inputs().at(1)->expr().first)) {
+                const_index = 1;
+            } else if (helpers::IsBinaryMul(factor) && helpers::IsConstant(factor->inputs().at(0)->expr().first)) {
+                const_index = 0;
+            }
+            if (const_index < 0) {
+                return false;
+            }
+            VARP const_var = factor->inputs().at(const_index);
+            auto* info     = const_var->getInfo();
+            if (!info || info->size != 1 || info->type != halide_type_of<float>()) {
+                return false;
+            }
+            scale = const_var->readMap<float>()[0];
+            if (helpers::IsBinaryRealDiv(factor)) {
+                scale = 1.0f / scale;
+            }
+            scores = factor->inputs().at(1 - const_index);
+        }
+        EXPRP qk = scores->expr().first;
+        if (!GetMatMulTranspose(qk, &transpose_a, &transpose_b) || transpose_a) {
+            return false;
+        }
+        VARP query = qk->inputs().at(0);
+        VARP key   = qk->inputs().at(1);
+        if (!transpose_b) {
+            key = SwapLastTwoInput(key);
+            if (nullptr == key) {
+                return false;
+            }
+        }
+        VARP value = expr->inputs().at(1);
+
+        // The fused op doesn't broadcast, so the shapes must be known and match
+        auto* q_info = query->getInfo();
+        auto* k_info = key->getInfo();
+        auto* v_info = value->getInfo();
+        if (!q_info || !k_info || !v_info || q_info->type != halide_type_of<float>()) {
+            return false;
+        }
+        const int rank = q_info->dim.size();
+        if (rank < 2 || k_info->dim.size() != rank || v_info->dim.size() != rank) {
+            return false;
+        }
+        for (int i = 0; i < rank - 2; ++i) {
+            if (k_info->dim[i] != q_info->dim[i] || v_info->dim[i] != q_info->dim[i]) {
+                return false;
+            }
+        }
+        if (k_info->dim[rank - 1] != q_info->dim[rank - 1] || k_info->dim[rank - 2] != v_info->dim[rank - 2]) {
+            return false;
+        }
+        int axis = softmax->get()->main_as_Axis()->axis();
+        if (axis != -1 && axis != rank - 1) {
+            return false;
+        }
+
+        query_var_ = query;
+        key_var_   = key;
+        value_var_ = value;
+        scale_     = scale;
+        return true;
+    };
+
+    auto fold = [this](EXPRP expr) -> bool {
+        EXPRP attention_expr = _Attention(query_var_, key_var_, value_var_, scale_)->expr().first;
+        attention_expr->setName(expr->name());
+        Expr::replace(expr, attention_expr);
+        return true /*modified*/;
+    };
+    TemplateMerge::getInstance("Merge").insertTemplate("FuseAttention", match, fold);
+}
+
+static FuseAttention g_fuse_attention;
+
+} // namespace Express
+} // namespace MNN
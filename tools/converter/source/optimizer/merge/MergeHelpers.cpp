@@ -54,6 +54,10 @@ bool IsBinaryMul(EXPRP expr) {
     IS_BINARY_OP_TYPE(BinaryOpOperation_MUL);
 }
 
+bool IsBinaryRealDiv(EXPRP expr) {
+    IS_BINARY_OP_TYPE(BinaryOpOperation_REALDIV);
+}
+
 bool IsBinarySquaredDifference(Express::EXPRP expr) {
     IS_BINARY_OP_TYPE(BinaryOpOperation_SquaredDifference);
 }
@@ -88,6 +92,11 @@ bool IsExpandDims(EXPRP expr) {
     return op && op->type() == OpType_ExpandDims;
 }
 
+bool IsSoftmax(EXPRP expr) {
+    const Op* op = expr->get();
+    return op && op->type() == OpType_Softmax;
+}
+
 EXPRP InputExpr(EXPRP expr, int input_index) {
     return expr->inputs().at(input_index)->expr().first;
 }
@@ -15,6 +15,7 @@ bool IsUnaryOp(Express::EXPRP expr);
 bool IsBinaryAdd(Express::EXPRP expr);
 bool IsBinarySub(Express::EXPRP expr);
 bool IsBinaryMul(Express::EXPRP expr);
+bool IsBinaryRealDiv(Express::EXPRP expr);
 
 bool IsBinarySquaredDifference(Express::EXPRP expr);
 
@@ -27,6 +28,8 @@ bool IsConvolution(Express::EXPRP expr);
 
 bool IsExpandDims(Express::EXPRP expr);
 
+bool IsSoftmax(Express::EXPRP expr);
+
 Express::EXPRP InputExpr(Express::EXPRP expr, int input_index);
 Express::EXPRP OutputExpr(Express::EXPRP expr, int output_index);
 
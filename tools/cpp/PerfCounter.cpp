@@ -0,0 +1,113 @@
+//
+//  PerfCounter.cpp
+//  MNN
+//
+//  Created by MNN on 2021/04/30.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "PerfCounter.hpp"
+#include <stdlib.h>
+#include <string.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <dirent.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#define MNN_PERF_COUNTER_SUPPORT
+#endif
+
+namespace MNN {
+
+#ifdef MNN_PERF_COUNTER_SUPPORT
+static int _openEvent(uint64_t config, int tid, int groupFd) {
+    struct perf_event_attr attr;
+    ::memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, tid, -1, groupFd, 0);
+}
+#endif
+
+PerfCounter::~PerfCounter() {
+#ifdef MNN_PERF_COUNTER_SUPPORT
+    for (auto& fds : mFds) {
+        for (auto fd : fds) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounter::open() {
+#ifdef MNN_PERF_COUNTER_SUPPORT
+    const uint64_t configs[EVENT_NUMBER] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                            PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+    DIR* root = opendir("/proc/self/task");
+    if (nullptr == root) {
+        return false;
+    }
+    struct dirent* ent;
+    while ((ent = readdir(root)) != nullptr) {
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+        int tid = atoi(ent->d_name);
+        std::vector<int> fds;
+        for (int i = 0; i < EVENT_NUMBER; ++i) {
+            int fd = _openEvent(configs[i], tid, fds.empty() ? -1 : fds[0]);
+            if (fd < 0) {
+                break;
+            }
+            fds.emplace_back(fd);
+        }
+        if (fds.size() != EVENT_NUMBER) {
+            // The thread has exited or the event is not supported
+            for (auto fd : fds) {
+                close(fd);
+            }
+            continue;
+        }
+        mFds.emplace_back(fds);
+        mThreads.emplace_back(tid);
+    }
+    closedir(root);
+    return valid();
+#else
+    return false;
+#endif
+}
+
+void PerfCounter::read(std::vector<Values>& values) const {
+    values.resize(mFds.size());
+#ifdef MNN_PERF_COUNTER_SUPPORT
+    // nr, time enabled, time running, values of the group
+    uint64_t buffer[3 + EVENT_NUMBER];
+    for (int i = 0; i < mFds.size(); ++i) {
+        if (::read(mFds[i][0], buffer, sizeof(buffer)) != sizeof(buffer)) {
+            continue;
+        }
+        values[i].timeEnabled = buffer[1];
+        values[i].timeRunning = buffer[2];
+        ::memcpy(values[i].value, buffer + 3, EVENT_NUMBER * sizeof(uint64_t));
+    }
+#endif
+}
+
+void PerfCounter::diff(const Values& begin, const Values& end, double* result) {
+    double scale = 1.0;
+    auto enabled = end.timeEnabled - begin.timeEnabled;
+    auto running = end.timeRunning - begin.timeRunning;
+    if (running > 0 && running < enabled) {
+        scale = (double)enabled / (double)running;
+    }
+    for (int i = 0; i < EVENT_NUMBER; ++i) {
+        result[i] = (double)(end.value[i] - begin.value[i]) * scale;
+    }
+}
+
+} // namespace MNN
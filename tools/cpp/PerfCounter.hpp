@@ -0,0 +1,61 @@
+//
+//  PerfCounter.hpp
+//  MNN
+//
+//  Created by MNN on 2021/04/30.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef PerfCounter_hpp
+#define PerfCounter_hpp
+
+#include <stdint.h>
+#include <vector>
+
+namespace MNN {
+
+/** Hardware counters of each thread of the process by perf_event_open, only supported on linux / android */
+class PerfCounter {
+public:
+    enum Event {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        // Last level cache
+        CACHE_REFERENCES,
+        CACHE_MISSES,
+        EVENT_NUMBER
+    };
+    struct Values {
+        uint64_t value[EVENT_NUMBER] = {0};
+        uint64_t timeEnabled         = 0;
+        uint64_t timeRunning         = 0;
+    };
+    PerfCounter() = default;
+    ~PerfCounter();
+    /**
+     * @brief open the counters of the threads existing now, call it after the session is created so that the
+     * workers of the thread pool are counted.
+     * @return false if perf_event_open is not supported or not permitted (see /proc/sys/kernel/perf_event_paranoid).
+     */
+    bool open();
+    bool valid() const {
+        return !mThreads.empty();
+    }
+    /** thread ids of the counters */
+    const std::vector<int>& threads() const {
+        return mThreads;
+    }
+    /** read the counters of each thread */
+    void read(std::vector<Values>& values) const;
+    /** difference of the counters, scaled by the running time if the counters are multiplexed */
+    static void diff(const Values& begin, const Values& end, double* result);
+
+private:
+    // The group leader of each thread is the fd of cycles
+    std::vector<std::vector<int>> mFds;
+    std::vector<int> mThreads;
+};
+
+} // namespace MNN
+
+#endif /* PerfCounter_hpp */
@@ -8,6 +8,7 @@
 
 #include <string.h>
 #include <algorithm>
+#include <functional>
 #include <string>
 #if defined(_MSC_VER)
 #include <Windows.h>
@@ -100,21 +101,48 @@ Profiler::Record& Profiler::getNamedRecord(const OperatorInfo* op) {
 }
 
 void Profiler::start(const OperatorInfo* info) {
-    mStartTime = getTime();
     mTotalMFlops += info->flops();
     auto& typed = getTypedRecord(info);
     typed.calledTimes++;
     typed.flops += info->flops();
     auto& named = getNamedRecord(info);
     named.flops += info->flops();
+    if (nullptr != mCounter) {
+        mCounter->read(mStartValues);
+    }
+    // Taken last and read first in end, so that the time doesn't include the reads of the counters
+    mStartTime = getTime();
 }
 
 void Profiler::end(const OperatorInfo* info) {
-    mEndTime   = getTime();
+    mEndTime = getTime();
+    if (nullptr != mCounter) {
+        mCounter->read(mEndValues);
+    }
     float cost = (float)(mEndTime - mStartTime) / 1000.0f;
     mMapByType[info->type()].costTime += cost;
-    mMapByName[info->name()].costTime += cost;
+    auto& named = mMapByName[info->name()];
+    named.costTime += cost;
     mTotalTime += cost;
+    if (nullptr != mCounter) {
+        named.counters.resize(mEndValues.size() * PerfCounter::EVENT_NUMBER);
+        double delta[PerfCounter::EVENT_NUMBER];
+        for (int i = 0; i < mEndValues.size(); ++i) {
+            PerfCounter::diff(mStartValues[i], mEndValues[i], delta);
+            for (int e = 0; e < PerfCounter::EVENT_NUMBER; ++e) {
+                named.counters[i * PerfCounter::EVENT_NUMBER + e] += delta[e];
+            }
+        }
+    }
+}
+
+bool Profiler::enableHardwareCounter() {
+    std::shared_ptr<PerfCounter> counter(new PerfCounter);
+    if (!counter->open()) {
+        return false;
+    }
+    mCounter = counter;
+    return true;
 }
 
 static void printTable(const char* title, const std::vector<std::string>& header,
@@ -193,4 +221,56 @@ void Profiler::printTimeByName(int loops) {
     printTable("Sort by node name !", header, rows);
 }
 
+void Profiler::printHardwareCounterByName(int loops) {
+    if (nullptr == mCounter) {
+        MNN_PRINT("Hardware counter is not enabled\n");
+        return;
+    }
+    // Bytes from memory are estimated by the last level cache misses
+    const double cacheLine = 64.0;
+    std::vector<std::pair<float, std::string>> sorted;
+    for (auto& iter : mMapByName) {
+        sorted.push_back(std::make_pair(iter.second.costTime, iter.first));
+    }
+    std::sort(sorted.begin(), sorted.end(), std::greater<std::pair<float, std::string>>());
+
+    const std::vector<std::string> header = {"Node Name", "Op Type", "Avg(ms)",   "MCycles",     "IPC",
+                                             "LLC Miss %", "GB/s",  "GFLOPS",   "Flops/Byte", "MCycles by thread"};
+    std::vector<std::vector<std::string>> rows;
+    for (auto& iter : sorted) {
+        auto& record = mMapByName.find(iter.second)->second;
+        double sum[PerfCounter::EVENT_NUMBER] = {0.0};
+        std::string threadCycles;
+        auto threadNumber = record.counters.size() / PerfCounter::EVENT_NUMBER;
+        for (int i = 0; i < threadNumber; ++i) {
+            for (int e = 0; e < PerfCounter::EVENT_NUMBER; ++e) {
+                sum[e] += record.counters[i * PerfCounter::EVENT_NUMBER + e];
+            }
+            char cycles[32];
+            sprintf(cycles, "%s%.2f", i > 0 ? "/" : "",
+                    record.counters[i * PerfCounter::EVENT_NUMBER + PerfCounter::CYCLES] / 1e6 / loops);
+            threadCycles += cycles;
+        }
+        // MFlops per ms is GFlops per second
+        double time  = record.costTime / (double)loops;
+        double flops = record.flops / (double)loops;
+        double bytes = sum[PerfCounter::CACHE_MISSES] * cacheLine / loops;
+        std::vector<std::string> columns;
+        columns.push_back(iter.second);
+        columns.push_back(record.type);
+        columns.push_back(toString(time));
+        columns.push_back(toString(sum[PerfCounter::CYCLES] / 1e6 / loops));
+        columns.push_back(toString(sum[PerfCounter::CYCLES] > 0 ? sum[PerfCounter::INSTRUCTIONS] / sum[PerfCounter::CYCLES] : 0.0));
+        columns.push_back(toString(sum[PerfCounter::CACHE_REFERENCES] > 0
+                                       ? sum[PerfCounter::CACHE_MISSES] / sum[PerfCounter::CACHE_REFERENCES] * 100.0
+                                       : 0.0));
+        columns.push_back(toString(time > 0 ? bytes / time / 1e6 : 0.0));
+        columns.push_back(toString(time > 0 ? flops / time : 0.0));
+        columns.push_back(toString(bytes > 0 ? flops * 1e6 / bytes : 0.0));
+        columns.push_back(threadCycles);
+        rows.emplace_back(columns);
+    }
+    printTable("Hardware counters, sort by time cost !", header, rows);
+}
+
 } // namespace MNN
@@ -12,10 +12,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <MNN/Interpreter.hpp>
 #include <MNN/Tensor.hpp>
+#include "PerfCounter.hpp"
 
 namespace MNN {
 
@@ -46,6 +48,18 @@ public:
      * @param loops     loop count.
      */
     void printTimeByName(int loops = 1);
+    /**
+     * @brief count cycles, instructions and last level cache misses of each op per thread by perf_event_open. call
+     * it after the session is created so that the workers of the thread pool are counted.
+     * @return false if hardware counters are not available.
+     */
+    bool enableHardwareCounter();
+    /**
+     * print hardware counters of each op, with the achieved GFLOPS and the arithmetic intensity (flops per byte
+     * of the last level cache misses), sorted by time cost.
+     * @param loops     loop count.
+     */
+    void printHardwareCounterByName(int loops = 1);
 
 private:
     ~Profiler() = default;
@@ -58,6 +72,8 @@ private:
         int64_t calledTimes;
         float costTime;
         float flops;
+        // Hardware counters: [thread, PerfCounter::Event]
+        std::vector<double> counters;
     };
 
     static Profiler* gInstance;
@@ -67,6 +83,9 @@ private:
     float mTotalMFlops  = 0.0f;
     std::map<std::string, Record> mMapByType;
     std::map<std::string, Record> mMapByName;
+    std::shared_ptr<PerfCounter> mCounter;
+    std::vector<PerfCounter::Values> mStartValues;
+    std::vector<PerfCounter::Values> mEndValues;
 
 private:
     Record& getTypedRecord(const OperatorInfo* info);
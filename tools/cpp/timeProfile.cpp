@@ -69,6 +69,11 @@ int main(int argc, const char* argv[]) {
         threadNumber = ::atoi(argv[5]);
         MNN_PRINT("Set ThreadNumber = %d\n", threadNumber);
     }
+    // Count cycles, instructions and cache misses of each op by perf_event_open
+    bool hardwareCounter = false;
+    if (argc > 6) {
+        hardwareCounter = ::atoi(argv[6]) > 0;
+    }
 
     
     // revert MNN model if necessary
@@ -107,6 +112,10 @@ int main(int argc, const char* argv[]) {
     std::shared_ptr<MNN::Tensor> outputTensorUser(MNN::Tensor::createHostTensorFromDevice(outputTensor, false));
     
     auto profiler      = MNN::Profiler::getInstance();
+    if (hardwareCounter && !profiler->enableHardwareCounter()) {
+        MNN_ERROR("Hardware counter is not available, check /proc/sys/kernel/perf_event_paranoid\n");
+        hardwareCounter = false;
+    }
     auto beginCallBack = [&](const std::vector<Tensor*>& inputs, const OperatorInfo* info) {
         profiler->start(info);
         return true;
@@ -128,5 +137,8 @@ int main(int argc, const char* argv[]) {
     profiler->printTimeByName(runTime);
 #endif
     profiler->printTimeByType(runTime);
+    if (hardwareCounter) {
+        profiler->printHardwareCounterByName(runTime);
+    }
     return 0;
 }